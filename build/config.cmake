@@ -77,6 +77,12 @@ IF (${ESCARGOT_MODE} STREQUAL "debug")
     SET (ESCARGOT_DEFINITIONS_COMMON ${ESCARGOT_DEFINITIONS_COMMON} -DGC_DEBUG)
 ENDIF()
 
+# multiple VMInstances on multiple threads
+IF (ESCARGOT_THREADING)
+    SET (ESCARGOT_DEFINITIONS ${ESCARGOT_DEFINITIONS} -DENABLE_THREADING -DGC_THREADS)
+    SET (ESCARGOT_GCUTIL_CFLAGS ${ESCARGOT_GCUTIL_CFLAGS} -DGC_THREADS -DTHREAD_LOCAL_ALLOC -DPARALLEL_MARK)
+ENDIF()
+
 #######################################################
 # FLAGS FOR $(ESCARGOT_HOST)
 #######################################################
@@ -31,6 +31,11 @@ ELSEIF (${ESCARGOT_OUTPUT} STREQUAL "shell_test")
     SET (ESCARGOT_CXXFLAGS ${ESCARGOT_CXXFLAGS} ${ESCARGOT_CXXFLAGS_SHELL} ${ESCARGOT_DEFINITIONS_TEST})
     SET (ESCARGOT_LDFLAGS ${ESCARGOT_LDFLAGS} ${ESCARGOT_LDFLAGS_SHELL})
     SET (ESCARGOT_DEFINITIONS ${ESCARGOT_DEFINITIONS} ${ESCARGOT_DEFINITIONS_SHELL})
+ELSEIF (${ESCARGOT_OUTPUT} STREQUAL "cctest")
+    SET (ESCARGOT_TARGET cctest)
+    SET (ESCARGOT_CXXFLAGS ${ESCARGOT_CXXFLAGS} ${ESCARGOT_CXXFLAGS_SHELL})
+    SET (ESCARGOT_LDFLAGS ${ESCARGOT_LDFLAGS} ${ESCARGOT_LDFLAGS_SHELL})
+    SET (ESCARGOT_DEFINITIONS ${ESCARGOT_DEFINITIONS} ${ESCARGOT_DEFINITIONS_SHELL})
 ELSEIF (${ESCARGOT_OUTPUT} STREQUAL "shared_lib")
     SET (ESCARGOT_CXXFLAGS ${ESCARGOT_CXXFLAGS} ${ESCARGOT_CXXFLAGS_SHAREDLIB})
     SET (ESCARGOT_LDFLAGS ${ESCARGOT_LDFLAGS} ${ESCARGOT_LDFLAGS_SHAREDLIB})
@@ -54,7 +59,8 @@ FILE (GLOB DOUBLE_CONVERSION_SRC ${ESCARGOT_THIRD_PARTY_ROOT}/double_conversion/
 FILE (GLOB LZ4_SRC ${ESCARGOT_THIRD_PARTY_ROOT}/lz4/*.cpp)
 
 IF (NOT ${ESCARGOT_OUTPUT} MATCHES "shell")
-    LIST (REMOVE_ITEM ESCARGOT_SRC ${ESCARGOT_ROOT}/src/shell/Shell.cpp)
+    FILE (GLOB ESCARGOT_SHELL_SRC ${ESCARGOT_ROOT}/src/shell/*.cpp)
+    LIST (REMOVE_ITEM ESCARGOT_SRC ${ESCARGOT_SHELL_SRC})
 ENDIF()
 
 SET (ESCARGOT_SRC_LIST
@@ -64,6 +70,11 @@ SET (ESCARGOT_SRC_LIST
     ${LZ4_SRC}
 )
 
+IF (${ESCARGOT_OUTPUT} STREQUAL "cctest")
+    # embedder api tests replace the shell as main of executable
+    SET (ESCARGOT_SRC_LIST ${ESCARGOT_SRC_LIST} ${ESCARGOT_ROOT}/test/cctest/cctest.cpp)
+ENDIF()
+
 # GCUTIL
 SET (GCUTIL_CFLAGS ${ESCARGOT_GCUTIL_CFLAGS})
 
@@ -95,7 +106,7 @@ ADD_SUBDIRECTORY (third_party/runtime_icu_binder)
 SET (ESCARGOT_LIBRARIES ${ESCARGOT_LIBRARIES} runtime-icu-binder-static)
 
 # BUILD
-IF (${ESCARGOT_OUTPUT} MATCHES "shell")
+IF (${ESCARGOT_OUTPUT} MATCHES "shell" OR ${ESCARGOT_OUTPUT} STREQUAL "cctest")
     ADD_EXECUTABLE (${ESCARGOT_TARGET} ${ESCARGOT_SRC_LIST})
 
     TARGET_LINK_LIBRARIES (${ESCARGOT_TARGET} ${ESCARGOT_LIBRARIES} ${ESCARGOT_LDFLAGS} ${LDFLAGS_FROM_ENV})
@@ -185,6 +185,7 @@
 #endif
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <climits>
 #include <clocale>
@@ -200,6 +201,7 @@
 #include <locale>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <sstream>
 #include <string>
@@ -388,6 +390,23 @@ typedef uint16_t ByteCodeRegisterIndex;
 #define KEEP_NUMERAL_LITERDATA_IN_REGISTERFILE_LIMIT 16
 #endif
 
+#ifndef INTERPRETER_REGISTER_STACK_SIZE
+#define INTERPRETER_REGISTER_STACK_SIZE (1024 * 16)
+#endif
+
+#ifndef INTERPRETER_CALL_FRAME_STACK_SIZE
+#define INTERPRETER_CALL_FRAME_STACK_SIZE 512
+#endif
+
+// interpreter stack is allocated by segments of these sizes as calls get deeper
+#ifndef INTERPRETER_REGISTER_STACK_SEGMENT_SIZE
+#define INTERPRETER_REGISTER_STACK_SEGMENT_SIZE (1024 * 2)
+#endif
+
+#ifndef INTERPRETER_CALL_FRAME_SEGMENT_SIZE
+#define INTERPRETER_CALL_FRAME_SEGMENT_SIZE 16
+#endif
+
 typedef uint16_t LexicalBlockIndex;
 #define LEXICAL_BLOCK_INDEX_MAX (std::numeric_limits<LexicalBlockIndex>::max())
 
@@ -399,6 +418,11 @@ typedef uint16_t LexicalBlockIndex;
 #define STACK_LIMIT_FROM_BASE (1024 * 1024 * 3) // 3MB
 #endif
 
+// stack area kept below stack limit for native frames running after stack limit check
+#ifndef STACK_FREESPACE_FROM_LIMIT
+#define STACK_FREESPACE_FROM_LIMIT (1024 * 256) // 256KB
+#endif
+
 #ifndef STRING_MAXIMUM_LENGTH
 #define STRING_MAXIMUM_LENGTH 1024 * 1024 * 512 // 512MB
 #endif
@@ -419,11 +443,20 @@ typedef uint16_t LexicalBlockIndex;
 #define REGEXP_CACHE_SIZE_MAX 64
 #endif
 
+#ifndef OBJECT_KEYS_CACHE_SIZE_MAX
+#define OBJECT_KEYS_CACHE_SIZE_MAX 128
+#endif
+
 
 #ifndef ROPE_STRING_MIN_LENGTH
 #define ROPE_STRING_MIN_LENGTH 24
 #endif
 
+// maximum spare capacity(in characters) reserved when appending onto flat buffer of RopeString
+#ifndef ROPE_STRING_EXTENSIBLE_SLACK_MAX
+#define ROPE_STRING_EXTENSIBLE_SLACK_MAX (1024 * 1024)
+#endif
+
 #include "heap/Heap.h"
 #include "CheckedArithmetic.h"
 #include "runtime/String.h"
@@ -51,6 +51,11 @@
 #include "runtime/MapObject.h"
 #include "runtime/WeakMapObject.h"
 #include "runtime/CompressibleString.h"
+#include "runtime/ObjectTemplate.h"
+#include "runtime/FunctionTemplate.h"
+#include "runtime/MessagePort.h"
+#include "runtime/ValueSerializer.h"
+#include "heap/HeapCensus.h"
 
 namespace Escargot {
 
@@ -108,6 +113,9 @@ DEFINE_CAST(SetObject);
 DEFINE_CAST(WeakSetObject);
 DEFINE_CAST(MapObject);
 DEFINE_CAST(WeakMapObject);
+DEFINE_CAST(ObjectTemplate);
+DEFINE_CAST(FunctionTemplate);
+DEFINE_CAST(MessagePort);
 
 #undef DEFINE_CAST
 
@@ -166,6 +174,28 @@ void Globals::finalize()
     Heap::finalize();
 }
 
+static void releaseLocalHandleBlocks();
+
+void Globals::initializeThread()
+{
+    Heap::initializeThread();
+}
+
+void Globals::finalizeThread()
+{
+    releaseLocalHandleBlocks();
+    Heap::finalizeThread();
+}
+
+bool Globals::supportsThreading()
+{
+#if defined(ENABLE_THREADING)
+    return true;
+#else
+    return false;
+#endif
+}
+
 void* Memory::gcMalloc(size_t siz)
 {
     return GC_MALLOC(siz);
@@ -239,6 +269,111 @@ void Memory::setGCEventListener(OnGCEventListener l)
     GC_add_event_callback(gcEventListener, nullptr);
 }
 
+// Persistent handles are allocated from uncollectable blocks.
+// Free slots store address of next free slot. the address points into uncollectable block,
+// so it never keeps gc-allocated memory alive.
+// Blocks are never released because holders can be destroyed after Globals::finalize
+// holders can be created and destroyed on any thread, so free list is guarded by mutex
+static const size_t PersistentHandleBlockSlotCount = 1024;
+static void** g_persistentHandleFreeList;
+static std::mutex g_persistentHandleMutex;
+
+void** Memory::allocatePersistentHandle()
+{
+    std::lock_guard<std::mutex> guard(g_persistentHandleMutex);
+    if (UNLIKELY(!g_persistentHandleFreeList)) {
+        void** block = (void**)GC_MALLOC_UNCOLLECTABLE(sizeof(void*) * PersistentHandleBlockSlotCount);
+        for (size_t i = 0; i < PersistentHandleBlockSlotCount - 1; i++) {
+            block[i] = &block[i + 1];
+        }
+        block[PersistentHandleBlockSlotCount - 1] = nullptr;
+        g_persistentHandleFreeList = block;
+    }
+
+    void** handle = g_persistentHandleFreeList;
+    g_persistentHandleFreeList = (void**)*handle;
+    *handle = nullptr;
+    return handle;
+}
+
+void Memory::freePersistentHandle(void** handle)
+{
+    ASSERT(handle);
+    std::lock_guard<std::mutex> guard(g_persistentHandleMutex);
+    *handle = g_persistentHandleFreeList;
+    g_persistentHandleFreeList = handle;
+}
+
+// Local handles are pushed on chain of uncollectable blocks.
+// Blocks are kept for next scopes, so opening and closing scope doesn't allocate memory usually
+// Each thread has its own chain because scopes are nested on stack of a thread
+static const size_t LocalHandleBlockSlotCount = 256;
+static thread_local std::vector<void**> g_localHandleBlocks;
+static thread_local size_t g_localHandleTop;
+static thread_local size_t g_handleScopeDepth;
+
+static void releaseLocalHandleBlocks()
+{
+    ASSERT(!g_handleScopeDepth);
+    for (size_t i = 0; i < g_localHandleBlocks.size(); i++) {
+        GC_FREE(g_localHandleBlocks[i]);
+    }
+    g_localHandleBlocks.clear();
+    g_localHandleTop = 0;
+}
+
+HandleScope::HandleScope()
+    : m_savedTop(g_localHandleTop)
+{
+    g_handleScopeDepth++;
+}
+
+HandleScope::~HandleScope()
+{
+    ASSERT(g_handleScopeDepth);
+    ASSERT(m_savedTop <= g_localHandleTop);
+    // clear popped slots for gc
+    for (size_t i = m_savedTop; i < g_localHandleTop; i++) {
+        g_localHandleBlocks[i / LocalHandleBlockSlotCount][i % LocalHandleBlockSlotCount] = nullptr;
+    }
+    g_localHandleTop = m_savedTop;
+    g_handleScopeDepth--;
+}
+
+void** HandleScope::allocateHandle()
+{
+    // handle should be allocated in scope
+    RELEASE_ASSERT(g_handleScopeDepth);
+    size_t blockIndex = g_localHandleTop / LocalHandleBlockSlotCount;
+    if (UNLIKELY(blockIndex == g_localHandleBlocks.size())) {
+        g_localHandleBlocks.push_back((void**)GC_MALLOC_UNCOLLECTABLE(sizeof(void*) * LocalHandleBlockSlotCount));
+    }
+    return &g_localHandleBlocks[blockIndex][g_localHandleTop++ % LocalHandleBlockSlotCount];
+}
+
+size_t HandleScope::handleCount()
+{
+    return g_localHandleTop;
+}
+
+EscapableHandleScope::EscapableHandleScope()
+    : m_escapeSlot(nullptr)
+{
+    // escaped pointer is kept by the enclosing scope
+    RELEASE_ASSERT(g_handleScopeDepth > 1);
+    // slot is reserved below this scope, so it survives destruction of this scope
+    m_escapeSlot = allocateHandle();
+    m_savedTop = g_localHandleTop;
+}
+
+void** EscapableHandleScope::escapeSlot()
+{
+    RELEASE_ASSERT(m_escapeSlot);
+    void** slot = m_escapeSlot;
+    m_escapeSlot = nullptr;
+    return slot;
+}
+
 // I store ref count as SmallValue. this can prevent what bdwgc can see ref count as address (SmallValue store integer value as odd)
 using PersistentValueRefMapImpl = std::unordered_map<ValueRef*, SmallValue, std::hash<void*>, std::equal_to<void*>, GCUtil::gc_malloc_allocator<std::pair<ValueRef* const, SmallValue>>>;
 
@@ -328,6 +463,30 @@ StringRef* StringRef::createExternalFromUTF16(const char16_t* s, size_t len)
     return toRef(new UTF16String(s, len, String::FromExternalMemory));
 }
 
+static void registerExternalStringBufferReleaser(String* string, StringRef::ExternalStringBufferReleaser releaser)
+{
+    GC_REGISTER_FINALIZER_NO_ORDER(string, [](void* obj, void* data) {
+        String* string = (String*)obj;
+        auto bufferData = string->bufferAccessData();
+        ((StringRef::ExternalStringBufferReleaser)data)(bufferData.buffer, bufferData.length);
+    },
+                                   (void*)releaser, nullptr, nullptr);
+}
+
+StringRef* StringRef::createExternalFromASCII(const char* s, size_t len, ExternalStringBufferReleaser releaser)
+{
+    String* string = new ASCIIString(s, len, String::FromExternalMemory);
+    registerExternalStringBufferReleaser(string, releaser);
+    return toRef(string);
+}
+
+StringRef* StringRef::createExternalFromLatin1(const unsigned char* s, size_t len, ExternalStringBufferReleaser releaser)
+{
+    String* string = new Latin1String(s, len, String::FromExternalMemory);
+    registerExternalStringBufferReleaser(string, releaser);
+    return toRef(string);
+}
+
 bool StringRef::isCompressibleStringEnabled()
 {
 #if defined(ENABLE_COMPRESSIBLE_STRING)
@@ -623,6 +782,12 @@ public:
         m_platform->onArrayBufferObjectDataBufferFree(toRef(whereObjectMade), toRef(obj), buffer);
     }
 
+    virtual void* arrayBufferAllocatorIdentity() override
+    {
+        // VMInstances created with same PlatformRef have their own bridges
+        return m_platform;
+    }
+
     virtual void didPromiseJobEnqueued(Context* relatedContext, PromiseObject* obj) override
     {
         m_platform->didPromiseJobEnqueued(toRef(relatedContext), toRef(obj));
@@ -640,6 +805,28 @@ public:
         return result;
     }
 
+    virtual LoadModuleResultVector onLoadModules(Context* relatedContext, const ModuleRequestVector& requests) override
+    {
+        std::vector<PlatformRef::ModuleRequest> refRequests;
+        refRequests.reserve(requests.size());
+        for (size_t i = 0; i < requests.size(); i++) {
+            refRequests.push_back({ toRef(requests[i].whereRequestFrom), toRef(requests[i].moduleSrc) });
+        }
+
+        auto refResults = m_platform->onLoadModules(toRef(relatedContext), refRequests);
+        ASSERT(refResults.size() == requests.size());
+
+        LoadModuleResultVector results;
+        for (size_t i = 0; i < refResults.size(); i++) {
+            LoadModuleResult result;
+            result.script = toImpl(refResults[i].script.get());
+            result.errorMessage = toImpl(refResults[i].errorMessage);
+            result.errorCode = refResults[i].errorCode;
+            results.push_back(result);
+        }
+        return results;
+    }
+
     virtual void didLoadModule(Context* relatedContext, Optional<Script*> whereRequestFrom, Script* loadedModule) override
     {
         if (whereRequestFrom) {
@@ -778,6 +965,82 @@ void VMInstanceRef::clearCachesRelatedWithContext()
     imp->globalSymbolRegistry().clear();
 }
 
+void VMInstanceRef::setCompressibleStringMemoryBudget(size_t budgetInBytes)
+{
+#if defined(ENABLE_COMPRESSIBLE_STRING)
+    toImpl(this)->compressibleStringsMemoryBudget() = budgetInBytes;
+#endif
+}
+
+size_t VMInstanceRef::compressibleStringMemoryBudget()
+{
+#if defined(ENABLE_COMPRESSIBLE_STRING)
+    return toImpl(this)->compressibleStringsMemoryBudget();
+#else
+    return SIZE_MAX;
+#endif
+}
+
+void VMInstanceRef::compressIdleCompressibleStrings()
+{
+#if defined(ENABLE_COMPRESSIBLE_STRING)
+    VMInstance* imp = toImpl(this);
+    auto currentTick = fastTickCount();
+    imp->compressStringsIfNeeds(currentTick);
+    imp->m_lastCompressibleStringsTestTime = currentTick;
+#endif
+}
+
+bool VMInstanceRef::startCPUProfiler(size_t samplingIntervalInMicroseconds)
+{
+    return toImpl(this)->samplingProfiler()->start(samplingIntervalInMicroseconds);
+}
+
+void VMInstanceRef::stopCPUProfiler()
+{
+    toImpl(this)->samplingProfiler()->stop();
+}
+
+std::string VMInstanceRef::dumpCPUProfile()
+{
+    return toImpl(this)->samplingProfiler()->dumpFoldedStacks();
+}
+
+bool VMInstanceRef::startAllocationProfiler(size_t samplingIntervalInBytes)
+{
+    return toImpl(this)->allocationProfiler()->start(samplingIntervalInBytes);
+}
+
+void VMInstanceRef::stopAllocationProfiler()
+{
+    toImpl(this)->allocationProfiler()->stop();
+}
+
+std::string VMInstanceRef::dumpAllocationProfile()
+{
+    return toImpl(this)->allocationProfiler()->dumpAllocationSites();
+}
+
+std::string VMInstanceRef::dumpHeapCensus()
+{
+    std::vector<HeapCensus::Item> items = HeapCensus::take(toImpl(this));
+    std::string result;
+    size_t totalCount = 0;
+    size_t totalBytes = 0;
+    for (size_t i = 0; i < items.size(); i++) {
+        result += items[i].m_typeName + " " + std::to_string(items[i].m_count) + " " + std::to_string(items[i].m_bytes) + "\n";
+        totalCount += items[i].m_count;
+        totalBytes += items[i].m_bytes;
+    }
+    result += "(total) " + std::to_string(totalCount) + " " + std::to_string(totalBytes) + "\n";
+    return result;
+}
+
+bool VMInstanceRef::writeHeapSnapshot(const char* filePath)
+{
+    return HeapCensus::writeSnapshot(toImpl(this), filePath);
+}
+
 #define DECLARE_GLOBAL_SYMBOLS(name)                      \
     SymbolRef* VMInstanceRef::name##Symbol()              \
     {                                                     \
@@ -1055,10 +1318,10 @@ bool ObjectRef::defineAccessorProperty(ExecutionStateRef* state, ValueRef* prope
                                            ObjectPropertyName(*toImpl(state), toImpl(propertyName)), ObjectPropertyDescriptor(JSGetterSetter(toImpl(desc.m_getter), toImpl(desc.m_setter)), (ObjectPropertyDescriptor::PresentAttribute)desc.m_attribute));
 }
 
-bool ObjectRef::defineNativeDataAccessorProperty(ExecutionStateRef* state, ValueRef* propertyName, NativeDataAccessorPropertyData* publicData)
+static ObjectPropertyNativeGetterSetterData* toNativeGetterSetterData(ObjectRef::NativeDataAccessorPropertyData* publicData)
 {
     ObjectPropertyNativeGetterSetterData* innerData = new ObjectPropertyNativeGetterSetterData(publicData->m_isWritable, publicData->m_isEnumerable, publicData->m_isConfigurable, [](ExecutionState& state, Object* self, const SmallValue& privateDataFromObjectPrivateArea) -> Value {
-        NativeDataAccessorPropertyData* publicData = reinterpret_cast<NativeDataAccessorPropertyData*>(privateDataFromObjectPrivateArea.payload());
+        ObjectRef::NativeDataAccessorPropertyData* publicData = reinterpret_cast<ObjectRef::NativeDataAccessorPropertyData*>(privateDataFromObjectPrivateArea.payload());
         return toImpl(publicData->m_getter(toRef(&state), toRef(self), publicData));
     },
                                                                                                nullptr);
@@ -1071,12 +1334,18 @@ bool ObjectRef::defineNativeDataAccessorProperty(ExecutionStateRef* state, Value
         };
     } else {
         innerData->m_setter = [](ExecutionState& state, Object* self, SmallValue& privateDataFromObjectPrivateArea, const Value& setterInputData) -> bool {
-            NativeDataAccessorPropertyData* publicData = reinterpret_cast<NativeDataAccessorPropertyData*>(privateDataFromObjectPrivateArea.payload());
+            ObjectRef::NativeDataAccessorPropertyData* publicData = reinterpret_cast<ObjectRef::NativeDataAccessorPropertyData*>(privateDataFromObjectPrivateArea.payload());
             // ExecutionStateRef* state, ObjectRef* self, NativeDataAccessorPropertyData* data, ValueRef* setterInputData
             return publicData->m_setter(toRef(&state), toRef(self), publicData, toRef(setterInputData));
         };
     }
 
+    return innerData;
+}
+
+bool ObjectRef::defineNativeDataAccessorProperty(ExecutionStateRef* state, ValueRef* propertyName, NativeDataAccessorPropertyData* publicData)
+{
+    ObjectPropertyNativeGetterSetterData* innerData = toNativeGetterSetterData(publicData);
     return toImpl(this)->defineNativeDataAccessorProperty(*toImpl(state), ObjectPropertyName(*toImpl(state), toImpl(propertyName)), innerData, Value(Value::FromPayload, (intptr_t)publicData));
 }
 
@@ -1198,6 +1467,34 @@ void ObjectRef::setExtraData(void* e)
     toImpl(this)->setExtraData(e);
 }
 
+size_t ObjectRef::internalFieldCount()
+{
+    Object* o = toImpl(this);
+    if (o->isTemplateObject()) {
+        return o->asTemplateObject()->internalFieldCount();
+    }
+    return 0;
+}
+
+void* ObjectRef::internalField(size_t idx)
+{
+    Object* o = toImpl(this);
+    if (o->isTemplateObject() && idx < o->asTemplateObject()->internalFieldCount()) {
+        return o->asTemplateObject()->internalField(idx);
+    }
+    return nullptr;
+}
+
+bool ObjectRef::setInternalField(size_t idx, void* value)
+{
+    Object* o = toImpl(this);
+    if (o->isTemplateObject() && idx < o->asTemplateObject()->internalFieldCount()) {
+        o->asTemplateObject()->setInternalField(idx, value);
+        return true;
+    }
+    return false;
+}
+
 void ObjectRef::removeFromHiddenClassChain()
 {
     toImpl(this)->markThisObjectDontNeedStructureTransitionTable();
@@ -1547,6 +1844,92 @@ static FunctionObjectRef* createFunction(ExecutionStateRef* state, FunctionObjec
     return toRef(f);
 }
 
+ObjectTemplateRef* ObjectTemplateRef::create(size_t internalFieldCount)
+{
+    return toRef(new ObjectTemplate(internalFieldCount));
+}
+
+void ObjectTemplateRef::set(ValueRef* propertyName, ValueRef* value, bool isWritable, bool isEnumerable, bool isConfigurable)
+{
+    int attr = 0;
+    if (isWritable)
+        attr = attr | ObjectStructurePropertyDescriptor::WritablePresent;
+    if (isEnumerable)
+        attr = attr | ObjectStructurePropertyDescriptor::EnumerablePresent;
+    if (isConfigurable)
+        attr = attr | ObjectStructurePropertyDescriptor::ConfigurablePresent;
+    toImpl(this)->set(toImpl(propertyName), toImpl(value), (ObjectStructurePropertyDescriptor::PresentAttribute)attr);
+}
+
+void ObjectTemplateRef::setNativeDataAccessorProperty(ValueRef* propertyName, ObjectRef::NativeDataAccessorPropertyData* data)
+{
+    // getter-setter data is shared by every instance, so instances have same hidden class
+    toImpl(this)->setNativeDataAccessorProperty(toImpl(propertyName), toNativeGetterSetterData(data), Value(Value::FromPayload, (intptr_t)data));
+}
+
+size_t ObjectTemplateRef::internalFieldCount()
+{
+    return toImpl(this)->internalFieldCount();
+}
+
+ObjectRef* ObjectTemplateRef::instantiate(ExecutionStateRef* state)
+{
+    return toRef(toImpl(this)->instantiate(*toImpl(state)));
+}
+
+class CallTemplateFunctionData : public CallPublicFunctionData {
+public:
+    FunctionTemplate* m_functionTemplate;
+};
+
+static Value templateFunctionBridge(ExecutionState& state, Value thisValue, size_t calledArgc, Value* calledArgv, bool isNewExpression)
+{
+    FunctionObject* callee = state.resolveCallee();
+    CallTemplateFunctionData* code = (CallTemplateFunctionData*)(callee->codeBlock()->nativeFunctionData());
+
+    if (isNewExpression) {
+        Value proto = callee->getFunctionPrototype(state);
+        Object* prototype = proto.isObject() ? proto.asObject() : state.context()->globalObject()->objectPrototype();
+        thisValue = code->m_functionTemplate->instanceTemplate()->instantiate(state, prototype);
+    }
+
+    ValueRef** newArgv = ALLOCA(sizeof(ValueRef*) * calledArgc, ValueRef*, state);
+    for (size_t i = 0; i < calledArgc; i++) {
+        newArgv[i] = toRef(calledArgv[i]);
+    }
+    Value result = toImpl(code->m_publicFn(toRef(&state), toRef(thisValue), calledArgc, newArgv, isNewExpression));
+
+    if (isNewExpression && !result.isObject()) {
+        return thisValue;
+    }
+    return result;
+}
+
+FunctionTemplateRef* FunctionTemplateRef::create(AtomicStringRef* name, size_t argumentCount, bool isStrict, bool isConstructor, FunctionObjectRef::NativeFunctionPointer fn)
+{
+    CallTemplateFunctionData* data = new CallTemplateFunctionData();
+    data->m_fn = templateFunctionBridge;
+    data->m_publicFn = fn;
+    FunctionTemplate* functionTemplate = new FunctionTemplate(toImpl(name), argumentCount, isStrict, isConstructor, data);
+    data->m_functionTemplate = functionTemplate;
+    return toRef(functionTemplate);
+}
+
+ObjectTemplateRef* FunctionTemplateRef::prototypeTemplate()
+{
+    return toRef(toImpl(this)->prototypeTemplate());
+}
+
+ObjectTemplateRef* FunctionTemplateRef::instanceTemplate()
+{
+    return toRef(toImpl(this)->instanceTemplate());
+}
+
+FunctionObjectRef* FunctionTemplateRef::instantiate(ExecutionStateRef* state)
+{
+    return toRef(toImpl(this)->instantiate(*toImpl(state)));
+}
+
 FunctionObjectRef* FunctionObjectRef::create(ExecutionStateRef* state, FunctionObjectRef::NativeFunctionInfo info)
 {
     return createFunction(state, info, false);
@@ -2432,6 +2815,70 @@ bool WeakMapObjectRef::has(ExecutionStateRef* state, ObjectRef* key)
     return toImpl(this)->has(*toImpl(state), toImpl(key));
 }
 
+std::vector<uint8_t> ValueSerializerRef::serialize(ExecutionStateRef* state, ValueRef* value)
+{
+    std::vector<uint8_t> output;
+    ValueSerializer serializer(*toImpl(state), output);
+    serializer.writeHeader();
+    serializer.writeValue(toImpl(value));
+    return output;
+}
+
+ValueRef* ValueDeserializerRef::deserialize(ExecutionStateRef* state, const uint8_t* data, size_t length)
+{
+    ValueDeserializer deserializer(*toImpl(state), data, length);
+    deserializer.readHeader();
+    return toRef(deserializer.readValue());
+}
+
+void MessagePortRef::createChannel(MessagePortRef*& port1, MessagePortRef*& port2)
+{
+    MessagePort* p1;
+    MessagePort* p2;
+    MessagePort::createEntangledPair(p1, p2);
+    port1 = toRef(p1);
+    port2 = toRef(p2);
+}
+
+void MessagePortRef::destroy()
+{
+    delete toImpl(this);
+}
+
+void MessagePortRef::postMessage(ExecutionStateRef* state, ValueRef* message, ValueVectorRef* transferList)
+{
+    ValueVector transfer;
+    if (transferList) {
+        SmallValueVector* list = toImpl(transferList);
+        transfer.resizeWithUninitializedValues(list->size());
+        for (size_t i = 0; i < list->size(); i++) {
+            transfer[i] = list->at(i);
+        }
+    }
+    toImpl(this)->postMessage(*toImpl(state), toImpl(message), transfer);
+}
+
+bool MessagePortRef::hasMessage()
+{
+    return toImpl(this)->hasMessage();
+}
+
+OptionalRef<ValueRef> MessagePortRef::receiveMessage(ExecutionStateRef* state)
+{
+    // empty value is converted into OptionalRef without value
+    return toOptionalValue(toImpl(this)->receiveMessage(*toImpl(state)));
+}
+
+bool MessagePortRef::waitForMessage(uint64_t timeoutInMilliseconds)
+{
+    return toImpl(this)->waitForMessage(timeoutInMilliseconds);
+}
+
+bool MessagePortRef::isClosed()
+{
+    return toImpl(this)->isClosed();
+}
+
 ScriptParserRef::InitializeScriptResult::InitializeScriptResult()
     : script()
     , parseErrorMessage(StringRef::emptyString())
@@ -2497,6 +2944,13 @@ StringRef* ScriptRef::moduleRequest(size_t i)
     return toRef(toImpl(this)->moduleRequest(i));
 }
 
+PlatformRef::LoadModuleResult::LoadModuleResult()
+    : script(nullptr)
+    , errorMessage(StringRef::emptyString())
+    , errorCode(ErrorObjectRef::Code::None)
+{
+}
+
 PlatformRef::LoadModuleResult::LoadModuleResult(ScriptRef* result)
     : script(result)
     , errorMessage(StringRef::emptyString())
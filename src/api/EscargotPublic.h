@@ -36,6 +36,7 @@
 #include <tuple>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #if !defined(NDEBUG) && defined(__GLIBCXX__) && !defined(_GLIBCXX_DEBUG)
 #pragma message("You should define `_GLIBCXX_DEBUG` in {debug mode + libstdc++} because Escargot uses it")
@@ -52,6 +53,8 @@ class PointerValueRef;
 class ObjectRef;
 class GlobalObjectRef;
 class FunctionObjectRef;
+class ObjectTemplateRef;
+class FunctionTemplateRef;
 class ArrayObjectRef;
 class ArrayBufferObjectRef;
 class ArrayBufferViewRef;
@@ -83,11 +86,20 @@ class ScriptParserRef;
 class ExecutionStateRef;
 class ValueVectorRef;
 class JobRef;
+class MessagePortRef;
 
 class ESCARGOT_EXPORT Globals {
 public:
     static void initialize();
     static void finalize();
+
+    // Escargot built with ENABLE_THREADING can run one VMInstance per thread concurrently
+    // every thread except one called initialize should call initializeThread before using any API,
+    // and call finalizeThread after every object of the thread is released.
+    // VMInstance should be used only on the thread which created it
+    static void initializeThread();
+    static void finalizeThread();
+    static bool supportsThreading();
 };
 
 class ESCARGOT_EXPORT Memory {
@@ -121,6 +133,12 @@ public:
     // (Allocated memory by GC x 2) / (Frequency parameter value)
     // Increasing this value may use less space but there is more collection event
     static void setGCFrequency(size_t value = 1);
+
+    // allocate root slot for PersistentRefHolder
+    // slots are carved from large uncollectable blocks and reused through free list,
+    // so bdwgc scans a few large roots instead of one root per holder
+    static void** allocatePersistentHandle();
+    static void freePersistentHandle(void** handle);
 };
 
 // NOTE only {stack, kinds of PersistentHolders} are root set. if you store the data you need on other space, you may lost your data
@@ -150,6 +168,10 @@ public:
 
     const PersistentRefHolder<T>& operator=(PersistentRefHolder<T>&& src)
     {
+        if (this == &src) {
+            return *this;
+        }
+        destoryHolderSpace();
         m_holder = src.m_holder;
         src.m_holder = nullptr;
 
@@ -200,14 +222,14 @@ public:
 private:
     void initHolderSpace(T* initialValue)
     {
-        m_holder = (T**)Memory::gcMallocUncollectable(sizeof(T**));
+        m_holder = (T**)Memory::allocatePersistentHandle();
         *m_holder = initialValue;
     }
 
     void destoryHolderSpace()
     {
         if (m_holder) {
-            Memory::gcFree(m_holder);
+            Memory::freePersistentHandle((void**)m_holder);
         }
         m_holder = nullptr;
     }
@@ -215,6 +237,62 @@ private:
     T** m_holder;
 };
 
+// HandleScope roots pointers returned by API until the scope is destroyed
+// use this when you keep ValueRef or ObjectRef on space which is not scanned by gc(eg. malloc-ed memory) for a short time
+// handles are pushed on arena of current thread and popped at once when the scope is destroyed.
+// ex) HandleScope scope;
+//     std::vector<ValueRef*> values;
+//     values.push_back(scope.add(ObjectRef::create(state)));
+class ESCARGOT_EXPORT HandleScope {
+public:
+    HandleScope();
+    ~HandleScope();
+
+    HandleScope(const HandleScope&) = delete;
+    const HandleScope& operator=(const HandleScope&) = delete;
+
+    template <typename T>
+    T* add(T* ptr)
+    {
+        *allocateHandle() = ptr;
+        return ptr;
+    }
+
+    // returns how many handles are pushed on arena of current thread by every alive scope
+    static size_t handleCount();
+
+protected:
+    static void** allocateHandle();
+
+    size_t m_savedTop;
+};
+
+// HandleScope which can hand one pointer over to the enclosing scope
+// slot for the pointer is reserved on the enclosing scope when this scope is created
+// ex) ObjectRef* createPoint(ExecutionStateRef* state) {
+//         EscapableHandleScope scope;
+//         ObjectRef* point = scope.add(ObjectRef::create(state));
+//         ...
+//         return scope.escape(point);
+//     }
+class ESCARGOT_EXPORT EscapableHandleScope : public HandleScope {
+public:
+    EscapableHandleScope();
+
+    // can be called once for a scope
+    template <typename T>
+    T* escape(T* ptr)
+    {
+        *escapeSlot() = ptr;
+        return ptr;
+    }
+
+private:
+    void** escapeSlot();
+
+    void** m_escapeSlot;
+};
+
 class PersistentValueRefMap {
 public:
     static PersistentRefHolder<PersistentValueRefMap> create();
@@ -549,6 +627,38 @@ public:
 
     bool hasPendingPromiseJob();
     Evaluator::EvaluatorResult executePendingPromiseJob();
+
+    // these functions have effect only if you enabled source compression
+    // if uncompressed buffers of CompressibleStrings exceed the budget, strings are compressed more aggressively
+    void setCompressibleStringMemoryBudget(size_t budgetInBytes);
+    size_t compressibleStringMemoryBudget();
+    // compress idle CompressibleStrings now
+    // you can call this when the vm is idle(e.g. between event loop tasks) to take compression off the critical path
+    void compressIdleCompressibleStrings();
+
+    // sampling profiler for interpreter (POSIX only)
+    // samples are taken by SIGPROF timer on the thread which called startCPUProfiler
+    // you should not use SIGPROF for other purposes while profiling, and only one vm can be profiled at a time
+    bool startCPUProfiler(size_t samplingIntervalInMicroseconds = 1000);
+    void stopCPUProfiler();
+    // returns collapsed stacks("outermost;...;innermost count" per line) which flamegraph tools accept
+    std::string dumpCPUProfile();
+
+    // allocation-site sampling profiler
+    // allocation on the thread which called startAllocationProfiler is sampled whenever given amount of bytes are allocated
+    // only one vm can be profiled at a time
+    bool startAllocationProfiler(size_t samplingIntervalInBytes = 32 * 1024);
+    void stopAllocationProfiler();
+    // returns "outermost;...;innermost allocated-bytes allocation-count surviving-bytes" per line sorted by allocated bytes
+    // bytes and counts are estimated from samples. surviving bytes are updated after each gc
+    std::string dumpAllocationProfile();
+
+    // census of reachable heap objects. these functions run full gc before inspecting heap
+    // returns "type count bytes" per line sorted by bytes
+    std::string dumpHeapCensus();
+    // writes every reachable object and references between objects into file
+    // each line is "object <address> <type> <bytes>" or "edge <from address> <to address>"
+    bool writeHeapSnapshot(const char* filePath);
 };
 
 class ESCARGOT_EXPORT ContextRef {
@@ -774,6 +884,12 @@ public:
     static StringRef* createExternalFromLatin1(const unsigned char* s, size_t len);
     static StringRef* createExternalFromUTF16(const char16_t* s, size_t len);
 
+    // releaser is called with buffer of string when string is collected by gc
+    // so you can tie lifetime of external buffer(eg. mmap-ed file) to the string
+    typedef void (*ExternalStringBufferReleaser)(const void* buffer, size_t length);
+    static StringRef* createExternalFromASCII(const char* s, size_t len, ExternalStringBufferReleaser releaser);
+    static StringRef* createExternalFromLatin1(const unsigned char* s, size_t len, ExternalStringBufferReleaser releaser);
+
     // you can use these functions only if you enabled source compression
     // you don't need to use CompressibleString when string is small(~128KB)
     static bool isCompressibleStringEnabled();
@@ -992,6 +1108,14 @@ public:
     void* extraData();
     void setExtraData(void* e);
 
+    // internal fields are available on objects created by ObjectTemplateRef
+    // internal field can hold gc-allocated pointer
+    // other objects have no internal field. internalField returns nullptr and setInternalField returns false
+    // for them or for index out of range
+    size_t internalFieldCount();
+    void* internalField(size_t idx);
+    bool setInternalField(size_t idx, void* value);
+
     void removeFromHiddenClassChain();
 
     // DEPRECATED! this function will be removed
@@ -1097,6 +1221,45 @@ public:
     void markFunctionNeedsSlowVirtualIdentifierOperation();
 };
 
+// ObjectTemplateRef precomputes properties, native accessors and internal fields of objects
+// every object created by template shares same hidden class, so accessing them can be cached by inline cache
+// NOTE template is gc-allocated. you should keep template with PersistentRefHolder
+// template can be instantiated in every Context of one VMInstance
+// hidden class is cached by each Context, so template doesn't keep Contexts alive
+// NOTE values given to set are shared by instances of every Context.
+// object value created in one Context is reachable from other Contexts through instances. use primitive values
+// or set object values on each instance after instantiation if Contexts should be isolated
+class ESCARGOT_EXPORT ObjectTemplateRef {
+public:
+    static ObjectTemplateRef* create(size_t internalFieldCount = 0);
+
+    // propertyName should be string or symbol
+    // property of template value is shared by every instance
+    void set(ValueRef* propertyName, ValueRef* value, bool isWritable, bool isEnumerable, bool isConfigurable);
+    // data is not copied. data should be alive while template and instances are alive
+    void setNativeDataAccessorProperty(ValueRef* propertyName, ObjectRef::NativeDataAccessorPropertyData* data);
+
+    size_t internalFieldCount();
+
+    ObjectRef* instantiate(ExecutionStateRef* state);
+};
+
+// FunctionTemplateRef creates native function which constructs objects by instanceTemplate
+// prototype property of the function is created by prototypeTemplate
+// in constructor call, thisValue is new object created by instanceTemplate
+// the object is result of construction if function returns non-object value
+class ESCARGOT_EXPORT FunctionTemplateRef {
+public:
+    static FunctionTemplateRef* create(AtomicStringRef* name, size_t argumentCount, bool isStrict, bool isConstructor, FunctionObjectRef::NativeFunctionPointer fn);
+
+    ObjectTemplateRef* prototypeTemplate();
+    ObjectTemplateRef* instanceTemplate();
+
+    // returns same function object for same context
+    // function is cached by each Context, so template doesn't keep Contexts alive
+    FunctionObjectRef* instantiate(ExecutionStateRef* state);
+};
+
 class ESCARGOT_EXPORT IteratorObjectRef : public ObjectRef {
 public:
     static IteratorObjectRef* create(ExecutionStateRef* state);
@@ -1378,6 +1541,43 @@ public:
     StringRef* moduleRequest(size_t i);
 };
 
+// Binary structured clone of values
+// Unlike JSON, it keeps types of Map, Set, Date, RegExp, ArrayBuffer and TypedArray,
+// and shared or cyclic references. Output can be deserialized on another Context or VMInstance,
+// or stored and deserialized later. data written with other format version is rejected
+class ESCARGOT_EXPORT ValueSerializerRef {
+public:
+    // throws TypeError if value contains function, symbol, proxy or other object which can't be cloned
+    static std::vector<uint8_t> serialize(ExecutionStateRef* state, ValueRef* value);
+};
+
+class ESCARGOT_EXPORT ValueDeserializerRef {
+public:
+    // throws TypeError if data is malformed
+    static ValueRef* deserialize(ExecutionStateRef* state, const uint8_t* data, size_t length);
+};
+
+// Entangled pair of MessagePortRef connects two VMInstances which can live on different threads
+// Messages are structured clones of values. ArrayBuffers in transfer list are moved to receiver without copy.
+// MessagePortRef is not managed by GC. user should call destroy when it is not needed
+class ESCARGOT_EXPORT MessagePortRef {
+public:
+    static void createChannel(MessagePortRef*& port1, MessagePortRef*& port2);
+    // closes channel. entangled port is still alive until its destroy is called
+    void destroy();
+
+    // can be called on any thread with state of any VMInstance
+    // throws TypeError if message can't be cloned
+    void postMessage(ExecutionStateRef* state, ValueRef* message, ValueVectorRef* transferList = nullptr);
+
+    // receiving functions should be called only on one thread
+    bool hasMessage();
+    OptionalRef<ValueRef> receiveMessage(ExecutionStateRef* state);
+    // returns true if message arrived before timeout
+    bool waitForMessage(uint64_t timeoutInMilliseconds = std::numeric_limits<uint64_t>::max());
+    bool isClosed();
+};
+
 class ESCARGOT_EXPORT PlatformRef {
 public:
     virtual ~PlatformRef() {}
@@ -1399,6 +1599,7 @@ public:
     // Module
     // client needs cache module map<absolute_module_path, ScriptRef*>
     struct LoadModuleResult {
+        LoadModuleResult();
         LoadModuleResult(ScriptRef* result);
         LoadModuleResult(ErrorObjectRef::Code errorCode, StringRef* errorMessage);
 
@@ -1407,6 +1608,24 @@ public:
         ErrorObjectRef::Code errorCode;
     };
     virtual LoadModuleResult onLoadModule(ContextRef* relatedContext, ScriptRef* whereRequestFrom, StringRef* moduleSrc) = 0;
+    // engine collects module graph breadth-first and requests every new module of one level at once
+    // client can read sources of requests concurrently. results should be in same order with requests
+    // default implementation calls onLoadModule for each request
+    // values of requests are kept alive by engine while this function runs.
+    // results are in GCManagedVector because scripts and error messages of earlier results should survive gc
+    // which can occur while client parses later ones
+    struct ModuleRequest {
+        ScriptRef* whereRequestFrom;
+        StringRef* moduleSrc;
+    };
+    virtual GCManagedVector<LoadModuleResult> onLoadModules(ContextRef* relatedContext, const std::vector<ModuleRequest>& requests)
+    {
+        GCManagedVector<LoadModuleResult> results(requests.size());
+        for (size_t i = 0; i < requests.size(); i++) {
+            results[i] = onLoadModule(relatedContext, requests[i].whereRequestFrom, requests[i].moduleSrc);
+        }
+        return results;
+    }
     virtual void didLoadModule(ContextRef* relatedContext, OptionalRef<ScriptRef> whereRequestFrom, ScriptRef* loadedModule) = 0;
 };
 
@@ -26,6 +26,7 @@
 #include "runtime/ArrayBufferObject.h"
 #include "parser/CodeBlock.h"
 #include "interpreter/ByteCode.h"
+#include "runtime/AllocationProfiler.h"
 
 namespace Escargot {
 
@@ -213,6 +214,16 @@ void iterateSpecificKindOfObject(ExecutionState& state, HeapObjectKind kind, Hea
     GC_enable();
 }
 
+HeapObjectKind heapObjectKindFromGCKind(int gcKind)
+{
+    for (unsigned i = 0; i < HeapObjectKind::NumberOfKind; i++) {
+        if (s_gcKinds[i] == gcKind) {
+            return (HeapObjectKind)i;
+        }
+    }
+    return HeapObjectKind::NumberOfKind;
+}
+
 template <>
 Value* CustomAllocator<Value>::allocate(size_type GC_n, const void*)
 {
@@ -223,6 +234,7 @@ Value* CustomAllocator<Value>::allocate(size_type GC_n, const void*)
 
     Value* ret;
     ret = (Value*)GC_GENERIC_MALLOC(size, kind);
+    AllocationProfiler::recordAllocation(ret);
     return ret;
 }
 
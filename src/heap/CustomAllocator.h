@@ -68,6 +68,9 @@ typedef std::function<void(ExecutionState& state, void* obj)> HeapObjectIterator
  */
 void iterateSpecificKindOfObject(ExecutionState& state, HeapObjectKind kind, HeapObjectIteratorCallback callback);
 
+// returns NumberOfKind if gcKind is not one of custom kinds
+HeapObjectKind heapObjectKindFromGCKind(int gcKind);
+
 template <class GC_Tp>
 class CustomAllocator {
 public:
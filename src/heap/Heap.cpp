@@ -26,21 +26,57 @@
 
 namespace Escargot {
 
-static bool g_isInited = false;
+static std::once_flag g_initializeOnce;
 
-void Heap::initialize()
+// types are registered from any thread which creates the first instance of them
+static std::mutex g_typeNamesLock;
+static std::unordered_map<size_t, const char*> g_typeNames;
+
+void Heap::registerTypeName(size_t tag, const char* typeName)
 {
-    if (g_isInited)
-        return;
+    std::lock_guard<std::mutex> guard(g_typeNamesLock);
+    g_typeNames.insert(std::make_pair(tag, typeName));
+}
 
-    RELEASE_ASSERT(GC_get_all_interior_pointers() == 0);
+std::unordered_map<size_t, const char*> Heap::registeredTypeNames()
+{
+    std::lock_guard<std::mutex> guard(g_typeNamesLock);
+    return g_typeNames;
+}
+
+void Heap::initialize()
+{
+    std::call_once(g_initializeOnce, []() {
+#if defined(ENABLE_THREADING)
+        GC_INIT();
+        GC_allow_register_threads();
+#endif
+        RELEASE_ASSERT(GC_get_all_interior_pointers() == 0);
 
-    GC_set_force_unmap_on_gcollect(1);
-    g_isInited = true;
-    initializeCustomAllocators();
+        GC_set_force_unmap_on_gcollect(1);
+        initializeCustomAllocators();
 
 #ifdef PROFILE_BDWGC
-    GCUtil::HeapUsageVisualizer::initialize();
+        GCUtil::HeapUsageVisualizer::initialize();
+#endif
+    });
+}
+
+void Heap::initializeThread()
+{
+#if defined(ENABLE_THREADING)
+    struct GC_stack_base stackBase;
+    RELEASE_ASSERT(GC_get_stack_base(&stackBase) == GC_SUCCESS);
+    // thread called GC_INIT is already registered
+    int result = GC_register_my_thread(&stackBase);
+    RELEASE_ASSERT(result == GC_SUCCESS || result == GC_DUPLICATE);
+#endif
+}
+
+void Heap::finalizeThread()
+{
+#if defined(ENABLE_THREADING)
+    GC_unregister_my_thread();
 #endif
 }
 
@@ -27,7 +27,15 @@ class Heap {
 public:
     static void initialize();
     static void finalize();
+    // registers threads other than one called initialize to gc
+    static void initializeThread();
+    static void finalizeThread();
     static void printGCHeapUsage();
+
+    // registry of vtable tags of gc types. heap census uses this for naming objects
+    // see HeapCensus::registerTypeNames
+    static void registerTypeName(size_t tag, const char* typeName);
+    static std::unordered_map<size_t, const char*> registeredTypeNames();
 };
 }
 
@@ -0,0 +1,378 @@
+/*
+ * Copyright (c) 2020-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#include "Escargot.h"
+#include "HeapCensus.h"
+#include "CustomAllocator.h"
+#include "runtime/VMInstance.h"
+#include "runtime/ArrayObject.h"
+#include "runtime/ScriptFunctionObject.h"
+#include "runtime/NativeFunctionObject.h"
+#include "runtime/BoundFunctionObject.h"
+#include "runtime/RopeString.h"
+#include "runtime/CompressibleString.h"
+#include "runtime/EnvironmentRecord.h"
+#include "runtime/ArgumentsObject.h"
+#include "runtime/ArrayBufferObject.h"
+#include "runtime/BooleanObject.h"
+#include "runtime/DateObject.h"
+#include "runtime/ErrorObject.h"
+#include "runtime/GeneratorObject.h"
+#include "runtime/MapObject.h"
+#include "runtime/NumberObject.h"
+#include "runtime/PromiseObject.h"
+#include "runtime/ProxyObject.h"
+#include "runtime/RegExpObject.h"
+#include "runtime/SetObject.h"
+#include "runtime/StringObject.h"
+#include "runtime/SymbolObject.h"
+#include "runtime/WeakMapObject.h"
+#include "runtime/WeakSetObject.h"
+#include "interpreter/ByteCode.h"
+
+namespace Escargot {
+
+extern size_t g_doubleInSmallValueTag;
+extern size_t g_objectRareDataTag;
+extern size_t g_symbolTag;
+
+struct HeapCensusObject {
+    void* m_pointer;
+    size_t m_bytes;
+    int m_kind;
+};
+
+static void registerTypeName(void* temporaryObject, const char* typeName)
+{
+    Heap::registerTypeName(*((size_t*)temporaryObject), typeName);
+}
+
+void HeapCensus::registerTypeNames(ExecutionState& state)
+{
+    Context* context = state.context();
+
+    registerTypeName(String::emptyString, "ASCIIString");
+    registerTypeName(new Latin1String("", 0), "Latin1String");
+    registerTypeName(new UTF16String(u"", 0), "UTF16String");
+    registerTypeName(new RopeString(), "RopeString");
+#if defined(ENABLE_COMPRESSIBLE_STRING)
+    registerTypeName(new CompressibleString(context), "CompressibleString");
+#endif
+
+    registerTypeName(new ObjectStructureWithoutTransition(new ObjectStructureItemVector(), false, false), "ObjectStructureWithoutTransition");
+    registerTypeName(new ObjectStructureWithTransition(ObjectStructureItemTightVector(), false, false), "ObjectStructureWithTransition");
+    registerTypeName(new ObjectStructureWithMap(false, ObjectStructureItemTightVector()), "ObjectStructureWithMap");
+
+    registerTypeName(new ArrayBufferObject(state), "ArrayBufferObject");
+    registerTypeName(new ArrayIteratorObject(state, new ArrayObject(state), ArrayIteratorObject::TypeValue), "ArrayIteratorObject");
+    registerTypeName(new BooleanObject(state, false), "BooleanObject");
+    registerTypeName(new DateObject(state), "DateObject");
+    registerTypeName(new ErrorObject(state, String::emptyString), "ErrorObject");
+    registerTypeName(new ReferenceErrorObject(state, String::emptyString), "ReferenceErrorObject");
+    registerTypeName(new TypeErrorObject(state, String::emptyString), "TypeErrorObject");
+    registerTypeName(new SyntaxErrorObject(state, String::emptyString), "SyntaxErrorObject");
+    registerTypeName(new RangeErrorObject(state, String::emptyString), "RangeErrorObject");
+    registerTypeName(new URIErrorObject(state, String::emptyString), "URIErrorObject");
+    registerTypeName(new EvalErrorObject(state, String::emptyString), "EvalErrorObject");
+    registerTypeName(new GeneratorObject(state), "GeneratorObject");
+    registerTypeName(new MapObject(state), "MapObject");
+    registerTypeName(new NumberObject(state, 0), "NumberObject");
+    registerTypeName(new PromiseObject(state), "PromiseObject");
+    registerTypeName(new ProxyObject(state), "ProxyObject");
+    registerTypeName(new RegExpObject(state, true), "RegExpObject");
+    registerTypeName(new SetObject(state), "SetObject");
+    registerTypeName(new StringObject(state, String::emptyString), "StringObject");
+    registerTypeName(new SymbolObject(state, new Symbol()), "SymbolObject");
+    registerTypeName(new WeakMapObject(state), "WeakMapObject");
+    registerTypeName(new WeakSetObject(state), "WeakSetObject");
+
+    registerTypeName(new ObjectEnvironmentRecord(new Object(state)), "ObjectEnvironmentRecord");
+    registerTypeName(new DeclarativeEnvironmentRecordNotIndexed(state), "DeclarativeEnvironmentRecordNotIndexed");
+}
+
+// records of functions and blocks need code block of script function, and there is no one when first Context is created.
+// so these types are registered by first census which finds script function
+static void registerTypeNamesOfScriptFunction(const std::vector<HeapCensusObject>& objects)
+{
+    // census can run on threads of several VMInstances at once
+    static std::mutex registerLock;
+    static bool registered = false;
+    std::lock_guard<std::mutex> guard(registerLock);
+    if (registered || !g_scriptFunctionObjectTag) {
+        return;
+    }
+
+    ScriptFunctionObject* function = nullptr;
+    for (size_t i = 0; i < objects.size(); i++) {
+        if (objects[i].m_bytes >= sizeof(ScriptFunctionObject) && *((size_t*)objects[i].m_pointer) == g_scriptFunctionObjectTag) {
+            function = (ScriptFunctionObject*)objects[i].m_pointer;
+            if (function->codeBlock()->isInterpretedCodeBlock()) {
+                break;
+            }
+            function = nullptr;
+        }
+    }
+    if (!function) {
+        return;
+    }
+    registered = true;
+
+    InterpretedCodeBlock* codeBlock = function->codeBlock()->asInterpretedCodeBlock();
+    ExecutionState state(codeBlock->context());
+
+    // type names of template instances are same. census counts them together
+    auto record = new FunctionEnvironmentRecordOnHeap<false, false>(function);
+    registerTypeName(record, "FunctionEnvironmentRecordOnHeap");
+    registerTypeName(new FunctionEnvironmentRecordOnHeap<true, true>(function), "FunctionEnvironmentRecordOnHeap");
+    registerTypeName(new FunctionEnvironmentRecordOnHeap<false, true>(function), "FunctionEnvironmentRecordOnHeap");
+    registerTypeName(new FunctionEnvironmentRecordNotIndexed<false, false>(function), "FunctionEnvironmentRecordNotIndexed");
+    registerTypeName(new FunctionEnvironmentRecordNotIndexed<true, true>(function), "FunctionEnvironmentRecordNotIndexed");
+    registerTypeName(new FunctionEnvironmentRecordNotIndexed<false, true>(function), "FunctionEnvironmentRecordNotIndexed");
+    if (codeBlock->blockInfos().size()) {
+        registerTypeName(new DeclarativeEnvironmentRecordIndexed(state, codeBlock->blockInfos()[0]), "DeclarativeEnvironmentRecordIndexed");
+    }
+    registerTypeName(new ArgumentsObject(state, function, 0, nullptr, record, false), "ArgumentsObject");
+}
+
+// maps gc object to name of its type
+class HeapCensusTypeTable {
+public:
+    explicit HeapCensusTypeTable(VMInstance* vmInstance)
+    {
+        // tags are vtables of types. tags of types which are not created yet are zero
+        addVTable(g_objectTag, "Object");
+        addVTable(g_arrayObjectTag, "ArrayObject");
+        addVTable(g_scriptFunctionObjectTag, "ScriptFunctionObject");
+        addVTable(g_nativeFunctionObjectTag, "NativeFunctionObject");
+        addVTable(g_boundFunctionObjectTag, "BoundFunctionObject");
+        addVTable(g_symbolTag, "Symbol");
+        addVTable(g_objectRareDataTag, "ObjectRareData");
+        addVTable(g_doubleInSmallValueTag, "DoubleInSmallValue");
+
+        // other types are registered by HeapCensus::registerTypeNames and registerTypeNamesOfScriptFunction
+        auto registeredTypeNames = Heap::registeredTypeNames();
+        for (auto iter = registeredTypeNames.begin(); iter != registeredTypeNames.end(); iter++) {
+            addVTable(iter->first, iter->second);
+        }
+
+        auto& byteCodeBlocks = vmInstance->compiledByteCodeBlocks();
+        m_byteCodeBlocks.insert(byteCodeBlocks.begin(), byteCodeBlocks.end());
+    }
+
+    const char* typeName(const HeapCensusObject& object)
+    {
+        switch (heapObjectKindFromGCKind(object.m_kind)) {
+        case HeapObjectKind::ValueVectorKind:
+            return "ValueVector";
+        case HeapObjectKind::ArrayObjectKind:
+            return "ArrayObject";
+        case HeapObjectKind::CodeBlockKind:
+            return "CodeBlock";
+        case HeapObjectKind::InterpretedCodeBlockKind:
+            return "InterpretedCodeBlock";
+        case HeapObjectKind::ArrayBufferObjectKind:
+            return "ArrayBufferObject";
+        case HeapObjectKind::GetObjectInlineCacheDataKind:
+            return "GetObjectInlineCacheData";
+        default:
+            break;
+        }
+
+        if (object.m_kind == GC_I_PTRFREE) {
+            return "(pointer-free memory)";
+        }
+
+        if (object.m_bytes >= sizeof(size_t)) {
+            auto iter = m_vtables.find(*((size_t*)object.m_pointer));
+            if (iter != m_vtables.end()) {
+                return iter->second;
+            }
+        }
+
+        if (m_byteCodeBlocks.find((ByteCodeBlock*)object.m_pointer) != m_byteCodeBlocks.end()) {
+            return "ByteCodeBlock";
+        }
+
+        if (object.m_kind == GC_I_NORMAL) {
+            return "(untyped memory)";
+        }
+        return "(memory of other gc kind)";
+    }
+
+private:
+    void addVTable(size_t vtable, const char* name)
+    {
+        if (vtable) {
+            m_vtables.insert(std::make_pair(vtable, name));
+        }
+    }
+
+    std::unordered_map<size_t, const char*> m_vtables;
+    std::unordered_set<ByteCodeBlock*> m_byteCodeBlocks;
+};
+
+// UNCOLLECTABLE kind of bdwgc (see gc_priv.h). persistent handles and local handle blocks are allocated in this kind
+#define HEAP_CENSUS_UNCOLLECTABLE_KIND 2
+
+static void* enumerateMarkedObjects(void* cd)
+{
+    // GC_enumerate_reachable_objects_inner requires allocation lock
+    GC_enumerate_reachable_objects_inner([](void* obj, size_t bytes, void* cd) {
+        size_t size;
+        int kind = GC_get_kind_and_size(obj, &size);
+        std::vector<HeapCensusObject>* objects = (std::vector<HeapCensusObject>*)cd;
+        objects->push_back(HeapCensusObject({ GC_USR_PTR_FROM_BASE(obj), size, kind }));
+    },
+                                         cd);
+    return nullptr;
+}
+
+// Marked objects belong to every VMInstance of process.
+// so we keep objects which are reachable from roots of vmInstance only
+// roots are vmInstance itself, stack of current thread and uncollectable objects
+// uncollectable objects (persistent handles) of other VMInstances are roots too. so objects referenced by them are counted
+// GC should be disabled while caller uses result
+static std::vector<HeapCensusObject> collectReachableObjects(VMInstance* vmInstance)
+{
+    std::vector<HeapCensusObject> markedObjects;
+
+    ASSERT(!GC_is_disabled());
+    GC_gcollect(); // Update mark status. See comments of iterateSpecificKindOfObject in src/heap/CustomAllocator.h
+    GC_disable();
+    GC_call_with_alloc_lock(enumerateMarkedObjects, &markedObjects);
+
+    std::unordered_map<void*, size_t> indexOfAddress;
+    indexOfAddress.reserve(markedObjects.size());
+    for (size_t i = 0; i < markedObjects.size(); i++) {
+        indexOfAddress.insert(std::make_pair(markedObjects[i].m_pointer, i));
+    }
+
+    std::vector<bool> visited(markedObjects.size(), false);
+    std::vector<size_t> worklist;
+    // interior pointers are not recognized by gc. so we look for pointers to start of objects only
+    auto visitWords = [&](void** begin, void** end) {
+        for (void** word = begin; word < end; word++) {
+            auto iter = indexOfAddress.find(*word);
+            if (iter != indexOfAddress.end() && !visited[iter->second]) {
+                visited[iter->second] = true;
+                worklist.push_back(iter->second);
+            }
+        }
+    };
+
+    void* vmInstanceAddress = vmInstance;
+    visitWords(&vmInstanceAddress, &vmInstanceAddress + 1);
+
+    void* stackPointer = currentStackPointer();
+    void* stackStart = vmInstance->stackStartAddress();
+    if (stackPointer < stackStart) {
+        visitWords((void**)stackPointer, (void**)stackStart);
+    } else {
+        visitWords((void**)stackStart, (void**)stackPointer);
+    }
+
+    for (size_t i = 0; i < markedObjects.size(); i++) {
+        if (markedObjects[i].m_kind == HEAP_CENSUS_UNCOLLECTABLE_KIND && !visited[i]) {
+            visited[i] = true;
+            worklist.push_back(i);
+        }
+    }
+
+    while (worklist.size()) {
+        const HeapCensusObject& object = markedObjects[worklist.back()];
+        worklist.pop_back();
+        if (object.m_kind != GC_I_PTRFREE) {
+            void** words = (void**)object.m_pointer;
+            visitWords(words, words + object.m_bytes / sizeof(void*));
+        }
+    }
+
+    std::vector<HeapCensusObject> objects;
+    for (size_t i = 0; i < markedObjects.size(); i++) {
+        if (visited[i]) {
+            objects.push_back(markedObjects[i]);
+        }
+    }
+    return objects;
+}
+
+std::vector<HeapCensus::Item> HeapCensus::take(VMInstance* vmInstance)
+{
+    std::vector<HeapCensusObject> objects = collectReachableObjects(vmInstance);
+    registerTypeNamesOfScriptFunction(objects);
+    HeapCensusTypeTable typeTable(vmInstance);
+
+    std::unordered_map<const char*, size_t> itemIndex;
+    std::vector<Item> result;
+    for (size_t i = 0; i < objects.size(); i++) {
+        const char* name = typeTable.typeName(objects[i]);
+        auto iter = itemIndex.find(name);
+        if (iter == itemIndex.end()) {
+            iter = itemIndex.insert(std::make_pair(name, result.size())).first;
+            result.push_back(Item({ name, 0, 0 }));
+        }
+        result[iter->second].m_count++;
+        result[iter->second].m_bytes += objects[i].m_bytes;
+    }
+    GC_enable();
+
+    std::sort(result.begin(), result.end(), [](const Item& a, const Item& b) {
+        return a.m_bytes > b.m_bytes;
+    });
+    return result;
+}
+
+bool HeapCensus::writeSnapshot(VMInstance* vmInstance, const char* filePath)
+{
+    FILE* fp = fopen(filePath, "w");
+    if (!fp) {
+        return false;
+    }
+
+    std::vector<HeapCensusObject> objects = collectReachableObjects(vmInstance);
+    registerTypeNamesOfScriptFunction(objects);
+    HeapCensusTypeTable typeTable(vmInstance);
+
+    std::unordered_set<void*> addresses;
+    addresses.reserve(objects.size());
+    for (size_t i = 0; i < objects.size(); i++) {
+        addresses.insert(objects[i].m_pointer);
+        fprintf(fp, "object %p %s %zu\n", objects[i].m_pointer, typeTable.typeName(objects[i]), objects[i].m_bytes);
+    }
+
+    // interior pointers are not recognized by gc. so we look for pointers to start of objects only
+    for (size_t i = 0; i < objects.size(); i++) {
+        if (objects[i].m_kind == GC_I_PTRFREE) {
+            continue;
+        }
+        void** words = (void**)objects[i].m_pointer;
+        size_t wordCount = objects[i].m_bytes / sizeof(void*);
+        for (size_t j = 0; j < wordCount; j++) {
+            if (words[j] && words[j] != objects[i].m_pointer && addresses.find(words[j]) != addresses.end()) {
+                fprintf(fp, "edge %p %p\n", objects[i].m_pointer, words[j]);
+            }
+        }
+    }
+    GC_enable();
+
+    bool succeeded = !ferror(fp);
+    fclose(fp);
+    return succeeded;
+}
+}
@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2020-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#ifndef __EscargotHeapCensus__
+#define __EscargotHeapCensus__
+
+namespace Escargot {
+
+class VMInstance;
+class ExecutionState;
+
+// Census of gc objects reachable from roots of a VMInstance
+// Objects of custom gc kinds are classified by kind.
+// Other objects are classified by vtables registered with registerTypeNames,
+// and remaining objects are counted by gc kind. e.g. "(pointer-free memory)"
+// These functions call GC_gcollect() to get precise mark status. don't call them in performance-critical path.
+// These functions should be called on thread of vmInstance because its stack is one of roots
+class HeapCensus {
+public:
+    struct Item {
+        std::string m_typeName;
+        size_t m_count;
+        size_t m_bytes;
+    };
+
+    // items are sorted by bytes in descending order
+    static std::vector<Item> take(VMInstance* vmInstance);
+
+    // registers vtables of gc types by creating temporary object of each type
+    // this is called once when first Context is created, so constructors of types don't need to care about census
+    static void registerTypeNames(ExecutionState& state);
+
+    // writes every reachable object and references between objects into file
+    // each line is "object <address> <type> <bytes>" or "edge <from address> <to address>"
+    // references are found by scanning words of objects conservatively
+    static bool writeSnapshot(VMInstance* vmInstance, const char* filePath);
+};
+}
+
+#endif
@@ -77,11 +77,31 @@ void SetGlobalVariable::dump(const char* byteCodeStart)
 }
 #endif
 
+static void finalizeByteCodeBlock(void* obj)
+{
+    ByteCodeBlock* self = (ByteCodeBlock*)obj;
+    self->m_numeralLiteralData.clear();
+    self->m_code.clear();
+    if (self->m_locData) {
+        delete self->m_locData;
+        self->m_locData = nullptr;
+    }
+
+#if defined(ENABLE_THREADING)
+    // ~VMInstance can be running on other thread. it sets the flag and reads the list under this lock
+    std::lock_guard<std::mutex> guard(VMInstance::pendingFinalizersMutex());
+#endif
+    if (!self->m_isOwnerMayFreed) {
+        auto& v = self->m_codeBlock->context()->vmInstance()->compiledByteCodeBlocks();
+        v.erase(std::find(v.begin(), v.end(), self));
+    }
+}
+
 ByteCodeBlock::ByteCodeBlock(InterpretedCodeBlock* codeBlock)
     : m_isEvalMode(false)
     , m_isOnGlobal(false)
-    , m_isOwnerMayFreed(false)
     , m_requiredRegisterFileSizeInValueSize(2)
+    , m_isOwnerMayFreed(false)
     , m_inlineCacheDataSize(0)
     , m_locData(nullptr)
     , m_codeBlock(codeBlock)
@@ -89,26 +109,21 @@ ByteCodeBlock::ByteCodeBlock(InterpretedCodeBlock* codeBlock)
     auto& v = m_codeBlock->context()->vmInstance()->compiledByteCodeBlocks();
     v.push_back(this);
     GC_REGISTER_FINALIZER_NO_ORDER(this, [](void* obj, void*) {
+#if defined(ENABLE_THREADING)
         ByteCodeBlock* self = (ByteCodeBlock*)obj;
-        self->m_numeralLiteralData.clear();
-        self->m_code.clear();
-        if (self->m_locData) {
-            delete self->m_locData;
-            self->m_locData = nullptr;
-        }
-
-        if (!self->m_isOwnerMayFreed) {
-            auto& v = self->m_codeBlock->context()->vmInstance()->compiledByteCodeBlocks();
-            v.erase(std::find(v.begin(), v.end(), self));
+        if (!self->m_isOwnerMayFreed && self->m_codeBlock->context()->vmInstance()->deferFinalizerToOwnerThread(obj, finalizeByteCodeBlock)) {
+            return;
         }
+#endif
+        finalizeByteCodeBlock(obj);
     },
                                    nullptr, nullptr, nullptr);
 }
 
 void* ByteCodeBlock::operator new(size_t size)
 {
-    static bool typeInited = false;
-    static GC_descr descr;
+    static std::atomic<bool> typeInited(false);
+    static std::atomic<GC_descr> descr;
     if (!typeInited) {
         GC_word obj_bitmap[GC_BITMAP_SIZE(ByteCodeBlock)] = { 0 };
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(ByteCodeBlock, m_literalData));
@@ -286,8 +301,8 @@ void ByteCodeBlock::pushPauseStatementExtraData(ByteCodeGenerateContext* context
 
 void* GetObjectInlineCache::operator new(size_t size)
 {
-    static bool typeInited = false;
-    static GC_descr descr;
+    static std::atomic<bool> typeInited(false);
+    static std::atomic<GC_descr> descr;
     if (!typeInited) {
         GC_word obj_bitmap[GC_BITMAP_SIZE(GetObjectInlineCache)] = { 0 };
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(GetObjectInlineCache, m_cache));
@@ -299,8 +314,8 @@ void* GetObjectInlineCache::operator new(size_t size)
 
 void* SetObjectInlineCache::operator new(size_t size)
 {
-    static bool typeInited = false;
-    static GC_descr descr;
+    static std::atomic<bool> typeInited(false);
+    static std::atomic<GC_descr> descr;
     if (!typeInited) {
         GC_word obj_bitmap[GC_BITMAP_SIZE(SetObjectInlineCache)] = { 0 };
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(SetObjectInlineCache, m_cachedHiddenClassChainData));
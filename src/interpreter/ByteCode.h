@@ -33,6 +33,27 @@ class ObjectStructure;
 class Node;
 struct GlobalVariableAccessCacheItem;
 
+// superinstructions. see ByteCodePeepholeOptimizer
+// <OpcodeName, PushCount, PopCount>
+#define FOR_EACH_SUPERINSTRUCTION_OP(F)                           \
+    F(MoveThenMove, 1, 0)                                         \
+    F(MoveThenJump, 1, 0)                                         \
+    F(LoadLiteralThenBinaryPlus, 1, 0)                            \
+    F(LoadLiteralThenJumpIfEqual, 1, 0)                           \
+    F(IncrementThenJump, 1, 1)                                    \
+    F(GetObjectPreComputedCaseThenGetObjectPreComputedCase, 1, 1) \
+    F(GetObjectPreComputedCaseThenCallFunctionWithReceiver, 1, 1)
+
+// <OpcodeName, FirstOpcodeName, SecondOpcodeName>
+#define FOR_EACH_SUPERINSTRUCTION(F)                                                                            \
+    F(MoveThenMove, Move, Move)                                                                                 \
+    F(MoveThenJump, Move, Jump)                                                                                 \
+    F(LoadLiteralThenBinaryPlus, LoadLiteral, BinaryPlus)                                                       \
+    F(LoadLiteralThenJumpIfEqual, LoadLiteral, JumpIfEqual)                                                     \
+    F(IncrementThenJump, Increment, Jump)                                                                       \
+    F(GetObjectPreComputedCaseThenGetObjectPreComputedCase, GetObjectPreComputedCase, GetObjectPreComputedCase) \
+    F(GetObjectPreComputedCaseThenCallFunctionWithReceiver, GetObjectPreComputedCase, CallFunctionWithReceiver)
+
 // <OpcodeName, PushCount, PopCount>
 #define FOR_EACH_BYTECODE_OP(F)                             \
     F(LoadLiteral, 1, 0)                                    \
@@ -108,6 +129,7 @@ struct GlobalVariableAccessCacheItem;
     F(JumpIfEqual, 0, 0)                                    \
     F(CallFunction, -1, 0)                                  \
     F(CallFunctionWithReceiver, -1, 0)                      \
+    F(CallFunctionForwardingArguments, -1, 0)               \
     F(CallFunctionWithSpreadElement, -1, 0)                 \
     F(GetParameter, 0, 0)                                   \
     F(ReturnFunctionSlowCase, 0, 0)                         \
@@ -134,8 +156,11 @@ struct GlobalVariableAccessCacheItem;
     F(BlockOperation, 0, 0)                                 \
     F(ReplaceBlockLexicalEnvironmentOperation, 0, 0)        \
     F(EnsureArgumentsObject, 0, 0)                          \
+    F(GetArgumentsLength, 1, 0)                             \
+    F(GetArgument, 1, 1)                                    \
     F(ResolveNameAddress, 1, 0)                             \
     F(StoreByNameWithAddress, 0, 1)                         \
+    FOR_EACH_SUPERINSTRUCTION_OP(F)                         \
     F(End, 0, 0)
 
 
@@ -1558,6 +1583,29 @@ public:
 #endif
 };
 
+// call-site cache of CallFunction and CallFunctionWithReceiver
+// it remembers kind and CodeBlock of last callee, so closures of same function hit same cache.
+// CodeBlock is kept alive by pushing it into literal data of ByteCodeBlock
+struct CallFunctionInlineCache {
+    enum CalleeKind : uint8_t {
+        None,
+        // ScriptFunctionObject which can be called without native recursion
+        ScriptFunction,
+        NativeFunction,
+    };
+
+    CallFunctionInlineCache()
+        : m_codeBlock(nullptr)
+        , m_kind(None)
+        , m_cacheMissCount(0)
+    {
+    }
+
+    CodeBlock* m_codeBlock;
+    CalleeKind m_kind;
+    uint8_t m_cacheMissCount;
+};
+
 class CallFunction : public ByteCode {
 public:
     CallFunction(const ByteCodeLOC& loc, const size_t calleeIndex, const size_t argumentsStartIndex, const size_t resultIndex, const size_t argumentCount)
@@ -1572,6 +1620,7 @@ public:
     ByteCodeRegisterIndex m_argumentsStartIndex;
     ByteCodeRegisterIndex m_resultIndex;
     uint16_t m_argumentCount;
+    CallFunctionInlineCache m_inlineCache;
 
 #ifndef NDEBUG
     void dump(const char* byteCodeStart)
@@ -1598,6 +1647,7 @@ public:
     ByteCodeRegisterIndex m_argumentsStartIndex;
     ByteCodeRegisterIndex m_resultIndex;
     uint16_t m_argumentCount;
+    CallFunctionInlineCache m_inlineCache;
 
 #ifndef NDEBUG
     void dump(const char* byteCodeStart)
@@ -1607,6 +1657,36 @@ public:
 #endif
 };
 
+// receiver.apply(thisArgument, arguments)
+// if arguments object is not created yet and callee is Function.prototype.apply,
+// receiver is called with argv of current function directly
+class CallFunctionForwardingArguments : public ByteCode {
+public:
+    CallFunctionForwardingArguments(const ByteCodeLOC& loc, const size_t receiverIndex, const size_t calleeIndex, const size_t thisArgumentIndex, const size_t argumentsObjectIndex, const size_t resultIndex)
+        : ByteCode(Opcode::CallFunctionForwardingArgumentsOpcode, loc)
+        , m_receiverIndex(receiverIndex)
+        , m_calleeIndex(calleeIndex)
+        , m_thisArgumentIndex(thisArgumentIndex)
+        , m_argumentsObjectIndex(argumentsObjectIndex)
+        , m_resultIndex(resultIndex)
+    {
+    }
+
+    ByteCodeRegisterIndex m_receiverIndex;
+    ByteCodeRegisterIndex m_calleeIndex;
+    ByteCodeRegisterIndex m_thisArgumentIndex;
+    ByteCodeRegisterIndex m_argumentsObjectIndex;
+    ByteCodeRegisterIndex m_resultIndex;
+    CallFunctionInlineCache m_inlineCache;
+
+#ifndef NDEBUG
+    void dump(const char* byteCodeStart)
+    {
+        printf("call forwarding arguments r%d <- r%d,r%d(r%d, r%d)", (int)m_resultIndex, (int)m_receiverIndex, (int)m_calleeIndex, (int)m_thisArgumentIndex, (int)m_argumentsObjectIndex);
+    }
+#endif
+};
+
 class CallFunctionWithSpreadElement : public ByteCode {
 public:
     CallFunctionWithSpreadElement(const ByteCodeLOC& loc, const size_t receiverIndex, const size_t calleeIndex, const size_t argumentsStartIndex, const size_t resultIndex, const size_t argumentCount)
@@ -1944,7 +2024,9 @@ public:
         : ByteCode(Opcode::CreateEnumerateObjectOpcode, loc)
         , m_objectRegisterIndex(REGISTER_LIMIT)
         , m_dataRegisterIndex(REGISTER_LIMIT)
+        , m_spreadTargetRegisterIndex(REGISTER_LIMIT)
         , m_isDestruction(false)
+        , m_spreadExitPosition(SIZE_MAX)
     {
     }
 
@@ -1952,13 +2034,19 @@ public:
         : ByteCode(Opcode::CreateEnumerateObjectOpcode, loc)
         , m_objectRegisterIndex(objIndex)
         , m_dataRegisterIndex(dataIndex)
+        , m_spreadTargetRegisterIndex(REGISTER_LIMIT)
         , m_isDestruction(isDestruction)
+        , m_spreadExitPosition(SIZE_MAX)
     {
     }
 
     ByteCodeRegisterIndex m_objectRegisterIndex;
     ByteCodeRegisterIndex m_dataRegisterIndex;
+    // empty object literal which spread element of object is copied to
+    // if every property is copied by ObjectStructure, enumeration loop is skipped by jumping to m_spreadExitPosition
+    ByteCodeRegisterIndex m_spreadTargetRegisterIndex;
     bool m_isDestruction : 1;
+    size_t m_spreadExitPosition;
 
 #ifndef NDEBUG
     void dump(const char* byteCodeStart)
@@ -2243,6 +2331,52 @@ public:
 #endif
 };
 
+// arguments.length
+// reads argc of current function while arguments object is not created
+class GetArgumentsLength : public ByteCode {
+public:
+    GetArgumentsLength(const ByteCodeLOC& loc, const size_t argumentsObjectIndex, const size_t storeRegisterIndex)
+        : ByteCode(Opcode::GetArgumentsLengthOpcode, loc)
+        , m_argumentsObjectIndex(argumentsObjectIndex)
+        , m_storeRegisterIndex(storeRegisterIndex)
+    {
+    }
+
+    ByteCodeRegisterIndex m_argumentsObjectIndex;
+    ByteCodeRegisterIndex m_storeRegisterIndex;
+
+#ifndef NDEBUG
+    void dump(const char* byteCodeStart)
+    {
+        printf("get arguments length r%d <- r%d", (int)m_storeRegisterIndex, (int)m_argumentsObjectIndex);
+    }
+#endif
+};
+
+// arguments[property]
+// reads argv of current function while arguments object is not created
+class GetArgument : public ByteCode {
+public:
+    GetArgument(const ByteCodeLOC& loc, const size_t argumentsObjectIndex, const size_t propertyRegisterIndex, const size_t storeRegisterIndex)
+        : ByteCode(Opcode::GetArgumentOpcode, loc)
+        , m_argumentsObjectIndex(argumentsObjectIndex)
+        , m_propertyRegisterIndex(propertyRegisterIndex)
+        , m_storeRegisterIndex(storeRegisterIndex)
+    {
+    }
+
+    ByteCodeRegisterIndex m_argumentsObjectIndex;
+    ByteCodeRegisterIndex m_propertyRegisterIndex;
+    ByteCodeRegisterIndex m_storeRegisterIndex;
+
+#ifndef NDEBUG
+    void dump(const char* byteCodeStart)
+    {
+        printf("get argument r%d <- r%d[r%d]", (int)m_storeRegisterIndex, (int)m_argumentsObjectIndex, (int)m_propertyRegisterIndex);
+    }
+#endif
+};
+
 class ResolveNameAddress : public ByteCode {
 public:
     ResolveNameAddress(const ByteCodeLOC& loc, AtomicString name, ByteCodeRegisterIndex registerIndex)
@@ -2302,6 +2436,15 @@ public:
 };
 
 
+// Superinstruction is first instruction of pair whose opcode is replaced by ByteCodePeepholeOptimizer.
+// Interpreter runs first instruction and jumps to handler of second instruction directly without dispatch.
+// Second instruction remains in code stream, so jumps into the pair are still valid.
+#define DECLARE_SUPERINSTRUCTION(name, first, second) \
+    class name : public first {                       \
+    };
+FOR_EACH_SUPERINSTRUCTION(DECLARE_SUPERINSTRUCTION)
+#undef DECLARE_SUPERINSTRUCTION
+
 typedef Vector<char, std::allocator<char>, ComputeReservedCapacityFunctionWithLog2<200>> ByteCodeBlockData;
 typedef std::vector<std::pair<size_t, size_t>, std::allocator<std::pair<size_t, size_t>>> ByteCodeLOCData;
 typedef Vector<void*, GCUtil::gc_malloc_allocator<void*>> ByteCodeLiteralData;
@@ -2417,8 +2560,9 @@ public:
     bool m_isEvalMode : 1;
     bool m_isOnGlobal : 1;
     bool m_shouldClearStack : 1;
-    bool m_isOwnerMayFreed : 1;
     ByteCodeRegisterIndex m_requiredRegisterFileSizeInValueSize : REGISTER_INDEX_IN_BIT;
+    // set by ~VMInstance, which can run on other thread than the finalizer of this
+    std::atomic<bool> m_isOwnerMayFreed;
 
     ByteCodeBlockData m_code;
     ByteCodeNumeralLiteralData m_numeralLiteralData;
@@ -20,6 +20,7 @@
 #include "Escargot.h"
 #include "ByteCodeGenerator.h"
 #include "interpreter/ByteCode.h"
+#include "interpreter/ByteCodePeepholeOptimizer.h"
 #include "parser/ast/AST.h"
 
 namespace Escargot {
@@ -160,6 +161,19 @@ ByteCodeBlock* ByteCodeGenerator::generateByteCode(Context* c, InterpretedCodeBl
             }
         }
 
+        // arguments object of function which is not mapped to parameters can be created lazily.
+        // arguments.length, arguments[index] and fn.apply(thisArg, arguments) read argc and argv directly
+        // until arguments object escapes by another use of arguments
+        if (codeBlock->usesArgumentsObject() && codeBlock->canUseIndexedVariableStorage() && !codeBlock->isArrowFunctionExpression()
+            && !codeBlock->isGenerator() && !codeBlock->isAsync()
+            && (codeBlock->isStrict() || codeBlock->hasParameterOtherThanIdentifier() || !codeBlock->parameterCount())) {
+            InterpretedCodeBlock::IndexedIdentifierInfo info = codeBlock->indexedIdentifierInfo(c->staticStrings().arguments, codeBlock->functionBodyBlockIndex());
+            if (info.m_isResultSaved && info.m_isStackAllocated && info.m_type == InterpretedCodeBlock::IndexedIdentifierInfo::VarDeclared) {
+                ctx.m_lazyArgumentsObjectIndex = REGULAR_REGISTER_LIMIT + info.m_index;
+                block->pushCode(LoadLiteral(ByteCodeLOC(0), ctx.m_lazyArgumentsObjectIndex, Value(Value::EmptyValue)), &ctx, nullptr);
+            }
+        }
+
         ast->generateStatementByteCode(block, &ctx);
     } catch (const ByteCodeGenerateError& err) {
         block->m_code.clear();
@@ -194,6 +208,8 @@ ByteCodeBlock* ByteCodeGenerator::generateByteCode(Context* c, InterpretedCodeBl
         }
     }
 
+    ByteCodePeepholeOptimizer::optimize(block);
+
     {
         ByteCodeRegisterIndex stackBase = REGULAR_REGISTER_LIMIT;
         ByteCodeRegisterIndex stackBaseWillBe = block->m_requiredRegisterFileSizeInValueSize;
@@ -213,6 +229,8 @@ ByteCodeBlock* ByteCodeGenerator::generateByteCode(Context* c, InterpretedCodeBl
             currentCode->assignOpcodeInAddress();
 
             switch (opcode) {
+            case LoadLiteralThenBinaryPlusOpcode:
+            case LoadLiteralThenJumpIfEqualOpcode:
             case LoadLiteralOpcode: {
                 LoadLiteral* cd = (LoadLiteral*)currentCode;
                 ASSIGN_STACKINDEX_IF_NEEDED(cd->m_registerIndex, stackBase, stackBaseWillBe, stackVariableSize);
@@ -320,6 +338,8 @@ ByteCodeBlock* ByteCodeGenerator::generateByteCode(Context* c, InterpretedCodeBl
                     ASSIGN_STACKINDEX_IF_NEEDED(cd->m_loadRegisterIndexs[i], stackBase, stackBaseWillBe, stackVariableSize);
                 break;
             }
+            case GetObjectPreComputedCaseThenGetObjectPreComputedCaseOpcode:
+            case GetObjectPreComputedCaseThenCallFunctionWithReceiverOpcode:
             case GetObjectPreComputedCaseOpcode: {
                 GetObjectPreComputedCase* cd = (GetObjectPreComputedCase*)currentCode;
                 ASSIGN_STACKINDEX_IF_NEEDED(cd->m_objectRegisterIndex, stackBase, stackBaseWillBe, stackVariableSize);
@@ -332,6 +352,19 @@ ByteCodeBlock* ByteCodeGenerator::generateByteCode(Context* c, InterpretedCodeBl
                 ASSIGN_STACKINDEX_IF_NEEDED(cd->m_loadRegisterIndex, stackBase, stackBaseWillBe, stackVariableSize);
                 break;
             }
+            case GetArgumentsLengthOpcode: {
+                GetArgumentsLength* cd = (GetArgumentsLength*)currentCode;
+                ASSIGN_STACKINDEX_IF_NEEDED(cd->m_argumentsObjectIndex, stackBase, stackBaseWillBe, stackVariableSize);
+                ASSIGN_STACKINDEX_IF_NEEDED(cd->m_storeRegisterIndex, stackBase, stackBaseWillBe, stackVariableSize);
+                break;
+            }
+            case GetArgumentOpcode: {
+                GetArgument* cd = (GetArgument*)currentCode;
+                ASSIGN_STACKINDEX_IF_NEEDED(cd->m_argumentsObjectIndex, stackBase, stackBaseWillBe, stackVariableSize);
+                ASSIGN_STACKINDEX_IF_NEEDED(cd->m_propertyRegisterIndex, stackBase, stackBaseWillBe, stackVariableSize);
+                ASSIGN_STACKINDEX_IF_NEEDED(cd->m_storeRegisterIndex, stackBase, stackBaseWillBe, stackVariableSize);
+                break;
+            }
             case GetParameterOpcode: {
                 GetParameter* cd = (GetParameter*)currentCode;
                 ASSIGN_STACKINDEX_IF_NEEDED(cd->m_registerIndex, stackBase, stackBaseWillBe, stackVariableSize);
@@ -347,6 +380,8 @@ ByteCodeBlock* ByteCodeGenerator::generateByteCode(Context* c, InterpretedCodeBl
                 ASSIGN_STACKINDEX_IF_NEEDED(cd->m_registerIndex, stackBase, stackBaseWillBe, stackVariableSize);
                 break;
             }
+            case MoveThenMoveOpcode:
+            case MoveThenJumpOpcode:
             case MoveOpcode: {
                 Move* cd = (Move*)currentCode;
                 ASSIGN_STACKINDEX_IF_NEEDED(cd->m_registerIndex0, stackBase, stackBaseWillBe, stackVariableSize);
@@ -376,6 +411,7 @@ ByteCodeBlock* ByteCodeGenerator::generateByteCode(Context* c, InterpretedCodeBl
                 break;
             }
             case ToNumberOpcode:
+            case IncrementThenJumpOpcode:
             case IncrementOpcode:
             case DecrementOpcode:
             case UnaryMinusOpcode:
@@ -429,6 +465,15 @@ ByteCodeBlock* ByteCodeGenerator::generateByteCode(Context* c, InterpretedCodeBl
                 ASSIGN_STACKINDEX_IF_NEEDED(cd->m_resultIndex, stackBase, stackBaseWillBe, stackVariableSize);
                 break;
             }
+            case CallFunctionForwardingArgumentsOpcode: {
+                CallFunctionForwardingArguments* cd = (CallFunctionForwardingArguments*)currentCode;
+                ASSIGN_STACKINDEX_IF_NEEDED(cd->m_receiverIndex, stackBase, stackBaseWillBe, stackVariableSize);
+                ASSIGN_STACKINDEX_IF_NEEDED(cd->m_calleeIndex, stackBase, stackBaseWillBe, stackVariableSize);
+                ASSIGN_STACKINDEX_IF_NEEDED(cd->m_thisArgumentIndex, stackBase, stackBaseWillBe, stackVariableSize);
+                ASSIGN_STACKINDEX_IF_NEEDED(cd->m_argumentsObjectIndex, stackBase, stackBaseWillBe, stackVariableSize);
+                ASSIGN_STACKINDEX_IF_NEEDED(cd->m_resultIndex, stackBase, stackBaseWillBe, stackVariableSize);
+                break;
+            }
             case CallEvalFunctionOpcode: {
                 CallEvalFunction* cd = (CallEvalFunction*)currentCode;
                 ASSIGN_STACKINDEX_IF_NEEDED(cd->m_argumentsStartIndex, stackBase, stackBaseWillBe, stackVariableSize);
@@ -487,6 +532,7 @@ ByteCodeBlock* ByteCodeGenerator::generateByteCode(Context* c, InterpretedCodeBl
             case CreateEnumerateObjectOpcode: {
                 CreateEnumerateObject* cd = (CreateEnumerateObject*)currentCode;
                 ASSIGN_STACKINDEX_IF_NEEDED(cd->m_objectRegisterIndex, stackBase, stackBaseWillBe, stackVariableSize);
+                ASSIGN_STACKINDEX_IF_NEEDED(cd->m_spreadTargetRegisterIndex, stackBase, stackBaseWillBe, stackVariableSize);
                 break;
             }
             case GetIteratorOpcode: {
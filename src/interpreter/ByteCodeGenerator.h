@@ -97,6 +97,7 @@ struct ByteCodeGenerateContext {
         , m_lexicalBlockIndex(0)
         , m_maxPauseStatementExtraDataLength(0)
         , m_numeralLiteralData(numeralLiteralData)
+        , m_lazyArgumentsObjectIndex(REGISTER_LIMIT)
     {
         m_inCallingExpressionScope = false;
         m_isHeadOfMemberExpression = false;
@@ -133,6 +134,7 @@ struct ByteCodeGenerateContext {
         , m_classInfo(contextBefore.m_classInfo)
         , m_maxPauseStatementExtraDataLength(contextBefore.m_maxPauseStatementExtraDataLength)
         , m_numeralLiteralData(contextBefore.m_numeralLiteralData)
+        , m_lazyArgumentsObjectIndex(contextBefore.m_lazyArgumentsObjectIndex)
     {
         m_isHeadOfMemberExpression = false;
     }
@@ -352,6 +354,9 @@ struct ByteCodeGenerateContext {
     std::map<size_t, size_t> m_complexCaseStatementPositions;
     size_t m_maxPauseStatementExtraDataLength;
     NumeralLiteralVector* m_numeralLiteralData;
+    // stack register of arguments variable if arguments object is created only when it escapes
+    // register holds empty value until arguments object is created
+    ByteCodeRegisterIndex m_lazyArgumentsObjectIndex;
 };
 
 class ByteCodeGenerator {
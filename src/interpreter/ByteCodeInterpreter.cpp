@@ -45,11 +45,23 @@
 #include "util/Util.h"
 #include "../third_party/checked_arithmetic/CheckedArithmetic.h"
 #include "runtime/ProxyObject.h"
+#include "runtime/NativeFunctionObject.h"
+#include "runtime/BoundFunctionObject.h"
+#include "interpreter/InterpreterStack.h"
 
 namespace Escargot {
 
 #define ADD_PROGRAM_COUNTER(CodeType) programCounter += sizeof(CodeType);
 
+// if callee is run by current interpret function, we go back to caller instead of returning
+#define RETURN_FROM_FUNCTION(value)                                                   \
+    if (LIKELY(!binder.isInInterpretedCall())) {                                      \
+        return value;                                                                 \
+    }                                                                                 \
+    leaveInterpretedCall(state, byteCodeBlock, registerFile, programCounter, value); \
+    codeBuffer = byteCodeBlock->m_code.data();                                        \
+    NEXT_INSTRUCTION();
+
 ALWAYS_INLINE size_t jumpTo(char* codeBuffer, const size_t jumpPosition)
 {
     return (size_t)&codeBuffer[jumpPosition];
@@ -62,21 +74,57 @@ ALWAYS_INLINE size_t resolveProgramCounter(char* codeBuffer, const size_t progra
 
 class ExecutionStateProgramCounterBinder {
 public:
-    ExecutionStateProgramCounterBinder(ExecutionState& state, size_t* newAddress)
+    ExecutionStateProgramCounterBinder(ExecutionState& state, ByteCodeBlock* byteCodeBlock, size_t* newAddress)
         : m_state(state)
+        , m_topInterpreterFrame(state.context()->vmInstance()->topInterpreterFrame())
+        , m_interpreterStack(state.context()->vmInstance()->interpreterStack())
+        , m_interpreterStackFrameCount(m_interpreterStack->frameCount())
     {
         m_oldAddress = state.m_programCounter;
         state.m_programCounter = newAddress;
+
+        m_frame.m_byteCodeBlock = byteCodeBlock;
+        m_frame.m_programCounter = newAddress;
+        m_frame.m_parent = m_topInterpreterFrame;
+        // sampling profiler can read frames at any time in signal handler
+        // frame should be initialized before it is linked
+        std::atomic_signal_fence(std::memory_order_seq_cst);
+        m_topInterpreterFrame = &m_frame;
     }
 
     ~ExecutionStateProgramCounterBinder()
     {
+        m_topInterpreterFrame = m_frame.m_parent;
+        std::atomic_signal_fence(std::memory_order_seq_cst);
+        if (UNLIKELY(isInInterpretedCall())) {
+            // exception is thrown from callee which is run by this interpret function
+            size_t frameCount = m_interpreterStack->frameCount();
+            for (size_t i = m_interpreterStackFrameCount; i < frameCount; i++) {
+                m_interpreterStack->frameAt(i).m_callerState->m_programCounter = m_frame.m_programCounter;
+            }
+            m_interpreterStack->unwindTo(m_interpreterStackFrameCount);
+        }
         m_state.m_programCounter = m_oldAddress;
     }
 
+    InterpreterStack* interpreterStack()
+    {
+        return m_interpreterStack;
+    }
+
+    // returns true if interpreter runs callee which is called from this interpret function
+    bool isInInterpretedCall()
+    {
+        return m_interpreterStack->frameCount() != m_interpreterStackFrameCount;
+    }
+
 private:
     ExecutionState& m_state;
     size_t* m_oldAddress;
+    InterpreterFrame*& m_topInterpreterFrame;
+    InterpreterFrame m_frame;
+    InterpreterStack* m_interpreterStack;
+    size_t m_interpreterStackFrameCount;
 };
 
 Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteCodeBlock, size_t programCounter, Value* registerFile)
@@ -91,7 +139,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
     ASSERT(registerFile != nullptr);
 
     {
-        ExecutionStateProgramCounterBinder binder(*state, &programCounter);
+        ExecutionStateProgramCounterBinder binder(*state, byteCodeBlock, &programCounter);
         char* codeBuffer = byteCodeBlock->m_code.data();
         programCounter = (size_t)(codeBuffer + programCounter);
 
@@ -623,8 +671,12 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
             if (UNLIKELY(!callee.isPointerValue())) {
                 ErrorObject::throwBuiltinError(*state, ErrorObject::TypeError, errorMessage_NOT_Callable);
             }
+            // script function is called without native recursion if possible
             // Return F.[[Call]](V, argumentsList).
-            registerFile[code->m_resultIndex] = callee.asPointerValue()->call(*state, Value(), code->m_argumentCount, &registerFile[code->m_argumentsStartIndex]);
+            if (callFunction(state, byteCodeBlock, registerFile, programCounter, sizeof(CallFunction), code->m_inlineCache, code->m_resultIndex, callee.asPointerValue(), Value(), code->m_argumentCount, &registerFile[code->m_argumentsStartIndex])) {
+                codeBuffer = byteCodeBlock->m_code.data();
+                NEXT_INSTRUCTION();
+            }
 
             ADD_PROGRAM_COUNTER(CallFunction);
             NEXT_INSTRUCTION();
@@ -644,12 +696,35 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
                 ErrorObject::throwBuiltinError(*state, ErrorObject::TypeError, errorMessage_NOT_Callable);
             }
             // Return F.[[Call]](V, argumentsList).
-            registerFile[code->m_resultIndex] = callee.asPointerValue()->call(*state, receiver, code->m_argumentCount, &registerFile[code->m_argumentsStartIndex]);
+            if (callFunction(state, byteCodeBlock, registerFile, programCounter, sizeof(CallFunctionWithReceiver), code->m_inlineCache, code->m_resultIndex, callee.asPointerValue(), receiver, code->m_argumentCount, &registerFile[code->m_argumentsStartIndex])) {
+                codeBuffer = byteCodeBlock->m_code.data();
+                NEXT_INSTRUCTION();
+            }
 
             ADD_PROGRAM_COUNTER(CallFunctionWithReceiver);
             NEXT_INSTRUCTION();
         }
 
+        DEFINE_OPCODE(CallFunctionForwardingArguments)
+            :
+        {
+            CallFunctionForwardingArguments* code = (CallFunctionForwardingArguments*)programCounter;
+            const Value& callee = registerFile[code->m_calleeIndex];
+            const Value& receiver = registerFile[code->m_receiverIndex];
+            if (LIKELY(registerFile[code->m_argumentsObjectIndex].isEmpty() && callee.isPointerValue() && callee.asPointerValue() == state->context()->globalObject()->functionApply() && receiver.isCallable())) {
+                // Function.prototype.apply copies elements of arguments object into new arguments list,
+                // so we can call receiver with argv of current function instead
+                if (callFunction(state, byteCodeBlock, registerFile, programCounter, sizeof(CallFunctionForwardingArguments), code->m_inlineCache, code->m_resultIndex, receiver.asPointerValue(), registerFile[code->m_thisArgumentIndex], state->argc(), state->argv())) {
+                    codeBuffer = byteCodeBlock->m_code.data();
+                    NEXT_INSTRUCTION();
+                }
+            } else {
+                registerFile[code->m_resultIndex] = callFunctionForwardingArgumentsSlowCase(*state, code, byteCodeBlock, registerFile);
+            }
+            ADD_PROGRAM_COUNTER(CallFunctionForwardingArguments);
+            NEXT_INSTRUCTION();
+        }
+
         DEFINE_OPCODE(LoadByHeapIndex)
             :
         {
@@ -800,7 +875,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
             :
         {
             End* code = (End*)programCounter;
-            return registerFile[code->m_registerIndex];
+            RETURN_FROM_FUNCTION(registerFile[code->m_registerIndex]);
         }
 
         DEFINE_OPCODE(ToNumber)
@@ -1046,7 +1121,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
         {
             Value v = tryOperation(state, programCounter, byteCodeBlock, registerFile);
             if (!v.isEmpty()) {
-                return v;
+                RETURN_FROM_FUNCTION(v);
             }
             NEXT_INSTRUCTION();
         }
@@ -1070,7 +1145,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
         {
             Value v = withOperation(state, programCounter, byteCodeBlock, registerFile);
             if (!v.isEmpty()) {
-                return v;
+                RETURN_FROM_FUNCTION(v);
             }
             NEXT_INSTRUCTION();
         }
@@ -1087,7 +1162,12 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
             :
         {
             CreateEnumerateObject* code = (CreateEnumerateObject*)programCounter;
-            auto data = createEnumerateObject(*state, registerFile[code->m_objectRegisterIndex].toObject(*state), code->m_isDestruction);
+            Object* obj = registerFile[code->m_objectRegisterIndex].toObject(*state);
+            if (code->m_spreadTargetRegisterIndex != REGISTER_LIMIT && Object::tryToAssignByStructure(*state, registerFile[code->m_spreadTargetRegisterIndex].asObject(), obj)) {
+                programCounter = jumpTo(codeBuffer, code->m_spreadExitPosition);
+                NEXT_INSTRUCTION();
+            }
+            auto data = createEnumerateObject(*state, obj, code->m_isDestruction);
             registerFile[code->m_dataRegisterIndex] = Value((PointerValue*)data);
             ADD_PROGRAM_COUNTER(CreateEnumerateObject);
             NEXT_INSTRUCTION();
@@ -1302,12 +1382,9 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
             } else {
                 result = new ArrayObject(*state);
                 size_t i = 0;
-                while (true) {
-                    Value next = IteratorObject::iteratorStep(*state, iterOrEnum);
-                    if (next.isFalse()) {
-                        break;
-                    }
-                    result->setIndexedProperty(*state, Value(i++), IteratorObject::iteratorValue(*state, next));
+                Value value;
+                while (IteratorObject::iteratorStepValue(*state, iterOrEnum, value)) {
+                    result->setIndexedProperty(*state, Value(i++), value);
                 }
             }
 
@@ -1348,7 +1425,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
             BlockOperation* code = (BlockOperation*)programCounter;
             Value v = blockOperation(state, code, programCounter, byteCodeBlock, registerFile);
             if (!v.isEmpty()) {
-                return v;
+                RETURN_FROM_FUNCTION(v);
             }
             NEXT_INSTRUCTION();
         }
@@ -1369,6 +1446,39 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
             NEXT_INSTRUCTION();
         }
 
+        DEFINE_OPCODE(GetArgumentsLength)
+            :
+        {
+            GetArgumentsLength* code = (GetArgumentsLength*)programCounter;
+            if (LIKELY(registerFile[code->m_argumentsObjectIndex].isEmpty())) {
+                registerFile[code->m_storeRegisterIndex] = Value(state->argc());
+            } else {
+                registerFile[code->m_storeRegisterIndex] = getArgumentsLengthSlowCase(*state, code, registerFile);
+            }
+            ADD_PROGRAM_COUNTER(GetArgumentsLength);
+            NEXT_INSTRUCTION();
+        }
+
+        DEFINE_OPCODE(GetArgument)
+            :
+        {
+            GetArgument* code = (GetArgument*)programCounter;
+            const Value& property = registerFile[code->m_propertyRegisterIndex];
+            // other keys go to slow case without conversion. converting here and again in slow case
+            // would call user-defined toString twice
+            if (LIKELY(registerFile[code->m_argumentsObjectIndex].isEmpty() && property.isUInt32())) {
+                uint32_t idx = property.asUInt32();
+                if (LIKELY(idx < state->argc())) {
+                    registerFile[code->m_storeRegisterIndex] = state->argv()[idx];
+                    ADD_PROGRAM_COUNTER(GetArgument);
+                    NEXT_INSTRUCTION();
+                }
+            }
+            registerFile[code->m_storeRegisterIndex] = getArgumentSlowCase(*state, code, byteCodeBlock, registerFile);
+            ADD_PROGRAM_COUNTER(GetArgument);
+            NEXT_INSTRUCTION();
+        }
+
         DEFINE_OPCODE(ResolveNameAddress)
             :
         {
@@ -1387,6 +1497,87 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
             NEXT_INSTRUCTION();
         }
 
+        // superinstructions run first instruction and go to handler of second instruction without dispatch
+
+        DEFINE_OPCODE(MoveThenMove)
+            :
+        {
+            Move* code = (Move*)programCounter;
+            ASSERT(!registerFile[code->m_registerIndex0].isEmpty());
+            registerFile[code->m_registerIndex1] = registerFile[code->m_registerIndex0];
+            ADD_PROGRAM_COUNTER(Move);
+            JUMP_INSTRUCTION(Move);
+        }
+
+        DEFINE_OPCODE(MoveThenJump)
+            :
+        {
+            Move* code = (Move*)programCounter;
+            ASSERT(!registerFile[code->m_registerIndex0].isEmpty());
+            registerFile[code->m_registerIndex1] = registerFile[code->m_registerIndex0];
+            ADD_PROGRAM_COUNTER(Move);
+            JUMP_INSTRUCTION(Jump);
+        }
+
+        DEFINE_OPCODE(LoadLiteralThenBinaryPlus)
+            :
+        {
+            LoadLiteral* code = (LoadLiteral*)programCounter;
+            registerFile[code->m_registerIndex] = code->m_value;
+            ADD_PROGRAM_COUNTER(LoadLiteral);
+            JUMP_INSTRUCTION(BinaryPlus);
+        }
+
+        DEFINE_OPCODE(LoadLiteralThenJumpIfEqual)
+            :
+        {
+            LoadLiteral* code = (LoadLiteral*)programCounter;
+            registerFile[code->m_registerIndex] = code->m_value;
+            ADD_PROGRAM_COUNTER(LoadLiteral);
+            JUMP_INSTRUCTION(JumpIfEqual);
+        }
+
+        DEFINE_OPCODE(IncrementThenJump)
+            :
+        {
+            Increment* code = (Increment*)programCounter;
+            registerFile[code->m_dstIndex] = incrementOperation(*state, registerFile[code->m_srcIndex]);
+            ADD_PROGRAM_COUNTER(Increment);
+            JUMP_INSTRUCTION(Jump);
+        }
+
+        DEFINE_OPCODE(GetObjectPreComputedCaseThenGetObjectPreComputedCase)
+            :
+        {
+            GetObjectPreComputedCase* code = (GetObjectPreComputedCase*)programCounter;
+            const Value& willBeObject = registerFile[code->m_objectRegisterIndex];
+            Object* obj;
+            if (LIKELY(willBeObject.isObject())) {
+                obj = willBeObject.asObject();
+            } else {
+                obj = fastToObject(*state, willBeObject);
+            }
+            registerFile[code->m_storeRegisterIndex] = getObjectPrecomputedCaseOperation(*state, obj, willBeObject, code, byteCodeBlock);
+            ADD_PROGRAM_COUNTER(GetObjectPreComputedCase);
+            JUMP_INSTRUCTION(GetObjectPreComputedCase);
+        }
+
+        DEFINE_OPCODE(GetObjectPreComputedCaseThenCallFunctionWithReceiver)
+            :
+        {
+            GetObjectPreComputedCase* code = (GetObjectPreComputedCase*)programCounter;
+            const Value& willBeObject = registerFile[code->m_objectRegisterIndex];
+            Object* obj;
+            if (LIKELY(willBeObject.isObject())) {
+                obj = willBeObject.asObject();
+            } else {
+                obj = fastToObject(*state, willBeObject);
+            }
+            registerFile[code->m_storeRegisterIndex] = getObjectPrecomputedCaseOperation(*state, obj, willBeObject, code, byteCodeBlock);
+            ADD_PROGRAM_COUNTER(GetObjectPreComputedCase);
+            JUMP_INSTRUCTION(CallFunctionWithReceiver);
+        }
+
         DEFINE_DEFAULT
     }
 
@@ -1402,6 +1593,219 @@ FillOpcodeTableLbl:
     return Value();
 }
 
+// calls callee with call-site cache. returns true if callee is entered without native recursion
+// otherwise result of call is stored into result register
+bool ByteCodeInterpreter::callFunction(ExecutionState*& state, ByteCodeBlock*& byteCodeBlock, Value*& registerFile, size_t& programCounter, size_t callInstructionSize, CallFunctionInlineCache& inlineCache, ByteCodeRegisterIndex resultIndex, PointerValue* callee, const Value& thisValue, size_t argc, Value* argv)
+{
+    // cache hit. kind of callee is not rediscovered
+    if (inlineCache.m_kind == CallFunctionInlineCache::ScriptFunction) {
+        if (LIKELY(callee->hasTag(g_scriptFunctionObjectTag) && callee->asScriptFunctionObject()->codeBlock() == inlineCache.m_codeBlock)) {
+            if (LIKELY(enterInterpretedCall(state, byteCodeBlock, registerFile, programCounter, callInstructionSize, resultIndex, callee->asScriptFunctionObject(), thisValue, argc, argv, true))) {
+                return true;
+            }
+            // bytecode is released by GC or stack is full
+            registerFile[resultIndex] = callee->call(*state, thisValue, argc, argv);
+            return false;
+        }
+    } else if (inlineCache.m_kind == CallFunctionInlineCache::NativeFunction) {
+        if (LIKELY(callee->hasTag(g_nativeFunctionObjectTag) && callee->asNativeFunctionObject()->codeBlock() == inlineCache.m_codeBlock)) {
+            // call NativeFunctionObject::call directly without virtual dispatch
+            registerFile[resultIndex] = callee->asNativeFunctionObject()->NativeFunctionObject::call(*state, thisValue, argc, argv);
+            return false;
+        }
+    }
+
+    return callFunctionSlowCase(state, byteCodeBlock, registerFile, programCounter, callInstructionSize, inlineCache, resultIndex, callee, thisValue, argc, argv);
+}
+
+NEVER_INLINE bool ByteCodeInterpreter::callFunctionSlowCase(ExecutionState*& state, ByteCodeBlock*& byteCodeBlock, Value*& registerFile, size_t& programCounter, size_t callInstructionSize, CallFunctionInlineCache& inlineCache, ByteCodeRegisterIndex resultIndex, PointerValue* callee, const Value& thisValue, size_t argc, Value* argv)
+{
+    if (callee->hasTag(g_boundFunctionObjectTag)) {
+        registerFile[resultIndex] = callBoundFunction(*state, callee->asBoundFunctionObject(), argc, argv);
+        return false;
+    }
+
+    // polymorphic call site can change cache only limited times
+    // because every CodeBlock of cache is kept in literal data
+    const int maxCacheMissCount = 16;
+    if (inlineCache.m_cacheMissCount < maxCacheMissCount) {
+        CallFunctionInlineCache::CalleeKind kind = CallFunctionInlineCache::None;
+        CodeBlock* calleeCodeBlock = nullptr;
+        if (callee->hasTag(g_scriptFunctionObjectTag)) {
+            calleeCodeBlock = callee->asScriptFunctionObject()->codeBlock();
+            if (canEnterInterpretedCall(calleeCodeBlock->asInterpretedCodeBlock())) {
+                kind = CallFunctionInlineCache::ScriptFunction;
+            }
+        } else if (callee->hasTag(g_nativeFunctionObjectTag)) {
+            calleeCodeBlock = callee->asNativeFunctionObject()->codeBlock();
+            kind = CallFunctionInlineCache::NativeFunction;
+        }
+
+        if (kind != CallFunctionInlineCache::None && (kind != inlineCache.m_kind || calleeCodeBlock != inlineCache.m_codeBlock)) {
+            inlineCache.m_kind = kind;
+            inlineCache.m_codeBlock = calleeCodeBlock;
+            inlineCache.m_cacheMissCount++;
+            byteCodeBlock->m_literalData.push_back(calleeCodeBlock);
+        }
+    }
+
+    if (callee->hasTag(g_scriptFunctionObjectTag) && enterInterpretedCall(state, byteCodeBlock, registerFile, programCounter, callInstructionSize, resultIndex, callee->asScriptFunctionObject(), thisValue, argc, argv, false)) {
+        return true;
+    }
+
+    registerFile[resultIndex] = callee->call(*state, thisValue, argc, argv);
+    return false;
+}
+
+// bound function chain is flattened when it is created. so we call innermost target directly
+NEVER_INLINE Value ByteCodeInterpreter::callBoundFunction(ExecutionState& state, BoundFunctionObject* callee, size_t calledArgc, Value* calledArgv)
+{
+    const SmallValueVector& boundArguments = callee->flattenedBoundArguments();
+    size_t boundArgc = boundArguments.size();
+    size_t mergedArgc = boundArgc + calledArgc;
+    Value* mergedArgv = ALLOCA(mergedArgc * sizeof(Value), Value, state);
+    for (size_t i = 0; i < boundArgc; i++) {
+        mergedArgv[i] = boundArguments[i];
+    }
+    if (calledArgc > 0) {
+        memcpy(mergedArgv + boundArgc, calledArgv, sizeof(Value) * calledArgc);
+    }
+
+    return Object::call(state, callee->m_flattenedTargetFunction, callee->m_flattenedBoundThis, mergedArgc, mergedArgv);
+}
+
+// bytecode is generated by first call through ScriptFunctionObject::call
+// and rare cases like non-indexed environment or try-finally(which needs clearing stack) are also handled by it
+bool ByteCodeInterpreter::canEnterInterpretedCall(InterpretedCodeBlock* codeBlock)
+{
+    ByteCodeBlock* blk = codeBlock->byteCodeBlock();
+    return blk && !blk->m_shouldClearStack && (codeBlock->canAllocateEnvironmentOnStack() || codeBlock->canUseIndexedVariableStorage());
+}
+
+bool ByteCodeInterpreter::enterInterpretedCall(ExecutionState*& state, ByteCodeBlock*& byteCodeBlock, Value*& registerFile, size_t& programCounter, size_t callInstructionSize, ByteCodeRegisterIndex resultIndex, ScriptFunctionObject* callee, const Value& thisValue, size_t argc, Value* argv, bool isCheckedByInlineCache)
+{
+    InterpretedCodeBlock* codeBlock = callee->codeBlock()->asInterpretedCodeBlock();
+    ByteCodeBlock* blk = codeBlock->byteCodeBlock();
+
+    // call-site cache checked conditions except bytecode which can be released by GC
+    if (isCheckedByInlineCache ? UNLIKELY(blk == nullptr) : UNLIKELY(!canEnterInterpretedCall(codeBlock))) {
+        return false;
+    }
+
+    size_t registerSize = blk->m_requiredRegisterFileSizeInValueSize;
+    size_t identifierOnStackCount = codeBlock->identifierOnStackCount();
+    size_t stackStorageSize = codeBlock->totalStackAllocatedVariableSize();
+    size_t literalStorageSize = blk->m_numeralLiteralData.size();
+
+    VMInstance* vmInstance = state->context()->vmInstance();
+    InterpreterStack* interpreterStack = vmInstance->interpreterStack();
+    InterpretedCallFrame* frame = interpreterStack->pushFrame(registerSize + stackStorageSize + literalStorageSize);
+    if (UNLIKELY(frame == nullptr)) {
+        // stack is full. continue with native recursion
+        return false;
+    }
+
+    frame->m_callerState = state;
+    frame->m_callerByteCodeBlock = byteCodeBlock;
+    frame->m_callerRegisterFile = registerFile;
+    frame->m_callerProgramCounter = programCounter;
+    frame->m_callInstructionSize = callInstructionSize;
+    frame->m_resultIndex = resultIndex;
+
+    Value* newRegisterFile = frame->m_registerFile;
+    Value* stackStorage = newRegisterFile + registerSize;
+
+    // literal data is not changed by bytecode.
+    // so we don't need to copy it if previous frame of this position was same function
+    if (UNLIKELY(frame->m_byteCodeBlock != blk)) {
+        Value* literalStorage = stackStorage + stackStorageSize;
+        Value* literalStorageSrc = blk->m_numeralLiteralData.data();
+        for (size_t i = 0; i < literalStorageSize; i++) {
+            literalStorage[i] = literalStorageSrc[i];
+        }
+        interpreterStack->setLiteralDataOwner(frame, blk);
+    }
+
+    // prepare env, ec
+    FunctionEnvironmentRecord* record;
+    LexicalEnvironment* lexEnv;
+    if (LIKELY(codeBlock->canAllocateEnvironmentOnStack())) {
+        // no capture, very simple case
+        record = new (&frame->m_record) FunctionEnvironmentRecordOnStack<false, false>(callee);
+        lexEnv = new (&frame->m_lexicalEnvironment) LexicalEnvironment(record, callee->outerEnvironment()
+#ifndef NDEBUG
+                                                                                     ,
+                                                                       false
+#endif
+                                                                       );
+    } else {
+        record = new FunctionEnvironmentRecordOnHeap<false, false>(callee);
+        lexEnv = new LexicalEnvironment(record, callee->outerEnvironment());
+    }
+
+    bool isStrict = codeBlock->isStrict();
+    ExecutionState* newState = new (&frame->m_state) ExecutionState(codeBlock->context(), state, lexEnv, argc, argv, isStrict);
+
+    // binding function name
+    stackStorage[1] = callee;
+
+    // initialize identifiers by undefined value
+    for (size_t i = 2; i < identifierOnStackCount; i++) {
+        stackStorage[i] = Value();
+    }
+
+    // OrdinaryCallBindThis ( F, calleeContext, thisArgument )
+    // same as FunctionObjectThisValueBinder
+    if (isStrict) {
+        stackStorage[0] = thisValue;
+    } else if (thisValue.isUndefinedOrNull()) {
+        stackStorage[0] = newState->context()->globalObject();
+    } else {
+        stackStorage[0] = thisValue.toObject(*newState);
+    }
+
+    // caller state and frame of caller read program counter from frame while callee runs
+    InterpreterFrame*& topInterpreterFrame = vmInstance->topInterpreterFrame();
+    state->m_programCounter = &frame->m_callerProgramCounter;
+    newState->m_programCounter = &programCounter;
+    frame->m_interpreterFrame.m_byteCodeBlock = blk;
+    frame->m_interpreterFrame.m_programCounter = &programCounter;
+    frame->m_interpreterFrame.m_parent = topInterpreterFrame;
+    topInterpreterFrame->m_programCounter = &frame->m_callerProgramCounter;
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+    topInterpreterFrame = &frame->m_interpreterFrame;
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+
+    state = newState;
+    byteCodeBlock = blk;
+    registerFile = newRegisterFile;
+    programCounter = (size_t)blk->m_code.data();
+    return true;
+}
+
+void ByteCodeInterpreter::leaveInterpretedCall(ExecutionState*& state, ByteCodeBlock*& byteCodeBlock, Value*& registerFile, size_t& programCounter, Value returnValue)
+{
+    VMInstance* vmInstance = state->context()->vmInstance();
+    InterpreterStack* interpreterStack = vmInstance->interpreterStack();
+    InterpretedCallFrame& frame = interpreterStack->topFrame();
+
+    InterpreterFrame*& topInterpreterFrame = vmInstance->topInterpreterFrame();
+    topInterpreterFrame = frame.m_interpreterFrame.m_parent;
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+    programCounter = frame.m_callerProgramCounter;
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+    topInterpreterFrame->m_programCounter = &programCounter;
+
+    state = frame.m_callerState;
+    state->m_programCounter = &programCounter;
+    byteCodeBlock = frame.m_callerByteCodeBlock;
+    registerFile = frame.m_callerRegisterFile;
+    registerFile[frame.m_resultIndex] = returnValue;
+    programCounter += frame.m_callInstructionSize;
+
+    interpreterStack->popFrame();
+}
+
 NEVER_INLINE EnvironmentRecord* ByteCodeInterpreter::getBindedEnvironmentRecordByName(ExecutionState& state, LexicalEnvironment* env, const AtomicString& name, Value& bindedValue, bool throwException)
 {
     while (env) {
@@ -2686,7 +3090,13 @@ NEVER_INLINE Value ByteCodeInterpreter::blockOperation(ExecutionState*& state, B
                 newRecord->createBinding(*state, iv[i].m_name, false, iv[i].m_isMutable, false);
             }
         }
-        newEnv = new LexicalEnvironment(newRecord, state->lexicalEnvironment());
+        // function environment on stack is skipped because closure can keep block environment alive
+        // see InterpretedCodeBlock::markHeapAllocatedBlockEnvironmentFromHere
+        LexicalEnvironment* outerEnv = state->lexicalEnvironment();
+        if (UNLIKELY(!outerEnv->record()->isAllocatedOnHeap())) {
+            outerEnv = outerEnv->outerEnvironment();
+        }
+        newEnv = new LexicalEnvironment(newRecord, outerEnv);
         ASSERT(newEnv->isAllocatedOnHeap());
     } else {
         newRecord = nullptr;
@@ -2904,8 +3314,6 @@ NEVER_INLINE Value ByteCodeInterpreter::executionPauseOperation(ExecutionState&
         ExecutionPauser::pause(state, nextResult, programCounter + sizeof(ExecutionPause), code->m_yieldDelegateData.m_tailDataLength, nextProgramCounter, REGISTER_LIMIT, ExecutionPauser::PauseReason::YieldDelegate);
     } else if (code->m_reason == ExecutionPause::Await) {
         // http://www.ecma-international.org/ecma-262/10.0/#await
-        ScriptAsyncFunctionObject* self = state.resolveCallee()->asScriptAsyncFunctionObject();
-
         ExecutionState* p = &state;
         ExecutionPauser* executionPauser;
         while (true) {
@@ -2924,15 +3332,14 @@ NEVER_INLINE Value ByteCodeInterpreter::executionPauseOperation(ExecutionState&
         // Let stepsFulfilled be the algorithm steps defined in Await Fulfilled Functions.
         // Let onFulfilled be CreateBuiltinFunction(stepsFulfilled, « [[AsyncContext]] »).
         // Set onFulfilled.[[AsyncContext]] to asyncContext.
-        FunctionObject* onFulfilled = new ScriptAsyncFunctionHelperFunctionObject(state, NativeFunctionInfo(AtomicString(), awaitFulfilledFunction, 1), executionPauser, self);
-
         // Let stepsRejected be the algorithm steps defined in Await Rejected Functions.
         // Let onRejected be CreateBuiltinFunction(stepsRejected, « [[AsyncContext]] »).
         // Set onRejected.[[AsyncContext]] to asyncContext.
-        FunctionObject* onRejected = new ScriptAsyncFunctionHelperFunctionObject(state, NativeFunctionInfo(AtomicString(), awaitRejectedFunction, 1), executionPauser, self);
-
         // Perform ! PerformPromiseThen(promise, onFulfilled, onRejected).
-        promise->then(state, onFulfilled, onRejected, Optional<PromiseReaction::Capability>());
+        // --> onFulfilled, onRejected are never exposed to user code.
+        //     reaction record resumes executionPauser directly without creating them
+        ASSERT(executionPauser->sourceObject() == state.resolveCallee()->asScriptAsyncFunctionObject());
+        promise->thenForAwait(state, executionPauser);
         // Remove asyncContext from the execution context stack and restore the execution context that is at the top of the execution context stack as the running execution context.
         // Set the code evaluation state of asyncContext such that when evaluation is resumed with a Completion completion, the following steps of the algorithm that invoked Await will be performed, with completion available.
         // Return.
@@ -3161,12 +3568,8 @@ NEVER_INLINE void ByteCodeInterpreter::createSpreadArrayObject(ExecutionState& s
 
     Value iteratorRecord = IteratorObject::getIterator(state, registerFile[code->m_argumentIndex]);
     size_t i = 0;
-    while (true) {
-        Value next = IteratorObject::iteratorStep(state, iteratorRecord);
-        if (next.isFalse()) {
-            break;
-        }
-        Value value = IteratorObject::iteratorValue(state, next);
+    Value value;
+    while (IteratorObject::iteratorStepValue(state, iteratorRecord, value)) {
         spreadArray->setIndexedProperty(state, Value(i++), value);
     }
     registerFile[code->m_registerIndex] = spreadArray;
@@ -3270,9 +3673,8 @@ NEVER_INLINE void ByteCodeInterpreter::getIteratorOperation(ExecutionState& stat
 NEVER_INLINE void ByteCodeInterpreter::iteratorStepOperation(ExecutionState& state, size_t& programCounter, Value* registerFile, char* codeBuffer)
 {
     IteratorStep* code = (IteratorStep*)programCounter;
-    Value nextResult = IteratorObject::iteratorStep(state, registerFile[code->m_iterRegisterIndex]);
-
-    if (nextResult.isFalse()) {
+    Value value;
+    if (!IteratorObject::iteratorStepValue(state, registerFile[code->m_iterRegisterIndex], value)) {
         if (code->m_forOfEndPosition == SIZE_MAX) {
             registerFile[code->m_registerIndex] = Value();
             ADD_PROGRAM_COUNTER(IteratorStep);
@@ -3280,7 +3682,7 @@ NEVER_INLINE void ByteCodeInterpreter::iteratorStepOperation(ExecutionState& sta
             programCounter = jumpTo(codeBuffer, code->m_forOfEndPosition);
         }
     } else {
-        registerFile[code->m_registerIndex] = IteratorObject::iteratorValue(state, nextResult);
+        registerFile[code->m_registerIndex] = value;
         ADD_PROGRAM_COUNTER(IteratorStep);
     }
 }
@@ -3339,6 +3741,38 @@ NEVER_INLINE void ByteCodeInterpreter::setObjectOpcodeSlowCase(ExecutionState& s
     }
 }
 
+NEVER_INLINE Value ByteCodeInterpreter::getArgumentsLengthSlowCase(ExecutionState& state, GetArgumentsLength* code, Value* registerFile)
+{
+    // arguments object is created already or arguments variable is overwritten
+    const Value& willBeObject = registerFile[code->m_argumentsObjectIndex];
+    Object* obj = fastToObject(state, willBeObject);
+    return obj->get(state, ObjectPropertyName(state.context()->staticStrings().length)).value(state, willBeObject);
+}
+
+NEVER_INLINE Value ByteCodeInterpreter::getArgumentSlowCase(ExecutionState& state, GetArgument* code, ByteCodeBlock* byteCodeBlock, Value* registerFile)
+{
+    if (registerFile[code->m_argumentsObjectIndex].isEmpty()) {
+        ensureArgumentsObjectOperation(state, byteCodeBlock, registerFile);
+    }
+    const Value& willBeObject = registerFile[code->m_argumentsObjectIndex];
+    Object* obj = fastToObject(state, willBeObject);
+    return obj->getIndexedProperty(state, registerFile[code->m_propertyRegisterIndex]).value(state, willBeObject);
+}
+
+NEVER_INLINE Value ByteCodeInterpreter::callFunctionForwardingArgumentsSlowCase(ExecutionState& state, CallFunctionForwardingArguments* code, ByteCodeBlock* byteCodeBlock, Value* registerFile)
+{
+    // callee is not Function.prototype.apply or arguments object escaped already
+    if (registerFile[code->m_argumentsObjectIndex].isEmpty()) {
+        ensureArgumentsObjectOperation(state, byteCodeBlock, registerFile);
+    }
+    const Value& callee = registerFile[code->m_calleeIndex];
+    if (UNLIKELY(!callee.isPointerValue())) {
+        ErrorObject::throwBuiltinError(state, ErrorObject::TypeError, errorMessage_NOT_Callable);
+    }
+    Value argv[2] = { registerFile[code->m_thisArgumentIndex], registerFile[code->m_argumentsObjectIndex] };
+    return callee.asPointerValue()->call(state, registerFile[code->m_receiverIndex], 2, argv);
+}
+
 NEVER_INLINE void ByteCodeInterpreter::ensureArgumentsObjectOperation(ExecutionState& state, ByteCodeBlock* byteCodeBlock, Value* registerFile)
 {
     ExecutionState* es = &state;
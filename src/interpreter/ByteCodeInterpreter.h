@@ -70,10 +70,23 @@ class IteratorStep;
 class IteratorClose;
 class EnumerateObject;
 class CheckLastEnumerateKey;
+class ScriptFunctionObject;
+class BoundFunctionObject;
+struct CallFunctionInlineCache;
+class CallFunctionForwardingArguments;
+class GetArgumentsLength;
+class GetArgument;
 
 class ByteCodeInterpreter {
 public:
     static Value interpret(ExecutionState* state, ByteCodeBlock* byteCodeBlock, size_t programCounter, Value* registerFile);
+    // these switch context of interpret function to callee or caller for calling script function without native recursion
+    static bool enterInterpretedCall(ExecutionState*& state, ByteCodeBlock*& byteCodeBlock, Value*& registerFile, size_t& programCounter, size_t callInstructionSize, ByteCodeRegisterIndex resultIndex, ScriptFunctionObject* callee, const Value& thisValue, size_t argc, Value* argv, bool isCheckedByInlineCache);
+    static void leaveInterpretedCall(ExecutionState*& state, ByteCodeBlock*& byteCodeBlock, Value*& registerFile, size_t& programCounter, Value returnValue);
+    static bool canEnterInterpretedCall(InterpretedCodeBlock* codeBlock);
+    static bool callFunction(ExecutionState*& state, ByteCodeBlock*& byteCodeBlock, Value*& registerFile, size_t& programCounter, size_t callInstructionSize, CallFunctionInlineCache& inlineCache, ByteCodeRegisterIndex resultIndex, PointerValue* callee, const Value& thisValue, size_t argc, Value* argv);
+    static bool callFunctionSlowCase(ExecutionState*& state, ByteCodeBlock*& byteCodeBlock, Value*& registerFile, size_t& programCounter, size_t callInstructionSize, CallFunctionInlineCache& inlineCache, ByteCodeRegisterIndex resultIndex, PointerValue* callee, const Value& thisValue, size_t argc, Value* argv);
+    static Value callBoundFunction(ExecutionState& state, BoundFunctionObject* callee, size_t calledArgc, Value* calledArgv);
     static Value loadByName(ExecutionState& state, LexicalEnvironment* env, const AtomicString& name, bool throwException = true);
     static EnvironmentRecord* getBindedEnvironmentRecordByName(ExecutionState& state, LexicalEnvironment* env, const AtomicString& name, Value& bindedValue, bool throwException = true);
     static void storeByName(ExecutionState& state, LexicalEnvironment* env, const AtomicString& name, const Value& value);
@@ -151,6 +164,9 @@ public:
     static void iteratorCloseOperation(ExecutionState& state, IteratorClose* code, Value* registerFile);
 
     static void ensureArgumentsObjectOperation(ExecutionState& state, ByteCodeBlock* byteCodeBlock, Value* registerFile);
+    static Value getArgumentsLengthSlowCase(ExecutionState& state, GetArgumentsLength* code, Value* registerFile);
+    static Value getArgumentSlowCase(ExecutionState& state, GetArgument* code, ByteCodeBlock* byteCodeBlock, Value* registerFile);
+    static Value callFunctionForwardingArgumentsSlowCase(ExecutionState& state, CallFunctionForwardingArguments* code, ByteCodeBlock* byteCodeBlock, Value* registerFile);
 };
 }
 
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2020-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#include "Escargot.h"
+#include "ByteCodePeepholeOptimizer.h"
+#include "interpreter/ByteCode.h"
+
+namespace Escargot {
+
+static const uint8_t byteCodeLengths[] = {
+#define ITER_BYTE_CODE(code, pushCount, popCount) \
+    (uint8_t)sizeof(code),
+
+    FOR_EACH_BYTECODE_OP(ITER_BYTE_CODE)
+#undef ITER_BYTE_CODE
+};
+
+#ifndef NDEBUG
+// VMInstances of several threads generate bytecode at once
+static std::atomic<size_t> g_peepholeInstructionCount;
+static std::atomic<size_t> g_peepholeFusedCount[OpcodeKindEnd];
+#endif
+
+static ALWAYS_INLINE Opcode readOpcode(ByteCode* code)
+{
+#if defined(COMPILER_GCC) || defined(COMPILER_CLANG)
+    return (Opcode)(size_t)code->m_opcodeInAddress;
+#else
+    return code->m_opcode;
+#endif
+}
+
+static ALWAYS_INLINE void writeOpcode(ByteCode* code, Opcode opcode)
+{
+#if defined(COMPILER_GCC) || defined(COMPILER_CLANG)
+    code->m_opcodeInAddress = (void*)(size_t)opcode;
+#else
+    code->m_opcode = opcode;
+#endif
+#ifndef NDEBUG
+    code->m_orgOpcode = opcode;
+#endif
+}
+
+static Opcode superinstructionOf(Opcode first, Opcode second)
+{
+#define CHECK_SUPERINSTRUCTION(name, firstName, secondName)           \
+    if (first == firstName##Opcode && second == secondName##Opcode) { \
+        return name##Opcode;                                          \
+    }
+    FOR_EACH_SUPERINSTRUCTION(CHECK_SUPERINSTRUCTION)
+#undef CHECK_SUPERINSTRUCTION
+    return OpcodeKindEnd;
+}
+
+void ByteCodePeepholeOptimizer::optimize(ByteCodeBlock* block)
+{
+    char* code = block->m_code.data();
+    char* end = code + block->m_code.size();
+
+    ByteCode* previousCode = nullptr;
+    Opcode previousOpcode = OpcodeKindEnd;
+    while (code < end) {
+        ByteCode* currentCode = (ByteCode*)code;
+        Opcode opcode = readOpcode(currentCode);
+        ASSERT(opcode <= EndOpcode);
+#ifndef NDEBUG
+        g_peepholeInstructionCount++;
+#endif
+
+        if (previousCode) {
+            Opcode fused = superinstructionOf(previousOpcode, opcode);
+            if (fused != OpcodeKindEnd) {
+                // second instruction is not changed by fusion,
+                // so it can be first instruction of next pair
+                writeOpcode(previousCode, fused);
+#ifndef NDEBUG
+                g_peepholeFusedCount[fused]++;
+#endif
+            }
+        }
+
+        previousCode = currentCode;
+        previousOpcode = opcode;
+
+        if (opcode == ExecutionPauseOpcode) {
+            // don't fuse pair across tail data of ExecutionPause
+            ExecutionPause* cd = (ExecutionPause*)currentCode;
+            if (cd->m_reason == ExecutionPause::Reason::Yield) {
+                code += cd->m_yieldData.m_tailDataLength;
+            } else if (cd->m_reason == ExecutionPause::Reason::YieldDelegate) {
+                code += cd->m_yieldDelegateData.m_tailDataLength;
+            } else if (cd->m_reason == ExecutionPause::Reason::Await) {
+                code += cd->m_awaitData.m_tailDataLength;
+            }
+            previousCode = nullptr;
+        }
+
+        code += byteCodeLengths[opcode];
+    }
+
+#ifndef NDEBUG
+    if (getenv("DUMP_BYTECODE_PEEPHOLE_STATISTICS") && strlen(getenv("DUMP_BYTECODE_PEEPHOLE_STATISTICS"))) {
+        dumpStatistics();
+    }
+#endif
+}
+
+#ifndef NDEBUG
+void ByteCodePeepholeOptimizer::dumpStatistics()
+{
+    printf("peephole statistics>>>>>>>>>>>>>>>>>>>>>>\n");
+    printf("instructions %d\n", (int)g_peepholeInstructionCount.load());
+#define DUMP_SUPERINSTRUCTION(name, firstName, secondName) \
+    printf("%s %d\n", #name, (int)g_peepholeFusedCount[name##Opcode].load());
+    FOR_EACH_SUPERINSTRUCTION(DUMP_SUPERINSTRUCTION)
+#undef DUMP_SUPERINSTRUCTION
+    printf("peephole statistics<<<<<<<<<<<<<<<<<<<<<<\n");
+}
+#endif
+}
@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2020-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#ifndef __EscargotByteCodePeepholeOptimizer__
+#define __EscargotByteCodePeepholeOptimizer__
+
+namespace Escargot {
+
+class ByteCodeBlock;
+
+// Peephole pass over generated bytecode
+// Adjacent instruction pairs listed in FOR_EACH_SUPERINSTRUCTION are fused into superinstruction
+// by replacing opcode of first instruction. Size and position of every instruction are kept,
+// so jump positions, exception handling and LOC data don't need any fix.
+// Instructions are never removed, so there is no copy propagation or redundant load elimination.
+// TODO follow-up work needs list of every jump target of block, which is spread over many bytecode kinds now
+// (try/finally, for-in/of, complex jump cases, yield tail data)
+// - remove Moves by copy propagation and LoadLiterals whose register holds the value already
+// - operand forms with immediate literal value, replacing LoadLiteral pairs above
+// - choose pairs from dispatch profile of benchmarks instead of hand-picked list
+class ByteCodePeepholeOptimizer {
+public:
+    // should be called before opcodes are converted into addresses
+    static void optimize(ByteCodeBlock* block);
+
+#ifndef NDEBUG
+    // prints count of fused pairs from start of process
+    // enabled by DUMP_BYTECODE_PEEPHOLE_STATISTICS environment variable
+    static void dumpStatistics();
+#endif
+};
+}
+
+#endif
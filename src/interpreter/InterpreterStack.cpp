@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2020-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#include "Escargot.h"
+#include "InterpreterStack.h"
+
+namespace Escargot {
+
+bool InterpreterStack::ensureSegments(size_t registerFileSize)
+{
+    if (m_frameCount % INTERPRETER_CALL_FRAME_SEGMENT_SIZE == 0) {
+        size_t frameSegmentIndex = m_frameCount / INTERPRETER_CALL_FRAME_SEGMENT_SIZE;
+        if (frameSegmentIndex == FrameSegmentCount) {
+            return false;
+        }
+        if (!m_frameSegments[frameSegmentIndex]) {
+            // frames are scanned conservatively like native stack
+            m_frameSegments[frameSegmentIndex] = (InterpretedCallFrame*)GC_MALLOC(sizeof(InterpretedCallFrame) * INTERPRETER_CALL_FRAME_SEGMENT_SIZE);
+        }
+    }
+
+    if (UNLIKELY(!m_registerStackTop)) {
+        ASSERT(m_registerSegmentIndex == 0);
+        switchRegisterSegment(0);
+        m_registerStackTop = m_registerSegments[0];
+        m_registerStackUsedEnd = m_registerStackTop;
+    }
+
+    if ((size_t)(m_registerStackEnd - m_registerStackTop) < registerFileSize) {
+        if (registerFileSize > INTERPRETER_REGISTER_STACK_SEGMENT_SIZE || m_registerSegmentIndex + 1 == RegisterSegmentCount) {
+            return false;
+        }
+        switchRegisterSegment(m_registerSegmentIndex + 1);
+        m_registerStackTop = m_registerSegments[m_registerSegmentIndex];
+        m_registerStackUsedEnd = m_registerStackTop;
+    }
+    return true;
+}
+
+void InterpreterStack::switchRegisterSegment(size_t index)
+{
+    ASSERT(index < RegisterSegmentCount);
+    if (!m_registerSegments[index]) {
+        // register files are scanned conservatively like native stack
+        m_registerSegments[index] = (Value*)GC_MALLOC(sizeof(Value) * INTERPRETER_REGISTER_STACK_SEGMENT_SIZE);
+    }
+    m_registerSegmentIndex = index;
+    m_registerStackEnd = m_registerSegments[index] + INTERPRETER_REGISTER_STACK_SEGMENT_SIZE;
+    // we don't know how much of segment was used before
+    m_registerStackUsedEnd = m_registerStackEnd;
+}
+
+void InterpreterStack::clearUnusedArea()
+{
+    if (!m_registerStackTop) {
+        return;
+    }
+
+    // popped frames keep literal data for next call. we give up that here
+    memset(m_registerStackTop, 0, sizeof(Value) * (m_registerStackUsedEnd - m_registerStackTop));
+    m_registerStackUsedEnd = m_registerStackTop;
+    for (size_t i = m_registerSegmentIndex + 1; i < RegisterSegmentCount; i++) {
+        m_registerSegments[i] = nullptr;
+    }
+
+    // frame segments from the one holding next frame are kept. remaining ones are released
+    size_t keepFrameSegmentCount = (m_frameCount + INTERPRETER_CALL_FRAME_SEGMENT_SIZE - 1) / INTERPRETER_CALL_FRAME_SEGMENT_SIZE;
+    if (m_frameCount % INTERPRETER_CALL_FRAME_SEGMENT_SIZE) {
+        size_t usedEnd = std::min(m_frameUsedCount, keepFrameSegmentCount * INTERPRETER_CALL_FRAME_SEGMENT_SIZE);
+        InterpretedCallFrame* segment = m_frameSegments[m_frameCount / INTERPRETER_CALL_FRAME_SEGMENT_SIZE];
+        memset(&segment[m_frameCount % INTERPRETER_CALL_FRAME_SEGMENT_SIZE], 0, sizeof(InterpretedCallFrame) * (usedEnd - m_frameCount));
+    }
+    for (size_t i = keepFrameSegmentCount; i < FrameSegmentCount; i++) {
+        m_frameSegments[i] = nullptr;
+    }
+    m_frameUsedCount = m_frameCount;
+}
+}
@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2020-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#ifndef __EscargotInterpreterStack__
+#define __EscargotInterpreterStack__
+
+// don't include this file in headers. VMInstance.h only has forward declaration of InterpreterStack
+#include "runtime/ExecutionState.h"
+#include "runtime/Environment.h"
+#include "runtime/EnvironmentRecord.h"
+#include "runtime/SamplingProfiler.h"
+
+namespace Escargot {
+
+class ByteCodeBlock;
+
+// Frame of script function call which interpreter runs without native recursion
+struct InterpretedCallFrame {
+    // caller context. these are restored when callee returns
+    ExecutionState* m_callerState;
+    ByteCodeBlock* m_callerByteCodeBlock;
+    Value* m_callerRegisterFile;
+    // address of call instruction. stack trace of caller reads this while callee runs
+    size_t m_callerProgramCounter;
+    size_t m_callInstructionSize;
+    ByteCodeRegisterIndex m_resultIndex;
+
+    // register file of callee starts at top of register stack
+    Value* m_registerFile;
+    // numeral literals of this block are stored in register file
+    // they are not copied again if same block is called on same register file
+    ByteCodeBlock* m_byteCodeBlock;
+    // segment of register stack which register file belongs to
+    size_t m_registerSegmentIndex;
+    InterpreterFrame m_interpreterFrame;
+
+    std::aligned_storage<sizeof(ExecutionState), alignof(ExecutionState)>::type m_state;
+    std::aligned_storage<sizeof(FunctionEnvironmentRecordOnStack<false, false>), alignof(FunctionEnvironmentRecordOnStack<false, false>)>::type m_record;
+    std::aligned_storage<sizeof(LexicalEnvironment), alignof(LexicalEnvironment)>::type m_lexicalEnvironment;
+};
+
+// Stack of register files and frames for calls between script functions
+// Interpreter pushes frame on call and pops frame on return in same interpret function,
+// so deep calls don't consume native stack.
+// Memory is allocated by segments as calls get deeper, and scanned conservatively by GC.
+// Segments are never moved because frames and interpreter hold pointers into them.
+// A register file never spans two segments
+class InterpreterStack : public gc {
+public:
+    InterpreterStack()
+        : m_registerStackTop(nullptr)
+        , m_registerStackEnd(nullptr)
+        , m_registerStackUsedEnd(nullptr)
+        , m_registerSegmentIndex(0)
+        , m_frameCount(0)
+        , m_frameUsedCount(0)
+    {
+        memset(m_registerSegments, 0, sizeof(m_registerSegments));
+        memset(m_frameSegments, 0, sizeof(m_frameSegments));
+    }
+
+    size_t frameCount()
+    {
+        return m_frameCount;
+    }
+
+    InterpretedCallFrame& frameAt(size_t index)
+    {
+        ASSERT(index < m_frameCount);
+        return m_frameSegments[index / INTERPRETER_CALL_FRAME_SEGMENT_SIZE][index % INTERPRETER_CALL_FRAME_SEGMENT_SIZE];
+    }
+
+    InterpretedCallFrame& topFrame()
+    {
+        ASSERT(m_frameCount);
+        return frameAt(m_frameCount - 1);
+    }
+
+    // returns nullptr if stack is full
+    ALWAYS_INLINE InterpretedCallFrame* pushFrame(size_t registerFileSize)
+    {
+        if (UNLIKELY(m_frameCount % INTERPRETER_CALL_FRAME_SEGMENT_SIZE == 0 || (size_t)(m_registerStackEnd - m_registerStackTop) < registerFileSize)) {
+            if (!ensureSegments(registerFileSize)) {
+                return nullptr;
+            }
+        }
+
+        InterpretedCallFrame* frame = &m_frameSegments[m_frameCount / INTERPRETER_CALL_FRAME_SEGMENT_SIZE][m_frameCount % INTERPRETER_CALL_FRAME_SEGMENT_SIZE];
+        if (frame->m_registerFile != m_registerStackTop) {
+            frame->m_registerFile = m_registerStackTop;
+            frame->m_byteCodeBlock = nullptr;
+        }
+        frame->m_registerSegmentIndex = m_registerSegmentIndex;
+        m_frameCount++;
+        m_frameUsedCount = std::max(m_frameUsedCount, m_frameCount);
+        m_registerStackTop += registerFileSize;
+        m_registerStackUsedEnd = std::max(m_registerStackUsedEnd, m_registerStackTop);
+        return frame;
+    }
+
+    // caller should copy numeral literals of byteCodeBlock into register file of frame before calling this
+    // register file of frame can be overlapped with register file of next frame used before,
+    // so literal data of next frame is not valid anymore
+    ALWAYS_INLINE void setLiteralDataOwner(InterpretedCallFrame* frame, ByteCodeBlock* byteCodeBlock)
+    {
+        ASSERT(frame == &topFrame());
+        frame->m_byteCodeBlock = byteCodeBlock;
+        if (m_frameCount < m_frameUsedCount) {
+            m_frameSegments[m_frameCount / INTERPRETER_CALL_FRAME_SEGMENT_SIZE][m_frameCount % INTERPRETER_CALL_FRAME_SEGMENT_SIZE].m_byteCodeBlock = nullptr;
+        }
+    }
+
+    ALWAYS_INLINE void popFrame()
+    {
+        ASSERT(m_frameCount);
+        m_frameCount--;
+        InterpretedCallFrame& frame = m_frameSegments[m_frameCount / INTERPRETER_CALL_FRAME_SEGMENT_SIZE][m_frameCount % INTERPRETER_CALL_FRAME_SEGMENT_SIZE];
+        m_registerStackTop = frame.m_registerFile;
+        if (UNLIKELY(frame.m_registerSegmentIndex != m_registerSegmentIndex)) {
+            switchRegisterSegment(frame.m_registerSegmentIndex);
+        }
+    }
+
+    // pops frames which are left by exception
+    void unwindTo(size_t frameCount)
+    {
+        ASSERT(frameCount <= m_frameCount);
+        while (m_frameCount > frameCount) {
+            popFrame();
+        }
+    }
+
+    // clears unused area before marking for not keeping garbage alive
+    // segments above the top are released
+    void clearUnusedArea();
+
+private:
+    static const size_t RegisterSegmentCount = INTERPRETER_REGISTER_STACK_SIZE / INTERPRETER_REGISTER_STACK_SEGMENT_SIZE;
+    static const size_t FrameSegmentCount = INTERPRETER_CALL_FRAME_STACK_SIZE / INTERPRETER_CALL_FRAME_SEGMENT_SIZE;
+
+    // allocates frame segment for next frame, and moves to next register segment if register file doesn't fit
+    // returns false if stack is full
+    bool ensureSegments(size_t registerFileSize);
+    // sets register segment at `index` to current segment. register stack top should be set by caller
+    void switchRegisterSegment(size_t index);
+
+    Value* m_registerStackTop;
+    // end of current register segment
+    Value* m_registerStackEnd;
+    // end of used area in current register segment
+    Value* m_registerStackUsedEnd;
+    size_t m_registerSegmentIndex;
+    Value* m_registerSegments[RegisterSegmentCount];
+    InterpretedCallFrame* m_frameSegments[FrameSegmentCount];
+    size_t m_frameCount;
+    size_t m_frameUsedCount;
+};
+}
+
+#endif
@@ -21,6 +21,7 @@
 #define __EscargotASTBuilder__
 
 #include "parser/ParserStringView.h"
+#include "parser/ASTConstantFolder.h"
 
 namespace Escargot {
 
@@ -602,8 +603,9 @@ public:
 
     MAKE_STACK_ALLOCATED();
 
-    NodeGenerator(ASTAllocator& allocator)
+    NodeGenerator(ASTAllocator& allocator, Context* context)
         : m_allocator(allocator)
+        , m_context(context)
     {
     }
 
@@ -653,6 +655,20 @@ public:
     FOR_EACH_TARGET_NODE(DECLARE_CREATE_FUNCTION)
 #undef DECLARE_CREATE_FUNCTION
 
+    // non-template overloads are preferred to create functions above
+    // operation on constant operands is replaced with literal
+#define DECLARE_FOLDING_CREATE_FUNCTION(name)                                                            \
+    Node* create##name##Node(Node* left, Node* right)                                                    \
+    {                                                                                                    \
+        Value result;                                                                                    \
+        if (ASTConstantFolder::foldBinaryExpression(m_context, ASTNodeType::name, left, right, result)) { \
+            return new (m_allocator) LiteralNode(result);                                                \
+        }                                                                                                \
+        return new (m_allocator) name##Node(left, right);                                                \
+    }
+    FOR_EACH_FOLDABLE_BINARY_NODE(DECLARE_FOLDING_CREATE_FUNCTION)
+#undef DECLARE_FOLDING_CREATE_FUNCTION
+
     Node* reinterpretExpressionAsPattern(Node* expr)
     {
         Node* result = expr;
@@ -776,6 +792,7 @@ public:
 
 private:
     ASTAllocator& m_allocator;
+    Context* m_context;
 };
 
 } // Escargot
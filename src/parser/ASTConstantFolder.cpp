@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) 2020-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#include "Escargot.h"
+#include "ASTConstantFolder.h"
+#include "interpreter/ByteCode.h"
+#include "interpreter/ByteCodeGenerator.h"
+#include "interpreter/ByteCodeInterpreter.h"
+#include "parser/ast/AST.h"
+#include "runtime/Context.h"
+
+namespace Escargot {
+
+bool ASTConstantFolder::constantValue(Context* context, Node* node, Value& result)
+{
+    switch (node->type()) {
+    case ASTNodeType::Literal:
+        result = node->asLiteral()->value();
+        // literal should be primitive value
+        return !result.isPointerValue() || result.isString();
+    case ASTNodeType::UnaryExpressionMinus:
+    case ASTNodeType::UnaryExpressionPlus:
+    case ASTNodeType::UnaryExpressionBitwiseNot:
+    case ASTNodeType::UnaryExpressionLogicalNot: {
+        Value argument;
+        Node* argumentNode;
+        if (node->type() == ASTNodeType::UnaryExpressionMinus) {
+            argumentNode = ((UnaryExpressionMinusNode*)node)->argument();
+        } else if (node->type() == ASTNodeType::UnaryExpressionPlus) {
+            argumentNode = ((UnaryExpressionPlusNode*)node)->argument();
+        } else if (node->type() == ASTNodeType::UnaryExpressionBitwiseNot) {
+            argumentNode = ((UnaryExpressionBitwiseNotNode*)node)->argument();
+        } else {
+            argumentNode = ((UnaryExpressionLogicalNotNode*)node)->argument();
+        }
+        if (!constantValue(context, argumentNode, argument)) {
+            return false;
+        }
+
+        ExecutionState state(context);
+        if (node->type() == ASTNodeType::UnaryExpressionMinus) {
+            result = Value(-argument.toNumber(state));
+        } else if (node->type() == ASTNodeType::UnaryExpressionPlus) {
+            result = Value(argument.toNumber(state));
+        } else if (node->type() == ASTNodeType::UnaryExpressionBitwiseNot) {
+            result = Value(~argument.toInt32(state));
+        } else {
+            result = Value(!argument.toBoolean(state));
+        }
+        return true;
+    }
+    default:
+        return false;
+    }
+}
+
+bool ASTConstantFolder::foldBinaryExpression(Context* context, ASTNodeType type, Node* left, Node* right, Value& result)
+{
+    Value lval;
+    Value rval;
+    if (!constantValue(context, left, lval) || !constantValue(context, right, rval)) {
+        return false;
+    }
+
+    ExecutionState state(context);
+    switch (type) {
+    case ASTNodeType::BinaryExpressionPlus:
+        if (lval.isString() || rval.isString()) {
+            // string length limit error should be thrown on runtime
+            size_t length = lval.toString(state)->length() + rval.toString(state)->length();
+            if (length > STRING_MAXIMUM_LENGTH) {
+                return false;
+            }
+        }
+        result = ByteCodeInterpreter::plusSlowCase(state, lval, rval);
+        return true;
+    case ASTNodeType::BinaryExpressionMinus:
+        result = Value(lval.toNumber(state) - rval.toNumber(state));
+        return true;
+    case ASTNodeType::BinaryExpressionMultiply:
+        result = Value(lval.toNumber(state) * rval.toNumber(state));
+        return true;
+    case ASTNodeType::BinaryExpressionDivision:
+        result = Value(lval.toNumber(state) / rval.toNumber(state));
+        return true;
+    case ASTNodeType::BinaryExpressionMod:
+        result = ByteCodeInterpreter::modOperation(state, lval, rval);
+        return true;
+    case ASTNodeType::BinaryExpressionExponentiation:
+        result = ByteCodeInterpreter::exponentialOperation(state, lval, rval);
+        return true;
+    case ASTNodeType::BinaryExpressionBitwiseAnd:
+        result = Value(lval.toInt32(state) & rval.toInt32(state));
+        return true;
+    case ASTNodeType::BinaryExpressionBitwiseOr:
+        result = Value(lval.toInt32(state) | rval.toInt32(state));
+        return true;
+    case ASTNodeType::BinaryExpressionBitwiseXor:
+        result = Value(lval.toInt32(state) ^ rval.toInt32(state));
+        return true;
+    case ASTNodeType::BinaryExpressionLeftShift: {
+        int32_t lnum = lval.toInt32(state);
+        int32_t rnum = rval.toInt32(state);
+        lnum <<= ((unsigned int)rnum) & 0x1F;
+        result = Value(lnum);
+        return true;
+    }
+    case ASTNodeType::BinaryExpressionSignedRightShift: {
+        int32_t lnum = lval.toInt32(state);
+        int32_t rnum = rval.toInt32(state);
+        lnum >>= ((unsigned int)rnum) & 0x1F;
+        result = Value(lnum);
+        return true;
+    }
+    case ASTNodeType::BinaryExpressionUnsignedRightShift: {
+        uint32_t lnum = lval.toUint32(state);
+        uint32_t rnum = rval.toUint32(state);
+        lnum = (lnum) >> ((rnum)&0x1F);
+        result = Value(lnum);
+        return true;
+    }
+    case ASTNodeType::BinaryExpressionLessThan:
+        result = Value(ByteCodeInterpreter::abstractRelationalComparison(state, lval, rval, true));
+        return true;
+    case ASTNodeType::BinaryExpressionLessThanOrEqual:
+        result = Value(ByteCodeInterpreter::abstractRelationalComparisonOrEqual(state, lval, rval, true));
+        return true;
+    case ASTNodeType::BinaryExpressionGreaterThan:
+        result = Value(ByteCodeInterpreter::abstractRelationalComparison(state, rval, lval, false));
+        return true;
+    case ASTNodeType::BinaryExpressionGreaterThanOrEqual:
+        result = Value(ByteCodeInterpreter::abstractRelationalComparisonOrEqual(state, rval, lval, false));
+        return true;
+    case ASTNodeType::BinaryExpressionEqual:
+        result = Value(lval.abstractEqualsTo(state, rval));
+        return true;
+    case ASTNodeType::BinaryExpressionNotEqual:
+        result = Value(!lval.abstractEqualsTo(state, rval));
+        return true;
+    case ASTNodeType::BinaryExpressionStrictEqual:
+        result = Value(lval.equalsTo(state, rval));
+        return true;
+    case ASTNodeType::BinaryExpressionNotStrictEqual:
+        result = Value(!lval.equalsTo(state, rval));
+        return true;
+    case ASTNodeType::BinaryExpressionLogicalAnd:
+        result = lval.toBoolean(state) ? rval : lval;
+        return true;
+    case ASTNodeType::BinaryExpressionLogicalOr:
+        result = lval.toBoolean(state) ? lval : rval;
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool ASTConstantFolder::evaluateCondition(Context* context, Node* node, bool& result)
+{
+    Value value;
+    if (!constantValue(context, node, value)) {
+        return false;
+    }
+
+    ExecutionState state(context);
+    result = value.toBoolean(state);
+    return true;
+}
+}
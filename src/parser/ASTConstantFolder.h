@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2020-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#ifndef __EscargotASTConstantFolder__
+#define __EscargotASTConstantFolder__
+
+#include "parser/ast/Node.h"
+
+namespace Escargot {
+
+class Context;
+
+// binary operators which are evaluated by NodeGenerator when both operands are constant
+#define FOR_EACH_FOLDABLE_BINARY_NODE(F)  \
+    F(BinaryExpressionBitwiseAnd)         \
+    F(BinaryExpressionBitwiseOr)          \
+    F(BinaryExpressionBitwiseXor)         \
+    F(BinaryExpressionDivision)           \
+    F(BinaryExpressionEqual)              \
+    F(BinaryExpressionExponentiation)     \
+    F(BinaryExpressionGreaterThan)        \
+    F(BinaryExpressionGreaterThanOrEqual) \
+    F(BinaryExpressionLeftShift)          \
+    F(BinaryExpressionLessThan)           \
+    F(BinaryExpressionLessThanOrEqual)    \
+    F(BinaryExpressionLogicalAnd)         \
+    F(BinaryExpressionLogicalOr)          \
+    F(BinaryExpressionMinus)              \
+    F(BinaryExpressionMod)                \
+    F(BinaryExpressionMultiply)           \
+    F(BinaryExpressionNotEqual)           \
+    F(BinaryExpressionNotStrictEqual)     \
+    F(BinaryExpressionPlus)               \
+    F(BinaryExpressionSignedRightShift)   \
+    F(BinaryExpressionStrictEqual)        \
+    F(BinaryExpressionUnsignedRightShift)
+
+// Constant folding on AST
+// Operands are constant when they are literals or unary operations on literals.
+// Literals are always primitive values, so folding never calls user code.
+// Results are computed by operations of interpreter to get the same value as runtime.
+class ASTConstantFolder {
+public:
+    // returns true and stores value of operation if it can be evaluated on parsing time
+    static bool foldBinaryExpression(Context* context, ASTNodeType type, Node* left, Node* right, Value& result);
+
+    // returns true and stores ToBoolean result if node is constant
+    // used for removing unreachable branches on generating bytecode
+    static bool evaluateCondition(Context* context, Node* node, bool& result);
+
+private:
+    static bool constantValue(Context* context, Node* node, Value& result);
+};
+}
+
+#endif
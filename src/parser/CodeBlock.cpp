@@ -32,8 +32,8 @@ void* CodeBlock::operator new(size_t size)
 #ifdef GC_DEBUG
     return CustomAllocator<CodeBlock>().allocate(1);
 #else
-    static bool typeInited = false;
-    static GC_descr descr;
+    static std::atomic<bool> typeInited(false);
+    static std::atomic<GC_descr> descr;
     if (!typeInited) {
         GC_word obj_bitmap[GC_BITMAP_SIZE(CodeBlock)] = { 0 };
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(CodeBlock, m_context));
@@ -50,8 +50,8 @@ void* InterpretedCodeBlock::operator new(size_t size)
 #ifdef GC_DEBUG
     return CustomAllocator<InterpretedCodeBlock>().allocate(1);
 #else
-    static bool typeInited = false;
-    static GC_descr descr;
+    static std::atomic<bool> typeInited(false);
+    static std::atomic<GC_descr> descr;
     if (!typeInited) {
         GC_word obj_bitmap[GC_BITMAP_SIZE(InterpretedCodeBlock)] = { 0 };
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(InterpretedCodeBlock, m_context));
@@ -73,8 +73,8 @@ void* InterpretedCodeBlock::operator new(size_t size)
 
 void* InterpretedCodeBlock::BlockInfo::operator new(size_t size)
 {
-    static bool typeInited = false;
-    static GC_descr descr;
+    static std::atomic<bool> typeInited(false);
+    static std::atomic<GC_descr> descr;
     if (!typeInited) {
         GC_word obj_bitmap[GC_BITMAP_SIZE(InterpretedCodeBlock::BlockInfo)] = { 0 };
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(InterpretedCodeBlock::BlockInfo, m_identifiers));
@@ -432,37 +432,53 @@ void InterpretedCodeBlock::markHeapAllocatedEnvironmentFromHere(LexicalBlockInde
     InterpretedCodeBlock* c = this;
 
     while (c) {
-        InterpretedCodeBlock::BlockInfo* bi = nullptr;
-        for (size_t i = 0; i < c->m_blockInfos.size(); i++) {
-            if (c->m_blockInfos[i]->m_blockIndex == blockIndex) {
-                bi = c->m_blockInfos[i];
-                break;
-            }
+        c->markHeapAllocatedBlocksFromHere(blockIndex);
+        c->m_canAllocateEnvironmentOnStack = false;
+        blockIndex = c->lexicalBlockIndexFunctionLocatedIn();
+
+        if (c == to) {
+            return;
         }
 
-        while (bi && bi->m_canAllocateEnvironmentOnStack) {
-            bi->m_canAllocateEnvironmentOnStack = false;
+        c = c->parentCodeBlock();
+    }
+}
 
-            if (bi->m_parentBlockIndex == LEXICAL_BLOCK_INDEX_MAX) {
-                break;
-            }
+// captured `let` declared variable lives in heap allocated block environment.
+// function environment can stay on stack because outer environment of heap allocated block environment skips it.
+// class constructor is excluded because LoadThisBinding looks for function environment through environment chain
+void InterpretedCodeBlock::markHeapAllocatedBlockEnvironmentFromHere(LexicalBlockIndex blockIndex)
+{
+    if (!isKindOfFunction() || isClassConstructor()) {
+        markHeapAllocatedEnvironmentFromHere(blockIndex, this);
+        return;
+    }
+    markHeapAllocatedBlocksFromHere(blockIndex);
+}
 
-            for (size_t i = 0; i < c->m_blockInfos.size(); i++) {
-                if (c->m_blockInfos[i]->m_blockIndex == bi->m_parentBlockIndex) {
-                    bi = c->m_blockInfos[i];
-                    break;
-                }
-            }
+void InterpretedCodeBlock::markHeapAllocatedBlocksFromHere(LexicalBlockIndex blockIndex)
+{
+    InterpretedCodeBlock::BlockInfo* bi = nullptr;
+    for (size_t i = 0; i < m_blockInfos.size(); i++) {
+        if (m_blockInfos[i]->m_blockIndex == blockIndex) {
+            bi = m_blockInfos[i];
+            break;
         }
+    }
 
-        c->m_canAllocateEnvironmentOnStack = false;
-        blockIndex = c->lexicalBlockIndexFunctionLocatedIn();
+    while (bi && bi->m_canAllocateEnvironmentOnStack) {
+        bi->m_canAllocateEnvironmentOnStack = false;
 
-        if (c == to) {
-            return;
+        if (bi->m_parentBlockIndex == LEXICAL_BLOCK_INDEX_MAX) {
+            break;
         }
 
-        c = c->parentCodeBlock();
+        for (size_t i = 0; i < m_blockInfos.size(); i++) {
+            if (m_blockInfos[i]->m_blockIndex == bi->m_parentBlockIndex) {
+                bi = m_blockInfos[i];
+                break;
+            }
+        }
     }
 }
 
@@ -802,7 +818,8 @@ InterpretedCodeBlock::IndexedIdentifierInfo InterpretedCodeBlock::indexedIdentif
         }
 
         if (blk == this) {
-            upperIndex += 1;
+            // function environment on stack is not in chain of heap allocated block environment
+            upperIndex += (blk->isKindOfFunction() && blk->canAllocateEnvironmentOnStack() && upperIndex) ? 0 : 1;
         } else {
             upperIndex += !blk->canAllocateEnvironmentOnStack();
         }
@@ -720,6 +720,7 @@ public:
     }
 
     void markHeapAllocatedEnvironmentFromHere(LexicalBlockIndex blockIndex = 0, InterpretedCodeBlock* to = nullptr);
+    void markHeapAllocatedBlockEnvironmentFromHere(LexicalBlockIndex blockIndex);
 
     void* operator new(size_t size);
     void* operator new[](size_t size) = delete;
@@ -730,6 +731,7 @@ protected:
     // init function codeBlock
     InterpretedCodeBlock(Context* ctx, Script* script, StringView src, ASTFunctionScopeContext* scopeCtx, ExtendedNodeLOC sourceElementStart, InterpretedCodeBlock* parentBlock, bool isEvalCode, bool isEvalCodeInFunction);
 
+    void markHeapAllocatedBlocksFromHere(LexicalBlockIndex blockIndex);
     void computeBlockVariables(LexicalBlockIndex currentBlockIndex, size_t currentStackAllocatedVariableIndex, size_t& maxStackAllocatedVariableDepth);
     void initBlockScopeInformation(ASTFunctionScopeContext* scopeCtx);
 
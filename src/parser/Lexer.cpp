@@ -681,6 +681,7 @@ Scanner::Scanner(::Escargot::Context* escargotContext, StringView code, size_t s
 
 void Scanner::skipSingleLineComment(void)
 {
+    this->skipPlainCharacters<StringKernels::countNonLineTerminatorPrefix, StringKernels::countNonLineTerminatorPrefix>();
     while (!this->eof()) {
         char16_t ch = this->peekCharWithoutEOF();
         ++this->index;
@@ -699,7 +700,11 @@ void Scanner::skipSingleLineComment(void)
 
 void Scanner::skipMultiLineComment(void)
 {
-    while (!this->eof()) {
+    while (true) {
+        this->skipPlainCharacters<StringKernels::countMultiLineCommentPlainPrefix, StringKernels::countMultiLineCommentPlainPrefix>();
+        if (this->eof()) {
+            break;
+        }
         char16_t ch = this->peekCharWithoutEOF();
         ++this->index;
 
@@ -766,6 +771,8 @@ Scanner::ScanIDResult Scanner::getIdentifier()
 {
     const size_t start = this->index;
     ++this->index;
+    // ASCII identifier parts are consumed by vector, rest of characters goes on below
+    this->skipPlainCharacters<StringKernels::countASCIIIdentifierPartPrefix, StringKernels::countASCIIIdentifierPartPrefix>();
     while (UNLIKELY(!this->eof())) {
         const char16_t ch = this->peekCharWithoutEOF();
         if (UNLIKELY(ch == 0x5C)) {
@@ -1339,7 +1346,11 @@ void Scanner::scanStringLiteral(Scanner::ScannerResult* token)
     bool octal = false;
     bool isPlainCase = true;
 
-    while (LIKELY(!this->eof())) {
+    while (true) {
+        this->skipStringLiteralPlainCharacters(quote);
+        if (UNLIKELY(this->eof())) {
+            break;
+        }
         char16_t ch = this->peekCharWithoutEOF();
         ++this->index;
         if (ch == quote) {
@@ -22,6 +22,7 @@
 
 #include "parser/esprima_cpp/esprima.h"
 #include "parser/ParserStringView.h"
+#include "util/StringKernels.h"
 
 namespace Escargot {
 
@@ -509,6 +510,10 @@ public:
 
             if (isWhiteSpace(ch)) {
                 ++this->index;
+                if (!this->eof() && (this->sourceCharAt(this->index) == ' ' || this->sourceCharAt(this->index) == '\t')) {
+                    // indentation
+                    this->skipPlainCharacters<StringKernels::countSpaceOrTabPrefix, StringKernels::countSpaceOrTabPrefix>();
+                }
             } else if (isLineTerminator(ch)) {
                 ++this->index;
                 if (ch == 0x0D && this->sourceCharAt(this->index) == 0x0A) {
@@ -657,6 +662,31 @@ private:
         return UNLIKELY(this->eof()) ? 0 : this->sourceCharAt(this->index);
     }
 
+    // skips characters which kernel doesn't stop at
+    // width of source is checked once per run, then kernel scans raw buffer by vector
+    template <size_t (*kernel8)(const LChar*, size_t), size_t (*kernel16)(const char16_t*, size_t)>
+    ALWAYS_INLINE void skipPlainCharacters()
+    {
+        ASSERT(this->index <= this->length);
+        size_t remain = this->length - this->index;
+        if (sourceCodeAccessData.has8BitContent) {
+            this->index += kernel8(((const LChar*)sourceCodeAccessData.bufferAs8Bit) + this->index, remain);
+        } else {
+            this->index += kernel16(sourceCodeAccessData.bufferAs16Bit + this->index, remain);
+        }
+    }
+
+    ALWAYS_INLINE void skipStringLiteralPlainCharacters(char16_t quote)
+    {
+        ASSERT(this->index <= this->length);
+        size_t remain = this->length - this->index;
+        if (sourceCodeAccessData.has8BitContent) {
+            this->index += StringKernels::countStringLiteralPlainPrefix(((const LChar*)sourceCodeAccessData.bufferAs8Bit) + this->index, remain, quote);
+        } else {
+            this->index += StringKernels::countStringLiteralPlainPrefix(sourceCodeAccessData.bufferAs16Bit + this->index, remain, quote);
+        }
+    }
+
     char32_t scanHexEscape(char prefix);
     char32_t scanUnicodeCodePointEscape();
 
@@ -71,36 +71,53 @@ static void registerToLoadedModuleIfNeeds(Context* context, Optional<Script*> re
 
 void Script::loadExternalModule(ExecutionState& state)
 {
-    for (size_t i = 0; i < m_moduleData->m_importEntries.size(); i++) {
-        bool loaded = findLoadedModule(context(), this, m_moduleData->m_importEntries[i].m_moduleRequest).hasValue();
-        if (!loaded) {
-            loadModuleFromScript(state, m_moduleData->m_importEntries[i].m_moduleRequest);
-        }
-    }
+    // module graph is collected breadth-first
+    // so platform can load every module of one level at once (e.g. reading files concurrently)
+    typedef Vector<Script*, GCUtil::gc_malloc_allocator<Script*>> ScriptVector;
+    ScriptVector currentLevel;
+    currentLevel.push_back(this);
+
+    while (currentLevel.size()) {
+        Platform::ModuleRequestVector requests;
+        for (size_t i = 0; i < currentLevel.size(); i++) {
+            Script* script = currentLevel[i];
+            size_t length = script->moduleRequestsLength();
+            for (size_t j = 0; j < length; j++) {
+                String* src = script->moduleRequest(j);
+                if (findLoadedModule(context(), script, src)) {
+                    continue;
+                }
 
-    for (size_t i = 0; i < m_moduleData->m_indirectExportEntries.size(); i++) {
-        bool loaded = findLoadedModule(context(), this, m_moduleData->m_indirectExportEntries[i].m_moduleRequest.value()).hasValue();
-        if (!loaded) {
-            loadModuleFromScript(state, m_moduleData->m_indirectExportEntries[i].m_moduleRequest.value());
+                bool requested = false;
+                for (size_t k = 0; k < requests.size(); k++) {
+                    if (requests[k].whereRequestFrom == script && requests[k].moduleSrc->equals(src)) {
+                        requested = true;
+                        break;
+                    }
+                }
+                if (!requested) {
+                    requests.push_back(Platform::ModuleRequest({ script, src }));
+                }
+            }
         }
-    }
 
-    for (size_t i = 0; i < m_moduleData->m_starExportEntries.size(); i++) {
-        bool loaded = findLoadedModule(context(), this, m_moduleData->m_starExportEntries[i].m_moduleRequest.value()).hasValue();
-        if (!loaded) {
-            loadModuleFromScript(state, m_moduleData->m_starExportEntries[i].m_moduleRequest.value());
+        if (!requests.size()) {
+            break;
         }
-    }
-}
 
-void Script::loadModuleFromScript(ExecutionState& state, String* src)
-{
-    Platform::LoadModuleResult result = context()->vmInstance()->platform()->onLoadModule(context(), this, src);
-    if (!result.script) {
-        ErrorObject::throwBuiltinError(state, (ErrorObject::Code)result.errorCode, result.errorMessage->toNonGCUTF8StringData().data());
+        Platform::LoadModuleResultVector results = context()->vmInstance()->platform()->onLoadModules(context(), requests);
+        ASSERT(results.size() == requests.size());
+
+        ScriptVector nextLevel;
+        for (size_t i = 0; i < results.size(); i++) {
+            if (!results[i].script) {
+                ErrorObject::throwBuiltinError(state, (ErrorObject::Code)results[i].errorCode, results[i].errorMessage->toNonGCUTF8StringData().data());
+            }
+            registerToLoadedModuleIfNeeds(context(), requests[i].whereRequestFrom, requests[i].moduleSrc, results[i].script.value());
+            nextLevel.push_back(results[i].script.value());
+        }
+        currentLevel = nextLevel;
     }
-    registerToLoadedModuleIfNeeds(context(), this, src, result.script.value());
-    result.script->loadExternalModule(state);
 }
 
 size_t Script::moduleRequestsLength()
@@ -153,7 +153,7 @@ InterpretedCodeBlock* ScriptParser::generateCodeBlockTreeFromASTWalker(Context*
                                         c->markHeapAllocatedEnvironmentFromHere(LEXICAL_BLOCK_INDEX_MAX, c);
                                     } else {
                                         // captured variable is `let` declared variable
-                                        c->markHeapAllocatedEnvironmentFromHere(r.second, c);
+                                        c->markHeapAllocatedBlockEnvironmentFromHere(r.second);
                                     }
                                 }
                                 break;
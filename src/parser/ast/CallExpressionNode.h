@@ -94,6 +94,23 @@ public:
         return std::make_pair(REGISTER_LIMIT, false);
     }
 
+    ByteCodeRegisterIndex lazyArgumentsObjectRegisterForApply(ByteCodeGenerateContext* context)
+    {
+        ASSERT(m_callee->isMemberExpression());
+        MemberExpressionNode* callee = (MemberExpressionNode*)m_callee;
+        if (context->m_lazyArgumentsObjectIndex == REGISTER_LIMIT || m_arguments.size() != 2 || !callee->isPreComputedCase() || callee->object()->isSuperExpression()
+            || callee->propertyName() != context->m_codeBlock->context()->staticStrings().apply) {
+            return REGISTER_LIMIT;
+        }
+
+        Node* thisArgument = m_arguments.begin()->astNode();
+        Node* argumentsObject = m_arguments.begin()->next()->astNode();
+        if (thisArgument->type() == ASTNodeType::SpreadElement || !argumentsObject->isIdentifier()) {
+            return REGISTER_LIMIT;
+        }
+        return argumentsObject->asIdentifier()->lazyArgumentsObjectRegister(context);
+    }
+
     static bool canUseDirectRegister(ByteCodeGenerateContext* context, Node* callee, const NodeList& args)
     {
         if (!context->m_canSkipCopyToRegister) {
@@ -192,6 +209,26 @@ public:
             }
         }
 
+        ByteCodeRegisterIndex lazyArgumentsIndex = isCalleeHasReceiver ? lazyArgumentsObjectRegisterForApply(context) : REGISTER_LIMIT;
+        if (lazyArgumentsIndex != REGISTER_LIMIT) {
+            // receiver.apply(thisArg, arguments)
+            context->m_inCallingExpressionScope = false;
+            Node* thisArgument = m_arguments.begin()->astNode();
+            ByteCodeRegisterIndex thisArgumentIndex = thisArgument->getRegister(codeBlock, context);
+            thisArgument->generateExpressionByteCode(codeBlock, context, thisArgumentIndex);
+            context->giveUpRegister();
+
+            // drop callee, receiver registers
+            context->giveUpRegister();
+            context->giveUpRegister();
+
+            codeBlock->pushCode(CallFunctionForwardingArguments(ByteCodeLOC(m_loc.index), receiverIndex, calleeIndex, thisArgumentIndex, lazyArgumentsIndex, dstRegister), context, this);
+
+            context->m_inCallingExpressionScope = prevInCallingExpressionScope;
+            context->m_canSkipCopyToRegister = directBefore;
+            return;
+        }
+
         auto args = generateArguments(codeBlock, context);
         ByteCodeRegisterIndex argumentsStartIndex = args.first;
         bool hasSpreadElement = args.second;
@@ -21,6 +21,7 @@
 #define ConditionalExpressionNode_h
 
 #include "ExpressionNode.h"
+#include "parser/ASTConstantFolder.h"
 
 namespace Escargot {
 
@@ -37,6 +38,17 @@ public:
     virtual ASTNodeType type() override { return ASTNodeType::ConditionalExpression; }
     virtual void generateExpressionByteCode(ByteCodeBlock* codeBlock, ByteCodeGenerateContext* context, ByteCodeRegisterIndex dstRegister) override
     {
+        bool testResult;
+        if (ASTConstantFolder::evaluateCondition(codeBlock->m_codeBlock->context(), m_test, testResult)) {
+            // unreachable branch is not generated
+            if (testResult) {
+                m_consequente->generateExpressionByteCode(codeBlock, context, dstRegister);
+            } else {
+                m_alternate->generateExpressionByteCode(codeBlock, context, dstRegister);
+            }
+            return;
+        }
+
         size_t resultRegisterExpected = dstRegister;
 
         size_t testReg = m_test->getRegister(codeBlock, context);
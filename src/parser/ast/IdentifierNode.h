@@ -83,6 +83,18 @@ public:
         return false;
     }
 
+    // returns register of arguments variable if this identifier points arguments object which is not created yet
+    ByteCodeRegisterIndex lazyArgumentsObjectRegister(ByteCodeGenerateContext* context)
+    {
+        if (context->m_lazyArgumentsObjectIndex != REGISTER_LIMIT && isPointsArgumentsObject(context)) {
+            InterpretedCodeBlock::IndexedIdentifierInfo info = context->m_codeBlock->asInterpretedCodeBlock()->indexedIdentifierInfo(m_name, context->m_lexicalBlockIndex);
+            if (info.m_isResultSaved && info.m_isStackAllocated && info.m_type == InterpretedCodeBlock::IndexedIdentifierInfo::VarDeclared && REGULAR_REGISTER_LIMIT + info.m_index == context->m_lazyArgumentsObjectIndex) {
+                return context->m_lazyArgumentsObjectIndex;
+            }
+        }
+        return REGISTER_LIMIT;
+    }
+
     bool mayNeedsResolveAddress(ByteCodeBlock* codeBlock, ByteCodeGenerateContext* context)
     {
         if (context->m_codeBlock->canUseIndexedVariableStorage()) {
@@ -21,6 +21,7 @@
 #define IfStatementNode_h
 
 #include "StatementNode.h"
+#include "parser/ASTConstantFolder.h"
 
 namespace Escargot {
 
@@ -37,6 +38,12 @@ public:
     virtual ASTNodeType type() override { return ASTNodeType::IfStatement; }
     virtual void generateStatementByteCode(ByteCodeBlock* codeBlock, ByteCodeGenerateContext* context) override
     {
+        bool testResult;
+        if (ASTConstantFolder::evaluateCondition(codeBlock->m_codeBlock->context(), m_test, testResult)) {
+            generateConstantTestByteCode(codeBlock, context, testResult);
+            return;
+        }
+
         context->getRegister(); // ExeuctionResult of m_consequente|m_alternate should not be overwritten by m_test
         size_t jPos = 0;
         if (m_test->isRelationOperation()) {
@@ -74,6 +81,21 @@ public:
         }
     }
 
+    // only reachable branch is generated when test is constant
+    void generateConstantTestByteCode(ByteCodeBlock* codeBlock, ByteCodeGenerateContext* context, bool testResult)
+    {
+        if (testResult) {
+            m_consequente->generateStatementByteCode(codeBlock, context);
+        } else if (m_alternate) {
+            m_alternate->generateStatementByteCode(codeBlock, context);
+        }
+
+        if (!m_alternate && context->shouldCareScriptExecutionResult()) {
+            codeBlock->pushCode(LoadLiteral(ByteCodeLOC(m_loc.index), context->getRegister(), Value()), context, this);
+            context->giveUpRegister();
+        }
+    }
+
     virtual void iterateChildren(const std::function<void(Node* node)>& fn) override
     {
         fn(this);
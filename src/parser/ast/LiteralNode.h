@@ -46,6 +46,11 @@ public:
         }
     }
 
+    virtual void generateResultNotRequiredExpressionByteCode(ByteCodeBlock* codeBlock, ByteCodeGenerateContext* context) override
+    {
+        // literal has no side effect
+    }
+
     virtual ByteCodeRegisterIndex getRegister(ByteCodeBlock* codeBlock, ByteCodeGenerateContext* context) override
     {
         size_t idxExists = SIZE_MAX;
@@ -64,6 +64,22 @@ public:
         bool prevHead = context->m_isHeadOfMemberExpression;
         context->m_isHeadOfMemberExpression = false;
 
+        if (m_object->isIdentifier() && !(context->m_inCallingExpressionScope && prevHead)) {
+            ByteCodeRegisterIndex argumentsIndex = m_object->asIdentifier()->lazyArgumentsObjectRegister(context);
+            if (argumentsIndex != REGISTER_LIMIT) {
+                if (isPreComputedCase() && propertyName() == codeBlock->m_codeBlock->context()->staticStrings().length) {
+                    codeBlock->pushCode(GetArgumentsLength(ByteCodeLOC(m_loc.index), argumentsIndex, dstIndex), context, this);
+                    return;
+                } else if (!isPreComputedCase()) {
+                    size_t propertyIndex = m_property->getRegister(codeBlock, context);
+                    m_property->generateExpressionByteCode(codeBlock, context, propertyIndex);
+                    codeBlock->pushCode(GetArgument(ByteCodeLOC(m_loc.index), argumentsIndex, propertyIndex, dstIndex), context, this);
+                    context->giveUpRegister();
+                    return;
+                }
+            }
+        }
+
         bool isSimple = true;
 
         if (!m_object->isIdentifier() || (!m_property->isLiteral() && !m_property->isIdentifier())) {
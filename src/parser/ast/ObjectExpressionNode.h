@@ -132,7 +132,13 @@ public:
                 context->giveUpRegister(); // for drop cmpIndex
 
 
+                // spread into empty literal can share ObjectStructure of source like Object.assign
+                size_t createPos = codeBlock->currentCodeSize();
                 codeBlock->pushCode(CreateEnumerateObject(ByteCodeLOC(m_loc.index), elementIndex, dataIndex, true), context, this);
+                bool isFirstProperty = property == m_properties.begin();
+                if (isFirstProperty) {
+                    codeBlock->peekCode<CreateEnumerateObject>(createPos)->m_spreadTargetRegisterIndex = objIndex;
+                }
 
                 size_t checkPos = codeBlock->currentCodeSize();
                 codeBlock->pushCode(CheckLastEnumerateKey(ByteCodeLOC(m_loc.index)), context, this);
@@ -145,6 +151,9 @@ public:
 
                 size_t exitPos = codeBlock->currentCodeSize();
                 codeBlock->peekCode<CheckLastEnumerateKey>(checkPos)->m_exitPosition = exitPos;
+                if (isFirstProperty) {
+                    codeBlock->peekCode<CreateEnumerateObject>(createPos)->m_spreadExitPosition = exitPos;
+                }
 
                 // for drop elementIndex, dataIndex, keyIndex, valueIndex
                 context->giveUpRegister();
@@ -4555,17 +4555,27 @@ public:
         ASSERT(token->type == StringLiteralToken);
 
         // check strict mode early before lexing of following tokens
-        if (!token->hasAllocatedString && token->valueStringLiteral(this->scanner).equals("use strict")) {
+        bool wasStrict = this->context->strict;
+        bool isUseStrict = !token->hasAllocatedString && token->valueStringLiteral(this->scanner).equals("use strict");
+        if (isUseStrict) {
             this->currentScopeContext->m_isStrict = this->context->strict = true;
         }
 
         MetaNode node = this->createNode();
         ASTNode expr = this->parseExpression(builder);
+
+        // directive is a statement of single string literal token
+        // expression like `"use" + " strict"` is folded into literal, but it is not a directive
+        bool isDirective = expr->type() == Literal && this->lastMarker.index == token->end;
         this->consumeSemicolon();
 
-        if (expr->type() == Literal) {
+        if (isDirective) {
             return this->finalize(node, builder.createDirectiveNode(expr));
         }
+        if (isUseStrict && !wasStrict) {
+            // `"use strict" + x;` doesn't change strictness
+            this->currentScopeContext->m_isStrict = this->context->strict = false;
+        }
         return this->finalize(node, builder.createExpressionStatementNode(expr));
     }
 
@@ -5583,7 +5593,7 @@ ProgramNode* parseProgram(::Escargot::Context* ctx, StringView source, bool isMo
     ASSERT(ctx->astAllocator().isInitialized());
 
     Parser parser(ctx, source, isModule, stackRemain);
-    NodeGenerator builder(ctx->astAllocator());
+    NodeGenerator builder(ctx->astAllocator(), ctx);
 
     parser.context->strict = strictFromOutside;
     parser.context->inWith = inWith;
@@ -5602,7 +5612,7 @@ FunctionNode* parseSingleFunction(::Escargot::Context* ctx, InterpretedCodeBlock
     ASSERT(ctx->astAllocator().isInitialized());
 
     Parser parser(ctx, codeBlock->src(), false, stackRemain, codeBlock->sourceElementStart());
-    NodeGenerator builder(ctx->astAllocator());
+    NodeGenerator builder(ctx->astAllocator(), ctx);
 
     parser.trackUsingNames = false;
     parser.context->allowLexicalDeclaration = true;
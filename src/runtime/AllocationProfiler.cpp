@@ -0,0 +1,296 @@
+/*
+ * Copyright (c) 2020-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#include "Escargot.h"
+#include "AllocationProfiler.h"
+#include "runtime/VMInstance.h"
+#include "runtime/SamplingProfiler.h"
+#include "interpreter/ByteCode.h"
+
+namespace Escargot {
+
+// should be power of 2
+#define ALLOCATION_PROFILER_SITES_CAPACITY (1 << 12)
+#define ALLOCATION_PROFILER_FRAMES_CAPACITY (1 << 16)
+#define ALLOCATION_PROFILER_SAMPLED_OBJECTS_CAPACITY (1 << 14)
+
+// allocation paths don't know vm instance. so running profiler is found by thread
+// allocations of other threads are not seen by profiler of this thread
+thread_local AllocationProfiler* g_runningAllocationProfiler;
+
+AllocationProfiler::AllocationProfiler(VMInstance* vmInstance)
+    : m_vmInstance(vmInstance)
+    , m_isRunning(false)
+    , m_isSampling(false)
+    , m_samplingInterval(0)
+    , m_bytesUntilNextSample(0)
+    , m_sites(nullptr)
+    , m_sitesCount(0)
+    , m_frames(nullptr)
+    , m_framesCount(0)
+    , m_sampledObjects(nullptr)
+    , m_sampledObjectsCount(0)
+    , m_sampledObjectsCursor(0)
+    , m_droppedSamples(0)
+{
+}
+
+AllocationProfiler::~AllocationProfiler()
+{
+    stop();
+    free(m_sites);
+    free(m_sampledObjects);
+    if (m_frames) {
+        GC_FREE(m_frames);
+    }
+}
+
+bool AllocationProfiler::start(size_t samplingIntervalInBytes)
+{
+    if (m_isRunning || g_runningAllocationProfiler || !samplingIntervalInBytes) {
+        return false;
+    }
+
+    if (!m_sites) {
+        m_sites = (AllocationSite*)malloc(sizeof(AllocationSite) * ALLOCATION_PROFILER_SITES_CAPACITY);
+        m_frames = (SampledFrame*)GC_MALLOC_UNCOLLECTABLE(sizeof(SampledFrame) * ALLOCATION_PROFILER_FRAMES_CAPACITY);
+        m_sampledObjects = (SampledObject*)calloc(ALLOCATION_PROFILER_SAMPLED_OBJECTS_CAPACITY, sizeof(SampledObject));
+    }
+    for (size_t i = 0; i < ALLOCATION_PROFILER_SITES_CAPACITY; i++) {
+        m_sites[i].m_depth = SIZE_MAX;
+    }
+    // release references of previous profile
+    memset(m_frames, 0, sizeof(SampledFrame) * m_framesCount);
+    m_sitesCount = 0;
+    m_framesCount = 0;
+    m_droppedSamples = 0;
+
+    m_samplingInterval = samplingIntervalInBytes;
+    m_bytesUntilNextSample = samplingIntervalInBytes;
+    g_runningAllocationProfiler = this;
+    m_isRunning = true;
+    return true;
+}
+
+void AllocationProfiler::stop()
+{
+    if (!m_isRunning) {
+        return;
+    }
+
+    // surviving bytes of sites are kept as result of last gc
+    releaseSampledObjects();
+    ASSERT(g_runningAllocationProfiler == this);
+    g_runningAllocationProfiler = nullptr;
+    m_isRunning = false;
+}
+
+void AllocationProfiler::releaseSampledObjects()
+{
+    for (size_t i = 0; i < ALLOCATION_PROFILER_SAMPLED_OBJECTS_CAPACITY; i++) {
+        SampledObject& object = m_sampledObjects[i];
+        if (object.m_hiddenObject) {
+            GC_unregister_disappearing_link((void**)&object.m_hiddenObject);
+            object.m_hiddenObject = 0;
+        }
+    }
+    m_sampledObjectsCount = 0;
+    m_sampledObjectsCursor = 0;
+}
+
+void AllocationProfiler::countAllocation(void* ptr)
+{
+    if (m_isSampling || GC_base(ptr) != ptr) {
+        return;
+    }
+
+    size_t bytes = GC_size(ptr);
+    if (bytes < m_bytesUntilNextSample) {
+        m_bytesUntilNextSample -= bytes;
+        return;
+    }
+
+    m_bytesUntilNextSample = m_samplingInterval;
+    m_isSampling = true;
+    takeSample(ptr, bytes);
+    m_isSampling = false;
+}
+
+void AllocationProfiler::takeSample(void* ptr, size_t bytes)
+{
+    SampledFrame frames[MaxStackDepth];
+    size_t depth = 0;
+    size_t hash = (size_t)14695981039346656037ULL;
+    const size_t prime = (size_t)1099511628211ULL;
+
+    InterpreterFrame* frame = m_vmInstance->topInterpreterFrame();
+    while (frame && depth < MaxStackDepth) {
+        ByteCodeBlock* block = frame->m_byteCodeBlock;
+        size_t codeStart = (size_t)block->m_code.data();
+        size_t programCounter = *frame->m_programCounter;
+        size_t codePosition = SIZE_MAX;
+        if (programCounter >= codeStart && programCounter < codeStart + block->m_code.size()) {
+            codePosition = programCounter - codeStart;
+        }
+
+        frames[depth].m_byteCodeBlock = block;
+        frames[depth].m_codePosition = codePosition;
+        hash = (hash ^ (size_t)block) * prime;
+        hash = (hash ^ codePosition) * prime;
+        depth++;
+        frame = frame->m_parent;
+    }
+
+    size_t siteIndex = findOrInsertSite(frames, depth, hash);
+    if (siteIndex == SIZE_MAX) {
+        m_droppedSamples++;
+        return;
+    }
+
+    // sample stands for all allocations since previous sample
+    size_t weightedBytes = std::max(bytes, m_samplingInterval);
+    AllocationSite& site = m_sites[siteIndex];
+    site.m_allocatedBytes += weightedBytes;
+    site.m_allocationCount += weightedBytes / bytes;
+
+    if (m_sampledObjectsCount == ALLOCATION_PROFILER_SAMPLED_OBJECTS_CAPACITY) {
+        return;
+    }
+    // there is at least one empty slot
+    while (m_sampledObjects[m_sampledObjectsCursor].m_hiddenObject) {
+        m_sampledObjectsCursor = (m_sampledObjectsCursor + 1) & (ALLOCATION_PROFILER_SAMPLED_OBJECTS_CAPACITY - 1);
+    }
+    SampledObject& object = m_sampledObjects[m_sampledObjectsCursor];
+    object.m_hiddenObject = GC_HIDE_POINTER(ptr);
+    object.m_siteIndex = siteIndex;
+    object.m_bytes = weightedBytes;
+    if (GC_general_register_disappearing_link((void**)&object.m_hiddenObject, ptr) != GC_SUCCESS) {
+        object.m_hiddenObject = 0;
+        return;
+    }
+    m_sampledObjectsCount++;
+}
+
+size_t AllocationProfiler::findOrInsertSite(const SampledFrame* frames, size_t depth, size_t hash)
+{
+    const size_t mask = ALLOCATION_PROFILER_SITES_CAPACITY - 1;
+    size_t index = hash & mask;
+    while (true) {
+        AllocationSite& site = m_sites[index];
+        if (site.m_depth == SIZE_MAX) {
+            break;
+        }
+        if (site.m_hash == hash && site.m_depth == depth && memcmp(&m_frames[site.m_frameStart], frames, sizeof(SampledFrame) * depth) == 0) {
+            return index;
+        }
+        index = (index + 1) & mask;
+    }
+
+    // keep load factor of table low enough for linear probing
+    if (m_sitesCount >= ALLOCATION_PROFILER_SITES_CAPACITY / 4 * 3 || m_framesCount + depth > ALLOCATION_PROFILER_FRAMES_CAPACITY) {
+        return SIZE_MAX;
+    }
+
+    AllocationSite& site = m_sites[index];
+    memcpy(&m_frames[m_framesCount], frames, sizeof(SampledFrame) * depth);
+    site.m_hash = hash;
+    site.m_frameStart = m_framesCount;
+    site.m_depth = depth;
+    site.m_allocatedBytes = 0;
+    site.m_allocationCount = 0;
+    site.m_survivingBytes = 0;
+    m_framesCount += depth;
+    m_sitesCount++;
+    return index;
+}
+
+void AllocationProfiler::didCollectGarbage()
+{
+    // gc already cleared links of collected objects. we should not call gc functions here
+    for (size_t i = 0; i < ALLOCATION_PROFILER_SITES_CAPACITY; i++) {
+        m_sites[i].m_survivingBytes = 0;
+    }
+
+    size_t count = 0;
+    for (size_t i = 0; i < ALLOCATION_PROFILER_SAMPLED_OBJECTS_CAPACITY; i++) {
+        const SampledObject& object = m_sampledObjects[i];
+        if (object.m_hiddenObject) {
+            m_sites[object.m_siteIndex].m_survivingBytes += object.m_bytes;
+            count++;
+        }
+    }
+    m_sampledObjectsCount = count;
+}
+
+std::string AllocationProfiler::dumpAllocationSites()
+{
+    std::string result;
+    if (!m_sites) {
+        return result;
+    }
+
+    std::vector<size_t> siteIndexes;
+    for (size_t i = 0; i < ALLOCATION_PROFILER_SITES_CAPACITY; i++) {
+        if (m_sites[i].m_depth != SIZE_MAX) {
+            siteIndexes.push_back(i);
+        }
+    }
+    std::sort(siteIndexes.begin(), siteIndexes.end(), [this](size_t a, size_t b) {
+        return m_sites[a].m_allocatedBytes > m_sites[b].m_allocatedBytes;
+    });
+
+    std::map<std::pair<ByteCodeBlock*, size_t>, std::string> frameNames;
+    for (size_t i = 0; i < siteIndexes.size(); i++) {
+        const AllocationSite& site = m_sites[siteIndexes[i]];
+        if (!site.m_depth) {
+            // allocated while vm was not interpreting. e.g. parsing or host code
+            result += "(native)";
+        }
+        // frames are recorded from innermost frame
+        for (size_t j = site.m_depth; j > 0; j--) {
+            const SampledFrame& frame = m_frames[site.m_frameStart + j - 1];
+            auto key = std::make_pair(frame.m_byteCodeBlock, frame.m_codePosition);
+            auto iter = frameNames.find(key);
+            if (iter == frameNames.end()) {
+                iter = frameNames.insert(std::make_pair(key, SamplingProfiler::frameName(frame.m_byteCodeBlock, frame.m_codePosition))).first;
+            }
+
+            result += iter->second;
+            if (j > 1) {
+                result += ';';
+            }
+        }
+        result += ' ';
+        result += std::to_string(site.m_allocatedBytes);
+        result += ' ';
+        result += std::to_string(site.m_allocationCount);
+        result += ' ';
+        result += std::to_string(site.m_survivingBytes);
+        result += '\n';
+    }
+
+    if (m_droppedSamples) {
+        result += "(dropped) ";
+        result += std::to_string(m_droppedSamples);
+        result += '\n';
+    }
+
+    return result;
+}
+}
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2020-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#ifndef __EscargotAllocationProfiler__
+#define __EscargotAllocationProfiler__
+
+namespace Escargot {
+
+class VMInstance;
+class ByteCodeBlock;
+class AllocationProfiler;
+
+// profiler running on current thread
+// every VMInstance runs on its own thread, so each VMInstance can run its profiler at once
+extern thread_local AllocationProfiler* g_runningAllocationProfiler;
+
+// Allocation-site sampling profiler
+// Whenever given amount of bytes are allocated, next allocation is sampled with interpreter stack.
+// Each sample stands for sampling interval bytes, so totals of sites are estimated in bytes.
+// Sampled objects are watched with disappearing links, and surviving bytes of sites are updated on every gc.
+// Allocations are reported by Object, String and CustomAllocator allocation paths.
+// start and stop should be called on thread of VMInstance
+class AllocationProfiler {
+public:
+    static const size_t MaxStackDepth = 64;
+
+    explicit AllocationProfiler(VMInstance* vmInstance);
+    ~AllocationProfiler();
+
+    bool start(size_t samplingIntervalInBytes);
+    void stop();
+    bool isRunning()
+    {
+        return m_isRunning;
+    }
+
+    // ptr should be start of gc object
+    // this function costs a branch while profiler is not running
+    static ALWAYS_INLINE void recordAllocation(void* ptr)
+    {
+        AllocationProfiler* profiler = g_runningAllocationProfiler;
+        if (UNLIKELY(profiler != nullptr)) {
+            profiler->countAllocation(ptr);
+        }
+    }
+
+    // updates surviving bytes of sites. called on GC_EVENT_RECLAIM_END
+    void didCollectGarbage();
+
+    // each line is "outermost;...;innermost allocated-bytes allocation-count surviving-bytes"
+    // lines are sorted by allocated bytes
+    std::string dumpAllocationSites();
+
+private:
+    struct SampledFrame {
+        ByteCodeBlock* m_byteCodeBlock;
+        size_t m_codePosition;
+    };
+
+    struct AllocationSite {
+        size_t m_hash;
+        size_t m_frameStart;
+        size_t m_depth;
+        size_t m_allocatedBytes;
+        size_t m_allocationCount;
+        size_t m_survivingBytes;
+    };
+
+    // gc clears m_hiddenObject when sampled object is collected
+    struct SampledObject {
+        GC_word m_hiddenObject;
+        size_t m_siteIndex;
+        size_t m_bytes;
+    };
+
+    void countAllocation(void* ptr);
+    void takeSample(void* ptr, size_t bytes);
+    size_t findOrInsertSite(const SampledFrame* frames, size_t depth, size_t hash);
+    void releaseSampledObjects();
+
+    VMInstance* m_vmInstance;
+    bool m_isRunning;
+    bool m_isSampling;
+    size_t m_samplingInterval;
+    size_t m_bytesUntilNextSample;
+
+    AllocationSite* m_sites;
+    size_t m_sitesCount;
+    // frame pool is allocated as uncollectable gc memory
+    // so ByteCodeBlocks of sites are kept alive until profiler is destroyed
+    SampledFrame* m_frames;
+    size_t m_framesCount;
+    // sampled objects are in malloc memory for not keeping them alive
+    // empty slots have zero in m_hiddenObject
+    SampledObject* m_sampledObjects;
+    size_t m_sampledObjectsCount;
+    size_t m_sampledObjectsCursor;
+    size_t m_droppedSamples;
+};
+}
+
+#endif
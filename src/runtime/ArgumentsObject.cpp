@@ -49,8 +49,8 @@ static void ArgumentsObjectNativeSetter(ExecutionState& state, Object* self, con
 
 void* ArgumentsObject::operator new(size_t size)
 {
-    static bool typeInited = false;
-    static GC_descr descr;
+    static std::atomic<bool> typeInited(false);
+    static std::atomic<GC_descr> descr;
     if (!typeInited) {
         GC_word obj_bitmap[GC_BITMAP_SIZE(ArgumentsObject)] = { 0 };
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(ArgumentsObject, m_structure));
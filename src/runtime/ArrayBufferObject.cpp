@@ -24,6 +24,14 @@
 
 namespace Escargot {
 
+void ArrayBufferObject::finalize(void* obj)
+{
+    ArrayBufferObject* self = (ArrayBufferObject*)obj;
+    if (self->m_data) {
+        self->m_context->vmInstance()->platform()->onArrayBufferObjectDataBufferFree(self->m_context, self, self->m_data);
+    }
+}
+
 ArrayBufferObject::ArrayBufferObject(ExecutionState& state)
     : Object(state, ESCARGOT_OBJECT_BUILTIN_PROPERTY_NUMBER, true)
     , m_context(state.context())
@@ -34,10 +42,14 @@ ArrayBufferObject::ArrayBufferObject(ExecutionState& state)
 
     GC_REGISTER_FINALIZER_NO_ORDER(this, [](void* obj,
                                             void*) {
+#if defined(ENABLE_THREADING)
+        // the platform frees data on the thread of VMInstance
         ArrayBufferObject* self = (ArrayBufferObject*)obj;
-        if (self->m_data) {
-            self->m_context->vmInstance()->platform()->onArrayBufferObjectDataBufferFree(self->m_context, self, self->m_data);
+        if (self->m_data && self->m_context->vmInstance()->deferFinalizerToOwnerThread(obj, finalize)) {
+            return;
         }
+#endif
+        finalize(obj);
     },
                                    nullptr, nullptr, nullptr);
 }
@@ -66,6 +78,53 @@ void ArrayBufferObject::detachArrayBuffer(ExecutionState& state)
     m_bytelength = 0;
 }
 
+ArrayBufferObjectBackingStore* ArrayBufferObject::releaseBuffer(ExecutionState& state)
+{
+    ASSERT(!isDetachedBuffer());
+    ArrayBufferObjectBackingStore* store = new (NoGC) ArrayBufferObjectBackingStore(m_data, m_bytelength, this, m_context, m_context->vmInstance()->platform());
+    m_data = NULL;
+    m_bytelength = 0;
+    return store;
+}
+
+void ArrayBufferObject::attachBuffer(ExecutionState& state, ArrayBufferObjectBackingStore* store)
+{
+    ASSERT(isDetachedBuffer());
+    if (!store->m_data) {
+        return;
+    }
+    if (m_context->vmInstance()->platform()->arrayBufferAllocatorIdentity() == store->m_platform->arrayBufferAllocatorIdentity()) {
+        // finalizer frees data through the same platform which allocated it
+        m_data = (uint8_t*)store->m_data;
+        m_bytelength = store->m_byteLength;
+        store->m_data = nullptr;
+    } else {
+        // data is copied into memory of our platform. store keeps its data and frees it through its platform when released
+        allocateBuffer(state, store->m_byteLength);
+        memcpy(m_data, store->m_data, store->m_byteLength);
+    }
+}
+
+void ArrayBufferObjectBackingStore::free(void* obj)
+{
+    ArrayBufferObjectBackingStore* self = (ArrayBufferObjectBackingStore*)obj;
+    if (self->m_data) {
+        self->m_platform->onArrayBufferObjectDataBufferFree(self->m_context, self->m_source, self->m_data);
+    }
+    GC_FREE(self);
+}
+
+void ArrayBufferObjectBackingStore::release(ArrayBufferObjectBackingStore* store)
+{
+#if defined(ENABLE_THREADING)
+    // like finalizer of ArrayBuffer, data is freed on the thread of VMInstance which allocated it
+    if (store->m_data && store->m_context->vmInstance()->deferFinalizerToOwnerThread(store, free)) {
+        return;
+    }
+#endif
+    free(store);
+}
+
 // http://www.ecma-international.org/ecma-262/6.0/#sec-clonearraybuffer
 bool ArrayBufferObject::cloneBuffer(ExecutionState& state, ArrayBufferObject* srcBuffer, size_t srcByteOffset)
 {
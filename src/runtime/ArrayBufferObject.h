@@ -37,6 +37,43 @@ enum TypedArrayType : unsigned {
     Float64
 };
 
+class ArrayBufferObject;
+class Platform;
+
+// Backing store released from an ArrayBuffer to be attached to another one, possibly on another VMInstance
+// the store should be freed through the platform which allocated it, so it remembers where it was allocated
+// it is allocated with NoGC. objects it refers stay alive until it is released
+class ArrayBufferObjectBackingStore : public gc {
+    friend class ArrayBufferObject;
+
+public:
+    // frees backing store if it was never attached. can be called on any thread
+    static void release(ArrayBufferObjectBackingStore* store);
+
+    size_t byteLength()
+    {
+        return m_byteLength;
+    }
+
+private:
+    ArrayBufferObjectBackingStore(void* data, size_t byteLength, ArrayBufferObject* source, Context* context, Platform* platform)
+        : m_data(data)
+        , m_byteLength(byteLength)
+        , m_source(source)
+        , m_context(context)
+        , m_platform(platform)
+    {
+    }
+
+    static void free(void* obj);
+
+    void* m_data;
+    size_t m_byteLength;
+    ArrayBufferObject* m_source;
+    Context* m_context;
+    Platform* m_platform;
+};
+
 class ArrayBufferObject : public Object {
     friend void initializeCustomAllocators();
     friend int getValidValueInArrayBufferObject(void* ptr, GC_mark_custom_result* arr);
@@ -59,6 +96,12 @@ public:
     void allocateBuffer(ExecutionState& state, size_t bytelength);
     void attachBuffer(ExecutionState& state, void* buffer, size_t bytelength);
     void detachArrayBuffer(ExecutionState& state);
+    // detaches buffer without freeing backing store
+    // caller should attach returned store or release it
+    ArrayBufferObjectBackingStore* releaseBuffer(ExecutionState& state);
+    // data of store moves to this if platform of this can free it. otherwise data is copied
+    // buffer stays detached if store is already attached to another ArrayBuffer
+    void attachBuffer(ExecutionState& state, ArrayBufferObjectBackingStore* store);
 
     virtual bool isArrayBufferObject() const
     {
@@ -150,6 +193,8 @@ public:
     void* operator new[](size_t size) = delete;
 
 private:
+    static void finalize(void* obj);
+
     Context* m_context;
     uint8_t* m_data;
     unsigned m_bytelength;
@@ -577,8 +577,8 @@ ArrayIteratorObject::ArrayIteratorObject(ExecutionState& state, Object* a, Type
 
 void* ArrayIteratorObject::operator new(size_t size)
 {
-    static bool typeInited = false;
-    static GC_descr descr;
+    static std::atomic<bool> typeInited(false);
+    static std::atomic<GC_descr> descr;
     if (!typeInited) {
         GC_word obj_bitmap[GC_BITMAP_SIZE(ArrayIteratorObject)] = { 0 };
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(ArrayIteratorObject, m_structure));
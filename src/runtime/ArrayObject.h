@@ -41,6 +41,8 @@ class ArrayObject : public Object {
     friend Value builtinArrayConstructor(ExecutionState& state, Value thisValue, size_t argc, Value* argv, bool isNewExpression);
     friend void initializeCustomAllocators();
     friend int getValidValueInArrayObject(void* ptr, GC_mark_custom_result* arr);
+    friend class ValueSerializer;
+    friend class ValueDeserializer;
 
 public:
     explicit ArrayObject(ExecutionState& state);
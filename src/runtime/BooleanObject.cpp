@@ -32,8 +32,8 @@ BooleanObject::BooleanObject(ExecutionState& state, bool value)
 
 void* BooleanObject::operator new(size_t size)
 {
-    static bool typeInited = false;
-    static GC_descr descr;
+    static std::atomic<bool> typeInited(false);
+    static std::atomic<GC_descr> descr;
     if (!typeInited) {
         GC_word obj_bitmap[GC_BITMAP_SIZE(BooleanObject)] = { 0 };
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(BooleanObject, m_structure));
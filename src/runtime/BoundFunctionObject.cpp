@@ -26,12 +26,19 @@
 
 namespace Escargot {
 
+size_t g_boundFunctionObjectTag;
+
 BoundFunctionObject::BoundFunctionObject(ExecutionState& state, Object* targetFunction, Value& boundThis, size_t boundArgc, Value* boundArgv, const Value& length, const Value& name)
     : Object(state, ESCARGOT_OBJECT_BUILTIN_PROPERTY_NUMBER + 2, false)
     , m_boundTargetFunction(targetFunction)
     , m_boundThis(boundThis)
 {
     m_structure = state.context()->defaultStructureForBoundFunctionObject();
+    // BoundFunctionObject has no derived class. interpreter uses this for unwrapping bound functions
+    static std::once_flag initializeTagOnce;
+    std::call_once(initializeTagOnce, [this]() {
+        g_boundFunctionObjectTag = getTag();
+    });
     m_values[ESCARGOT_OBJECT_BUILTIN_PROPERTY_NUMBER + 0] = length;
     m_values[ESCARGOT_OBJECT_BUILTIN_PROPERTY_NUMBER + 1] = name;
 
@@ -44,24 +51,44 @@ BoundFunctionObject::BoundFunctionObject(ExecutionState& state, Object* targetFu
             m_boundArguments[i] = boundArgv[i];
         }
     }
+
+    if (targetFunction->isBoundFunctionObject()) {
+        // target is already flattened. so we need to look only one level
+        BoundFunctionObject* target = (BoundFunctionObject*)targetFunction;
+        const SmallValueVector& targetArguments = target->flattenedBoundArguments();
+        m_flattenedTargetFunction = target->m_flattenedTargetFunction;
+        m_flattenedBoundThis = target->m_flattenedBoundThis;
+        m_flattenedBoundArguments.resizeWithUninitializedValues(targetArguments.size() + boundArgc);
+        for (size_t i = 0; i < targetArguments.size(); i++) {
+            m_flattenedBoundArguments[i] = targetArguments[i];
+        }
+        for (size_t i = 0; i < boundArgc; i++) {
+            m_flattenedBoundArguments[targetArguments.size() + i] = boundArgv[i];
+        }
+    } else {
+        m_flattenedTargetFunction = targetFunction;
+        m_flattenedBoundThis = boundThis;
+    }
 }
 
 // https://www.ecma-international.org/ecma-262/6.0/#sec-bound-function-exotic-objects-call-thisargument-argumentslist
 Value BoundFunctionObject::call(ExecutionState& state, const Value& thisValue, const size_t calledArgc, Value* calledArgv)
 {
     // Let args be a new list containing the same values as the list boundArgs in the same order followed by the same values as the list argumentsList in the same order.
-    size_t boundArgc = m_boundArguments.size();
+    // if target is a bound function, calling its target directly with flattened arguments gives same result
+    const SmallValueVector& boundArguments = flattenedBoundArguments();
+    size_t boundArgc = boundArguments.size();
     size_t mergedArgc = boundArgc + calledArgc;
     Value* mergedArgv = ALLOCA(mergedArgc * sizeof(Value), Value, state);
     for (size_t i = 0; i < boundArgc; i++) {
-        mergedArgv[i] = m_boundArguments[i];
+        mergedArgv[i] = boundArguments[i];
     }
     if (calledArgc > 0) {
         memcpy(mergedArgv + boundArgc, calledArgv, sizeof(Value) * calledArgc);
     }
 
     // Return Call(target, boundThis, args).
-    return Object::call(state, m_boundTargetFunction, m_boundThis, mergedArgc, mergedArgv);
+    return Object::call(state, m_flattenedTargetFunction, m_flattenedBoundThis, mergedArgc, mergedArgv);
 }
 
 // https://www.ecma-international.org/ecma-262/6.0/#sec-bound-function-exotic-objects-construct-argumentslist-newtarget
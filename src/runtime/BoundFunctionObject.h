@@ -24,7 +24,11 @@
 
 namespace Escargot {
 
+extern size_t g_boundFunctionObjectTag;
+
 class BoundFunctionObject : public Object {
+    friend class ByteCodeInterpreter;
+
 public:
     BoundFunctionObject(ExecutionState& state, Object* targetFunction, Value& boundThis, size_t boundArgc, Value* boundArgv, const Value& length, const Value& name);
 
@@ -63,9 +67,21 @@ private:
     virtual Value call(ExecutionState& state, const Value& thisValue, const size_t calledArgc, Value* calledArgv) override;
     virtual Object* construct(ExecutionState& state, const size_t calledArgc, Value* calledArgv, Object* newTarget) override;
 
+    const SmallValueVector& flattenedBoundArguments()
+    {
+        return m_flattenedTargetFunction == m_boundTargetFunction ? m_boundArguments : m_flattenedBoundArguments;
+    }
+
     Object* m_boundTargetFunction;
     SmallValue m_boundThis;
     SmallValueVector m_boundArguments;
+
+    // bound function chain is flattened at bind time. calling this is same as calling
+    // innermost non-bound target with innermost bound this and bound arguments of whole chain.
+    // m_flattenedBoundArguments is filled only if target is a bound function
+    Object* m_flattenedTargetFunction;
+    SmallValue m_flattenedBoundThis;
+    SmallValueVector m_flattenedBoundArguments;
 };
 }
 
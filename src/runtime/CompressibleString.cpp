@@ -25,46 +25,80 @@
 #include "runtime/VMInstance.h"
 #include "lz4.h"
 
+#include <csetjmp>
+
 namespace Escargot {
 
+// pointers held by callers can still be in callee saved registers.
+// setjmp spills them into `name`, and scanning stack from address of `name` covers them
+#define CAPTURE_CALLER_STACK(name) \
+    jmp_buf name;                  \
+    setjmp(name);
+
+#if defined(STACK_GROWS_DOWN)
+#define CALLER_STACK_POINTER(name) ((void*)&name)
+#else
+#define CALLER_STACK_POINTER(name) ((void*)((char*)&name + sizeof(name)))
+#endif
+
 void* CompressibleString::operator new(size_t size)
 {
-    static bool typeInited = false;
-    static GC_descr descr;
+    static std::atomic<bool> typeInited(false);
+    static std::atomic<GC_descr> descr;
     if (!typeInited) {
         GC_word obj_bitmap[GC_BITMAP_SIZE(CompressibleString)] = { 0 };
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(CompressibleString, m_context));
+        for (size_t i = 0; i < COMPRESSIBLE_DECOMPRESSED_CHUNKS_MAX; i++) {
+            GC_set_bit(obj_bitmap, GC_WORD_OFFSET(CompressibleString, m_decompressedChunks) + i * GC_WORD_LEN(DecompressedChunks) + GC_WORD_OFFSET(DecompressedChunks, m_buffer));
+        }
         descr = GC_make_descriptor(obj_bitmap, GC_WORD_LEN(CompressibleString));
         typeInited = true;
     }
     return GC_MALLOC_EXPLICITLY_TYPED(size, descr);
 }
 
+void CompressibleString::finalize(void* obj)
+{
+    CompressibleString* self = (CompressibleString*)obj;
+    if (self->isCompressed()) {
+        self->m_compressedData.~CompressedDataVector();
+    } else {
+        deallocateStringDataBuffer(const_cast<void*>(self->m_bufferData.buffer));
+    }
+
+#if defined(ENABLE_THREADING)
+    // ~VMInstance can be running on other thread. it sets the flag and reads the list under this lock
+    std::lock_guard<std::mutex> guard(VMInstance::pendingFinalizersMutex());
+#endif
+    if (!self->m_isOwnerMayFreed) {
+        self->m_context->vmInstance()->compressibleStringsUncomressedBufferSize() -= self->decomressedBufferSize() + self->decompressedChunksSize();
+
+        auto& v = self->m_context->vmInstance()->compressibleStrings();
+        v.erase(std::find(v.begin(), v.end(), self));
+    }
+}
+
 CompressibleString::CompressibleString(Context* context)
     : String()
     , m_isOwnerMayFreed(false)
     , m_isCompressed(false)
     , m_context(context)
     , m_lastUsedTickcount(fastTickCount())
+    , m_decompressedChunksCount(0)
+    , m_decompressedChunksSize(0)
 {
     m_bufferData.hasSpecialImpl = true;
 
     auto& v = context->vmInstance()->compressibleStrings();
     v.push_back(this);
     GC_REGISTER_FINALIZER_NO_ORDER(this, [](void* obj, void*) {
+#if defined(ENABLE_THREADING)
         CompressibleString* self = (CompressibleString*)obj;
-        if (self->isCompressed()) {
-            self->m_compressedData.~CompressedDataVector();
-        } else {
-            deallocateStringDataBuffer(const_cast<void*>(self->m_bufferData.buffer));
-        }
-
-        if (!self->m_isOwnerMayFreed) {
-            self->m_context->vmInstance()->compressibleStringsUncomressedBufferSize() -= self->decomressedBufferSize();
-
-            auto& v = self->m_context->vmInstance()->compressibleStrings();
-            v.erase(std::find(v.begin(), v.end(), self));
+        if (!self->m_isOwnerMayFreed && self->m_context->vmInstance()->deferFinalizerToOwnerThread(obj, finalize)) {
+            return;
         }
+#endif
+        finalize(obj);
     },
                                    nullptr, nullptr, nullptr);
 }
@@ -124,9 +158,7 @@ UTF16StringData CompressibleString::toUTF16StringData() const
     if (data.has8BitContent) {
         UTF16StringData ret;
         ret.resizeWithUninitializedValues(data.length);
-        for (size_t i = 0; i < data.length; i++) {
-            ret[i] = data.uncheckedCharAtFor8Bit(i);
-        }
+        StringKernels::widen(ret.data(), (const LChar*)data.buffer, data.length);
         return ret;
     } else {
         return UTF16StringData(data.bufferAs16Bit, data.length);
@@ -150,11 +182,12 @@ bool CompressibleString::compress()
         return false;
     }
 
+    CAPTURE_CALLER_STACK(callerStack);
     bool has8Bit = m_bufferData.has8BitContent;
     if (has8Bit) {
-        return compressWorker<LChar>(currentStackPointer());
+        return compressWorker<LChar>(CALLER_STACK_POINTER(callerStack));
     } else {
-        return compressWorker<char16_t>(currentStackPointer());
+        return compressWorker<char16_t>(CALLER_STACK_POINTER(callerStack));
     }
 }
 
@@ -163,23 +196,24 @@ void CompressibleString::decompress()
     ASSERT(m_isCompressed);
     ASSERT(m_bufferData.length);
 
+    CAPTURE_CALLER_STACK(callerStack);
     bool has8Bit = m_bufferData.has8BitContent;
     if (has8Bit) {
-        decompressWorker<LChar>();
+        decompressWorker<LChar>(CALLER_STACK_POINTER(callerStack));
     } else {
-        decompressWorker<char16_t>();
+        decompressWorker<char16_t>(CALLER_STACK_POINTER(callerStack));
     }
 }
 
-constexpr static const size_t g_compressChunkSize = 1044465;
-static_assert(LZ4_COMPRESSBOUND(g_compressChunkSize) == 1024 * 1024, "");
+// each chunk is compressed independently. so we can decompress only the chunks we need
+// chunk size should be multiple of sizeof(char16_t) so that a character never spans two chunks
+constexpr static const size_t g_compressChunkSize = 64 * 1024;
+static_assert(g_compressChunkSize % sizeof(char16_t) == 0, "");
 
-template <typename StringType>
-bool CompressibleString::compressWorker(void* callerSP)
+// true if any word of stack points into [buffer, buffer + byteLength)
+// accessors of a range hold pointers into the middle of buffer, so base pointer alone is not enough
+bool CompressibleString::isBufferReferencedOnStack(void* callerSP, const void* buffer, size_t byteLength)
 {
-    ASSERT(!m_isCompressed);
-    ASSERT(m_bufferData.length > 0);
-
 #if defined(STACK_GROWS_DOWN)
     size_t* start = (size_t*)((size_t)callerSP & ~(sizeof(size_t) - 1));
     size_t* end = (size_t*)m_context->vmInstance()->stackStartAddress();
@@ -188,13 +222,179 @@ bool CompressibleString::compressWorker(void* callerSP)
     size_t* end = (size_t*)((size_t)callerSP & ~(sizeof(size_t) - 1));
 #endif
 
+    size_t bufferStart = (size_t)buffer;
+    size_t bufferEnd = bufferStart + byteLength;
     while (start != end) {
-        if (UNLIKELY(*start == (size_t)m_bufferData.buffer)) {
-            // if there is reference on stack, we cannot compress string.
-            return false;
+        if (UNLIKELY(*start >= bufferStart && *start < bufferEnd)) {
+            return true;
         }
         start++;
     }
+    return false;
+}
+
+StringBufferAccessData CompressibleString::bufferAccessDataOfRange(size_t start, size_t length)
+{
+    ASSERT(start + length <= m_bufferData.length);
+    bool has8Bit = m_bufferData.has8BitContent;
+    if (UNLIKELY(!length)) {
+        return StringBufferAccessData(has8Bit, 0, const_cast<char*>(""));
+    }
+
+    size_t charSize = has8Bit ? sizeof(LChar) : sizeof(char16_t);
+    size_t byteStart = start * charSize;
+    size_t byteEnd = (start + length) * charSize;
+    size_t firstChunk = byteStart / g_compressChunkSize;
+    size_t lastChunk = (byteEnd - 1) / g_compressChunkSize;
+
+    if (!isCompressed() || (firstChunk == 0 && lastChunk + 1 >= m_compressedData.size())) {
+        // string is not compressed or whole string is requested
+        StringBufferAccessData r = bufferAccessData();
+        r.extraData = const_cast<void*>(r.buffer);
+        r.length = length;
+        r.bufferAs8Bit += byteStart;
+        return r;
+    }
+
+    uint64_t currentTickCount = fastTickCount();
+    char* buffer = nullptr;
+    size_t bufferFirstChunk = 0;
+    for (size_t i = 0; i < m_decompressedChunksCount; i++) {
+        auto& chunks = m_decompressedChunks[i];
+        if (chunks.m_firstChunk <= firstChunk && lastChunk < chunks.m_firstChunk + chunks.m_chunkCount) {
+            chunks.m_lastUsedTickcount = currentTickCount;
+            buffer = chunks.m_buffer;
+            bufferFirstChunk = chunks.m_firstChunk;
+            break;
+        }
+    }
+
+    if (!buffer) {
+        if (m_decompressedChunksCount == COMPRESSIBLE_DECOMPRESSED_CHUNKS_MAX) {
+            // registers saved by prologue of this function are above callerStack, so they are scanned too
+            CAPTURE_CALLER_STACK(callerStack);
+            if (!releaseDecompressedChunksWorker(CALLER_STACK_POINTER(callerStack), currentTickCount, 0)) {
+                // every chunk in the table is still accessed by callers. use the whole buffer instead
+                decompress();
+                StringBufferAccessData r = bufferAccessData();
+                r.extraData = const_cast<void*>(r.buffer);
+                r.length = length;
+                r.bufferAs8Bit += byteStart;
+                return r;
+            }
+        }
+
+        size_t chunkCount = lastChunk - firstChunk + 1;
+        size_t byteLength = std::min(chunkCount * g_compressChunkSize, m_bufferData.length * charSize - firstChunk * g_compressChunkSize);
+        buffer = decompressChunks(firstChunk, chunkCount, byteLength);
+        bufferFirstChunk = firstChunk;
+
+        auto& chunks = m_decompressedChunks[m_decompressedChunksCount++];
+        chunks.m_firstChunk = firstChunk;
+        chunks.m_chunkCount = chunkCount;
+        chunks.m_byteLength = byteLength;
+        chunks.m_buffer = buffer;
+        chunks.m_lastUsedTickcount = currentTickCount;
+    }
+
+    // returned pointer points into the middle of chunk buffer, which gc doesn't see as a reference.
+    // chunk buffer is kept alive by the table of this string, and chunks are only dropped from the table
+    // when no word of stack points into them (see releaseDecompressedChunksWorker)
+    return StringBufferAccessData(has8Bit, length, buffer + (byteStart - bufferFirstChunk * g_compressChunkSize), buffer);
+}
+
+char* CompressibleString::decompressChunks(size_t firstChunk, size_t chunkCount, size_t byteLength)
+{
+    ASSERT(m_isCompressed);
+    ASSERT(firstChunk + chunkCount <= m_compressedData.size());
+
+    char* dstBuffer = (char*)GC_MALLOC_ATOMIC(byteLength);
+    size_t dstIndex = 0;
+    for (size_t bufIndex = firstChunk; bufIndex < firstChunk + chunkCount; bufIndex++) {
+        int dstSize = (int)std::min(g_compressChunkSize, byteLength - dstIndex);
+        int decompressedLength = LZ4::LZ4_decompress_safe(m_compressedData[bufIndex].data(), dstBuffer + dstIndex, m_compressedData[bufIndex].size(), dstSize);
+        if (decompressedLength != dstSize) {
+            // decompress fail
+            RELEASE_ASSERT_NOT_REACHED();
+        }
+        dstIndex += dstSize;
+    }
+
+    m_decompressedChunksSize += byteLength;
+    m_context->vmInstance()->compressibleStringsUncomressedBufferSize() += byteLength;
+    return dstBuffer;
+}
+
+void CompressibleString::releaseDecompressedChunks(uint64_t currentTickCount, uint64_t usedBefore)
+{
+    CAPTURE_CALLER_STACK(callerStack);
+    releaseDecompressedChunksWorker(CALLER_STACK_POINTER(callerStack), currentTickCount, usedBefore);
+}
+
+bool CompressibleString::releaseDecompressedChunksWorker(void* callerSP, uint64_t currentTickCount, uint64_t usedBefore)
+{
+    bool released = false;
+    size_t lruIndex = SIZE_MAX;
+    for (size_t i = 0; i < m_decompressedChunksCount;) {
+        auto& chunks = m_decompressedChunks[i];
+        // chunks still accessed by callers stay in the table until next release
+        if (!isBufferReferencedOnStack(callerSP, chunks.m_buffer, chunks.m_byteLength)) {
+            if (usedBefore) {
+                if (currentTickCount - chunks.m_lastUsedTickcount > usedBefore) {
+                    releaseDecompressedChunksAt(i);
+                    released = true;
+                    continue;
+                }
+            } else if (lruIndex == SIZE_MAX || chunks.m_lastUsedTickcount < m_decompressedChunks[lruIndex].m_lastUsedTickcount) {
+                lruIndex = i;
+            }
+        }
+        i++;
+    }
+
+    // when usedBefore is zero, we release least recently used chunks only
+    if (lruIndex != SIZE_MAX) {
+        releaseDecompressedChunksAt(lruIndex);
+        released = true;
+    }
+    return released;
+}
+
+void CompressibleString::releaseDecompressedChunksAt(size_t index)
+{
+    ASSERT(index < m_decompressedChunksCount);
+    m_decompressedChunksSize -= m_decompressedChunks[index].m_byteLength;
+    m_context->vmInstance()->compressibleStringsUncomressedBufferSize() -= m_decompressedChunks[index].m_byteLength;
+
+    // just drop the reference. GC frees the buffer when nobody uses it
+    m_decompressedChunksCount--;
+    for (size_t i = index; i < m_decompressedChunksCount; i++) {
+        m_decompressedChunks[i] = m_decompressedChunks[i + 1];
+    }
+    m_decompressedChunks[m_decompressedChunksCount].m_buffer = nullptr;
+}
+
+void CompressibleString::releaseAllDecompressedChunks(void* callerSP)
+{
+    for (size_t i = 0; i < m_decompressedChunksCount;) {
+        if (isBufferReferencedOnStack(callerSP, m_decompressedChunks[i].m_buffer, m_decompressedChunks[i].m_byteLength)) {
+            i++;
+        } else {
+            releaseDecompressedChunksAt(i);
+        }
+    }
+}
+
+template <typename StringType>
+bool CompressibleString::compressWorker(void* callerSP)
+{
+    ASSERT(!m_isCompressed);
+    ASSERT(m_bufferData.length > 0);
+
+    if (isBufferReferencedOnStack(callerSP, m_bufferData.buffer, m_bufferData.length * sizeof(StringType))) {
+        // if there is reference on stack, we cannot compress string.
+        return false;
+    }
 
     size_t originByteLength = m_bufferData.length * sizeof(StringType);
     int lastBoundLength = 0;
@@ -229,7 +429,7 @@ bool CompressibleString::compressWorker(void* callerSP)
 
 
 template <typename StringType>
-void CompressibleString::decompressWorker()
+void CompressibleString::decompressWorker(void* callerSP)
 {
     ASSERT(m_isCompressed);
 
@@ -251,6 +451,8 @@ void CompressibleString::decompressWorker()
     }
 
     CompressedDataVector().swap(m_compressedData);
+    // whole string is available now. chunks are not needed anymore except ones callers still access
+    releaseAllDecompressedChunks(callerSP);
 
     m_bufferData.bufferAs8Bit = const_cast<const char*>(dstBuffer);
     m_isCompressed = false;
@@ -28,6 +28,9 @@ namespace Escargot {
 
 class Context;
 
+// maximum number of decompressed chunk buffers kept per string
+#define COMPRESSIBLE_DECOMPRESSED_CHUNKS_MAX 4
+
 class CompressibleString : public String {
     friend class VMInstance;
 
@@ -63,6 +66,11 @@ public:
         return (const char16_t*)bufferAccessData().buffer;
     }
 
+    virtual char16_t charAt(const size_t idx) const override
+    {
+        return const_cast<CompressibleString*>(this)->bufferAccessDataOfRange(idx, 1).charAt(0);
+    }
+
     virtual StringBufferAccessData bufferAccessDataSpecialImpl() override
     {
         m_lastUsedTickcount = fastTickCount();
@@ -72,6 +80,9 @@ public:
         return StringBufferAccessData(m_bufferData.has8BitContent, m_bufferData.length, const_cast<void*>(m_bufferData.buffer));
     }
 
+    // if string is compressed, this function decompresses only chunks which cover the range
+    virtual StringBufferAccessData bufferAccessDataOfRange(size_t start, size_t length) override;
+
     bool isCompressed()
     {
         return m_isCompressed;
@@ -86,8 +97,12 @@ public:
 
     bool compress();
     void decompress();
+    // drop decompressed chunks which are not used during `usedBefore`
+    // if `usedBefore` is zero, drop least recently used chunks only
+    void releaseDecompressedChunks(uint64_t currentTickCount, uint64_t usedBefore);
 
 private:
+    static void finalize(void* obj);
     void initBufferAccessData(void* data, size_t len, bool is8bit);
 
     size_t decomressedBufferSize()
@@ -99,17 +114,46 @@ private:
         }
     }
 
+    size_t decompressedChunksSize()
+    {
+        return m_decompressedChunksSize;
+    }
+
+    bool isBufferReferencedOnStack(void* callerSP, const void* buffer, size_t byteLength);
+
     template <typename StringType>
     NEVER_INLINE bool compressWorker(void* callerSP);
     template <typename StringType>
-    NEVER_INLINE void decompressWorker();
-
-    bool m_isOwnerMayFreed;
+    NEVER_INLINE void decompressWorker(void* callerSP);
+    NEVER_INLINE char* decompressChunks(size_t firstChunk, size_t chunkCount, size_t byteLength);
+    // returns true if any chunk is released
+    bool releaseDecompressedChunksWorker(void* callerSP, uint64_t currentTickCount, uint64_t usedBefore);
+    void releaseDecompressedChunksAt(size_t index);
+    void releaseAllDecompressedChunks(void* callerSP);
+
+    // set by ~VMInstance, which can run on other thread than the finalizer of this
+    std::atomic<bool> m_isOwnerMayFreed;
     bool m_isCompressed;
     Context* m_context;
     uint64_t m_lastUsedTickcount;
     typedef std::vector<std::vector<char>> CompressedDataVector;
     CompressedDataVector m_compressedData;
+
+    // decompressed chunks of compressed string. this works as small LRU cache
+    // chunk buffers are allocated from GC heap and m_buffer is the only reference gc sees.
+    // bufferAccessDataOfRange returns pointers into the middle of chunks, which gc doesn't see
+    // because interior pointers are disabled. so chunks are dropped from the table only
+    // when stack holds no pointer into them, like compress() does for whole buffer
+    struct DecompressedChunks {
+        size_t m_firstChunk;
+        size_t m_chunkCount;
+        size_t m_byteLength;
+        char* m_buffer;
+        uint64_t m_lastUsedTickcount;
+    };
+    DecompressedChunks m_decompressedChunks[COMPRESSIBLE_DECOMPRESSED_CHUNKS_MAX];
+    size_t m_decompressedChunksCount;
+    size_t m_decompressedChunksSize;
 };
 }
 
@@ -30,13 +30,15 @@
 #include "parser/CodeBlock.h"
 #include "SandBox.h"
 #include "ArrayObject.h"
+#include "NativeFunctionObject.h"
+#include "heap/HeapCensus.h"
 
 namespace Escargot {
 
 void* GlobalVariableAccessCacheItem::operator new(size_t size)
 {
-    static bool typeInited = false;
-    static GC_descr descr;
+    static std::atomic<bool> typeInited(false);
+    static std::atomic<GC_descr> descr;
     if (!typeInited) {
         GC_word obj_bitmap[GC_BITMAP_SIZE(GlobalVariableAccessCacheItem)] = { 0 };
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(GlobalVariableAccessCacheItem, m_cachedStructure));
@@ -57,6 +59,9 @@ Context::Context(VMInstance* instance)
     , m_loadedModules(new LoadedModuleVector())
     , m_bumpPointerAllocator(instance->m_bumpPointerAllocator)
     , m_regexpCache(instance->m_regexpCache)
+    , m_objectKeysCache(instance->m_objectKeysCache)
+    , m_objectTemplateStructureCache(new (GC) ObjectTemplateStructureCache())
+    , m_functionTemplateFunctionCache(new (GC) FunctionTemplateFunctionCache())
     , m_toStringRecursionPreventer(&instance->m_toStringRecursionPreventer)
     , m_astAllocator(*instance->m_astAllocator)
 {
@@ -82,8 +87,17 @@ Context::Context(VMInstance* instance)
     m_globalObject = new GlobalObject(stateForInit);
     m_globalObject->installBuiltins(stateForInit);
 
-    auto temp = new ArrayObject(stateForInit);
-    g_arrayObjectTag = *((size_t*)temp);
+    // tags are same for every Context. Contexts can be created on several threads at once
+    static std::once_flag initializeTagsOnce;
+    std::call_once(initializeTagsOnce, [&]() {
+        auto temp = new ArrayObject(stateForInit);
+        g_arrayObjectTag = *((size_t*)temp);
+
+        auto tempFunction = new NativeFunctionObject(stateForInit, NativeFunctionInfo(AtomicString(), nullptr, 0));
+        g_nativeFunctionObjectTag = *((size_t*)tempFunction);
+
+        HeapCensus::registerTypeNames(stateForInit);
+    });
 }
 
 void Context::throwException(ExecutionState& state, const Value& exception)
@@ -38,6 +38,8 @@ class ObjectStructure;
 class ControlFlowRecord;
 class SandBox;
 class ByteCodeBlock;
+class ObjectTemplate;
+class FunctionTemplate;
 class ToStringRecursionPreventer;
 
 struct IdentifierRecord {
@@ -72,6 +74,21 @@ typedef std::unordered_map<AtomicString, GlobalVariableAccessCacheItem*, std::ha
                            GCUtil::gc_malloc_allocator<std::pair<AtomicString const, GlobalVariableAccessCacheItem*>>>
     GlobalVariableAccessCache;
 
+// instantiation results of templates are cached per Context
+// caches are kept by Context, so templates don't keep Contexts alive
+struct ObjectTemplateCachedStructure {
+    size_t m_propertyVersion;
+    ObjectStructure* m_structure;
+};
+
+typedef std::unordered_map<ObjectTemplate*, ObjectTemplateCachedStructure, std::hash<void*>, std::equal_to<void*>,
+                           GCUtil::gc_malloc_allocator<std::pair<ObjectTemplate* const, ObjectTemplateCachedStructure>>>
+    ObjectTemplateStructureCache;
+
+typedef std::unordered_map<FunctionTemplate*, FunctionObject*, std::hash<void*>, std::equal_to<void*>,
+                           GCUtil::gc_malloc_allocator<std::pair<FunctionTemplate* const, FunctionObject*>>>
+    FunctionTemplateFunctionCache;
+
 class Context : public gc {
     friend class AtomicString;
     friend class SandBox;
@@ -107,6 +124,21 @@ public:
         return m_regexpCache;
     }
 
+    ObjectKeysCacheMap* objectKeysCache()
+    {
+        return m_objectKeysCache;
+    }
+
+    ObjectTemplateStructureCache* objectTemplateStructureCache()
+    {
+        return m_objectTemplateStructureCache;
+    }
+
+    FunctionTemplateFunctionCache* functionTemplateFunctionCache()
+    {
+        return m_functionTemplateFunctionCache;
+    }
+
     WTF::BumpPointerAllocator* bumpPointerAllocator()
     {
         return m_bumpPointerAllocator;
@@ -244,6 +276,9 @@ private:
     LoadedModuleVector* m_loadedModules;
     WTF::BumpPointerAllocator* m_bumpPointerAllocator;
     RegExpCacheMap* m_regexpCache;
+    ObjectKeysCacheMap* m_objectKeysCache;
+    ObjectTemplateStructureCache* m_objectTemplateStructureCache;
+    FunctionTemplateFunctionCache* m_functionTemplateFunctionCache;
     ObjectStructure* m_defaultStructureForObject;
     ObjectStructure* m_defaultStructureForFunctionObject;
     ObjectStructure* m_defaultStructureForNotConstructorFunctionObject;
@@ -275,14 +275,11 @@ static int equivalentYearForDST(int year)
 // e.g. return (t - 32400*1000) on KST zone
 time64_t DateObject::applyLocalTimezoneOffset(ExecutionState& state, time64_t t)
 {
-#if defined(ENABLE_ICU)
-    UErrorCode succ = U_ZERO_ERROR;
-#endif
     int32_t stdOffset = 0, dstOffset = 0;
 
 // roughly check range before calling yearFromTime function
 #if defined(ENABLE_ICU)
-    stdOffset = vzone_getRawOffset(state.context()->vmInstance()->timezone());
+    stdOffset = state.context()->vmInstance()->timezoneRawOffset();
 #else
     stdOffset = 0;
 #endif
@@ -302,14 +299,14 @@ time64_t DateObject::applyLocalTimezoneOffset(ExecutionState& state, time64_t t)
 
     t += msBetweenYears;
 #if defined(ENABLE_ICU)
-    vzone_getOffset3(state.context()->vmInstance()->timezone(), t, true, stdOffset, dstOffset, succ);
+    bool succ = state.context()->vmInstance()->timezoneOffset(t, stdOffset, dstOffset);
 #else
     dstOffset = 0;
 #endif
     t -= msBetweenYears;
 #if defined(ENABLE_ICU)
     // range check should be completed by caller function
-    if (!U_FAILURE(succ)) {
+    if (succ) {
         return t - (stdOffset + dstOffset);
     }
     return TIME64NAN;
@@ -1124,8 +1121,7 @@ void DateObject::resolveCache(ExecutionState& state)
 
     int32_t stdOffset = 0, dstOffset = 0;
 #if defined(ENABLE_ICU)
-    UErrorCode succ = U_ZERO_ERROR;
-    vzone_getOffset3(state.context()->vmInstance()->timezone(), t, true, stdOffset, dstOffset, succ);
+    state.context()->vmInstance()->timezoneOffset(t, stdOffset, dstOffset);
 #endif
 
     m_cachedLocal.isdst = dstOffset == 0 ? 0 : 1;
@@ -1403,8 +1399,8 @@ DECLARE_DATE_UTC_GETTER(Seconds);
 void* DateObject::operator new(size_t size)
 {
     ASSERT(size == sizeof(DateObject));
-    static bool typeInited = false;
-    static GC_descr descr;
+    static std::atomic<bool> typeInited(false);
+    static std::atomic<GC_descr> descr;
     if (!typeInited) {
         GC_word obj_bitmap[GC_BITMAP_SIZE(DateObject)] = { 0 };
         DateObject::fillGCDescriptor(obj_bitmap);
@@ -1416,8 +1412,8 @@ void* DateObject::operator new(size_t size)
 
 void* DatePrototypeObject::operator new(size_t size)
 {
-    static bool typeInited = false;
-    static GC_descr descr;
+    static std::atomic<bool> typeInited(false);
+    static std::atomic<GC_descr> descr;
     if (!typeInited) {
         GC_word obj_bitmap[GC_BITMAP_SIZE(DatePrototypeObject)] = { 0 };
         DatePrototypeObject::fillGCDescriptor(obj_bitmap);
@@ -61,8 +61,8 @@ void EnumerateObject::update(ExecutionState& state)
 
 void* EnumerateObjectWithDestruction::operator new(size_t size)
 {
-    static bool typeInited = false;
-    static GC_descr descr;
+    static std::atomic<bool> typeInited(false);
+    static std::atomic<GC_descr> descr;
     if (!typeInited) {
         GC_word obj_bitmap[GC_BITMAP_SIZE(EnumerateObjectWithDestruction)] = { 0 };
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(EnumerateObjectWithDestruction, m_keys));
@@ -76,8 +76,8 @@ void* EnumerateObjectWithDestruction::operator new(size_t size)
 
 void* EnumerateObjectWithIteration::operator new(size_t size)
 {
-    static bool typeInited = false;
-    static GC_descr descr;
+    static std::atomic<bool> typeInited(false);
+    static std::atomic<GC_descr> descr;
     if (!typeInited) {
         GC_word obj_bitmap[GC_BITMAP_SIZE(EnumerateObjectWithIteration)] = { 0 };
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(EnumerateObjectWithIteration, m_keys));
@@ -93,6 +93,23 @@ void EnumerateObjectWithDestruction::fillRestElement(ExecutionState& state, Obje
 {
     ASSERT(m_index == 0);
 
+    bool isOrdinaryObject = m_object->hasTag(g_objectTag);
+    if (isOrdinaryObject && !checkIfModified(state)) {
+        // FAST PATH
+        // when there is no marked key, result can share ObjectStructure of object
+        bool hasMarkedKey = false;
+        for (size_t i = 0; i < m_keys.size(); i++) {
+            if (m_keys[i].isEmpty()) {
+                hasMarkedKey = true;
+                break;
+            }
+        }
+        if (!hasMarkedKey && Object::tryToAssignByStructure(state, result, m_object)) {
+            m_index = m_keys.size();
+            return;
+        }
+    }
+
     Value key, value;
     while (m_index < m_keys.size()) {
         if (UNLIKELY(checkIfModified(state))) {
@@ -101,7 +118,19 @@ void EnumerateObjectWithDestruction::fillRestElement(ExecutionState& state, Obje
             key = m_keys[m_index++];
             // check unmarked key and put rest properties
             if (!key.isEmpty()) {
-                value = m_object->getIndexedProperty(state, key).value(state, m_object);
+                // data property of ordinary object is read from structure directly
+                size_t idx = SIZE_MAX;
+                if (isOrdinaryObject) {
+                    auto findResult = m_hiddenClass->findProperty(ObjectStructurePropertyName(state, key));
+                    if (findResult.first != SIZE_MAX && findResult.second.value()->m_descriptor.isPlainDataProperty()) {
+                        idx = findResult.first;
+                    }
+                }
+                if (idx != SIZE_MAX) {
+                    value = m_object->uncheckedGetOwnDataProperty(state, idx);
+                } else {
+                    value = m_object->getIndexedProperty(state, key).value(state, m_object);
+                }
                 result->setIndexedProperty(state, key, value);
             }
         }
@@ -32,8 +32,8 @@ void* ExecutionPauser::operator new(size_t size)
 {
     ASSERT(size == sizeof(ExecutionPauser));
 
-    static bool typeInited = false;
-    static GC_descr descr;
+    static std::atomic<bool> typeInited(false);
+    static std::atomic<GC_descr> descr;
     if (!typeInited) {
         GC_word desc[GC_BITMAP_SIZE(ExecutionPauser)] = { 0 };
         GC_set_bit(desc, GC_WORD_OFFSET(ExecutionPauser, m_executionState));
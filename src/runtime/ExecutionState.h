@@ -20,6 +20,8 @@
 #ifndef __EscargotExecutionState__
 #define __EscargotExecutionState__
 
+#include "runtime/ThreadLocal.h"
+
 namespace Escargot {
 
 class Context;
@@ -76,10 +78,14 @@ public:
         volatile int sp;
         m_stackLimit = (size_t)&sp;
 
+        // stack of current thread can be smaller than STACK_LIMIT_FROM_BASE
+        size_t threadStackLimit = ThreadLocal::stackLimit();
 #ifdef STACK_GROWS_DOWN
-        m_stackLimit = m_stackLimit - STACK_LIMIT_FROM_BASE;
+        size_t stackRemain = m_stackLimit > threadStackLimit ? m_stackLimit - threadStackLimit : 0;
+        m_stackLimit = m_stackLimit - std::min(stackRemain, (size_t)STACK_LIMIT_FROM_BASE);
 #else
-        m_stackLimit = m_stackLimit + STACK_LIMIT_FROM_BASE;
+        size_t stackRemain = threadStackLimit > m_stackLimit ? threadStackLimit - m_stackLimit : 0;
+        m_stackLimit = m_stackLimit + std::min(stackRemain, (size_t)STACK_LIMIT_FROM_BASE);
 #endif
     }
 
@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2020-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#include "Escargot.h"
+#include "FunctionTemplate.h"
+#include "parser/CodeBlock.h"
+#include "runtime/Context.h"
+#include "runtime/NativeFunctionObject.h"
+
+namespace Escargot {
+
+FunctionTemplate::FunctionTemplate(AtomicString name, size_t argumentCount, bool isStrict, bool isConstructor, CallNativeFunctionData* nativeFunctionData)
+    : m_name(name)
+    , m_argumentCount(argumentCount)
+    , m_isStrict(isStrict)
+    , m_isConstructor(isConstructor)
+    , m_nativeFunctionData(nativeFunctionData)
+    , m_prototypeTemplate(new ObjectTemplate())
+    , m_instanceTemplate(new ObjectTemplate())
+{
+}
+
+FunctionObject* FunctionTemplate::instantiate(ExecutionState& state)
+{
+    Context* context = state.context();
+    FunctionTemplateFunctionCache* cache = context->functionTemplateFunctionCache();
+    auto iter = cache->find(this);
+    if (iter != cache->end()) {
+        return iter->second;
+    }
+
+    CodeBlock* cb = new CodeBlock(context, m_name, m_argumentCount, m_isStrict, m_isConstructor, m_nativeFunctionData);
+    FunctionObject* function = new NativeFunctionObject(state, cb);
+
+    if (m_isConstructor) {
+        Object* prototype = m_prototypeTemplate->instantiate(state);
+        prototype->defineOwnProperty(state, ObjectPropertyName(state.context()->staticStrings().constructor), ObjectPropertyDescriptor(function, (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::WritablePresent | ObjectPropertyDescriptor::ConfigurablePresent)));
+        function->setFunctionPrototype(state, prototype);
+    }
+
+    cache->insert(std::make_pair(this, function));
+
+    return function;
+}
+}
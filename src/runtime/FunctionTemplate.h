@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2020-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#ifndef __EscargotFunctionTemplate__
+#define __EscargotFunctionTemplate__
+
+#include "runtime/AtomicString.h"
+#include "runtime/ObjectTemplate.h"
+
+namespace Escargot {
+
+class CallNativeFunctionData;
+class FunctionObject;
+
+// FunctionTemplate creates one native function object per Context
+// instances of function are created by instanceTemplate from native function(see FunctionTemplateRef)
+// and prototype object of function is created by prototypeTemplate
+// functions are cached in Context(see Context::functionTemplateFunctionCache) because template can outlive Contexts
+// template should be used by Contexts of one VMInstance because name of function is atomic string of VMInstance
+class FunctionTemplate : public gc {
+public:
+    FunctionTemplate(AtomicString name, size_t argumentCount, bool isStrict, bool isConstructor, CallNativeFunctionData* nativeFunctionData);
+
+    ObjectTemplate* prototypeTemplate()
+    {
+        return m_prototypeTemplate;
+    }
+
+    ObjectTemplate* instanceTemplate()
+    {
+        return m_instanceTemplate;
+    }
+
+    // returns same function object for same context
+    FunctionObject* instantiate(ExecutionState& state);
+
+private:
+    AtomicString m_name;
+    size_t m_argumentCount;
+    bool m_isStrict : 1;
+    bool m_isConstructor : 1;
+    CallNativeFunctionData* m_nativeFunctionData;
+    ObjectTemplate* m_prototypeTemplate;
+    ObjectTemplate* m_instanceTemplate;
+};
+}
+
+#endif
@@ -46,8 +46,8 @@ void* GeneratorObject::operator new(size_t size)
 {
     ASSERT(size == sizeof(GeneratorObject));
 
-    static bool typeInited = false;
-    static GC_descr descr;
+    static std::atomic<bool> typeInited(false);
+    static std::atomic<GC_descr> descr;
     if (!typeInited) {
         GC_word obj_bitmap[GC_BITMAP_SIZE(GeneratorObject)] = { 0 };
         fillGCDescriptor(obj_bitmap);
@@ -38,6 +38,9 @@
 #include "heap/LeakCheckerBridge.h"
 #include "EnvironmentRecord.h"
 #include "Environment.h"
+#if defined(ESCARGOT_ENABLE_TEST)
+#include "CompressibleString.h"
+#endif
 
 namespace Escargot {
 
@@ -74,6 +77,38 @@ static Value builtinIsBlockAllocatedOnStack(ExecutionState& state, Value thisVal
 
     return Value(result);
 }
+
+// returns UTF-8 encoding of argument as a string of bytes
+static Value builtinToUTF8Bytes(ExecutionState& state, Value thisValue, size_t argc, Value* argv, bool isNewExpression)
+{
+    auto bytes = argv[0].toString(state)->toNonGCUTF8StringData();
+    return new Latin1String(bytes.data(), bytes.length());
+}
+
+#if defined(ENABLE_COMPRESSIBLE_STRING)
+static Value builtinCreateCompressibleString(ExecutionState& state, Value thisValue, size_t argc, Value* argv, bool isNewExpression)
+{
+    auto data = argv[0].toString(state)->bufferAccessData();
+    if (data.has8BitContent) {
+        return new CompressibleString(state.context(), (const LChar*)data.buffer, data.length);
+    }
+    return new CompressibleString(state.context(), data.bufferAs16Bit, data.length);
+}
+
+static Value builtinCompressString(ExecutionState& state, Value thisValue, size_t argc, Value* argv, bool isNewExpression)
+{
+    if (!argv[0].isString() || !argv[0].asString()->isCompressibleString()) {
+        return Value(false);
+    }
+    CompressibleString* str = (CompressibleString*)argv[0].asString();
+    return Value(str->isCompressed() || str->compress());
+}
+
+static Value builtinIsStringCompressed(ExecutionState& state, Value thisValue, size_t argc, Value* argv, bool isNewExpression)
+{
+    return Value(argv[0].isString() && argv[0].asString()->isCompressibleString() && ((CompressibleString*)argv[0].asString())->isCompressed());
+}
+#endif
 #endif
 
 class EvalFunctionObject : public NativeFunctionObject {
@@ -1072,6 +1107,32 @@ void GlobalObject::installOthers(ExecutionState& state)
                       ObjectPropertyDescriptor(new NativeFunctionObject(state,
                                                                         NativeFunctionInfo(strings->run, builtinIsBlockAllocatedOnStack, 2, NativeFunctionInfo::Strict)),
                                                (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::AllPresent)));
+
+    AtomicString toUTF8BytesFunctionName(state, "toUTF8Bytes");
+    defineOwnProperty(state, ObjectPropertyName(toUTF8BytesFunctionName),
+                      ObjectPropertyDescriptor(new NativeFunctionObject(state,
+                                                                        NativeFunctionInfo(toUTF8BytesFunctionName, builtinToUTF8Bytes, 1, NativeFunctionInfo::Strict)),
+                                               (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::AllPresent)));
+
+#if defined(ENABLE_COMPRESSIBLE_STRING)
+    AtomicString createCompressibleStringFunctionName(state, "createCompressibleString");
+    defineOwnProperty(state, ObjectPropertyName(createCompressibleStringFunctionName),
+                      ObjectPropertyDescriptor(new NativeFunctionObject(state,
+                                                                        NativeFunctionInfo(createCompressibleStringFunctionName, builtinCreateCompressibleString, 1, NativeFunctionInfo::Strict)),
+                                               (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::AllPresent)));
+
+    AtomicString compressStringFunctionName(state, "compressString");
+    defineOwnProperty(state, ObjectPropertyName(compressStringFunctionName),
+                      ObjectPropertyDescriptor(new NativeFunctionObject(state,
+                                                                        NativeFunctionInfo(compressStringFunctionName, builtinCompressString, 1, NativeFunctionInfo::Strict)),
+                                               (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::AllPresent)));
+
+    AtomicString isStringCompressedFunctionName(state, "isStringCompressed");
+    defineOwnProperty(state, ObjectPropertyName(isStringCompressedFunctionName),
+                      ObjectPropertyDescriptor(new NativeFunctionObject(state,
+                                                                        NativeFunctionInfo(isStringCompressedFunctionName, builtinIsStringCompressed, 1, NativeFunctionInfo::Strict)),
+                                               (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::AllPresent)));
+#endif
 #endif
 
 #ifdef PROFILE_BDWGC
@@ -57,6 +57,7 @@ public:
         , m_objectFreeze(nullptr)
         , m_function(nullptr)
         , m_functionPrototype(nullptr)
+        , m_functionApply(nullptr)
         , m_iteratorPrototype(nullptr)
         , m_error(nullptr)
         , m_errorPrototype(nullptr)
@@ -75,6 +76,7 @@ public:
         , m_string(nullptr)
         , m_stringPrototype(nullptr)
         , m_stringIteratorPrototype(nullptr)
+        , m_stringIteratorPrototypeNext(nullptr)
         , m_number(nullptr)
         , m_numberPrototype(nullptr)
         , m_symbol(nullptr)
@@ -82,6 +84,7 @@ public:
         , m_array(nullptr)
         , m_arrayPrototype(nullptr)
         , m_arrayIteratorPrototype(nullptr)
+        , m_arrayIteratorPrototypeNext(nullptr)
         , m_arrayPrototypeValues(nullptr)
         , m_boolean(nullptr)
         , m_booleanPrototype(nullptr)
@@ -139,9 +142,11 @@ public:
         , m_map(nullptr)
         , m_mapPrototype(nullptr)
         , m_mapIteratorPrototype(nullptr)
+        , m_mapIteratorPrototypeNext(nullptr)
         , m_set(nullptr)
         , m_setPrototype(nullptr)
         , m_setIteratorPrototype(nullptr)
+        , m_setIteratorPrototypeNext(nullptr)
         , m_weakMap(nullptr)
         , m_weakMapPrototype(nullptr)
         , m_weakSet(nullptr)
@@ -264,6 +269,10 @@ public:
     {
         return m_functionPrototype;
     }
+    FunctionObject* functionApply()
+    {
+        return m_functionApply;
+    }
 
     FunctionObject* error()
     {
@@ -335,6 +344,11 @@ public:
         return m_stringIteratorPrototype;
     }
 
+    FunctionObject* stringIteratorPrototypeNext()
+    {
+        return m_stringIteratorPrototypeNext;
+    }
+
     FunctionObject* number()
     {
         return m_number;
@@ -366,6 +380,11 @@ public:
         return m_arrayIteratorPrototype;
     }
 
+    FunctionObject* arrayIteratorPrototypeNext()
+    {
+        return m_arrayIteratorPrototypeNext;
+    }
+
     FunctionObject* arrayPrototypeValues()
     {
         return m_arrayPrototypeValues;
@@ -577,6 +596,11 @@ public:
         return m_mapIteratorPrototype;
     }
 
+    FunctionObject* mapIteratorPrototypeNext()
+    {
+        return m_mapIteratorPrototypeNext;
+    }
+
     FunctionObject* set()
     {
         return m_set;
@@ -592,6 +616,11 @@ public:
         return m_setIteratorPrototype;
     }
 
+    FunctionObject* setIteratorPrototypeNext()
+    {
+        return m_setIteratorPrototypeNext;
+    }
+
     FunctionObject* weakMap()
     {
         return m_weakMap;
@@ -701,6 +730,7 @@ private:
 
     FunctionObject* m_function;
     FunctionObject* m_functionPrototype;
+    FunctionObject* m_functionApply;
 
     Object* m_iteratorPrototype;
 
@@ -722,6 +752,7 @@ private:
     FunctionObject* m_string;
     Object* m_stringPrototype;
     Object* m_stringIteratorPrototype;
+    FunctionObject* m_stringIteratorPrototypeNext;
 
     FunctionObject* m_number;
     Object* m_numberPrototype;
@@ -732,6 +763,9 @@ private:
     FunctionObject* m_array;
     Object* m_arrayPrototype;
     Object* m_arrayIteratorPrototype;
+    // initial value of next of %ArrayIteratorPrototype%
+    // iterators of which next is not replaced are advanced without result object
+    FunctionObject* m_arrayIteratorPrototypeNext;
     // https://www.ecma-international.org/ecma-262/6.0/#sec-well-known-intrinsic-objects
     // Well-Known Intrinsic Objects : %ArrayProto_values%
     // The initial value of the values data property of %ArrayPrototype%
@@ -808,9 +842,11 @@ private:
     FunctionObject* m_map;
     Object* m_mapPrototype;
     Object* m_mapIteratorPrototype;
+    FunctionObject* m_mapIteratorPrototypeNext;
     FunctionObject* m_set;
     Object* m_setPrototype;
     Object* m_setIteratorPrototype;
+    FunctionObject* m_setIteratorPrototypeNext;
     FunctionObject* m_weakMap;
     Object* m_weakMapPrototype;
     FunctionObject* m_weakSet;
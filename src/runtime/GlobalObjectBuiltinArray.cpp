@@ -233,16 +233,15 @@ static Value builtinArrayFrom(ExecutionState& state, Value thisValue, size_t arg
             // Let Pk be ! ToString(k).
             ObjectPropertyName pk(state, k);
             // Let next be ? IteratorStep(iteratorRecord).
-            Value next = IteratorObject::iteratorStep(state, iteratorRecord);
+            // Let nextValue be ? IteratorValue(next).
+            Value nextValue;
             // If next is false, then
-            if (next.isFalse()) {
+            if (!IteratorObject::iteratorStepValue(state, iteratorRecord, nextValue)) {
                 // Perform ? Set(A, "length", k, true).
                 A->setThrowsException(state, ObjectPropertyName(state, state.context()->staticStrings().length), Value(k), A);
                 // Return A.
                 return A;
             }
-            // Let nextValue be ? IteratorValue(next).
-            Value nextValue = IteratorObject::iteratorValue(state, next);
             Value mappedValue;
             // If mapping is true, then
             if (mapping) {
@@ -2011,8 +2010,9 @@ void GlobalObject::installArray(ExecutionState& state)
     m_arrayIteratorPrototype = m_iteratorPrototype;
     m_arrayIteratorPrototype = new ArrayIteratorPrototypeObject(state, nullptr, ArrayIteratorObject::TypeKey);
 
+    m_arrayIteratorPrototypeNext = new NativeFunctionObject(state, NativeFunctionInfo(state.context()->staticStrings().next, builtinArrayIteratorNext, 0, NativeFunctionInfo::Strict));
     m_arrayIteratorPrototype->defineOwnPropertyThrowsException(state, ObjectPropertyName(state.context()->staticStrings().next),
-                                                               ObjectPropertyDescriptor(new NativeFunctionObject(state, NativeFunctionInfo(state.context()->staticStrings().next, builtinArrayIteratorNext, 0, NativeFunctionInfo::Strict)), (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::WritablePresent | ObjectPropertyDescriptor::ConfigurablePresent)));
+                                                               ObjectPropertyDescriptor(m_arrayIteratorPrototypeNext, (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::WritablePresent | ObjectPropertyDescriptor::ConfigurablePresent)));
     m_arrayIteratorPrototype->defineOwnPropertyThrowsException(state, ObjectPropertyName(state.context()->vmInstance()->globalSymbols().toStringTag),
                                                                ObjectPropertyDescriptor(Value(String::fromASCII("Array Iterator")), (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::ConfigurablePresent)));
 
@@ -454,8 +454,23 @@ static Value builtinJSONStringify(ExecutionState& state, Value thisValue, size_t
 
         StringBuilder product;
         product.appendChar('"');
-        for (size_t i = 0; i < str->length(); ++i) {
-            char16_t c = str->charAt(i);
+        const auto& data = str->bufferAccessData();
+        for (size_t i = 0; i < data.length; ++i) {
+            size_t plainLength;
+            if (data.has8BitContent) {
+                plainLength = StringKernels::countJSONPlainPrefix((const LChar*)data.buffer + i, data.length - i);
+            } else {
+                plainLength = StringKernels::countJSONPlainPrefix(data.bufferAs16Bit + i, data.length - i);
+            }
+            if (plainLength) {
+                product.appendSubString(str, i, i + plainLength);
+                i += plainLength;
+                if (i == data.length) {
+                    break;
+                }
+            }
+
+            char16_t c = data.charAt(i);
 
             if (c == u'\"' || c == u'\\') {
                 product.appendChar('\\');
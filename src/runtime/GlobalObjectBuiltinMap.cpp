@@ -57,13 +57,12 @@ Value builtinMapConstructor(ExecutionState& state, Value thisValue, size_t argc,
 
     // Let iteratorRecord be ? GetIterator(iterable).
     Value iteratorRecord = IteratorObject::getIterator(state, iterable);
+    Value nextItem;
     while (true) {
-        Value next = IteratorObject::iteratorStep(state, iteratorRecord);
-        if (next.isFalse()) {
+        if (!IteratorObject::iteratorStepValue(state, iteratorRecord, nextItem)) {
             return map;
         }
 
-        Value nextItem = IteratorObject::iteratorValue(state, next);
         if (!nextItem.isObject()) {
             TypeErrorObject* errorobj = new TypeErrorObject(state, new ASCIIString("TypeError"));
             return IteratorObject::iteratorClose(state, iteratorRecord, errorobj, true);
@@ -255,8 +254,9 @@ void GlobalObject::installMap(ExecutionState& state)
     m_mapIteratorPrototype = m_iteratorPrototype;
     m_mapIteratorPrototype = new MapIteratorObject(state, nullptr, MapIteratorObject::TypeKey);
 
+    m_mapIteratorPrototypeNext = new NativeFunctionObject(state, NativeFunctionInfo(state.context()->staticStrings().next, builtinMapIteratorNext, 0, NativeFunctionInfo::Strict));
     m_mapIteratorPrototype->defineOwnPropertyThrowsException(state, ObjectPropertyName(state.context()->staticStrings().next),
-                                                             ObjectPropertyDescriptor(new NativeFunctionObject(state, NativeFunctionInfo(state.context()->staticStrings().next, builtinMapIteratorNext, 0, NativeFunctionInfo::Strict)), (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::WritablePresent | ObjectPropertyDescriptor::ConfigurablePresent)));
+                                                             ObjectPropertyDescriptor(m_mapIteratorPrototypeNext, (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::WritablePresent | ObjectPropertyDescriptor::ConfigurablePresent)));
 
     m_mapIteratorPrototype->defineOwnPropertyThrowsException(state, ObjectPropertyName(state.context()->vmInstance()->globalSymbols().toStringTag),
                                                              ObjectPropertyDescriptor(Value(String::fromASCII("Map Iterator")), (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::ConfigurablePresent)));
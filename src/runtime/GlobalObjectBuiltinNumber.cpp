@@ -24,6 +24,7 @@
 #include "NativeFunctionObject.h"
 
 // dtoa
+#include "util/Dtoa.h"
 #include "ieee.h"
 #include "double-conversion.h"
 
@@ -127,6 +128,10 @@ static Value builtinNumberToFixed(ExecutionState& state, Value thisValue, size_t
         }
 
         char buffer[NUMBER_TO_STRING_BUFFER_LENGTH];
+        size_t length = Dtoa::toFixed(number, digit, buffer);
+        if (length) {
+            return Value(new ASCIIString(buffer, length));
+        }
         double_conversion::StringBuilder builder(buffer, NUMBER_TO_STRING_BUFFER_LENGTH);
         double_conversion::DoubleToStringConverter::EcmaScriptConverter().ToFixed(number, digit, &builder);
         return Value(new ASCIIString(builder.Finalize()));
@@ -208,6 +213,10 @@ static Value builtinNumberToPrecision(ExecutionState& state, Value thisValue, si
                 ErrorObject::throwBuiltinError(state, ErrorObject::RangeError, state.context()->staticStrings().Number.string(), true, state.context()->staticStrings().toPrecision.string(), errorMessage_GlobalObject_RangeError);
             }
             char buffer[NUMBER_TO_STRING_BUFFER_LENGTH];
+            size_t length = Dtoa::toPrecision(number, p, buffer);
+            if (length) {
+                return Value(new ASCIIString(buffer, length));
+            }
             double_conversion::StringBuilder builder(buffer, NUMBER_TO_STRING_BUFFER_LENGTH);
             double_conversion::DoubleToStringConverter::EcmaScriptConverter().ToPrecision(number, p, &builder);
             return Value(new ASCIIString(builder.Finalize()));
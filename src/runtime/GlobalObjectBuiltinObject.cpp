@@ -583,6 +583,10 @@ static Value builtinObjectAssign(ExecutionState& state, Value thisValue, size_t
         if (!nextSource.isUndefinedOrNull()) {
             // Let from be ! ToObject(nextSource).
             from = nextSource.toObject(state);
+            // copy every property at once when to is still empty
+            if (Object::tryToAssignByStructure(state, to, from)) {
+                continue;
+            }
             // Let keys be ? from.[[OwnPropertyKeys]]().
             keys = from->ownPropertyKeys(state);
         }
@@ -624,9 +628,8 @@ static Value builtinObjectKeys(ExecutionState& state, Value thisValue, size_t ar
     // Let obj be ? ToObject(O).
     Object* obj = argv[0].toObject(state);
     // Let nameList be ? EnumerableOwnProperties(obj, "key").
-    auto nameList = Object::enumerableOwnProperties(state, obj, EnumerableOwnPropertiesType::Key);
     // Return CreateArrayFromList(nameList).
-    return Object::createArrayFromList(state, nameList.size(), nameList.data());
+    return Object::enumerableOwnPropertyKeysArray(state, obj);
 }
 
 static Value builtinObjectValues(ExecutionState& state, Value thisValue, size_t argc, Value* argv, bool isNewExpression)
@@ -60,15 +60,14 @@ Value builtinSetConstructor(ExecutionState& state, Value thisValue, size_t argc,
     Value iteratorRecord = IteratorObject::getIterator(state, iterable);
 
     // Repeat
+    Value nextValue;
     while (true) {
         // Let next be ? IteratorStep(iteratorRecord).
-        Value next = IteratorObject::iteratorStep(state, iteratorRecord);
         // If next is false, return set.
-        if (next.isFalse()) {
+        // Let nextValue be ? IteratorValue(next).
+        if (!IteratorObject::iteratorStepValue(state, iteratorRecord, nextValue)) {
             return set;
         }
-        // Let nextValue be ? IteratorValue(next).
-        Value nextValue = IteratorObject::iteratorValue(state, next);
 
         // Let status be Call(adder, set, « nextValue »).
         try {
@@ -233,8 +232,9 @@ void GlobalObject::installSet(ExecutionState& state)
     m_setIteratorPrototype = m_iteratorPrototype;
     m_setIteratorPrototype = new SetIteratorObject(state, nullptr, SetIteratorObject::TypeKey);
 
+    m_setIteratorPrototypeNext = new NativeFunctionObject(state, NativeFunctionInfo(state.context()->staticStrings().next, builtinSetIteratorNext, 0, NativeFunctionInfo::Strict));
     m_setIteratorPrototype->defineOwnPropertyThrowsException(state, ObjectPropertyName(state.context()->staticStrings().next),
-                                                             ObjectPropertyDescriptor(new NativeFunctionObject(state, NativeFunctionInfo(state.context()->staticStrings().next, builtinSetIteratorNext, 0, NativeFunctionInfo::Strict)), (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::WritablePresent | ObjectPropertyDescriptor::ConfigurablePresent)));
+                                                             ObjectPropertyDescriptor(m_setIteratorPrototypeNext, (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::WritablePresent | ObjectPropertyDescriptor::ConfigurablePresent)));
 
     m_setIteratorPrototype->defineOwnPropertyThrowsException(state, ObjectPropertyName(state.context()->vmInstance()->globalSymbols().toStringTag),
                                                              ObjectPropertyDescriptor(Value(String::fromASCII("Set Iterator")), (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::ConfigurablePresent)));
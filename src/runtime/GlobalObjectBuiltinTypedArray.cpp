@@ -165,14 +165,9 @@ static ValueVectorWithInlineStorage iterableToList(ExecutionState& state, const
 {
     Value iteratorRecord = IteratorObject::getIterator(state, items, true, method);
     ValueVectorWithInlineStorage values;
-    Value next(Value::True);
-
-    while (!next.isFalse()) {
-        next = IteratorObject::iteratorStep(state, iteratorRecord);
-        if (!next.isFalse()) {
-            Value nextValue = IteratorObject::iteratorValue(state, next);
-            values.pushBack(nextValue);
-        }
+    Value nextValue;
+    while (IteratorObject::iteratorStepValue(state, iteratorRecord, nextValue)) {
+        values.pushBack(nextValue);
     }
 
     return values;
@@ -57,13 +57,12 @@ Value builtinWeakMapConstructor(ExecutionState& state, Value thisValue, size_t a
 
     // Let iteratorRecord be ? GetIterator(iterable).
     Value iteratorRecord = IteratorObject::getIterator(state, iterable);
+    Value nextItem;
     while (true) {
-        Value next = IteratorObject::iteratorStep(state, iteratorRecord);
-        if (next.isFalse()) {
+        if (!IteratorObject::iteratorStepValue(state, iteratorRecord, nextItem)) {
             return map;
         }
 
-        Value nextItem = IteratorObject::iteratorValue(state, next);
         if (!nextItem.isObject()) {
             TypeErrorObject* errorobj = new TypeErrorObject(state, new ASCIIString("TypeError"));
             return IteratorObject::iteratorClose(state, iteratorRecord, errorobj, true);
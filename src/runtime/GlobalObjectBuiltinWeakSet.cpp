@@ -62,15 +62,14 @@ Value builtinWeakSetConstructor(ExecutionState& state, Value thisValue, size_t a
     Value iteratorRecord = IteratorObject::getIterator(state, iterable);
 
     // Repeat
+    Value nextValue;
     while (true) {
         // Let next be ? IteratorStep(iteratorRecord).
-        Value next = IteratorObject::iteratorStep(state, iteratorRecord);
         // If next is false, return set.
-        if (next.isFalse()) {
+        // Let nextValue be ? IteratorValue(next).
+        if (!IteratorObject::iteratorStepValue(state, iteratorRecord, nextValue)) {
             return set;
         }
-        // Let nextValue be ? IteratorValue(next).
-        Value nextValue = IteratorObject::iteratorValue(state, next);
 
         // Let status be Call(adder, set, « nextValue »).
         try {
@@ -1574,28 +1574,29 @@ Value Intl::getOption(ExecutionState& state, Object* options, Value property, St
 
 std::vector<std::string> Intl::numberingSystemsForLocale(String* locale)
 {
-    static std::vector<std::string> availableNumberingSystems;
-
-    UErrorCode status = U_ZERO_ERROR;
-    if (availableNumberingSystems.size() == 0) {
+    // initialization of function local static is thread-safe
+    static const std::vector<std::string> availableNumberingSystems = []() {
+        std::vector<std::string> result;
+        UErrorCode status = U_ZERO_ERROR;
         UEnumeration* numberingSystemNames = unumsys_openAvailableNames(&status);
         ASSERT(U_SUCCESS(status));
 
         int32_t resultLength;
         // Numbering system names are always ASCII, so use char[].
-        while (const char* result = uenum_next(numberingSystemNames, &resultLength, &status)) {
+        while (const char* name = uenum_next(numberingSystemNames, &resultLength, &status)) {
             ASSERT(U_SUCCESS(status));
-            auto numsys = unumsys_openByName(result, &status);
+            auto numsys = unumsys_openByName(name, &status);
             ASSERT(U_SUCCESS(status));
             if (!unumsys_isAlgorithmic(numsys)) {
-                availableNumberingSystems.push_back(std::string(result, resultLength));
+                result.push_back(std::string(name, resultLength));
             }
             unumsys_close(numsys);
         }
         uenum_close(numberingSystemNames);
-    }
+        return result;
+    }();
 
-    status = U_ZERO_ERROR;
+    UErrorCode status = U_ZERO_ERROR;
     UNumberingSystem* defaultSystem = unumsys_open(locale->toUTF8StringData().data(), &status);
     ASSERT(U_SUCCESS(status));
     std::string defaultSystemName(unumsys_getName(defaultSystem));
@@ -20,6 +20,7 @@
 #include "Escargot.h"
 #include "IteratorObject.h"
 #include "runtime/Context.h"
+#include "runtime/GlobalObject.h"
 #include "runtime/VMInstance.h"
 #include "runtime/Object.h"
 #include "runtime/ErrorObject.h"
@@ -109,6 +110,62 @@ Value IteratorObject::iteratorStep(ExecutionState& state, const Value& iteratorR
     return done ? Value(Value::False) : result;
 }
 
+IteratorObject* IteratorObject::builtinIteratorWithUntouchedNext(ExecutionState& state, IteratorRecord* record)
+{
+    Value iterator = record->m_iterator;
+    Value nextMethod = record->m_nextMethod;
+    if (!iterator.isObject() || !iterator.asObject()->isIteratorObject() || !nextMethod.isPointerValue()) {
+        return nullptr;
+    }
+
+    // calling built-in next method only advances iterator and creates result object which has data properties
+    // so skipping result object is not observable. receiver checks here should be same as the next methods
+    IteratorObject* iter = iterator.asObject()->asIteratorObject();
+    PointerValue* next = nextMethod.asPointerValue();
+    GlobalObject* globalObject = state.context()->globalObject();
+    if (iter->isArrayIteratorObject()) {
+        if (next == globalObject->arrayIteratorPrototypeNext() && !iter->isArrayIteratorPrototypeObject()) {
+            return iter;
+        }
+    } else if (iter->isStringIteratorObject()) {
+        if (next == globalObject->stringIteratorPrototypeNext()) {
+            return iter;
+        }
+    } else if (iter->isMapIteratorObject()) {
+        if (next == globalObject->mapIteratorPrototypeNext()) {
+            return iter;
+        }
+    } else if (iter->isSetIteratorObject()) {
+        if (next == globalObject->setIteratorPrototypeNext()) {
+            return iter;
+        }
+    }
+    return nullptr;
+}
+
+bool IteratorObject::iteratorStepValue(ExecutionState& state, const Value& iteratorRecord, Value& value)
+{
+    ASSERT(iteratorRecord.isPointerValue() && iteratorRecord.asPointerValue()->isIteratorRecord());
+    IteratorRecord* record = iteratorRecord.asPointerValue()->asIteratorRecord();
+
+    IteratorObject* iter = builtinIteratorWithUntouchedNext(state, record);
+    if (LIKELY(iter != nullptr)) {
+        auto result = iter->advance(state);
+        if (result.second) {
+            return false;
+        }
+        value = result.first;
+        return true;
+    }
+
+    Value next = IteratorObject::iteratorStep(state, iteratorRecord);
+    if (next.isFalse()) {
+        return false;
+    }
+    value = IteratorObject::iteratorValue(state, next);
+    return true;
+}
+
 // https://www.ecma-international.org/ecma-262/10.0/#sec-iteratorclose
 Value IteratorObject::iteratorClose(ExecutionState& state, const Value& iteratorRecord, const Value& completionValue, bool hasThrowOnCompletionType)
 {
@@ -117,6 +117,9 @@ public:
     static bool iteratorComplete(ExecutionState& state, const Value& iterResult);
     static Value iteratorValue(ExecutionState& state, const Value& iterResult);
     static Value iteratorStep(ExecutionState& state, const Value& iteratorRecord);
+    // IteratorStep followed by IteratorValue. returns false if iterator is done
+    // built-in iterators whose next method is not replaced are advanced directly without result object
+    static bool iteratorStepValue(ExecutionState& state, const Value& iteratorRecord, Value& value);
     static Value iteratorClose(ExecutionState& state, const Value& iteratorRecord, const Value& completionValue, bool hasThrowOnCompletionType);
     static Value createIterResultObject(ExecutionState& state, const Value& value, bool done);
 
@@ -125,6 +128,7 @@ public:
     // static Value asyncIteratorClose(ExecutionState& state, const Value& iteratorRecord, const Value& completionValue, bool hasThrowOnCompletionType);
 
 protected:
+    static IteratorObject* builtinIteratorWithUntouchedNext(ExecutionState& state, IteratorRecord* record);
 };
 }
 
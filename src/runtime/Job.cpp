@@ -21,6 +21,7 @@
 #include "Job.h"
 #include "Context.h"
 #include "SandBox.h"
+#include "ScriptAsyncFunctionObject.h"
 
 namespace Escargot {
 
@@ -30,17 +31,28 @@ SandBox::SandBoxResult PromiseReactionJob::run()
     ExecutionState state(relatedContext());
     return sandbox.run([&]() -> Value {
         /* 25.4.2.1.4 Handler is "Identity" case */
-        if (m_reaction.m_handler == (Object*)1) {
+        if (m_reaction.hasSpecialHandler(PromiseReaction::Identity)) {
             Value value[] = { m_argument };
             return Object::call(state, m_reaction.m_capability.m_resolveFunction, Value(), 1, value);
         }
 
         /* 25.4.2.1.5 Handler is "Thrower" case */
-        if (m_reaction.m_handler == (Object*)2) {
+        if (m_reaction.hasSpecialHandler(PromiseReaction::Thrower)) {
             Value value[] = { m_argument };
             return Object::call(state, m_reaction.m_capability.m_rejectFunction, Value(), 1, value);
         }
 
+        /* Handler is Await Fulfilled, Await Rejected Functions case. there is no result capability */
+        if (m_reaction.hasSpecialHandler(PromiseReaction::AwaitFulfilled)) {
+            awaitFulfilledFunctions(state, m_reaction.m_executionPauser, m_argument);
+            return Value();
+        }
+
+        if (m_reaction.hasSpecialHandler(PromiseReaction::AwaitRejected)) {
+            awaitRejectedFunctions(state, m_reaction.m_executionPauser, m_argument);
+            return Value();
+        }
+
         SandBox sb(state.context());
         auto res = sb.run([&]() -> Value {
             Value arguments[] = { m_argument };
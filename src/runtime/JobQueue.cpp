@@ -26,20 +26,48 @@
 
 namespace Escargot {
 
+#define JOB_QUEUE_INITIAL_CAPACITY 16
+
 void JobQueue::enqueueJob(Job* job)
 {
-    m_jobs.push_back(job);
+    if (UNLIKELY(m_size == m_capacity)) {
+        expandBuffer();
+    }
+    m_buffer[(m_head + m_size) & (m_capacity - 1)] = job;
+    m_size++;
+}
+
+void JobQueue::expandBuffer()
+{
+    size_t newCapacity = m_capacity ? m_capacity * 2 : JOB_QUEUE_INITIAL_CAPACITY;
+    Job** newBuffer = (Job**)GC_MALLOC(newCapacity * sizeof(Job*));
+    // unwrap jobs into start of new buffer
+    for (size_t i = 0; i < m_size; i++) {
+        newBuffer[i] = m_buffer[(m_head + i) & (m_capacity - 1)];
+    }
+
+    if (m_buffer) {
+        GC_FREE(m_buffer);
+    }
+    m_buffer = newBuffer;
+    m_capacity = newCapacity;
+    m_head = 0;
 }
 
 void JobQueue::clearJobRelatedWithSpecificContext(Context* context)
 {
-    auto iter = m_jobs.begin();
-    while (iter != m_jobs.end()) {
-        if ((*iter)->relatedContext() == context) {
-            iter = m_jobs.erase(iter);
-        } else {
-            iter++;
+    // compact remaining jobs in order
+    size_t newSize = 0;
+    for (size_t i = 0; i < m_size; i++) {
+        Job* job = m_buffer[(m_head + i) & (m_capacity - 1)];
+        if (job->relatedContext() != context) {
+            m_buffer[(m_head + newSize) & (m_capacity - 1)] = job;
+            newSize++;
         }
     }
+    for (size_t i = newSize; i < m_size; i++) {
+        m_buffer[(m_head + i) & (m_capacity - 1)] = nullptr;
+    }
+    m_size = newSize;
 }
 }
@@ -26,26 +26,43 @@ namespace Escargot {
 
 class ExecutionState;
 
+// jobs are kept in ring buffer allocated by gc
+// so enqueueing a job doesn't allocate until buffer is full
 class JobQueue : public gc {
 public:
-    JobQueue() {}
+    JobQueue()
+        : m_buffer(nullptr)
+        , m_capacity(0)
+        , m_head(0)
+        , m_size(0)
+    {
+    }
+
     void enqueueJob(Job* job);
     void clearJobRelatedWithSpecificContext(Context* context);
     bool hasNextJob()
     {
-        return !m_jobs.empty();
+        return m_size != 0;
     }
 
     Job* nextJob()
     {
-        ASSERT(!m_jobs.empty());
-        Job* job = m_jobs.front();
-        m_jobs.pop_front();
+        ASSERT(m_size != 0);
+        Job* job = m_buffer[m_head];
+        // drop reference from buffer so gc can collect the job after running it
+        m_buffer[m_head] = nullptr;
+        m_head = (m_head + 1) & (m_capacity - 1);
+        m_size--;
         return job;
     }
 
 private:
-    std::list<Job*, gc_allocator<Job*>> m_jobs;
+    void expandBuffer();
+
+    Job** m_buffer;
+    size_t m_capacity; // always power of 2
+    size_t m_head;
+    size_t m_size;
 };
 }
 #endif // __EscargotJobQueue__
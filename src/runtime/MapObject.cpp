@@ -32,8 +32,8 @@ MapObject::MapObject(ExecutionState& state)
 
 void* MapObject::operator new(size_t size)
 {
-    static bool typeInited = false;
-    static GC_descr descr;
+    static std::atomic<bool> typeInited(false);
+    static std::atomic<GC_descr> descr;
     if (!typeInited) {
         GC_word obj_bitmap[GC_BITMAP_SIZE(MapObject)] = { 0 };
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(MapObject, m_structure));
@@ -156,8 +156,8 @@ MapIteratorObject::MapIteratorObject(ExecutionState& state, MapObject* map, Type
 
 void* MapIteratorObject::operator new(size_t size)
 {
-    static bool typeInited = false;
-    static GC_descr descr;
+    static std::atomic<bool> typeInited(false);
+    static std::atomic<GC_descr> descr;
     if (!typeInited) {
         GC_word obj_bitmap[GC_BITMAP_SIZE(MapIteratorObject)] = { 0 };
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(MapIteratorObject, m_structure));
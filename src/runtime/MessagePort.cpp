@@ -0,0 +1,242 @@
+/*
+ * Copyright (c) 2020-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#include "Escargot.h"
+#include "MessagePort.h"
+#include "runtime/Context.h"
+#include "runtime/ArrayBufferObject.h"
+#include "runtime/ErrorObject.h"
+#include "runtime/ValueSerializer.h"
+
+namespace Escargot {
+
+SerializedMessage::~SerializedMessage()
+{
+    // stores of a message which is never received are freed here
+    for (size_t i = 0; i < m_transferredBuffers.size(); i++) {
+        ArrayBufferObjectBackingStore::release(m_transferredBuffers[i]);
+    }
+}
+
+SerializedMessage* SerializedMessage::serialize(ExecutionState& state, const Value& value, const ValueVector& transferList)
+{
+    for (size_t i = 0; i < transferList.size(); i++) {
+        const Value& item = transferList[i];
+        if (!item.isObject() || !item.asObject()->isArrayBufferObject() || item.asObject()->asArrayBufferObject()->isDetachedBuffer()) {
+            ErrorObject::throwBuiltinError(state, ErrorObject::TypeError, "transfer list should contain attached ArrayBuffers");
+        }
+        for (size_t j = 0; j < i; j++) {
+            if (transferList[j] == item) {
+                ErrorObject::throwBuiltinError(state, ErrorObject::TypeError, "transfer list contains same ArrayBuffer twice");
+            }
+        }
+    }
+
+    std::unique_ptr<SerializedMessage> message(new SerializedMessage());
+    ValueSerializer serializer(state, message->m_data, &transferList);
+    serializer.writeHeader();
+    serializer.writeValue(value);
+
+    // backing stores are moved only after whole value is serialized successfully
+    for (size_t i = 0; i < transferList.size(); i++) {
+        message->m_transferredBuffers.push_back(transferList[i].asObject()->asArrayBufferObject()->releaseBuffer(state));
+    }
+
+    return message.release();
+}
+
+Value SerializedMessage::deserialize(ExecutionState& state)
+{
+    ValueDeserializer deserializer(state, m_data.data(), m_data.size(), &m_transferredBuffers);
+    deserializer.readHeader();
+    return deserializer.readValue();
+}
+
+MessageQueue::MessageQueue()
+    : m_head(&m_stub)
+    , m_tail(&m_stub)
+{
+    m_stub.m_next.store(nullptr, std::memory_order_relaxed);
+    m_stub.m_message = nullptr;
+}
+
+MessageQueue::~MessageQueue()
+{
+    while (SerializedMessage* message = pop()) {
+        delete message;
+    }
+}
+
+void MessageQueue::pushNode(Node* node)
+{
+    node->m_next.store(nullptr, std::memory_order_relaxed);
+    Node* prev = m_head.exchange(node, std::memory_order_acq_rel);
+    // consumer can't see node until this store
+    prev->m_next.store(node, std::memory_order_release);
+}
+
+void MessageQueue::push(SerializedMessage* message)
+{
+    Node* node = new Node();
+    node->m_message = message;
+    pushNode(node);
+}
+
+SerializedMessage* MessageQueue::pop()
+{
+    Node* tail = m_tail;
+    Node* next = tail->m_next.load(std::memory_order_acquire);
+    if (tail == &m_stub) {
+        if (!next) {
+            return nullptr;
+        }
+        m_tail = next;
+        tail = next;
+        next = next->m_next.load(std::memory_order_acquire);
+    }
+
+    if (!next) {
+        if (tail != m_head.load(std::memory_order_acquire)) {
+            // producer swapped head but not linked yet
+            return nullptr;
+        }
+        // keep last node in queue by pushing stub behind it
+        pushNode(&m_stub);
+        next = tail->m_next.load(std::memory_order_acquire);
+        if (!next) {
+            return nullptr;
+        }
+    }
+
+    m_tail = next;
+    SerializedMessage* message = tail->m_message;
+    delete tail;
+    return message;
+}
+
+struct MessageChannelSide {
+    MessageQueue m_queue;
+    std::atomic<int64_t> m_messageCount;
+    std::atomic<size_t> m_waiterCount;
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+
+    MessageChannelSide()
+        : m_messageCount(0)
+        , m_waiterCount(0)
+    {
+    }
+
+    void notify()
+    {
+        if (m_waiterCount.load()) {
+            // taking mutex prevents wake up from being lost between test and wait of waiter
+            std::lock_guard<std::mutex> guard(m_mutex);
+            m_condition.notify_all();
+        }
+    }
+};
+
+// shared by two entangled ports. it is deleted with the last port
+class MessageChannel {
+public:
+    MessageChannel()
+        : m_refCount(2)
+        , m_closed(false)
+    {
+    }
+
+    MessageChannelSide m_sides[2];
+    std::atomic<size_t> m_refCount;
+    std::atomic<bool> m_closed;
+};
+
+void MessagePort::createEntangledPair(MessagePort*& port1, MessagePort*& port2)
+{
+    MessageChannel* channel = new MessageChannel();
+    port1 = new MessagePort(channel, 0);
+    port2 = new MessagePort(channel, 1);
+}
+
+MessagePort::~MessagePort()
+{
+    m_channel->m_closed = true;
+    m_channel->m_sides[1 - m_side].notify();
+    if (--m_channel->m_refCount == 0) {
+        delete m_channel;
+    }
+}
+
+void MessagePort::postMessage(ExecutionState& state, const Value& message, const ValueVector& transferList)
+{
+    SerializedMessage* serialized = SerializedMessage::serialize(state, message, transferList);
+    if (UNLIKELY(isClosed())) {
+        // nobody can receive message
+        delete serialized;
+        return;
+    }
+
+    MessageChannelSide& target = m_channel->m_sides[1 - m_side];
+    target.m_queue.push(serialized);
+    target.m_messageCount++;
+    target.notify();
+}
+
+bool MessagePort::hasMessage()
+{
+    return m_channel->m_sides[m_side].m_messageCount.load() > 0;
+}
+
+Value MessagePort::receiveMessage(ExecutionState& state)
+{
+    MessageChannelSide& side = m_channel->m_sides[m_side];
+    std::unique_ptr<SerializedMessage> message(side.m_queue.pop());
+    if (!message) {
+        return Value(Value::EmptyValue);
+    }
+    side.m_messageCount--;
+    return message->deserialize(state);
+}
+
+bool MessagePort::waitForMessage(uint64_t timeoutInMilliseconds)
+{
+    MessageChannelSide& side = m_channel->m_sides[m_side];
+    if (hasMessage()) {
+        return true;
+    }
+
+    std::unique_lock<std::mutex> lock(side.m_mutex);
+    side.m_waiterCount++;
+    auto arrived = [&]() {
+        return side.m_messageCount.load() > 0 || m_channel->m_closed.load();
+    };
+    if (timeoutInMilliseconds == std::numeric_limits<uint64_t>::max()) {
+        side.m_condition.wait(lock, arrived);
+    } else {
+        side.m_condition.wait_for(lock, std::chrono::milliseconds(timeoutInMilliseconds), arrived);
+    }
+    side.m_waiterCount--;
+    return hasMessage();
+}
+
+bool MessagePort::isClosed()
+{
+    return m_channel->m_closed.load();
+}
+}
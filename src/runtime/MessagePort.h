@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2020-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#ifndef __EscargotMessagePort__
+#define __EscargotMessagePort__
+
+#include "runtime/Value.h"
+
+#include <condition_variable>
+
+namespace Escargot {
+
+class ArrayBufferObjectBackingStore;
+
+// Value serialized on sender VMInstance
+// It can be moved to another thread and deserialized on another VMInstance.
+// Backing stores of transferred ArrayBuffers are owned by message until it is deserialized.
+// stores which are never attached are freed through the platform of sender
+class SerializedMessage {
+public:
+    ~SerializedMessage();
+
+    // throws TypeError if value can't be cloned
+    static SerializedMessage* serialize(ExecutionState& state, const Value& value, const ValueVector& transferList);
+    Value deserialize(ExecutionState& state);
+
+private:
+    SerializedMessage() {}
+
+    std::vector<uint8_t> m_data;
+    std::vector<ArrayBufferObjectBackingStore*> m_transferredBuffers;
+};
+
+// Lock-free multi-producer single-consumer queue
+// any thread can push messages, only the thread owning receiving port pops them
+class MessageQueue {
+public:
+    MessageQueue();
+    ~MessageQueue();
+
+    void push(SerializedMessage* message);
+    // returns nullptr if queue is empty or a producer is in the middle of push
+    SerializedMessage* pop();
+
+private:
+    struct Node {
+        std::atomic<Node*> m_next;
+        SerializedMessage* m_message;
+    };
+
+    void pushNode(Node* node);
+
+    std::atomic<Node*> m_head;
+    Node* m_tail;
+    Node m_stub;
+};
+
+class MessageChannel;
+
+// One end of message channel which connects two VMInstances
+// postMessage can be called on any thread. receiving should be done on one thread
+class MessagePort {
+public:
+    static void createEntangledPair(MessagePort*& port1, MessagePort*& port2);
+    ~MessagePort();
+
+    void postMessage(ExecutionState& state, const Value& message, const ValueVector& transferList);
+
+    bool hasMessage();
+    // returns empty value if there is no message
+    Value receiveMessage(ExecutionState& state);
+    // returns true when message arrives before timeout
+    // returns false on timeout or when entangled port is destroyed
+    bool waitForMessage(uint64_t timeoutInMilliseconds);
+
+    // entangled port is destroyed
+    bool isClosed();
+
+private:
+    MessagePort(MessageChannel* channel, size_t side)
+        : m_channel(channel)
+        , m_side(side)
+    {
+    }
+
+    MessageChannel* m_channel;
+    size_t m_side;
+};
+}
+
+#endif
@@ -24,6 +24,8 @@
 
 namespace Escargot {
 
+size_t g_nativeFunctionObjectTag;
+
 // function for derived classes. derived class MUST initlize member variable of FunctionObject.
 NativeFunctionObject::NativeFunctionObject(ExecutionState& state, size_t defaultSpace)
     : FunctionObject(state, defaultSpace)
@@ -24,6 +24,8 @@
 
 namespace Escargot {
 
+extern size_t g_nativeFunctionObjectTag;
+
 class NativeFunctionObject : public FunctionObject {
 public:
     NativeFunctionObject(ExecutionState& state, NativeFunctionInfo info);
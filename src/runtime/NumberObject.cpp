@@ -35,8 +35,8 @@ NumberObject::NumberObject(ExecutionState& state, double value)
 
 void* NumberObject::operator new(size_t size)
 {
-    static bool typeInited = false;
-    static GC_descr descr;
+    static std::atomic<bool> typeInited(false);
+    static std::atomic<GC_descr> descr;
     if (!typeInited) {
         GC_word obj_bitmap[GC_BITMAP_SIZE(NumberObject)] = { 0 };
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(NumberObject, m_structure));
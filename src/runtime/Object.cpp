@@ -102,8 +102,8 @@ ObjectRareData::ObjectRareData(Object* obj)
 
 void* ObjectRareData::operator new(size_t size)
 {
-    static bool typeInited = false;
-    static GC_descr descr;
+    static std::atomic<bool> typeInited(false);
+    static std::atomic<GC_descr> descr;
     if (!typeInited) {
         GC_word obj_bitmap[GC_BITMAP_SIZE(ObjectRareData)] = { 0 };
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(ObjectRareData, m_prototype));
@@ -427,6 +427,7 @@ Object::Object(ExecutionState& state, size_t defaultSpace, bool initPlainArea)
     : m_structure(state.context()->defaultStructureForObject())
     , m_prototype(nullptr)
 {
+    AllocationProfiler::recordAllocation(this);
     m_values.resizeWithUninitializedValues(0, defaultSpace);
     if (initPlainArea) {
         initPlainObject(state);
@@ -436,6 +437,7 @@ Object::Object(ExecutionState& state, size_t defaultSpace, bool initPlainArea)
 Object::Object(ExecutionState& state)
     : m_structure(state.context()->defaultStructureForObject())
 {
+    AllocationProfiler::recordAllocation(this);
     m_values.resizeWithUninitializedValues(0, ESCARGOT_OBJECT_BUILTIN_PROPERTY_NUMBER);
     initPlainObject(state);
 }
@@ -467,7 +469,10 @@ Object* Object::createBuiltinObjectPrototype(ExecutionState& state)
     Object* obj = new Object(state, ESCARGOT_OBJECT_BUILTIN_PROPERTY_NUMBER, false);
     obj->m_structure = state.context()->defaultStructureForObject();
     obj->m_prototype = nullptr;
-    g_objectTag = *((size_t*)obj);
+    static std::once_flag initializeTagOnce;
+    std::call_once(initializeTagOnce, [obj]() {
+        g_objectTag = *((size_t*)obj);
+    });
     return obj;
 }
 
@@ -1541,6 +1546,41 @@ ALWAYS_INLINE static void enumerableOwnPropertiesPushResult(ExecutionState& stat
 ValueVectorWithInlineStorage Object::enumerableOwnProperties(ExecutionState& state, Object* object, EnumerableOwnPropertiesType kind)
 {
     // https://www.ecma-international.org/ecma-262/8.0/#sec-enumerableownproperties
+    if (object->hasTag(g_objectTag) && !object->structure()->hasIndexPropertyName()) {
+        // FAST PATH for ordinary object
+        // order of ObjectStructure is same as [[OwnPropertyKeys]] when there is no index property name
+        // values are read from m_values directly because there is no code which can modify object during this loop
+        ObjectStructure* structure = object->structure();
+        ValueVectorWithInlineStorage properties;
+        size_t count = structure->propertyCount();
+        size_t i = 0;
+        for (; i < count; i++) {
+            const ObjectStructureItem& item = structure->readProperty(i);
+            if (!item.m_propertyName.isPlainString() || !item.m_descriptor.isEnumerable()) {
+                continue;
+            }
+            if (!item.m_descriptor.isPlainDataProperty()) {
+                // accessor can modify object. use generic path below
+                break;
+            }
+
+            Value key = item.m_propertyName.toValue();
+            if (kind == EnumerableOwnPropertiesType::Key) {
+                properties.pushBack(key);
+            } else if (kind == EnumerableOwnPropertiesType::Value) {
+                properties.pushBack(object->m_values[i]);
+            } else {
+                ASSERT(kind == EnumerableOwnPropertiesType::KeyAndValue);
+                Value v[2] = { key, object->m_values[i] };
+                properties.pushBack(Object::createArrayFromList(state, 2, v));
+            }
+        }
+
+        if (i == count) {
+            return properties;
+        }
+    }
+
     if (object->canUseOwnPropertyKeysFastPath()) {
         // FAST PATH
         Object::OwnPropertyKeyAndDescVector ownKeysAndDesc = object->ownPropertyKeysFastPath(state);
@@ -1599,6 +1639,89 @@ ValueVectorWithInlineStorage Object::enumerableOwnProperties(ExecutionState& sta
     return properties;
 }
 
+ArrayObject* Object::enumerableOwnPropertyKeysArray(ExecutionState& state, Object* object)
+{
+    ObjectStructure* structure = object->structure();
+    // structure in transition mode is shared and never changed, so its key list can be reused
+    if (object->hasTag(g_objectTag) && !structure->hasIndexPropertyName() && structure->inTransitionMode()) {
+        auto cache = state.context()->objectKeysCache();
+        auto iter = cache->find(structure);
+        if (iter != cache->end()) {
+            // cache can be cleared by gc while creating array. keep key list on stack
+            ValueVector* keys = iter->second;
+            return Object::createArrayFromList(state, *keys);
+        }
+
+        ValueVector* keys = new ValueVector();
+        size_t count = structure->propertyCount();
+        for (size_t i = 0; i < count; i++) {
+            const ObjectStructureItem& item = structure->readProperty(i);
+            if (item.m_propertyName.isPlainString() && item.m_descriptor.isEnumerable()) {
+                keys->pushBack(item.m_propertyName.toValue());
+            }
+        }
+        cache->insert(std::make_pair(structure, keys));
+        return Object::createArrayFromList(state, *keys);
+    }
+
+    auto nameList = Object::enumerableOwnProperties(state, object, EnumerableOwnPropertiesType::Key);
+    return Object::createArrayFromList(state, nameList.size(), nameList.data());
+}
+
+bool Object::tryToAssignByStructure(ExecutionState& state, Object* target, Object* source)
+{
+    // target should be empty extensible ordinary object
+    if (!target->hasTag(g_objectTag) || target->structure() != state.context()->defaultStructureForObject() || !target->isExtensible(state) || target->isEverSetAsPrototypeObject()) {
+        return false;
+    }
+
+    // source structure is shared by target, so it should be in transition mode
+    // every property should be same as a property created by Set
+    ObjectStructure* structure = source->structure();
+    if (!source->hasTag(g_objectTag) || !structure->inTransitionMode() || structure->hasIndexPropertyName()) {
+        return false;
+    }
+    size_t count = structure->propertyCount();
+    if (count == 0) {
+        return true;
+    }
+    for (size_t i = 0; i < count; i++) {
+        const ObjectStructurePropertyDescriptor& desc = structure->readProperty(i).m_descriptor;
+        if (!desc.isPlainDataProperty() || !desc.isWritable() || !desc.isEnumerable() || !desc.isConfigurable()) {
+            return false;
+        }
+    }
+
+    // Set on target reaches prototype chain for new properties
+    // setter or non-writable property of prototype should be handled by generic path
+    Object* proto = target->getPrototypeObject(state);
+    while (proto) {
+        if (!proto->hasTag(g_objectTag)) {
+            return false;
+        }
+        ObjectStructure* protoStructure = proto->structure();
+        if (protoStructure->propertyCount()) {
+            for (size_t i = 0; i < count; i++) {
+                auto result = protoStructure->findProperty(structure->readProperty(i).m_propertyName);
+                if (result.first != SIZE_MAX) {
+                    const ObjectStructurePropertyDescriptor& desc = result.second.value()->m_descriptor;
+                    if (!desc.isPlainDataProperty() || !desc.isWritable()) {
+                        return false;
+                    }
+                }
+            }
+        }
+        proto = proto->getPrototypeObject(state);
+    }
+
+    target->m_values.resizeWithUninitializedValues(0, count);
+    for (size_t i = 0; i < count; i++) {
+        target->m_values[i] = source->m_values[i];
+    }
+    target->m_structure = structure;
+    return true;
+}
+
 Value Object::speciesConstructor(ExecutionState& state, const Value& defaultConstructor)
 {
     ASSERT(isObject());
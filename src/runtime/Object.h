@@ -715,6 +715,8 @@ class Object : public PointerValue {
     friend class EnumerateObjectWithDestruction;
     friend class EnumerateObjectWithIteration;
     friend struct ObjectRareData;
+    friend class ValueSerializer;
+    friend class ValueDeserializer;
     static Object* createBuiltinObjectPrototype(ExecutionState& state);
 
 public:
@@ -1044,6 +1046,12 @@ public:
     static ArrayObject* createArrayFromList(ExecutionState& state, const ValueVector& elements);
     static ValueVector createListFromArrayLike(ExecutionState& state, Value obj, uint8_t types = (uint8_t)ElementTypes::ALL);
     static ValueVectorWithInlineStorage enumerableOwnProperties(ExecutionState& state, Object* object, EnumerableOwnPropertiesType kind);
+    // same as CreateArrayFromList(EnumerableOwnProperties(object, "key"))
+    // key list of ordinary object is cached per ObjectStructure
+    static ArrayObject* enumerableOwnPropertyKeysArray(ExecutionState& state, Object* object);
+    // copy own properties of source into empty target by sharing ObjectStructure of source
+    // returns false when the copy could be observed differently from Set of each property
+    static bool tryToAssignByStructure(ExecutionState& state, Object* target, Object* source);
 
     // this function differ with defineOwnProperty.
     // !hasOwnProperty(state, P) is needed for success
@@ -1170,6 +1178,11 @@ protected:
     void markAsPrototypeObject(ExecutionState& state);
     void deleteOwnProperty(ExecutionState& state, size_t idx);
 };
+
+// enumerable own string keys of ordinary objects which have same ObjectStructure
+typedef std::unordered_map<ObjectStructure*, ValueVector*, std::hash<ObjectStructure*>, std::equal_to<ObjectStructure*>,
+                           GCUtil::gc_malloc_allocator<std::pair<ObjectStructure* const, ValueVector*>>>
+    ObjectKeysCacheMap;
 }
 
 #endif
@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2020-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#include "Escargot.h"
+#include "ObjectTemplate.h"
+#include "runtime/Context.h"
+#include "runtime/GlobalObject.h"
+
+namespace Escargot {
+
+TemplateObject::TemplateObject(ExecutionState& state, ObjectStructure* structure, const SmallValueVector& values, Object* prototype, size_t internalFieldCount)
+    : Object(state, values.size(), false)
+    , m_internalFieldCount(internalFieldCount)
+{
+    m_structure = structure;
+    memcpy(m_values.data(), values.data(), sizeof(SmallValue) * values.size());
+    for (size_t i = 0; i < internalFieldCount; i++) {
+        internalFields()[i] = nullptr;
+    }
+
+    if (prototype == state.context()->globalObject()->objectPrototype()) {
+        initPlainObject(state);
+    } else {
+        Object::setPrototypeForIntrinsicObjectCreation(state, prototype);
+    }
+}
+
+void* TemplateObject::operator new(size_t size, size_t internalFieldCount)
+{
+    // internal fields can hold gc-allocated pointers
+    return GC_MALLOC(size + sizeof(void*) * internalFieldCount);
+}
+
+ObjectTemplate::ObjectTemplate(size_t internalFieldCount)
+    : m_internalFieldCount(internalFieldCount)
+    , m_propertyVersion(0)
+{
+}
+
+void ObjectTemplate::set(const Value& propertyName, const Value& value, ObjectStructurePropertyDescriptor::PresentAttribute attribute)
+{
+    addProperty(propertyName, ObjectStructurePropertyDescriptor::createDataDescriptor(attribute), value);
+}
+
+void ObjectTemplate::setNativeDataAccessorProperty(const Value& propertyName, ObjectPropertyNativeGetterSetterData* data, const Value& privateData)
+{
+    addProperty(propertyName, ObjectStructurePropertyDescriptor::createDataButHasNativeGetterSetterDescriptor(data), privateData);
+}
+
+void ObjectTemplate::addProperty(const Value& propertyName, const ObjectStructurePropertyDescriptor& desc, const Value& value)
+{
+    ASSERT(propertyName.isString() || propertyName.isSymbol());
+    m_propertyVersion++;
+
+    for (size_t i = 0; i < m_propertyNames.size(); i++) {
+        const Value& name = m_propertyNames[i].m_name;
+        bool isSame = name.isString() ? (propertyName.isString() && name.asString()->equals(propertyName.asString())) : (name == propertyName);
+        if (isSame) {
+            // redefinition replaces old property
+            m_propertyNames[i].m_descriptor = desc;
+            m_values[i] = value;
+            return;
+        }
+    }
+
+    m_propertyNames.pushBack(TemplatePropertyName(propertyName, desc));
+    m_values.pushBack(value);
+}
+
+ObjectStructure* ObjectTemplate::structureFor(ExecutionState& state)
+{
+    Context* context = state.context();
+    ObjectTemplateStructureCache* cache = context->objectTemplateStructureCache();
+    auto iter = cache->find(this);
+    if (iter != cache->end() && iter->second.m_propertyVersion == m_propertyVersion) {
+        return iter->second.m_structure;
+    }
+
+    ObjectStructure* structure = context->defaultStructureForObject();
+    for (size_t i = 0; i < m_propertyNames.size(); i++) {
+        structure = structure->addProperty(ObjectStructurePropertyName(state, m_propertyNames[i].m_name), m_propertyNames[i].m_descriptor);
+    }
+
+    // structure without transition is owned by one object
+    // so only structure in transition mode can be shared with every instance
+    if (structure->inTransitionMode()) {
+        ObjectTemplateCachedStructure cachedStructure;
+        cachedStructure.m_propertyVersion = m_propertyVersion;
+        cachedStructure.m_structure = structure;
+        (*cache)[this] = cachedStructure;
+    } else if (iter != cache->end()) {
+        cache->erase(iter);
+    }
+
+    return structure;
+}
+
+Object* ObjectTemplate::instantiate(ExecutionState& state)
+{
+    return instantiate(state, state.context()->globalObject()->objectPrototype());
+}
+
+Object* ObjectTemplate::instantiate(ExecutionState& state, Object* prototype)
+{
+    ObjectStructure* structure = structureFor(state);
+    return new (m_internalFieldCount) TemplateObject(state, structure, m_values, prototype, m_internalFieldCount);
+}
+}
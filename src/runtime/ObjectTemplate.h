@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2020-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#ifndef __EscargotObjectTemplate__
+#define __EscargotObjectTemplate__
+
+#include "runtime/Object.h"
+
+namespace Escargot {
+
+// Object created by ObjectTemplate
+// internal fields are allocated right after object in same memory block
+class TemplateObject : public Object {
+    friend class ObjectTemplate;
+
+public:
+    virtual bool isTemplateObject() const
+    {
+        return true;
+    }
+
+    size_t internalFieldCount() const
+    {
+        return m_internalFieldCount;
+    }
+
+    void* internalField(size_t idx)
+    {
+        ASSERT(idx < m_internalFieldCount);
+        return internalFields()[idx];
+    }
+
+    void setInternalField(size_t idx, void* value)
+    {
+        ASSERT(idx < m_internalFieldCount);
+        internalFields()[idx] = value;
+    }
+
+    void* operator new(size_t size, size_t internalFieldCount);
+    void* operator new(size_t size) = delete;
+    void* operator new[](size_t size) = delete;
+
+private:
+    TemplateObject(ExecutionState& state, ObjectStructure* structure, const SmallValueVector& values, Object* prototype, size_t internalFieldCount);
+
+    void** internalFields()
+    {
+        return reinterpret_cast<void**>(this + 1);
+    }
+
+    size_t m_internalFieldCount;
+};
+
+// ObjectTemplate keeps list of properties and builds ObjectStructure for them once per Context
+// Every instance of template shares the structure, so inline caches work for them
+// Property values(or private data of native accessor) are copied into instance without structure transition
+// Structures are cached in Context(see Context::objectTemplateStructureCache) because template can outlive Contexts
+// NOTE property values are shared by instances of every Context. object values of one Context become reachable from others
+class ObjectTemplate : public gc {
+public:
+    explicit ObjectTemplate(size_t internalFieldCount = 0);
+
+    size_t internalFieldCount() const
+    {
+        return m_internalFieldCount;
+    }
+
+    // propertyName should be String or Symbol
+    // adding property after instantiation is allowed but cached structures are rebuilt
+    void set(const Value& propertyName, const Value& value, ObjectStructurePropertyDescriptor::PresentAttribute attribute);
+    void setNativeDataAccessorProperty(const Value& propertyName, ObjectPropertyNativeGetterSetterData* data, const Value& privateData);
+
+    // instance has Object.prototype of context as prototype
+    Object* instantiate(ExecutionState& state);
+    Object* instantiate(ExecutionState& state, Object* prototype);
+
+private:
+    struct TemplatePropertyName {
+        Value m_name;
+        ObjectStructurePropertyDescriptor m_descriptor;
+
+        TemplatePropertyName(const Value& name, const ObjectStructurePropertyDescriptor& desc)
+            : m_name(name)
+            , m_descriptor(desc)
+        {
+        }
+    };
+
+    void addProperty(const Value& propertyName, const ObjectStructurePropertyDescriptor& desc, const Value& value);
+    ObjectStructure* structureFor(ExecutionState& state);
+
+    size_t m_internalFieldCount;
+    Vector<TemplatePropertyName, GCUtil::gc_malloc_allocator<TemplatePropertyName>> m_propertyNames;
+    SmallValueVector m_values;
+    // increased when properties are changed. structures cached with old version are rebuilt
+    size_t m_propertyVersion;
+};
+}
+
+#endif
@@ -34,6 +34,12 @@ public:
     // ArrayBuffer
     virtual void* onArrayBufferObjectDataBufferMalloc(Context* whereObjectMade, ArrayBufferObject* obj, size_t sizeInByte) = 0;
     virtual void onArrayBufferObjectDataBufferFree(Context* whereObjectMade, ArrayBufferObject* obj, void* buffer) = 0;
+    // platforms returning same value free data allocated by each other.
+    // data of transferred ArrayBuffer moves between them, and it is copied between other platforms
+    virtual void* arrayBufferAllocatorIdentity()
+    {
+        return this;
+    }
 
     // Promise
     virtual void didPromiseJobEnqueued(Context* relatedContext, PromiseObject* obj) = 0;
@@ -45,6 +51,21 @@ public:
         int errorCode;
     };
     virtual LoadModuleResult onLoadModule(Context* relatedContext, Script* whereRequestFrom, String* moduleSrc) = 0;
+    struct ModuleRequest {
+        Script* whereRequestFrom;
+        String* moduleSrc;
+    };
+    typedef Vector<ModuleRequest, GCUtil::gc_malloc_allocator<ModuleRequest>> ModuleRequestVector;
+    typedef Vector<LoadModuleResult, GCUtil::gc_malloc_allocator<LoadModuleResult>> LoadModuleResultVector;
+    // loads every module requested in one level of module graph. results are in same order with requests
+    virtual LoadModuleResultVector onLoadModules(Context* relatedContext, const ModuleRequestVector& requests)
+    {
+        LoadModuleResultVector results;
+        for (size_t i = 0; i < requests.size(); i++) {
+            results.push_back(onLoadModule(relatedContext, requests[i].whereRequestFrom, requests[i].moduleSrc));
+        }
+        return results;
+    }
     virtual void didLoadModule(Context* relatedContext, Optional<Script*> whereRequestFrom, Script* loadedModule) = 0;
 };
 }
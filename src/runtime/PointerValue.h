@@ -57,6 +57,7 @@ class WeakMapObject;
 class WeakSetObject;
 class GeneratorObject;
 class IteratorRecord;
+class TemplateObject;
 
 #define POINTER_VALUE_STRING_TAG_IN_DATA 0x1
 #define POINTER_VALUE_SYMBOL_TAG_IN_DATA 0x2
@@ -341,6 +342,11 @@ public:
         return false;
     }
 
+    virtual bool isTemplateObject() const
+    {
+        return false;
+    }
+
     virtual bool isCallable() const
     {
         return false;
@@ -555,6 +561,12 @@ public:
         return (IteratorRecord*)this;
     }
 
+    TemplateObject* asTemplateObject()
+    {
+        ASSERT(isTemplateObject());
+        return (TemplateObject*)this;
+    }
+
     bool hasTag(const size_t tag) const
     {
         return tag == *((size_t*)(this));
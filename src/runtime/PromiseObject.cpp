@@ -40,8 +40,8 @@ PromiseObject::PromiseObject(ExecutionState& state)
 
 void* PromiseObject::operator new(size_t size)
 {
-    static bool typeInited = false;
-    static GC_descr descr;
+    static std::atomic<bool> typeInited(false);
+    static std::atomic<GC_descr> descr;
     if (!typeInited) {
         GC_word obj_bitmap[GC_BITMAP_SIZE(PromiseObject)] = { 0 };
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(PromiseObject, m_structure));
@@ -156,8 +156,8 @@ PromiseObject* PromiseObject::catchOperation(ExecutionState& state, Value handle
 
 Optional<PromiseObject*> PromiseObject::then(ExecutionState& state, Value onFulfilledValue, Value onRejectedValue, Optional<PromiseReaction::Capability> resultCapability)
 {
-    Object* onFulfilled = onFulfilledValue.isCallable() ? onFulfilledValue.asObject() : (Object*)(1);
-    Object* onRejected = onRejectedValue.isCallable() ? onRejectedValue.asObject() : (Object*)(2);
+    Object* onFulfilled = onFulfilledValue.isCallable() ? onFulfilledValue.asObject() : PromiseReaction::specialHandler(PromiseReaction::Identity);
+    Object* onRejected = onRejectedValue.isCallable() ? onRejectedValue.asObject() : PromiseReaction::specialHandler(PromiseReaction::Thrower);
 
     PromiseReaction::Capability capability = resultCapability.hasValue() ? resultCapability.value() : PromiseReaction::Capability(Value(Value::EmptyValue), nullptr, nullptr);
 
@@ -187,6 +187,30 @@ Optional<PromiseObject*> PromiseObject::then(ExecutionState& state, Value onFulf
     }
 }
 
+void PromiseObject::thenForAwait(ExecutionState& state, ExecutionPauser* executionPauser)
+{
+    switch (this->state()) {
+    case PromiseObject::PromiseState::Pending: {
+        m_fulfillReactions.push_back(PromiseReaction(PromiseReaction::AwaitFulfilled, executionPauser));
+        m_rejectReactions.push_back(PromiseReaction(PromiseReaction::AwaitRejected, executionPauser));
+        break;
+    }
+    case PromiseObject::PromiseState::FulFilled: {
+        // already settled promise resumes async function on next job without keeping reactions
+        Job* job = new PromiseReactionJob(state.context(), PromiseReaction(PromiseReaction::AwaitFulfilled, executionPauser), promiseResult());
+        state.context()->vmInstance()->enqueuePromiseJob(this, job);
+        break;
+    }
+    case PromiseObject::PromiseState::Rejected: {
+        Job* job = new PromiseReactionJob(state.context(), PromiseReaction(PromiseReaction::AwaitRejected, executionPauser), promiseResult());
+        state.context()->vmInstance()->enqueuePromiseJob(this, job);
+        break;
+    }
+    default:
+        break;
+    }
+}
+
 void PromiseObject::triggerPromiseReactions(ExecutionState& state, PromiseObject::Reactions& reactions)
 {
     for (size_t i = 0; i < reactions.size(); i++) {
@@ -194,6 +218,38 @@ void PromiseObject::triggerPromiseReactions(ExecutionState& state, PromiseObject
     }
 }
 
+// steps of Promise Resolve Functions after [[AlreadyResolved]] is checked and set
+static void resolvePromise(ExecutionState& state, PromiseObject* promise, const Value& resolutionValue)
+{
+    auto strings = &state.context()->staticStrings();
+    if (resolutionValue == Value(promise)) {
+        promise->reject(state, new TypeErrorObject(state, new ASCIIString("Self resolution error")));
+        return;
+    }
+
+    if (!resolutionValue.isObject()) {
+        promise->fulfill(state, resolutionValue);
+        return;
+    }
+    Object* resolution = resolutionValue.asObject();
+
+    SandBox sb(state.context());
+    auto res = sb.run([&]() -> Value {
+        return resolution->get(state, strings->then).value(state, resolution);
+    });
+    if (!res.error.isEmpty()) {
+        promise->reject(state, res.error);
+        return;
+    }
+    Value then = res.result;
+
+    if (then.isCallable()) {
+        state.context()->vmInstance()->enqueuePromiseJob(promise, new PromiseResolveThenableJob(state.context(), promise, resolution, then.asObject()));
+    } else {
+        promise->fulfill(state, resolution);
+    }
+}
+
 // http://www.ecma-international.org/ecma-262/10.0/#sec-promise-resolve
 // The abstract operation PromiseResolve, given a constructor and a value, returns a new promise resolved with that value.
 Value promiseResolve(ExecutionState& state, Object* C, const Value& x)
@@ -207,6 +263,15 @@ Value promiseResolve(ExecutionState& state, Object* C, const Value& x)
             return x.asObject()->asPromiseObject();
         }
     }
+
+    if (C == state.context()->globalObject()->promise()) {
+        // capability of %Promise% cannot be observed by user code
+        // so promise is resolved directly without executor, resolving functions
+        PromiseObject* promise = new PromiseObject(state);
+        resolvePromise(state, promise, x);
+        return promise;
+    }
+
     // Let promiseCapability be ? NewPromiseCapability(C).
     PromiseReaction::Capability capability = PromiseObject::newPromiseCapability(state, C);
 
@@ -249,35 +314,7 @@ Value promiseResolveFunctions(ExecutionState& state, Value thisValue, size_t arg
         return Value();
     alreadyResolved->setThrowsException(state, strings->value, Value(true), alreadyResolved);
 
-    Value resolutionValue = argv[0];
-    if (resolutionValue == Value(promise)) {
-        promise->reject(state, new TypeErrorObject(state, new ASCIIString("Self resolution error")));
-        return Value();
-    }
-
-    if (!resolutionValue.isObject()) {
-        promise->fulfill(state, resolutionValue);
-        return Value();
-    }
-    Object* resolution = resolutionValue.asObject();
-
-    SandBox sb(state.context());
-    auto res = sb.run([&]() -> Value {
-        return resolution->get(state, strings->then).value(state, resolution);
-    });
-    if (!res.error.isEmpty()) {
-        promise->reject(state, res.error);
-        return Value();
-    }
-    Value then = res.result;
-
-    if (then.isCallable()) {
-        state.context()->vmInstance()->enqueuePromiseJob(promise, new PromiseResolveThenableJob(state.context(), promise, resolution, then.asObject()));
-    } else {
-        promise->fulfill(state, resolution);
-        return Value();
-    }
-
+    resolvePromise(state, promise, argv[0]);
     return Value();
 }
 
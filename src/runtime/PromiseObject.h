@@ -24,6 +24,8 @@
 
 namespace Escargot {
 
+class ExecutionPauser;
+
 struct PromiseReaction {
 public:
     struct Capability {
@@ -54,21 +56,51 @@ public:
         Object* m_rejectFunction;
     };
 
+    // m_handler can be one of these values instead of function object
+    enum SpecialHandler : size_t {
+        Identity = 1,
+        Thrower = 2,
+        AwaitFulfilled = 3, // Await Fulfilled Functions
+        AwaitRejected = 4, // Await Rejected Functions
+    };
+
+    static Object* specialHandler(SpecialHandler handler)
+    {
+        return reinterpret_cast<Object*>((size_t)handler);
+    }
+
+    bool hasSpecialHandler(SpecialHandler handler) const
+    {
+        return m_handler == specialHandler(handler);
+    }
+
     PromiseReaction()
         : m_capability()
         , m_handler(nullptr)
+        , m_executionPauser(nullptr)
     {
     }
 
     PromiseReaction(Object* handler, const Capability& capability)
         : m_capability(capability)
         , m_handler(handler)
+        , m_executionPauser(nullptr)
     {
     }
 
+    // reaction of Await resumes async function directly
+    // instead of creating Await Fulfilled, Await Rejected function objects
+    PromiseReaction(SpecialHandler handler, ExecutionPauser* executionPauser)
+        : m_capability()
+        , m_handler(specialHandler(handler))
+        , m_executionPauser(executionPauser)
+    {
+        ASSERT(handler == AwaitFulfilled || handler == AwaitRejected);
+    }
 
     Capability m_capability;
     Object* m_handler;
+    ExecutionPauser* m_executionPauser;
 };
 
 class PromiseObject : public Object {
@@ -121,6 +153,9 @@ public:
     // http://www.ecma-international.org/ecma-262/10.0/#sec-performpromisethen
     // You can get return value when you give resultCapability
     Optional<PromiseObject*> then(ExecutionState& state, Value onFulfilled, Value onRejected, Optional<PromiseReaction::Capability> resultCapability);
+    // PerformPromiseThen(promise, onFulfilled, onRejected) of Await
+    // http://www.ecma-international.org/ecma-262/10.0/#await
+    void thenForAwait(ExecutionState& state, ExecutionPauser* executionPauser);
 
     void* operator new(size_t size);
     void* operator new[](size_t size) = delete;
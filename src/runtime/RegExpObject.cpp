@@ -89,8 +89,8 @@ void RegExpObject::initRegExpObject(ExecutionState& state, bool hasLastIndex)
 
 void* RegExpObject::operator new(size_t size)
 {
-    static bool typeInited = false;
-    static GC_descr descr;
+    static std::atomic<bool> typeInited(false);
+    static std::atomic<GC_descr> descr;
     if (!typeInited) {
         GC_word obj_bitmap[GC_BITMAP_SIZE(RegExpObject)] = { 0 };
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(RegExpObject, m_structure));
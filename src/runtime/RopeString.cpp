@@ -21,13 +21,14 @@
 #include "RopeString.h"
 #include "StringBuilder.h"
 #include "ErrorObject.h"
+#include "AllocationProfiler.h"
 
 namespace Escargot {
 
 void* RopeString::operator new(size_t size)
 {
-    static bool typeInited = false;
-    static GC_descr descr;
+    static std::atomic<bool> typeInited(false);
+    static std::atomic<GC_descr> descr;
     if (!typeInited) {
         GC_word obj_bitmap[GC_BITMAP_SIZE(RopeString)] = { 0 };
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(RopeString, m_left));
@@ -35,7 +36,19 @@ void* RopeString::operator new(size_t size)
         descr = GC_make_descriptor(obj_bitmap, GC_WORD_LEN(RopeString));
         typeInited = true;
     }
-    return GC_MALLOC_EXPLICITLY_TYPED(size, descr);
+    void* ptr = GC_MALLOC_EXPLICITLY_TYPED(size, descr);
+    AllocationProfiler::recordAllocation(ptr);
+    return ptr;
+}
+
+template <typename ResultType>
+static void copyBufferAccessData(ResultType* result, const StringBufferAccessData& data)
+{
+    if (data.has8BitContent) {
+        StringKernels::copy(result, (const LChar*)data.buffer, data.length);
+    } else {
+        StringKernels::copy(result, (const char16_t*)data.buffer, data.length);
+    }
 }
 
 String* RopeString::createRopeString(String* lstr, String* rstr, ExecutionState* state)
@@ -59,16 +72,8 @@ String* RopeString::createRopeString(String* lstr, String* rstr, ExecutionState*
             ret.resizeWithUninitializedValues(len);
 
             LChar* result = ret.data();
-            const LChar* buffer = (const LChar*)lData.buffer;
-            for (size_t i = 0; i < lData.length; i++) {
-                result[i] = buffer[i];
-            }
-
-            result += lData.length;
-            buffer = (const LChar*)rData.buffer;
-            for (size_t i = 0; i < rData.length; i++) {
-                result[i] = buffer[i];
-            }
+            copyBufferAccessData(result, lData);
+            copyBufferAccessData(result + lData.length, rData);
             return new Latin1String(std::move(ret));
         } else {
             StringBuilder builder;
@@ -82,6 +87,15 @@ String* RopeString::createRopeString(String* lstr, String* rstr, ExecutionState*
         ErrorObject::throwBuiltinError(*state, ErrorObject::RangeError, errorMessage_String_InvalidStringLength);
     }
 
+    if (lstr->isRopeString() && rlen <= llen) {
+        // appending short string to string made by concatenation (like `s += chunk` in loop)
+        // we can reuse spare capacity of left flat buffer instead of building deep rope tree
+        RopeString* left = (RopeString*)lstr;
+        if (left->m_bufferData.hasSpecialImpl || left->isExtensible()) {
+            return appendToExtensibleString(left, rstr);
+        }
+    }
+
     RopeString* rope = new RopeString();
     rope->m_bufferData.length = llen + rlen;
     rope->m_left = lstr;
@@ -105,10 +119,71 @@ String* RopeString::createRopeString(String* lstr, String* rstr, ExecutionState*
     return rope;
 }
 
+// reserves half of length for next appends(1.5x growth)
+// slack is bounded so that building a large string doesn't keep much unused memory
+static size_t computeExtensibleCapacity(size_t length)
+{
+    size_t slack = std::min(length / 2, (size_t)ROPE_STRING_EXTENSIBLE_SLACK_MAX);
+    return length + std::max(slack, (size_t)ROPE_STRING_MIN_LENGTH);
+}
+
+String* RopeString::appendToExtensibleString(RopeString* lstr, String* rstr)
+{
+    size_t llen = lstr->length();
+    size_t newLength = llen + rstr->length();
+    bool l8bit = lstr->m_bufferData.has8BitContent;
+    bool is8Bit = l8bit && rstr->has8BitContent();
+    size_t newCapacity = computeExtensibleCapacity(newLength);
+
+    if (lstr->m_bufferData.hasSpecialImpl) {
+        // flatten left string into buffer which has room for rstr
+        // if result needs 16bit buffer, left buffer will be copied(widened) below anyway
+        lstr->flattenRopeString(is8Bit == l8bit ? newCapacity : 0);
+    }
+
+    RopeString* result = new RopeString();
+    result->m_left = nullptr;
+    result->m_bufferData.hasSpecialImpl = false;
+    result->m_bufferData.has8BitContent = is8Bit;
+    result->m_bufferData.length = newLength;
+
+    void* buffer;
+    if (is8Bit == l8bit && lstr->m_extensibleCapacity >= newLength) {
+        // append in-place. lstr still sees its own prefix of buffer only
+        buffer = const_cast<void*>(lstr->m_bufferData.buffer);
+        result->m_extensibleCapacity = lstr->m_extensibleCapacity;
+    } else {
+        if (is8Bit) {
+            buffer = GC_MALLOC_ATOMIC(sizeof(LChar) * newCapacity);
+            copyBufferAccessData((LChar*)buffer, lstr->m_bufferData);
+        } else {
+            buffer = GC_MALLOC_ATOMIC(sizeof(char16_t) * newCapacity);
+            copyBufferAccessData((char16_t*)buffer, lstr->m_bufferData);
+        }
+        result->m_extensibleCapacity = newCapacity;
+    }
+    result->m_bufferData.buffer = buffer;
+
+    // only one string can extend the buffer
+    lstr->m_extensibleCapacity = 0;
+
+    // NOTE rstr can share buffer with lstr(ex. s + s).
+    // it is safe because rstr content is always placed before llen
+    const auto& rData = rstr->bufferAccessData();
+    if (is8Bit) {
+        copyBufferAccessData((LChar*)buffer + llen, rData);
+    } else {
+        copyBufferAccessData((char16_t*)buffer + llen, rData);
+    }
+
+    return result;
+}
+
 template <typename ResultType>
-void RopeString::flattenRopeStringWorker()
+void RopeString::flattenRopeStringWorker(size_t capacity)
 {
-    ResultType* result = (ResultType*)GC_MALLOC_ATOMIC(sizeof(ResultType) * m_bufferData.length);
+    capacity = std::max(capacity, (size_t)m_bufferData.length);
+    ResultType* result = (ResultType*)GC_MALLOC_ATOMIC(sizeof(ResultType) * capacity);
     std::vector<String*> queue;
     queue.push_back(m_left);
     queue.push_back((String*)m_bufferData.buffer);
@@ -129,34 +204,23 @@ void RopeString::flattenRopeStringWorker()
         const auto& data = sub->bufferAccessData();
 
         pos -= data.length;
-        size_t subLength = data.length;
-
-        if (data.has8BitContent) {
-            auto ptr = (const LChar*)data.buffer;
-            for (size_t i = 0; i < subLength; i++) {
-                result[i + pos] = ptr[i];
-            }
-        } else {
-            auto ptr = (const char16_t*)data.buffer;
-            for (size_t i = 0; i < subLength; i++) {
-                result[i + pos] = ptr[i];
-            }
-        }
+        copyBufferAccessData(result + pos, data);
     }
 
     m_bufferData.hasSpecialImpl = false;
     m_bufferData.buffer = result;
+    m_extensibleCapacity = capacity;
 
     m_left = nullptr;
 }
 
-void RopeString::flattenRopeString()
+void RopeString::flattenRopeString(size_t capacity)
 {
     ASSERT(m_left);
     if (m_bufferData.has8BitContent) {
-        flattenRopeStringWorker<LChar>();
+        flattenRopeStringWorker<LChar>(capacity);
     } else {
-        flattenRopeStringWorker<char16_t>();
+        flattenRopeStringWorker<char16_t>(capacity);
     }
 }
 
@@ -176,9 +240,7 @@ UTF16StringData RopeString::toUTF16StringData() const
     if (data.has8BitContent) {
         UTF16StringData ret;
         ret.resizeWithUninitializedValues(data.length);
-        for (size_t i = 0; i < data.length; i++) {
-            ret[i] = data.uncheckedCharAtFor8Bit(i);
-        }
+        StringKernels::widen(ret.data(), (const LChar*)data.buffer, data.length);
         return ret;
     } else {
         return UTF16StringData(data.bufferAs16Bit, data.length);
@@ -32,6 +32,7 @@ public:
         : String()
     {
         m_left = String::emptyString;
+        m_extensibleCapacity = 0;
         m_bufferData.has8BitContent = true;
         m_bufferData.hasSpecialImpl = true;
         m_bufferData.length = 0;
@@ -41,6 +42,8 @@ public:
     // this function not always create RopeString.
     // if (l+r).length() < ROPE_STRING_MIN_LENGTH
     // then create just normalString
+    // if lstr is a RopeString, rstr is appended into lstr's flat buffer(extensible string)
+    // instead of building deeper rope tree. see appendToExtensibleString
     // provide ExecutionState if you need limit of string length(exception can be thrown only in ExecutionState area)
     static String* createRopeString(String* lstr, String* rstr, ExecutionState* state = nullptr);
 
@@ -77,12 +80,22 @@ protected:
     }
 
     template <typename ResultType>
-    void flattenRopeStringWorker();
-    void flattenRopeString();
+    void flattenRopeStringWorker(size_t capacity);
+    void flattenRopeString(size_t capacity = 0);
+
+    // flattened RopeString owns its buffer and can be appended in-place
+    // only the last string created from the buffer has non-zero m_extensibleCapacity
+    bool isExtensible() const
+    {
+        return !m_bufferData.hasSpecialImpl && m_extensibleCapacity;
+    }
+
+    static String* appendToExtensibleString(RopeString* lstr, String* rstr);
 
 private:
     String* m_left;
     // String* m_right; // Right String is stored in m_bufferAccessData.buffer if string is not flattened
+    size_t m_extensibleCapacity; // capacity(in characters) of m_bufferData.buffer if this string owns flat buffer
 };
 }
 
@@ -0,0 +1,387 @@
+/*
+ * Copyright (c) 2020-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#include "Escargot.h"
+#include "SamplingProfiler.h"
+#include "runtime/VMInstance.h"
+#include "runtime/Context.h"
+#include "interpreter/ByteCode.h"
+#include "parser/CodeBlock.h"
+#include "parser/Script.h"
+
+#if defined(OS_POSIX)
+#include <sys/time.h>
+#endif
+#if defined(SAMPLING_PROFILER_USE_THREAD_TIMER)
+#include <sys/syscall.h>
+#include <unistd.h>
+// older glibc doesn't expose the name of thread id field
+#if !defined(sigev_notify_thread_id)
+#define sigev_notify_thread_id _sigev_un._tid
+#endif
+#endif
+
+namespace Escargot {
+
+// should be power of 2
+#define SAMPLING_PROFILER_STACKS_CAPACITY (1 << 14)
+#define SAMPLING_PROFILER_FRAMES_CAPACITY (1 << 17)
+
+#if defined(OS_POSIX)
+// SIGPROF handler is process-wide. first running profiler installs it and last one restores old one
+static std::mutex g_samplingProfilerLock;
+static size_t g_runningSamplingProfilerCount;
+static struct sigaction g_oldSignalAction;
+#endif
+#if !defined(SAMPLING_PROFILER_USE_THREAD_TIMER)
+// ITIMER_PROF is process-wide. so only one profiler can run at a time
+static SamplingProfiler* volatile g_runningSamplingProfiler;
+#endif
+
+SamplingProfiler::SamplingProfiler(VMInstance* vmInstance)
+    : m_vmInstance(vmInstance)
+    , m_isRunning(false)
+    , m_stacks(nullptr)
+    , m_stacksCount(0)
+    , m_frames(nullptr)
+    , m_framesCount(0)
+    , m_totalSamples(0)
+    , m_droppedSamples(0)
+{
+}
+
+SamplingProfiler::~SamplingProfiler()
+{
+    stop();
+    free(m_stacks);
+    if (m_frames) {
+        GC_FREE(m_frames);
+    }
+}
+
+bool SamplingProfiler::start(size_t samplingIntervalInMicroseconds)
+{
+#if defined(OS_POSIX)
+    if (m_isRunning || !samplingIntervalInMicroseconds) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> guard(g_samplingProfilerLock);
+#if !defined(SAMPLING_PROFILER_USE_THREAD_TIMER)
+    if (g_runningSamplingProfiler) {
+        return false;
+    }
+#endif
+
+    if (!m_stacks) {
+        m_stacks = (SampledStack*)malloc(sizeof(SampledStack) * SAMPLING_PROFILER_STACKS_CAPACITY);
+        m_frames = (SampledFrame*)GC_MALLOC_UNCOLLECTABLE(sizeof(SampledFrame) * SAMPLING_PROFILER_FRAMES_CAPACITY);
+    }
+    for (size_t i = 0; i < SAMPLING_PROFILER_STACKS_CAPACITY; i++) {
+        m_stacks[i].m_depth = SIZE_MAX;
+    }
+    // release references of previous profile
+    memset(m_frames, 0, sizeof(SampledFrame) * m_framesCount);
+    m_stacksCount = 0;
+    m_framesCount = 0;
+    m_totalSamples = 0;
+    m_droppedSamples = 0;
+
+    m_thread = pthread_self();
+
+    if (!g_runningSamplingProfilerCount) {
+        struct sigaction action;
+        memset(&action, 0, sizeof(action));
+        action.sa_sigaction = signalHandler;
+        action.sa_flags = SA_RESTART | SA_SIGINFO;
+        sigemptyset(&action.sa_mask);
+        if (sigaction(SIGPROF, &action, &g_oldSignalAction) != 0) {
+            return false;
+        }
+    }
+
+    struct timespec interval;
+    interval.tv_sec = samplingIntervalInMicroseconds / 1000000;
+    interval.tv_nsec = (samplingIntervalInMicroseconds % 1000000) * 1000;
+
+#if defined(SAMPLING_PROFILER_USE_THREAD_TIMER)
+    // timer counts cpu time of this thread and SIGPROF is delivered to this thread only
+    clockid_t clock;
+    struct sigevent event;
+    memset(&event, 0, sizeof(event));
+    event.sigev_notify = SIGEV_THREAD_ID;
+    event.sigev_signo = SIGPROF;
+    event.sigev_value.sival_ptr = this;
+    event.sigev_notify_thread_id = (pid_t)syscall(SYS_gettid);
+
+    bool timerCreated = false;
+    if (pthread_getcpuclockid(m_thread, &clock) == 0 && timer_create(clock, &event, &m_timer) == 0) {
+        timerCreated = true;
+        struct itimerspec timer;
+        timer.it_interval = interval;
+        timer.it_value = interval;
+        if (timer_settime(m_timer, 0, &timer, nullptr) == 0) {
+            g_runningSamplingProfilerCount++;
+            m_isRunning = true;
+            return true;
+        }
+    }
+
+    if (timerCreated) {
+        timer_delete(m_timer);
+    }
+#else
+    g_runningSamplingProfiler = this;
+    struct itimerval timer;
+    timer.it_interval.tv_sec = interval.tv_sec;
+    timer.it_interval.tv_usec = interval.tv_nsec / 1000;
+    timer.it_value = timer.it_interval;
+    if (setitimer(ITIMER_PROF, &timer, nullptr) == 0) {
+        g_runningSamplingProfilerCount++;
+        m_isRunning = true;
+        return true;
+    }
+    g_runningSamplingProfiler = nullptr;
+#endif
+
+    if (!g_runningSamplingProfilerCount) {
+        sigaction(SIGPROF, &g_oldSignalAction, nullptr);
+    }
+    return false;
+#else
+    return false;
+#endif
+}
+
+void SamplingProfiler::stop()
+{
+#if defined(OS_POSIX)
+    if (!m_isRunning) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> guard(g_samplingProfilerLock);
+#if defined(SAMPLING_PROFILER_USE_THREAD_TIMER)
+    // pending signal of deleted timer is discarded. so handler never sees this profiler after this
+    timer_delete(m_timer);
+#else
+    struct itimerval timer;
+    memset(&timer, 0, sizeof(timer));
+    setitimer(ITIMER_PROF, &timer, nullptr);
+    g_runningSamplingProfiler = nullptr;
+#endif
+
+    if (!--g_runningSamplingProfilerCount) {
+        sigaction(SIGPROF, &g_oldSignalAction, nullptr);
+    }
+    m_isRunning = false;
+#endif
+}
+
+void SamplingProfiler::signalHandler(int signal, siginfo_t* info, void* context)
+{
+#if defined(OS_POSIX)
+#if defined(SAMPLING_PROFILER_USE_THREAD_TIMER)
+    if (info->si_code != SI_TIMER) {
+        // SIGPROF from somewhere else
+        return;
+    }
+    SamplingProfiler* profiler = (SamplingProfiler*)info->si_value.sival_ptr;
+#else
+    SamplingProfiler* profiler = g_runningSamplingProfiler;
+#endif
+    if (!profiler) {
+        return;
+    }
+
+    // we can read interpreter frames only from the thread which runs the vm
+    if (pthread_equal(pthread_self(), profiler->m_thread)) {
+        profiler->takeSample();
+    } else {
+        profiler->m_droppedSamples.fetch_add(1, std::memory_order_relaxed);
+    }
+#endif
+}
+
+void SamplingProfiler::takeSample()
+{
+    // this function runs in signal handler. we should not allocate memory or take locks here
+    SampledFrame frames[MaxStackDepth];
+    size_t depth = 0;
+    size_t hash = (size_t)14695981039346656037ULL;
+    const size_t prime = (size_t)1099511628211ULL;
+
+    InterpreterFrame* frame = m_vmInstance->topInterpreterFrame();
+    while (frame && depth < MaxStackDepth) {
+        ByteCodeBlock* block = frame->m_byteCodeBlock;
+        size_t codeStart = (size_t)block->m_code.data();
+        size_t programCounter = *frame->m_programCounter;
+        size_t codePosition = SIZE_MAX;
+        if (programCounter >= codeStart && programCounter < codeStart + block->m_code.size()) {
+            codePosition = programCounter - codeStart;
+        }
+
+        frames[depth].m_byteCodeBlock = block;
+        frames[depth].m_codePosition = codePosition;
+        hash = (hash ^ (size_t)block) * prime;
+        hash = (hash ^ codePosition) * prime;
+        depth++;
+        frame = frame->m_parent;
+    }
+
+    m_totalSamples++;
+    SampledStack* stack = findOrInsertStack(frames, depth, hash);
+    if (stack) {
+        stack->m_count++;
+    } else {
+        m_droppedSamples.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+SamplingProfiler::SampledStack* SamplingProfiler::findOrInsertStack(const SampledFrame* frames, size_t depth, size_t hash)
+{
+    const size_t mask = SAMPLING_PROFILER_STACKS_CAPACITY - 1;
+    size_t index = hash & mask;
+    while (true) {
+        SampledStack& stack = m_stacks[index];
+        if (stack.m_depth == SIZE_MAX) {
+            break;
+        }
+        if (stack.m_hash == hash && stack.m_depth == depth && memcmp(&m_frames[stack.m_frameStart], frames, sizeof(SampledFrame) * depth) == 0) {
+            return &stack;
+        }
+        index = (index + 1) & mask;
+    }
+
+    // keep load factor of table low enough for linear probing
+    if (m_stacksCount >= SAMPLING_PROFILER_STACKS_CAPACITY / 4 * 3 || m_framesCount + depth > SAMPLING_PROFILER_FRAMES_CAPACITY) {
+        return nullptr;
+    }
+
+    SampledStack& stack = m_stacks[index];
+    memcpy(&m_frames[m_framesCount], frames, sizeof(SampledFrame) * depth);
+    stack.m_hash = hash;
+    stack.m_count = 0;
+    stack.m_frameStart = m_framesCount;
+    stack.m_depth = depth;
+    m_framesCount += depth;
+    m_stacksCount++;
+    return &stack;
+}
+
+static void appendFoldedFrameName(std::string& output, const char* str, size_t length)
+{
+    for (size_t i = 0; i < length; i++) {
+        // ';' separates frames and newline separates stacks in folded format
+        char c = str[i];
+        output += (c == ';' || c == '\n' || c == '\r') ? '_' : c;
+    }
+}
+
+static void appendFoldedFrameName(std::string& output, String* str)
+{
+    auto data = str->toNonGCUTF8StringData();
+    appendFoldedFrameName(output, data.data(), data.length());
+}
+
+std::string SamplingProfiler::frameName(ByteCodeBlock* byteCodeBlock, size_t codePosition)
+{
+    std::string name;
+    InterpretedCodeBlock* codeBlock = byteCodeBlock->m_codeBlock;
+    if (codeBlock->isGlobalScopeCodeBlock()) {
+        name = "(program)";
+    } else if (codeBlock->functionName().string()->length()) {
+        appendFoldedFrameName(name, codeBlock->functionName().string());
+    } else {
+        name = "(anonymous)";
+    }
+
+    if (codeBlock->script()) {
+        name += " (";
+        appendFoldedFrameName(name, codeBlock->script()->src());
+        ExtendedNodeLOC loc = byteCodeBlock->computeNodeLOCFromByteCode(codeBlock->context(), codePosition, codeBlock);
+        if (loc.line != SIZE_MAX) {
+            name += ":";
+            name += std::to_string(loc.line);
+        }
+        name += ")";
+    }
+    return name;
+}
+
+std::string SamplingProfiler::dumpFoldedStacks()
+{
+    std::string result;
+    if (!m_stacks) {
+        return result;
+    }
+
+#if defined(OS_POSIX)
+    // block sampling while we read tables
+    sigset_t set, oldSet;
+    sigemptyset(&set);
+    sigaddset(&set, SIGPROF);
+    pthread_sigmask(SIG_BLOCK, &set, &oldSet);
+#endif
+
+    // symbolizing needs source scan. so we cache names of frames
+    std::map<std::pair<ByteCodeBlock*, size_t>, std::string> frameNames;
+    for (size_t i = 0; i < SAMPLING_PROFILER_STACKS_CAPACITY; i++) {
+        const SampledStack& stack = m_stacks[i];
+        if (stack.m_depth == SIZE_MAX || !stack.m_count) {
+            continue;
+        }
+
+        if (!stack.m_depth) {
+            // vm was not interpreting. e.g. parsing, gc or host code
+            result += "(native)";
+        }
+        // frames are recorded from innermost frame
+        for (size_t j = stack.m_depth; j > 0; j--) {
+            const SampledFrame& frame = m_frames[stack.m_frameStart + j - 1];
+            auto key = std::make_pair(frame.m_byteCodeBlock, frame.m_codePosition);
+            auto iter = frameNames.find(key);
+            if (iter == frameNames.end()) {
+                iter = frameNames.insert(std::make_pair(key, frameName(frame.m_byteCodeBlock, frame.m_codePosition))).first;
+            }
+
+            result += iter->second;
+            if (j > 1) {
+                result += ';';
+            }
+        }
+        result += ' ';
+        result += std::to_string(stack.m_count);
+        result += '\n';
+    }
+
+    size_t droppedSamples = m_droppedSamples.load();
+    if (droppedSamples) {
+        result += "(dropped) ";
+        result += std::to_string(droppedSamples);
+        result += '\n';
+    }
+
+#if defined(OS_POSIX)
+    pthread_sigmask(SIG_SETMASK, &oldSet, nullptr);
+#endif
+
+    return result;
+}
+}
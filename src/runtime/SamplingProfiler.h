@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2020-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#ifndef __EscargotSamplingProfiler__
+#define __EscargotSamplingProfiler__
+
+#if defined(OS_POSIX)
+#include <pthread.h>
+#include <signal.h>
+#include <time.h>
+#endif
+
+#if defined(__linux__)
+// each profiler has its own timer which measures cpu time of vm thread and signals that thread only
+#define SAMPLING_PROFILER_USE_THREAD_TIMER
+#endif
+
+namespace Escargot {
+
+class VMInstance;
+class ByteCodeBlock;
+
+// interpreter links this on native stack while it runs a ByteCodeBlock
+// sampling profiler walks the list from VMInstance::topInterpreterFrame() in signal handler
+struct InterpreterFrame {
+    ByteCodeBlock* m_byteCodeBlock;
+    size_t* m_programCounter;
+    InterpreterFrame* m_parent;
+};
+
+// Sampling profiler for interpreter
+// SIGPROF timer records interpreter frames into preallocated tables without locks or allocation.
+// On linux, timer is bound to the thread which started profiler, so profilers of VMInstances on
+// different threads can run at the same time. Other platforms use process-wide ITIMER_PROF and
+// only one profiler can run at a time.
+// Identical stacks are merged in signal handler, so memory usage depends on the number of unique stacks.
+// Samples are symbolized with ByteCodeBlock location data and function names when profile is dumped.
+class SamplingProfiler {
+public:
+    static const size_t MaxStackDepth = 128;
+
+    explicit SamplingProfiler(VMInstance* vmInstance);
+    ~SamplingProfiler();
+
+    bool start(size_t samplingIntervalInMicroseconds);
+    void stop();
+    bool isRunning()
+    {
+        return m_isRunning;
+    }
+
+    // returns collapsed stacks which flamegraph tools accept
+    // each line is "outermost;...;innermost count"
+    std::string dumpFoldedStacks();
+
+    // name of frame in folded stacks. e.g. "foo (test.js:12)"
+    // codePosition is SIZE_MAX if position in ByteCodeBlock is unknown
+    static std::string frameName(ByteCodeBlock* byteCodeBlock, size_t codePosition);
+
+private:
+    struct SampledFrame {
+        ByteCodeBlock* m_byteCodeBlock;
+        size_t m_codePosition;
+    };
+
+    struct SampledStack {
+        size_t m_hash;
+        size_t m_count;
+        size_t m_frameStart;
+        size_t m_depth;
+    };
+
+    static void signalHandler(int signal, siginfo_t* info, void* context);
+    void takeSample();
+    SampledStack* findOrInsertStack(const SampledFrame* frames, size_t depth, size_t hash);
+
+    VMInstance* m_vmInstance;
+    bool m_isRunning;
+#if defined(OS_POSIX)
+    pthread_t m_thread;
+#endif
+#if defined(SAMPLING_PROFILER_USE_THREAD_TIMER)
+    timer_t m_timer;
+#endif
+
+    // these are written only by signal handler while profiler is running
+    SampledStack* m_stacks;
+    size_t m_stacksCount;
+    // frame pool is allocated as uncollectable gc memory
+    // so sampled ByteCodeBlocks are kept alive until profiler is destroyed
+    SampledFrame* m_frames;
+    size_t m_framesCount;
+    size_t m_totalSamples;
+    // samples which could not be recorded. this is also counted from other threads
+    std::atomic<size_t> m_droppedSamples;
+};
+}
+
+#endif
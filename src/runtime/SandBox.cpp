@@ -35,6 +35,10 @@ SandBox::SandBox(Context* s)
 {
     m_oldSandBox = m_context->vmInstance()->m_currentSandBox;
     m_context->vmInstance()->m_currentSandBox = this;
+#if defined(ENABLE_THREADING)
+    m_context->vmInstance()->runPendingFinalizers();
+    m_context->vmInstance()->runPendingGCEventWork();
+#endif
 }
 
 SandBox::~SandBox()
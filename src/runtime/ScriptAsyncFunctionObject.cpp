@@ -84,7 +84,7 @@ Object* ScriptAsyncFunctionObject::construct(ExecutionState& state, const size_t
 }
 
 // http://www.ecma-international.org/ecma-262/10.0/#await-fulfilled
-void awaitFulfilledFunctions(ExecutionState& state, ScriptAsyncFunctionHelperFunctionObject* F, const Value& value)
+void awaitFulfilledFunctions(ExecutionState& state, ExecutionPauser* executionPauser, const Value& value)
 {
     // Let F be the active function object.
     // Let asyncContext be F.[[AsyncContext]].
@@ -92,20 +92,13 @@ void awaitFulfilledFunctions(ExecutionState& state, ScriptAsyncFunctionHelperFun
     // Suspend prevContext.
     // Push asyncContext onto the execution context stack; asyncContext is now the running execution context.
     // Resume the suspended evaluation of asyncContext using NormalCompletion(value) as the result of the operation that suspended it.
-    ExecutionPauser::start(state, F->m_executionPauser, F->m_sourceFunction, value, false, false, ExecutionPauser::StartFrom::Async);
+    ExecutionPauser::start(state, executionPauser, executionPauser->sourceObject(), value, false, false, ExecutionPauser::StartFrom::Async);
     // Assert: When we reach this step, asyncContext has already been removed from the execution context stack and prevContext is the currently running execution context.
     // Return undefined.
 }
 
-Value awaitFulfilledFunction(ExecutionState& state, Value thisValue, size_t argc, Value* argv, bool isNewExpression)
-{
-    ScriptAsyncFunctionHelperFunctionObject* self = (ScriptAsyncFunctionHelperFunctionObject*)state.resolveCallee();
-    awaitFulfilledFunctions(state, self, argv[0]);
-    return Value();
-}
-
 // http://www.ecma-international.org/ecma-262/10.0/#await-rejected
-void awaitRejectedFunctions(ExecutionState& state, ScriptAsyncFunctionHelperFunctionObject* F, const Value& reason)
+void awaitRejectedFunctions(ExecutionState& state, ExecutionPauser* executionPauser, const Value& reason)
 {
     // Let F be the active function object.
     // Let asyncContext be F.[[AsyncContext]].
@@ -113,15 +106,8 @@ void awaitRejectedFunctions(ExecutionState& state, ScriptAsyncFunctionHelperFunc
     // Suspend prevContext.
     // Push asyncContext onto the execution context stack; asyncContext is now the running execution context.
     // Resume the suspended evaluation of asyncContext using ThrowCompletion(reason) as the result of the operation that suspended it.
-    ExecutionPauser::start(state, F->m_executionPauser, F->m_sourceFunction, reason, false, true, ExecutionPauser::StartFrom::Async);
+    ExecutionPauser::start(state, executionPauser, executionPauser->sourceObject(), reason, false, true, ExecutionPauser::StartFrom::Async);
     // Assert: When we reach this step, asyncContext has already been removed from the execution context stack and prevContext is the currently running execution context.
     // Return undefined.
 }
-
-Value awaitRejectedFunction(ExecutionState& state, Value thisValue, size_t argc, Value* argv, bool isNewExpression)
-{
-    ScriptAsyncFunctionHelperFunctionObject* self = (ScriptAsyncFunctionHelperFunctionObject*)state.resolveCallee();
-    awaitRejectedFunctions(state, self, argv[0]);
-    return Value();
-}
 }
@@ -63,21 +63,10 @@ private:
     Object* m_homeObject;
 };
 
-class ScriptAsyncFunctionHelperFunctionObject : public NativeFunctionObject {
-public:
-    ScriptAsyncFunctionHelperFunctionObject(ExecutionState& state, NativeFunctionInfo info, ExecutionPauser* executionPauser, ScriptAsyncFunctionObject* sourceFunction)
-        : NativeFunctionObject(state, info)
-        , m_executionPauser(executionPauser)
-        , m_sourceFunction(sourceFunction)
-    {
-    }
-
-    ExecutionPauser* m_executionPauser;
-    ScriptAsyncFunctionObject* m_sourceFunction;
-};
-
-Value awaitFulfilledFunction(ExecutionState& state, Value thisValue, size_t argc, Value* argv, bool isNewExpression);
-Value awaitRejectedFunction(ExecutionState& state, Value thisValue, size_t argc, Value* argv, bool isNewExpression);
+// steps of Await Fulfilled, Await Rejected Functions
+// these are called by PromiseReactionJob of Await reaction with ExecutionPauser of async function
+void awaitFulfilledFunctions(ExecutionState& state, ExecutionPauser* executionPauser, const Value& value);
+void awaitRejectedFunctions(ExecutionState& state, ExecutionPauser* executionPauser, const Value& reason);
 }
 
 #endif
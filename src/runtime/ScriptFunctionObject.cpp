@@ -38,6 +38,8 @@
 
 namespace Escargot {
 
+size_t g_scriptFunctionObjectTag;
+
 ScriptFunctionObject::ScriptFunctionObject(ExecutionState& state, CodeBlock* codeBlock, LexicalEnvironment* outerEnv, bool isConstructor, bool isGenerator)
     : ScriptFunctionObject(state, codeBlock, outerEnv,
                            ((isConstructor || isGenerator) ? (ESCARGOT_OBJECT_BUILTIN_PROPERTY_NUMBER + 3) : (ESCARGOT_OBJECT_BUILTIN_PROPERTY_NUMBER + 2)) + (codeBlock->isStrict() ? 2 : 0))
@@ -56,6 +58,12 @@ ScriptFunctionObject::ScriptFunctionObject(ExecutionState& state, CodeBlock* cod
 {
     m_codeBlock = codeBlock;
     m_outerEnvironment = outerEnvironment;
+    // this is tag of ScriptFunctionObject even if derived class is being constructed
+    // interpreter uses this for checking exact type of callee
+    static std::once_flag initializeTagOnce;
+    std::call_once(initializeTagOnce, [this]() {
+        g_scriptFunctionObjectTag = getTag();
+    });
 
 #ifdef NDEBUG
     if (m_outerEnvironment) {
@@ -24,6 +24,8 @@
 
 namespace Escargot {
 
+extern size_t g_scriptFunctionObjectTag;
+
 class ScriptFunctionObject : public FunctionObject {
     friend class Script;
     friend class ByteCodeInterpreter;
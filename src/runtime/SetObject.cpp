@@ -32,8 +32,8 @@ SetObject::SetObject(ExecutionState& state)
 
 void* SetObject::operator new(size_t size)
 {
-    static bool typeInited = false;
-    static GC_descr descr;
+    static std::atomic<bool> typeInited(false);
+    static std::atomic<GC_descr> descr;
     if (!typeInited) {
         GC_word obj_bitmap[GC_BITMAP_SIZE(SetObject)] = { 0 };
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(SetObject, m_structure));
@@ -141,8 +141,8 @@ SetIteratorObject::SetIteratorObject(ExecutionState& state, SetObject* set, Type
 
 void* SetIteratorObject::operator new(size_t size)
 {
-    static bool typeInited = false;
-    static GC_descr descr;
+    static std::atomic<bool> typeInited(false);
+    static std::atomic<GC_descr> descr;
     if (!typeInited) {
         GC_word obj_bitmap[GC_BITMAP_SIZE(SetIteratorObject)] = { 0 };
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(SetIteratorObject, m_structure));
@@ -27,6 +27,9 @@ void StaticStrings::initStaticStrings(AtomicStringMap* atomicStringMap)
 {
     atomicStringMap->insert(String::emptyString);
 
+    ASSERT(!(dtoaCacheSize & (dtoaCacheSize - 1)));
+    dtoaCache = (DtoaCacheEntry*)GC_MALLOC(sizeof(DtoaCacheEntry) * dtoaCacheSize);
+
 #define INIT_STATIC_STRING(name) name.initStaticString(atomicStringMap, new ASCIIString(#name, strlen(#name)));
     FOR_EACH_STATIC_STRING(INIT_STATIC_STRING)
 #undef INIT_STATIC_STRING
@@ -123,20 +126,19 @@ void StaticStrings::initStaticStrings(AtomicStringMap* atomicStringMap)
 
 ::Escargot::String* StaticStrings::dtoa(double d) const
 {
-    size_t size = dtoaCache.size();
-
-    for (size_t i = 0; i < size; ++i) {
-        if (dtoaCache[i].first == d) {
-            return dtoaCache[i].second;
-        }
+    uint64_t bits;
+    memcpy(&bits, &d, sizeof(uint64_t));
+    // fibonacci hashing. upper bits of product are well mixed
+    size_t index = (size_t)((bits * 0x9E3779B97F4A7C15ull) >> 40) & (dtoaCacheSize - 1);
+
+    DtoaCacheEntry& entry = dtoaCache[index];
+    if (entry.second && entry.first == d) {
+        return entry.second;
     }
 
     ::Escargot::String* s = String::fromDouble(d);
-    dtoaCache.insert(0, std::make_pair(d, s));
-    if (dtoaCache.size() > dtoaCacheSize) {
-        dtoaCache.erase(dtoaCache.size() - 1);
-    }
-
+    entry.first = d;
+    entry.second = s;
     return s;
 }
 }
@@ -546,10 +546,13 @@ namespace Escargot {
     F(126)                        \
     F(127)
 
+#define ESCARGOT_DTOA_CACHE_SIZE 256
+
 class StaticStrings {
 public:
     StaticStrings()
-        : dtoaCacheSize(5)
+        : dtoaCacheSize(ESCARGOT_DTOA_CACHE_SIZE)
+        , dtoaCache(nullptr)
     {
     }
     AtomicString NegativeInfinity;
@@ -636,8 +639,10 @@ public:
 
     void initStaticStrings(AtomicStringMap* map);
 
-    const size_t dtoaCacheSize; // 5;
-    mutable Vector<std::pair<double, ::Escargot::String*>, GCUtil::gc_malloc_allocator<std::pair<double, ::Escargot::String*>>> dtoaCache;
+    // direct-mapped cache of recent number to string conversions
+    const size_t dtoaCacheSize; // should be power of 2
+    typedef std::pair<double, ::Escargot::String*> DtoaCacheEntry;
+    mutable DtoaCacheEntry* dtoaCache;
 
     ::Escargot::String* dtoa(double d) const;
 };
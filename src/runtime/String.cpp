@@ -47,9 +47,9 @@
 #include "String.h"
 #include "CompressibleString.h"
 #include "Value.h"
+#include "AllocationProfiler.h"
 
-#include "fast-dtoa.h"
-#include "bignum-dtoa.h"
+#include "util/Dtoa.h"
 
 namespace Escargot {
 
@@ -99,32 +99,17 @@ bool isAllSpecialCharacters(const std::string& s, bool (*fn)(char))
 
 bool isAllASCII(const char* buf, const size_t len)
 {
-    for (unsigned i = 0; i < len; i++) {
-        if ((buf[i] & 0x80) != 0) {
-            return false;
-        }
-    }
-    return true;
+    return StringKernels::isAllASCII((const LChar*)buf, len);
 }
 
 bool isAllASCII(const char16_t* buf, const size_t len)
 {
-    for (unsigned i = 0; i < len; i++) {
-        if (buf[i] >= 128) {
-            return false;
-        }
-    }
-    return true;
+    return StringKernels::isAllASCII(buf, len);
 }
 
 bool isAllLatin1(const char16_t* buf, const size_t len)
 {
-    for (unsigned i = 0; i < len; i++) {
-        if (buf[i] >= 256) {
-            return false;
-        }
-    }
-    return true;
+    return StringKernels::isAllLatin1(buf, len);
 }
 
 bool isIndexString(String* str)
@@ -207,10 +192,20 @@ char32_t readUTF8Sequence(const char*& sequence, bool& valid, int& charlen)
 UTF16StringDataNonGCStd utf8StringToUTF16StringNonGC(const char* buf, const size_t len)
 {
     UTF16StringDataNonGCStd str;
+    str.reserve(len);
     const char* source = buf;
     int charlen;
     bool valid;
     while (source < buf + len) {
+        size_t asciiLength = StringKernels::countASCIIPrefix((const LChar*)source, buf + len - source);
+        if (asciiLength) {
+            size_t oldLength = str.length();
+            str.resize(oldLength + asciiLength);
+            StringKernels::widen(&str[oldLength], (const LChar*)source, asciiLength);
+            source += asciiLength;
+            continue;
+        }
+
         char32_t ch = readUTF8Sequence(source, valid, charlen);
         if (!valid) { // Invalid sequence
             str += 0xFFFD;
@@ -243,10 +238,8 @@ ASCIIStringData utf16StringToASCIIString(const char16_t* buf, const size_t len)
 {
     ASCIIStringData str;
     str.resizeWithUninitializedValues(len);
-    for (unsigned i = 0; i < len; i++) {
-        ASSERT(buf[i] < 128);
-        str[i] = buf[i];
-    }
+    ASSERT(StringKernels::isAllASCII(buf, len));
+    StringKernels::narrow((LChar*)str.data(), buf, len);
     return ASCIIStringData(std::move(str));
 }
 
@@ -355,9 +348,7 @@ UTF16StringData ASCIIString::toUTF16StringData() const
     UTF16StringData ret;
     size_t len = length();
     ret.resizeWithUninitializedValues(len);
-    for (size_t i = 0; i < len; i++) {
-        ret[i] = charAt(i);
-    }
+    StringKernels::widen(ret.data(), ASCIIString::characters8(), len);
     return ret;
 }
 
@@ -376,44 +367,18 @@ UTF16StringData Latin1String::toUTF16StringData() const
     UTF16StringData ret;
     size_t len = length();
     ret.resizeWithUninitializedValues(len);
-    for (size_t i = 0; i < len; i++) {
-        ret[i] = charAt(i);
-    }
+    StringKernels::widen(ret.data(), Latin1String::characters8(), len);
     return ret;
 }
 
 UTF8StringData Latin1String::toUTF8StringData() const
 {
-    UTF8StringData ret;
-    size_t len = length();
-    for (size_t i = 0; i < len; i++) {
-        uint8_t ch = m_bufferData.uncheckedCharAtFor8Bit(i); /* assume that code points above 0xff are impossible since latin-1 is 8-bit */
-        if (ch < 0x80) {
-            ret.append((char*)&ch, 1);
-        } else {
-            char buf[8];
-            auto len = utf32ToUtf8(ch, buf);
-            ret.append(buf, len);
-        }
-    }
-    return ret;
+    return bufferAccessData().toUTF8String<UTF8StringData>();
 }
 
 UTF8StringDataNonGCStd Latin1String::toNonGCUTF8StringData() const
 {
-    UTF8StringDataNonGCStd ret;
-    size_t len = length();
-    for (size_t i = 0; i < len; i++) {
-        uint8_t ch = m_bufferData.uncheckedCharAtFor8Bit(i); /* assume that code points above 0xff are impossible since latin-1 is 8-bit */
-        if (ch < 0x80) {
-            ret.append((char*)&ch, 1);
-        } else {
-            char buf[8];
-            auto len = utf32ToUtf8(ch, buf);
-            ret.append(buf, len);
-        }
-    }
-    return ret;
+    return bufferAccessData().toUTF8String<UTF8StringDataNonGCStd>();
 }
 
 UTF16StringData UTF16String::toUTF16StringData() const
@@ -431,164 +396,11 @@ UTF8StringDataNonGCStd UTF16String::toNonGCUTF8StringData() const
     return bufferAccessData().toUTF8String<UTF8StringDataNonGCStd>();
 }
 
-enum Flags : unsigned {
-    NO_FLAGS = 0,
-    EMIT_POSITIVE_EXPONENT_SIGN = 1,
-    EMIT_TRAILING_DECIMAL_POINT = 2,
-    EMIT_TRAILING_ZERO_AFTER_POINT = 4,
-    UNIQUE_ZERO = 8
-};
-
-void CreateDecimalRepresentation(
-    int flags_,
-    const char* decimal_digits,
-    int length,
-    int decimal_point,
-    int digits_after_point,
-    double_conversion::StringBuilder* result_builder)
-{
-    // Create a representation that is padded with zeros if needed.
-    if (decimal_point <= 0) {
-        // "0.00000decimal_rep".
-        result_builder->AddCharacter('0');
-        if (digits_after_point > 0) {
-            result_builder->AddCharacter('.');
-            result_builder->AddPadding('0', -decimal_point);
-            ASSERT(length <= digits_after_point - (-decimal_point));
-            result_builder->AddSubstring(decimal_digits, length);
-            int remaining_digits = digits_after_point - (-decimal_point) - length;
-            result_builder->AddPadding('0', remaining_digits);
-        }
-    } else if (decimal_point >= length) {
-        // "decimal_rep0000.00000" or "decimal_rep.0000"
-        result_builder->AddSubstring(decimal_digits, length);
-        result_builder->AddPadding('0', decimal_point - length);
-        if (digits_after_point > 0) {
-            result_builder->AddCharacter('.');
-            result_builder->AddPadding('0', digits_after_point);
-        }
-    } else {
-        // "decima.l_rep000"
-        ASSERT(digits_after_point > 0);
-        result_builder->AddSubstring(decimal_digits, decimal_point);
-        result_builder->AddCharacter('.');
-        ASSERT(length - decimal_point <= digits_after_point);
-        result_builder->AddSubstring(&decimal_digits[decimal_point],
-                                     length - decimal_point);
-        int remaining_digits = digits_after_point - (length - decimal_point);
-        result_builder->AddPadding('0', remaining_digits);
-    }
-    if (digits_after_point == 0) {
-        if ((flags_ & EMIT_TRAILING_DECIMAL_POINT) != 0) {
-            result_builder->AddCharacter('.');
-        }
-        if ((flags_ & EMIT_TRAILING_ZERO_AFTER_POINT) != 0) {
-            result_builder->AddCharacter('0');
-        }
-    }
-}
-
-void CreateExponentialRepresentation(
-    int flags_,
-    const char* decimal_digits,
-    int length,
-    int exponent,
-    double_conversion::StringBuilder* result_builder)
-{
-    ASSERT(length != 0);
-    result_builder->AddCharacter(decimal_digits[0]);
-    if (length != 1) {
-        result_builder->AddCharacter('.');
-        result_builder->AddSubstring(&decimal_digits[1], length - 1);
-    }
-    result_builder->AddCharacter('e');
-    if (exponent < 0) {
-        result_builder->AddCharacter('-');
-        exponent = -exponent;
-    } else {
-        if ((flags_ & EMIT_POSITIVE_EXPONENT_SIGN) != 0) {
-            result_builder->AddCharacter('+');
-        }
-    }
-    if (exponent == 0) {
-        result_builder->AddCharacter('0');
-        return;
-    }
-    ASSERT(exponent < 1e4);
-    const int kMaxExponentLength = 5;
-    char buffer[kMaxExponentLength + 1];
-    buffer[kMaxExponentLength] = '\0';
-    int first_char_pos = kMaxExponentLength;
-    while (exponent > 0) {
-        buffer[--first_char_pos] = '0' + (exponent % 10);
-        exponent /= 10;
-    }
-    result_builder->AddSubstring(&buffer[first_char_pos],
-                                 kMaxExponentLength - first_char_pos);
-}
-
 ASCIIStringData dtoa(double number)
 {
-    if (number == 0) {
-        return ASCIIStringData("0", 1);
-    }
-    const int flags = UNIQUE_ZERO | EMIT_POSITIVE_EXPONENT_SIGN;
-    bool sign = false;
-    if (number < 0) {
-        sign = true;
-        number = -number;
-    }
-    // The maximal number of digits that are needed to emit a double in base 10.
-    // A higher precision can be achieved by using more digits, but the shortest
-    // accurate representation of any double will never use more digits than
-    // kBase10MaximalLength.
-    // Note that DoubleToAscii null-terminates its input. So the given buffer
-    // should be at least kBase10MaximalLength + 1 characters long.
-    const int kBase10MaximalLength = 17;
-    const int kDecimalRepCapacity = kBase10MaximalLength + 1;
-    char decimal_rep[kDecimalRepCapacity];
-    int decimal_rep_length;
-    int decimal_point;
-    double_conversion::Vector<char> vector(decimal_rep, kDecimalRepCapacity);
-    bool fast_worked = FastDtoa(number, double_conversion::FAST_DTOA_SHORTEST, 0, vector, &decimal_rep_length, &decimal_point);
-    if (!fast_worked) {
-        BignumDtoa(number, double_conversion::BIGNUM_DTOA_SHORTEST, 0, vector, &decimal_rep_length, &decimal_point);
-        vector[decimal_rep_length] = '\0';
-    }
-
-    /* reserve(decimal_rep_length + sign ? 1 : 0);
-    if (sign)
-        operator +=('-');
-    for (unsigned i = 0; i < decimal_rep_length; i ++) {
-        operator +=(decimal_rep[i]);
-    }*/
-
-    const int bufferLength = 128;
-    char buffer[bufferLength];
-    double_conversion::StringBuilder builder(buffer, bufferLength);
-
-    int exponent = decimal_point - 1;
-    const int decimal_in_shortest_low_ = -6;
-    const int decimal_in_shortest_high_ = 21;
-    if ((decimal_in_shortest_low_ <= exponent)
-        && (exponent < decimal_in_shortest_high_)) {
-        CreateDecimalRepresentation(flags, decimal_rep, decimal_rep_length,
-                                    decimal_point,
-                                    double_conversion::Max(0, decimal_rep_length - decimal_point),
-                                    &builder);
-    } else {
-        CreateExponentialRepresentation(flags, decimal_rep, decimal_rep_length, exponent,
-                                        &builder);
-    }
-    ASCIIStringDataNonGCStd str;
-    if (sign)
-        str += '-';
-    char* buf = builder.Finalize();
-    while (*buf) {
-        str += *buf;
-        buf++;
-    }
-    return ASCIIStringData(str.data(), str.length());
+    char buffer[Dtoa::BufferLength];
+    size_t length = Dtoa::toString(number, buffer);
+    return ASCIIStringData(buffer, length);
 }
 
 String* String::fromASCII(const char* src)
@@ -865,41 +677,47 @@ size_t String::advanceStringIndex(size_t index, bool unicode)
 
 void* ASCIIString::operator new(size_t size)
 {
-    static bool typeInited = false;
-    static GC_descr descr;
+    static std::atomic<bool> typeInited(false);
+    static std::atomic<GC_descr> descr;
     if (!typeInited) {
         GC_word obj_bitmap[GC_BITMAP_SIZE(ASCIIString)] = { 0 };
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(ASCIIString, m_bufferData.buffer));
         descr = GC_make_descriptor(obj_bitmap, GC_WORD_LEN(ASCIIString));
         typeInited = true;
     }
-    return GC_MALLOC_EXPLICITLY_TYPED(size, descr);
+    void* ptr = GC_MALLOC_EXPLICITLY_TYPED(size, descr);
+    AllocationProfiler::recordAllocation(ptr);
+    return ptr;
 }
 
 void* Latin1String::operator new(size_t size)
 {
-    static bool typeInited = false;
-    static GC_descr descr;
+    static std::atomic<bool> typeInited(false);
+    static std::atomic<GC_descr> descr;
     if (!typeInited) {
         GC_word obj_bitmap[GC_BITMAP_SIZE(Latin1String)] = { 0 };
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(Latin1String, m_bufferData.buffer));
         descr = GC_make_descriptor(obj_bitmap, GC_WORD_LEN(Latin1String));
         typeInited = true;
     }
-    return GC_MALLOC_EXPLICITLY_TYPED(size, descr);
+    void* ptr = GC_MALLOC_EXPLICITLY_TYPED(size, descr);
+    AllocationProfiler::recordAllocation(ptr);
+    return ptr;
 }
 
 void* UTF16String::operator new(size_t size)
 {
-    static bool typeInited = false;
-    static GC_descr descr;
+    static std::atomic<bool> typeInited(false);
+    static std::atomic<GC_descr> descr;
     if (!typeInited) {
         GC_word obj_bitmap[GC_BITMAP_SIZE(UTF16String)] = { 0 };
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(UTF16String, m_bufferData.buffer));
         descr = GC_make_descriptor(obj_bitmap, GC_WORD_LEN(UTF16String));
         typeInited = true;
     }
-    return GC_MALLOC_EXPLICITLY_TYPED(size, descr);
+    void* ptr = GC_MALLOC_EXPLICITLY_TYPED(size, descr);
+    AllocationProfiler::recordAllocation(ptr);
+    return ptr;
 }
 
 String* String::getSubstitution(ExecutionState& state, String* matched, String* str, size_t position, StringVector& captures, String* replacement)
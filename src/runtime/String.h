@@ -24,12 +24,10 @@
 #include "util/BasicString.h"
 #include <string>
 #include "util/Vector.h"
+#include "util/StringKernels.h"
 
 namespace Escargot {
 
-// A type to hold a single Latin-1 character.
-typedef unsigned char LChar;
-
 typedef BasicString<char, GCUtil::gc_malloc_atomic_allocator<char>> ASCIIStringData;
 typedef BasicString<LChar, GCUtil::gc_malloc_atomic_allocator<LChar>> Latin1StringData;
 typedef BasicString<char, GCUtil::gc_malloc_atomic_allocator<char>> UTF8StringData;
@@ -141,35 +139,58 @@ struct StringBufferAccessData {
     {
         OutputType ret;
         const auto& accessData = *this;
-        for (size_t i = 0; i < accessData.length; i++) {
-            char32_t ch = (uint16_t)accessData.charAt(i);
-            if (ch < 0x80) {
-                ret.append((char*)&ch, 1);
-            } else {
-                char32_t finalCh;
-                if (U16_IS_LEAD(ch)) {
-                    if (i + 1 == accessData.length) {
-                        finalCh = ch;
+        size_t i = 0;
+        while (i < accessData.length) {
+            i += appendASCIIRun(ret, i);
+
+            // encode the whole non-ascii run before looking for the next ascii run
+            char buf[8];
+            while (i < accessData.length) {
+                char32_t ch = (uint16_t)accessData.charAt(i);
+                if (ch < 0x80) {
+                    break;
+                }
+                i++;
+
+                char32_t finalCh = ch;
+                if (U16_IS_LEAD(ch) && i < accessData.length) {
+                    char16_t c2 = accessData.charAt(i);
+                    if (U16_IS_TRAIL(c2)) {
+                        finalCh = U16_GET_SUPPLEMENTARY(ch, c2);
+                        i++;
                     } else {
-                        char16_t c2;
-                        if (U16_IS_TRAIL(c2 = accessData.charAt(i + 1))) {
-                            finalCh = U16_GET_SUPPLEMENTARY(ch, c2);
-                            i++;
-                        } else {
-                            finalCh = 0xFFFD;
-                        }
+                        finalCh = 0xFFFD;
                     }
-                } else {
-                    finalCh = ch;
                 }
 
-                char buf[8];
                 auto len = utf32ToUtf8(finalCh, buf);
                 ret.append(buf, len);
             }
         }
         return ret;
     }
+
+private:
+    // appends run of ascii characters starts from `start` into UTF-8 output
+    template <typename OutputType>
+    size_t appendASCIIRun(OutputType& ret, size_t start) const
+    {
+        if (has8BitContent) {
+            size_t asciiLength = StringKernels::countASCIIPrefix((const LChar*)buffer + start, length - start);
+            ret.append(bufferAs8Bit + start, asciiLength);
+            return asciiLength;
+        }
+
+        const char16_t* src = bufferAs16Bit + start;
+        size_t asciiLength = StringKernels::countASCIIPrefix(src, length - start);
+        LChar chunk[256];
+        for (size_t i = 0; i < asciiLength; i += sizeof(chunk)) {
+            size_t chunkLength = std::min(sizeof(chunk), asciiLength - i);
+            StringKernels::narrow(chunk, src + i, chunkLength);
+            ret.append((const char*)chunk, chunkLength);
+        }
+        return asciiLength;
+    }
 };
 
 class String : public PointerValue {
@@ -291,6 +312,24 @@ public:
         return m_bufferData;
     }
 
+    // returns access data of [start, start + length)
+    // extraData keeps the base buffer pointer in stack
+    virtual StringBufferAccessData bufferAccessDataOfRange(size_t start, size_t length)
+    {
+        ASSERT(start + length <= this->length());
+        StringBufferAccessData r = bufferAccessData();
+        // keep original buffer pointer in stack
+        // without this, compressible string can free this pointer
+        r.extraData = const_cast<void*>(r.buffer);
+        r.length = length;
+        if (r.has8BitContent) {
+            r.bufferAs8Bit += start;
+        } else {
+            r.bufferAs16Bit += start;
+        }
+        return r;
+    }
+
     bool equals(const String* src) const;
 
     template <const size_t srcLen>
@@ -374,10 +413,7 @@ public:
     template <typename T>
     static inline size_t stringHash(T* src, size_t length)
     {
-        size_t hash = static_cast<size_t>(0xc70f6907UL);
-        for (; length; --length)
-            hash = (hash * 131) + *src++;
-        return hash;
+        return StringKernels::hash(src, length, static_cast<size_t>(0xc70f6907UL));
     }
 
     size_t hashValue() const
@@ -543,10 +579,8 @@ public:
     {
         ASCIIStringData stringData;
         stringData.resizeWithUninitializedValues(len);
-        for (size_t i = 0; i < len; i++) {
-            ASSERT(str[i] < 128);
-            stringData[i] = str[i];
-        }
+        ASSERT(StringKernels::isAllASCII(str, len));
+        StringKernels::narrow((LChar*)stringData.data(), str, len);
         initBufferAccessData(stringData);
     }
 
@@ -640,10 +674,7 @@ public:
         Latin1StringData data;
 
         data.resizeWithUninitializedValues(len);
-        for (size_t i = 0; i < len; i++) {
-            ASSERT(str[i] < 256);
-            data[i] = str[i];
-        }
+        StringKernels::narrow(data.data(), str, len);
         initBufferAccessData(data);
     }
 
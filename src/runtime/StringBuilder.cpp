@@ -34,13 +34,7 @@ void StringBuilder::appendPiece(String* str, size_t s, size_t e)
 
         const auto& data = str->bufferAccessData();
         if (!data.has8BitContent) {
-            bool has8 = true;
-            for (size_t i = s; i < e; i++) {
-                if (((char16_t*)data.buffer)[i] > 255) {
-                    has8 = false;
-                    break;
-                }
-            }
+            bool has8 = StringKernels::isAllLatin1(((const char16_t*)data.buffer) + s, e - s);
 
             if (!has8) {
                 m_has8BitContent = false;
@@ -132,10 +126,8 @@ String* StringBuilder::finalize(ExecutionState* state)
                     memcpy(&ret[currentLength], ((LChar*)accessData.buffer) + s, l);
                     currentLength += l;
                 } else {
-                    char16_t* b = ((char16_t*)accessData.buffer);
-                    for (size_t k = s; k < e; k++) {
-                        ret[currentLength++] = b[k];
-                    }
+                    StringKernels::narrow(&ret[currentLength], ((const char16_t*)accessData.buffer) + s, l);
+                    currentLength += l;
                 }
             }
         }
@@ -159,10 +151,8 @@ String* StringBuilder::finalize(ExecutionState* state)
                     memcpy(&ret[currentLength], ((LChar*)accessData.buffer) + s, l);
                     currentLength += l;
                 } else {
-                    char16_t* b = ((char16_t*)accessData.buffer);
-                    for (size_t k = s; k < e; k++) {
-                        ret[currentLength++] = b[k];
-                    }
+                    StringKernels::narrow(&ret[currentLength], ((const char16_t*)accessData.buffer) + s, l);
+                    currentLength += l;
                 }
             }
         }
@@ -181,27 +171,19 @@ String* StringBuilder::finalize(ExecutionState* state)
             } else if (piece.m_type == StringBuilderPiece::ConstChar) {
                 const char* data = piece.m_raw;
                 size_t l = piece.m_end;
-                for (size_t j = 0; j < l; j++) {
-                    ret[currentLength++] = data[j];
-                }
+                StringKernels::widen(&ret[currentLength], (const LChar*)data, l);
+                currentLength += l;
             } else {
                 String* data = piece.m_string;
                 size_t s = piece.m_start;
                 size_t e = piece.m_end;
                 size_t l = e - s;
                 if (data->has8BitContent()) {
-                    auto ptr = data->characters8();
-                    ptr += s;
-                    for (size_t j = 0; j < l; j++) {
-                        ret[currentLength++] = ptr[j];
-                    }
+                    StringKernels::widen(&ret[currentLength], data->characters8() + s, l);
                 } else {
-                    auto ptr = data->characters16();
-                    ptr += s;
-                    for (size_t j = 0; j < l; j++) {
-                        ret[currentLength++] = ptr[j];
-                    }
+                    StringKernels::copy(&ret[currentLength], data->characters16() + s, l);
                 }
+                currentLength += l;
             }
         }
 
@@ -212,27 +194,19 @@ String* StringBuilder::finalize(ExecutionState* state)
             } else if (piece.m_type == StringBuilderPiece::ConstChar) {
                 const char* data = piece.m_raw;
                 size_t l = piece.m_end;
-                for (size_t j = 0; j < l; j++) {
-                    ret[currentLength++] = data[j];
-                }
+                StringKernels::widen(&ret[currentLength], (const LChar*)data, l);
+                currentLength += l;
             } else {
                 String* data = piece.m_string;
                 size_t s = piece.m_start;
                 size_t e = piece.m_end;
                 size_t l = e - s;
                 if (data->has8BitContent()) {
-                    auto ptr = data->characters8();
-                    ptr += s;
-                    for (size_t j = 0; j < l; j++) {
-                        ret[currentLength++] = ptr[j];
-                    }
+                    StringKernels::widen(&ret[currentLength], data->characters8() + s, l);
                 } else {
-                    auto ptr = data->characters16();
-                    ptr += s;
-                    for (size_t j = 0; j < l; j++) {
-                        ret[currentLength++] = ptr[j];
-                    }
+                    StringKernels::copy(&ret[currentLength], data->characters16() + s, l);
                 }
+                currentLength += l;
             }
         }
 
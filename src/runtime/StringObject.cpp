@@ -34,8 +34,8 @@ StringObject::StringObject(ExecutionState& state, String* value)
 
 void* StringObject::operator new(size_t size)
 {
-    static bool typeInited = false;
-    static GC_descr descr;
+    static std::atomic<bool> typeInited(false);
+    static std::atomic<GC_descr> descr;
     if (!typeInited) {
         GC_word obj_bitmap[GC_BITMAP_SIZE(StringObject)] = { 0 };
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(StringObject, m_structure));
@@ -134,8 +134,8 @@ StringIteratorObject::StringIteratorObject(ExecutionState& state, String* s)
 
 void* StringIteratorObject::operator new(size_t size)
 {
-    static bool typeInited = false;
-    static GC_descr descr;
+    static std::atomic<bool> typeInited(false);
+    static std::atomic<GC_descr> descr;
     if (!typeInited) {
         GC_word obj_bitmap[GC_BITMAP_SIZE(StringIteratorObject)] = { 0 };
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(StringIteratorObject, m_structure));
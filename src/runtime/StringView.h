@@ -83,11 +83,13 @@ public:
     virtual UTF16StringData toUTF16StringData() const override
     {
         UTF16StringData ret;
-        size_t len = length();
-        ret.resizeWithUninitializedValues(len);
+        const auto& data = bufferAccessData();
+        ret.resizeWithUninitializedValues(data.length);
 
-        for (size_t i = 0; i < len; i++) {
-            ret[i] = charAt(i);
+        if (data.has8BitContent) {
+            StringKernels::widen(ret.data(), (const LChar*)data.buffer, data.length);
+        } else {
+            StringKernels::copy(ret.data(), data.bufferAs16Bit, data.length);
         }
 
         return ret;
@@ -132,18 +134,7 @@ protected:
     {
         ASSERT(m_bufferData.hasSpecialImpl);
 
-        StringBufferAccessData r = m_bufferData.bufferAsString->bufferAccessData();
-        // keep original buffer pointer in stack
-        // without this, compressible string can free this pointer
-        r.extraData = const_cast<void*>(r.buffer);
-        r.length = m_bufferData.length;
-        if (r.has8BitContent) {
-            r.bufferAs8Bit += m_start;
-        } else {
-            r.bufferAs16Bit += m_start;
-        }
-
-        return r;
+        return m_bufferData.bufferAsString->bufferAccessDataOfRange(m_start, m_bufferData.length);
     }
 
     ALWAYS_INLINE void initBufferAccessData(String* str, size_t start, size_t end)
@@ -33,8 +33,8 @@ SymbolObject::SymbolObject(ExecutionState& state, Symbol* value)
 
 void* SymbolObject::operator new(size_t size)
 {
-    static bool typeInited = false;
-    static GC_descr descr;
+    static std::atomic<bool> typeInited(false);
+    static std::atomic<GC_descr> descr;
     if (!typeInited) {
         GC_word obj_bitmap[GC_BITMAP_SIZE(SymbolObject)] = { 0 };
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(SymbolObject, m_structure));
@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2020-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#include "Escargot.h"
+#include "ThreadLocal.h"
+
+#include <pthread.h>
+
+namespace Escargot {
+
+static thread_local void* g_stackStartAddress;
+static thread_local size_t g_stackLimit;
+
+void ThreadLocal::initializeStackInformation()
+{
+    pthread_attr_t attr;
+    RELEASE_ASSERT(pthread_getattr_np(pthread_self(), &attr) == 0);
+
+    void* stackAddress;
+    size_t size;
+    RELEASE_ASSERT(pthread_attr_getstack(&attr, &stackAddress, &size) == 0);
+    pthread_attr_destroy(&attr);
+
+    size_t freeSpace = std::min(size / 2, (size_t)STACK_FREESPACE_FROM_LIMIT);
+#ifdef STACK_GROWS_DOWN
+    g_stackStartAddress = (char*)stackAddress + size;
+    g_stackLimit = (size_t)stackAddress + freeSpace;
+#else
+    g_stackStartAddress = stackAddress;
+    g_stackLimit = (size_t)stackAddress + size - freeSpace;
+#endif
+
+    // test stack base property aligned
+    RELEASE_ASSERT(((size_t)g_stackStartAddress) % sizeof(size_t) == 0);
+}
+
+void* ThreadLocal::stackStartAddress()
+{
+    if (UNLIKELY(!g_stackStartAddress)) {
+        initializeStackInformation();
+    }
+    return g_stackStartAddress;
+}
+
+size_t ThreadLocal::stackLimit()
+{
+    if (UNLIKELY(!g_stackStartAddress)) {
+        initializeStackInformation();
+    }
+    return g_stackLimit;
+}
+}
@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2020-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#ifndef __EscargotThreadLocal__
+#define __EscargotThreadLocal__
+
+namespace Escargot {
+
+// Stack information of current thread
+// VMInstances run on several threads at once, so stack bounds can not be process-global.
+// Values are computed on first access from each thread and cached in thread local storage.
+class ThreadLocal {
+public:
+    // address where stack of current thread starts (highest address if stack grows down)
+    static void* stackStartAddress();
+
+    // farthest address JavaScript code can use on current thread
+    // STACK_FREESPACE_FROM_LIMIT is kept beyond this for native frames
+    static size_t stackLimit();
+
+private:
+    static void initializeStackInformation();
+};
+}
+
+#endif
@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2020-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#include "Escargot.h"
+#include "TimezoneOffsetCache.h"
+
+#if defined(ENABLE_ICU)
+
+namespace Escargot {
+
+void TimezoneOffsetCache::clear()
+{
+    for (size_t i = 0; i < IntervalCount; i++) {
+        // empty interval. it contains nothing
+        m_intervals[i].m_start = std::numeric_limits<int64_t>::max();
+        m_intervals[i].m_end = std::numeric_limits<int64_t>::min();
+        m_intervals[i].m_stdOffset = 0;
+        m_intervals[i].m_dstOffset = 0;
+        m_intervals[i].m_lastUsedStamp = 0;
+    }
+    m_lastHitIndex = 0;
+    m_stamp = 0;
+    m_rawOffset = 0;
+    m_hasRawOffset = false;
+}
+
+size_t TimezoneOffsetCache::findInterval(int64_t t)
+{
+    for (size_t i = 0; i < IntervalCount; i++) {
+        if (m_intervals[i].m_start <= t && t <= m_intervals[i].m_end) {
+            return i;
+        }
+    }
+    return SIZE_MAX;
+}
+
+size_t TimezoneOffsetCache::allocateInterval()
+{
+    // replace least recently used interval
+    size_t index = 0;
+    for (size_t i = 1; i < IntervalCount; i++) {
+        if (m_intervals[i].m_lastUsedStamp < m_intervals[index].m_lastUsedStamp) {
+            index = i;
+        }
+    }
+    return index;
+}
+
+bool TimezoneOffsetCache::getOffsetSlowCase(VZone* zone, int64_t t, int32_t& stdOffset, int32_t& dstOffset)
+{
+    size_t index = findInterval(t);
+    if (index == SIZE_MAX) {
+        UErrorCode succ = U_ZERO_ERROR;
+        vzone_getOffset3(zone, t, true, stdOffset, dstOffset, succ);
+        if (U_FAILURE(succ)) {
+            return false;
+        }
+
+        // find nearest intervals around t
+        size_t before = SIZE_MAX;
+        size_t after = SIZE_MAX;
+        for (size_t i = 0; i < IntervalCount; i++) {
+            const Interval& interval = m_intervals[i];
+            if (interval.m_start > interval.m_end) {
+                continue;
+            }
+            if (interval.m_end < t && t - interval.m_end <= MaxExtensionDistance) {
+                if (before == SIZE_MAX || m_intervals[before].m_end < interval.m_end) {
+                    before = i;
+                }
+            } else if (interval.m_start > t && interval.m_start - t <= MaxExtensionDistance) {
+                if (after == SIZE_MAX || m_intervals[after].m_start > interval.m_start) {
+                    after = i;
+                }
+            }
+        }
+
+        // if offsets are same on both ends, there is no transition between them
+        // because at most one transition can be in MaxExtensionDistance
+        bool canExtendBefore = before != SIZE_MAX && m_intervals[before].m_stdOffset == stdOffset && m_intervals[before].m_dstOffset == dstOffset;
+        bool canExtendAfter = after != SIZE_MAX && m_intervals[after].m_stdOffset == stdOffset && m_intervals[after].m_dstOffset == dstOffset;
+
+        if (canExtendBefore && canExtendAfter) {
+            m_intervals[before].m_end = m_intervals[after].m_end;
+            m_intervals[after].m_start = std::numeric_limits<int64_t>::max();
+            m_intervals[after].m_end = std::numeric_limits<int64_t>::min();
+            m_intervals[after].m_lastUsedStamp = 0;
+            index = before;
+        } else if (canExtendBefore) {
+            m_intervals[before].m_end = t;
+            index = before;
+        } else if (canExtendAfter) {
+            m_intervals[after].m_start = t;
+            index = after;
+        } else {
+            index = allocateInterval();
+            m_intervals[index].m_start = t;
+            m_intervals[index].m_end = t;
+            m_intervals[index].m_stdOffset = stdOffset;
+            m_intervals[index].m_dstOffset = dstOffset;
+        }
+    } else {
+        stdOffset = m_intervals[index].m_stdOffset;
+        dstOffset = m_intervals[index].m_dstOffset;
+    }
+
+    m_intervals[index].m_lastUsedStamp = ++m_stamp;
+    m_lastHitIndex = index;
+    return true;
+}
+}
+
+#endif
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2020-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#ifndef __EscargotTimezoneOffsetCache__
+#define __EscargotTimezoneOffsetCache__
+
+#if defined(ENABLE_ICU)
+
+namespace Escargot {
+
+// Cache of local timezone offsets for DateObject
+// Offsets of timezone change only on DST or raw offset transitions, which are months apart.
+// So we remember time intervals which have same offsets and conversion becomes range check.
+// Intervals are grown lazily from the result of vzone_getOffset3.
+class TimezoneOffsetCache {
+public:
+    TimezoneOffsetCache()
+    {
+        clear();
+    }
+
+    // same as vzone_getOffset3(zone, t, true, stdOffset, dstOffset, status)
+    // returns false if ICU fails to compute offsets
+    bool getOffset(VZone* zone, int64_t t, int32_t& stdOffset, int32_t& dstOffset)
+    {
+        Interval& last = m_intervals[m_lastHitIndex];
+        if (LIKELY(last.m_start <= t && t <= last.m_end)) {
+            stdOffset = last.m_stdOffset;
+            dstOffset = last.m_dstOffset;
+            return true;
+        }
+        return getOffsetSlowCase(zone, t, stdOffset, dstOffset);
+    }
+
+    int32_t rawOffset(VZone* zone)
+    {
+        if (UNLIKELY(!m_hasRawOffset)) {
+            m_rawOffset = vzone_getRawOffset(zone);
+            m_hasRawOffset = true;
+        }
+        return m_rawOffset;
+    }
+
+    // should be called when timezone is changed
+    void clear();
+
+private:
+    // at most one transition can be in this distance
+    // time zones don't change offset twice in 19 days
+    static const int64_t MaxExtensionDistance = 19LL * 24 * 60 * 60 * 1000;
+    static const size_t IntervalCount = 32;
+
+    struct Interval {
+        int64_t m_start;
+        int64_t m_end;
+        int32_t m_stdOffset;
+        int32_t m_dstOffset;
+        size_t m_lastUsedStamp;
+    };
+
+    bool getOffsetSlowCase(VZone* zone, int64_t t, int32_t& stdOffset, int32_t& dstOffset);
+    size_t findInterval(int64_t t);
+    size_t allocateInterval();
+
+    Interval m_intervals[IntervalCount];
+    size_t m_lastHitIndex;
+    size_t m_stamp;
+    int32_t m_rawOffset;
+    bool m_hasRawOffset;
+};
+}
+
+#endif
+
+#endif
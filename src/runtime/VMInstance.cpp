@@ -26,7 +26,9 @@
 #include "runtime/JobQueue.h"
 #include "runtime/CompressibleString.h"
 #include "interpreter/ByteCode.h"
+#include "interpreter/InterpreterStack.h"
 #include "parser/ASTAllocator.h"
+#include "runtime/ThreadLocal.h"
 
 #include <pthread.h>
 
@@ -105,20 +107,52 @@ void VMInstance::compressStringsIfNeeds(uint64_t currentTickCount)
 {
     auto& currentAllocatedCompressibleStrings = compressibleStrings();
     const size_t& currentAllocatedCompressibleStringsCount = currentAllocatedCompressibleStrings.size();
-    size_t mostBigIndex = SIZE_MAX;
+    bool overBudget = isCompressibleStringsOverBudget();
 
+    // release decompressed chunks of compressed strings first
+    // if we are over budget, release least recently used chunks regardless of last used time
     for (size_t i = 0; i < currentAllocatedCompressibleStringsCount; i++) {
-        if (!currentAllocatedCompressibleStrings[i]->isCompressed() && currentTickCount - currentAllocatedCompressibleStrings[i]->m_lastUsedTickcount > COMPRESSIBLE_COMPRESS_USED_BEFORE_INTERVAL && currentAllocatedCompressibleStrings[i]->decomressedBufferSize() > COMPRESSIBLE_COMPRESS_MIN_SIZE) {
-            if (mostBigIndex == SIZE_MAX) {
-                mostBigIndex = i;
-            } else if (currentAllocatedCompressibleStrings[i]->decomressedBufferSize() > currentAllocatedCompressibleStrings[mostBigIndex]->decomressedBufferSize()) {
-                mostBigIndex = i;
+        currentAllocatedCompressibleStrings[i]->releaseDecompressedChunks(currentTickCount, overBudget ? 0 : COMPRESSIBLE_COMPRESS_USED_BEFORE_INTERVAL);
+    }
+
+    if (!overBudget) {
+        size_t mostBigIndex = SIZE_MAX;
+        for (size_t i = 0; i < currentAllocatedCompressibleStringsCount; i++) {
+            if (!currentAllocatedCompressibleStrings[i]->isCompressed() && currentTickCount - currentAllocatedCompressibleStrings[i]->m_lastUsedTickcount > COMPRESSIBLE_COMPRESS_USED_BEFORE_INTERVAL && currentAllocatedCompressibleStrings[i]->decomressedBufferSize() > COMPRESSIBLE_COMPRESS_MIN_SIZE) {
+                if (mostBigIndex == SIZE_MAX) {
+                    mostBigIndex = i;
+                } else if (currentAllocatedCompressibleStrings[i]->decomressedBufferSize() > currentAllocatedCompressibleStrings[mostBigIndex]->decomressedBufferSize()) {
+                    mostBigIndex = i;
+                }
             }
         }
+
+        if (mostBigIndex != SIZE_MAX) {
+            currentAllocatedCompressibleStrings[mostBigIndex]->compress();
+        }
+        return;
     }
 
-    if (mostBigIndex != SIZE_MAX) {
-        currentAllocatedCompressibleStrings[mostBigIndex]->compress();
+    // we are over budget. compress strings until we are in budget
+    // idle strings go first, and bigger strings go first among them
+    std::vector<CompressibleString*> candidates;
+    for (size_t i = 0; i < currentAllocatedCompressibleStringsCount; i++) {
+        if (!currentAllocatedCompressibleStrings[i]->isCompressed() && currentAllocatedCompressibleStrings[i]->decomressedBufferSize() > COMPRESSIBLE_COMPRESS_MIN_SIZE) {
+            candidates.push_back(currentAllocatedCompressibleStrings[i]);
+        }
+    }
+
+    std::sort(candidates.begin(), candidates.end(), [currentTickCount](CompressibleString* a, CompressibleString* b) -> bool {
+        bool aIsIdle = currentTickCount - a->m_lastUsedTickcount > COMPRESSIBLE_COMPRESS_USED_BEFORE_INTERVAL;
+        bool bIsIdle = currentTickCount - b->m_lastUsedTickcount > COMPRESSIBLE_COMPRESS_USED_BEFORE_INTERVAL;
+        if (aIsIdle != bIsIdle) {
+            return aIsIdle;
+        }
+        return a->decomressedBufferSize() > b->decomressedBufferSize();
+    });
+
+    for (size_t i = 0; i < candidates.size() && isCompressibleStringsOverBudget(); i++) {
+        candidates[i]->compress();
     }
 }
 #endif
@@ -126,11 +160,34 @@ void VMInstance::compressStringsIfNeeds(uint64_t currentTickCount)
 void VMInstance::gcEventCallback(GC_EventType t, void* data)
 {
     VMInstance* self = (VMInstance*)data;
+#if defined(ENABLE_THREADING)
+    // gc can be started by any thread, and this runs while gc holds its allocation lock.
+    // clearing caches, compressing strings and purging bytecode free or allocate gc memory and touch data
+    // which only the owner thread may touch. so they are recorded here and done by the owner thread
+    bool isOwnerThread = pthread_equal(self->m_ownerThread, pthread_self());
+    if (t == GC_EventType::GC_EVENT_MARK_START) {
+        if (isOwnerThread) {
+            self->m_interpreterStack->clearUnusedArea();
+        }
+        self->m_pendingGCEvents |= PendingGCEventMarkStart;
+    } else if (t == GC_EventType::GC_EVENT_RECLAIM_END) {
+        if (isOwnerThread && self->m_allocationProfiler && self->m_allocationProfiler->isRunning()) {
+            self->m_allocationProfiler->didCollectGarbage();
+        }
+        self->m_pendingGCEvents |= PendingGCEventReclaimEnd;
+    }
+#else
     if (t == GC_EventType::GC_EVENT_MARK_START) {
+        self->m_interpreterStack->clearUnusedArea();
+
         if (self->m_regexpCache->size() > REGEXP_CACHE_SIZE_MAX) {
             self->m_regexpCache->clear();
         }
 
+        if (self->m_objectKeysCache->size() > OBJECT_KEYS_CACHE_SIZE_MAX) {
+            self->m_objectKeysCache->clear();
+        }
+
         auto& currentCodeSizeTotal = self->compiledByteCodeSize();
         if (currentCodeSizeTotal > SCRIPT_FUNCTION_OBJECT_BYTECODE_SIZE_MAX) {
             currentCodeSizeTotal = std::numeric_limits<size_t>::max();
@@ -141,9 +198,12 @@ void VMInstance::gcEventCallback(GC_EventType t, void* data)
             }
         }
     } else if (t == GC_EventType::GC_EVENT_RECLAIM_END) {
+        if (self->m_allocationProfiler && self->m_allocationProfiler->isRunning()) {
+            self->m_allocationProfiler->didCollectGarbage();
+        }
 #if defined(ENABLE_COMPRESSIBLE_STRING)
         auto currentTick = fastTickCount();
-        if (currentTick - self->m_lastCompressibleStringsTestTime > COMPRESSIBLE_COMPRESS_CHECK_INTERVAL) {
+        if (self->isCompressibleStringsOverBudget() || currentTick - self->m_lastCompressibleStringsTestTime > COMPRESSIBLE_COMPRESS_CHECK_INTERVAL) {
             self->compressStringsIfNeeds(currentTick);
             self->m_lastCompressibleStringsTestTime = currentTick;
         }
@@ -164,6 +224,7 @@ void VMInstance::gcEventCallback(GC_EventType t, void* data)
             }
         }
     }
+#endif
     /*
     if (t == GC_EventType::GC_EVENT_RECLAIM_END) {
         printf("Done GC: HeapSize: [%f MB , %f MB]\n", GC_get_memory_use() / 1024.f / 1024.f, GC_get_heap_size() / 1024.f / 1024.f);
@@ -175,8 +236,8 @@ void VMInstance::gcEventCallback(GC_EventType t, void* data)
 
 void* VMInstance::operator new(size_t size)
 {
-    static bool typeInited = false;
-    static GC_descr descr;
+    static std::atomic<bool> typeInited(false);
+    static std::atomic<GC_descr> descr;
     if (!typeInited) {
         GC_word desc[GC_BITMAP_SIZE(VMInstance)] = { 0 };
         GC_set_bit(desc, GC_WORD_OFFSET(VMInstance, m_staticStrings.dtoaCache));
@@ -210,9 +271,14 @@ void* VMInstance::operator new(size_t size)
         GC_set_bit(desc, GC_WORD_OFFSET(VMInstance, m_bumpPointerAllocator));
         GC_set_bit(desc, GC_WORD_OFFSET(VMInstance, m_regexpCache));
         GC_set_bit(desc, GC_WORD_OFFSET(VMInstance, m_regexpOptionStringCache));
+        GC_set_bit(desc, GC_WORD_OFFSET(VMInstance, m_objectKeysCache));
         GC_set_bit(desc, GC_WORD_OFFSET(VMInstance, m_cachedUTC));
         GC_set_bit(desc, GC_WORD_OFFSET(VMInstance, m_platform));
         GC_set_bit(desc, GC_WORD_OFFSET(VMInstance, m_jobQueue));
+        GC_set_bit(desc, GC_WORD_OFFSET(VMInstance, m_interpreterStack));
+#if defined(ENABLE_THREADING)
+        GC_set_bit(desc, GC_WORD_OFFSET(VMInstance, m_pendingFinalizers));
+#endif
 
         descr = GC_make_descriptor(desc, GC_WORD_LEN(VMInstance));
         typeInited = true;
@@ -220,8 +286,127 @@ void* VMInstance::operator new(size_t size)
     return GC_MALLOC_EXPLICITLY_TYPED(size, descr);
 }
 
+#if defined(ENABLE_THREADING)
+// objects collected together with their VMInstance can be finalized on other threads while ~VMInstance runs.
+// so the lock is shared by every VMInstance and never destroyed with one
+std::mutex& VMInstance::pendingFinalizersMutex()
+{
+    static std::mutex mutex;
+    return mutex;
+}
+
+bool VMInstance::deferFinalizerToOwnerThread(void* object, void (*finalizer)(void* object))
+{
+    if (pthread_equal(m_ownerThread, pthread_self())) {
+        return false;
+    }
+
+    // allocate before locking. gc can invoke other finalizers on this thread while allocating
+    PendingFinalizer* pending = new PendingFinalizer(object, finalizer);
+
+    std::lock_guard<std::mutex> guard(pendingFinalizersMutex());
+    if (m_isFinalized) {
+        // nothing can touch this VMInstance anymore
+        return false;
+    }
+    pending->m_next = m_pendingFinalizers;
+    m_pendingFinalizers = pending;
+    return true;
+}
+
+void VMInstance::runPendingFinalizers()
+{
+    PendingFinalizer* pending;
+    {
+        std::lock_guard<std::mutex> guard(pendingFinalizersMutex());
+        pending = m_pendingFinalizers;
+        m_pendingFinalizers = nullptr;
+    }
+
+    while (pending) {
+        pending->m_finalizer(pending->m_object);
+        pending = pending->m_next;
+    }
+}
+
+void VMInstance::runPendingGCEventWork()
+{
+    int events = m_pendingGCEvents.exchange(0);
+    if (events & PendingGCEventMarkStart) {
+        // gc started by other thread couldn't clear unused area of this thread
+        m_interpreterStack->clearUnusedArea();
+
+        if (m_regexpCache->size() > REGEXP_CACHE_SIZE_MAX) {
+            m_regexpCache->clear();
+        }
+
+        if (m_objectKeysCache->size() > OBJECT_KEYS_CACHE_SIZE_MAX) {
+            m_objectKeysCache->clear();
+        }
+
+        if (compiledByteCodeSize() > SCRIPT_FUNCTION_OBJECT_BYTECODE_SIZE_MAX) {
+            purgeByteCodeBlocks();
+            // the collection of purging is handled here too. otherwise every SandBox would collect again
+            events |= m_pendingGCEvents.exchange(0);
+        }
+    }
+
+    if (events & PendingGCEventReclaimEnd) {
+        // it is recomputed from sampled objects. so computing again after owner thread did it is harmless
+        if (m_allocationProfiler && m_allocationProfiler->isRunning()) {
+            m_allocationProfiler->didCollectGarbage();
+        }
+#if defined(ENABLE_COMPRESSIBLE_STRING)
+        auto currentTick = fastTickCount();
+        if (isCompressibleStringsOverBudget() || currentTick - m_lastCompressibleStringsTestTime > COMPRESSIBLE_COMPRESS_CHECK_INTERVAL) {
+            compressStringsIfNeeds(currentTick);
+            m_lastCompressibleStringsTestTime = currentTick;
+        }
+#endif
+    }
+}
+
+// every ByteCodeBlock is detached from its CodeBlock during one collection, so bytecode which no frame uses is collected.
+// a ByteCodeBlock whose finalizer was already called stays on compiledByteCodeBlocks
+// until its finalizer runs, maybe on other thread. finalizer table of gc tells which blocks are such ones
+void VMInstance::purgeByteCodeBlocks()
+{
+    auto& v = compiledByteCodeBlocks();
+    for (size_t i = 0; i < v.size(); i++) {
+        v[i]->m_codeBlock->m_byteCodeBlock = nullptr;
+    }
+
+    GC_gcollect();
+    runPendingFinalizers();
+
+    size_t currentCodeSizeTotal = 0;
+    for (size_t i = 0; i < v.size(); i++) {
+        ByteCodeBlock* block = v[i];
+        GC_finalization_proc finalizer;
+        void* finalizerData;
+        GC_REGISTER_FINALIZER_NO_ORDER(block, nullptr, nullptr, &finalizer, &finalizerData);
+        if (!finalizer) {
+            continue;
+        }
+        GC_REGISTER_FINALIZER_NO_ORDER(block, finalizer, finalizerData, nullptr, nullptr);
+
+        block->m_codeBlock->m_byteCodeBlock = block;
+        currentCodeSizeTotal += block->memoryAllocatedSize();
+    }
+    compiledByteCodeSize() = currentCodeSizeTotal;
+}
+#endif
+
 VMInstance::~VMInstance()
 {
+#if defined(ENABLE_THREADING)
+    std::unique_lock<std::mutex> pendingFinalizersGuard(pendingFinalizersMutex());
+    while (m_pendingFinalizers) {
+        pendingFinalizersGuard.unlock();
+        runPendingFinalizers();
+        pendingFinalizersGuard.lock();
+    }
+#endif
     {
         auto& v = compiledByteCodeBlocks();
         for (size_t i = 0; i < v.size(); i++) {
@@ -237,6 +422,11 @@ VMInstance::~VMInstance()
     }
 #endif
     m_isFinalized = true;
+#if defined(ENABLE_THREADING)
+    pendingFinalizersGuard.unlock();
+#endif
+    delete m_samplingProfiler;
+    delete m_allocationProfiler;
     GC_remove_event_callback(gcEventCallback, this);
     if (m_onVMInstanceDestroy) {
         m_onVMInstanceDestroy(this, m_onVMInstanceDestroyData);
@@ -254,9 +444,14 @@ VMInstance::VMInstance(Platform* platform, const char* locale, const char* timez
     , m_isFinalized(false)
     , m_didSomePrototypeObjectDefineIndexedProperty(false)
     , m_compiledByteCodeSize(0)
+    , m_interpreterStack(new InterpreterStack())
+    , m_topInterpreterFrame(nullptr)
+    , m_samplingProfiler(nullptr)
+    , m_allocationProfiler(nullptr)
 #if defined(ENABLE_COMPRESSIBLE_STRING)
     , m_lastCompressibleStringsTestTime(0)
     , m_compressibleStringsUncomressedBufferSize(0)
+    , m_compressibleStringsMemoryBudget(SIZE_MAX)
 #endif
     , m_onVMInstanceDestroy(nullptr)
     , m_onVMInstanceDestroyData(nullptr)
@@ -271,28 +466,30 @@ VMInstance::VMInstance(Platform* platform, const char* locale, const char* timez
                                    nullptr, nullptr, nullptr);
 
 
-    pthread_attr_t attr;
-    RELEASE_ASSERT(pthread_getattr_np(pthread_self(), &attr) == 0);
-
-    size_t size;
-    RELEASE_ASSERT(pthread_attr_getstack(&attr, &m_stackStartAddress, &size) == 0);
-    pthread_attr_destroy(&attr);
-#ifdef STACK_GROWS_DOWN
-    m_stackStartAddress = (char*)m_stackStartAddress + size;
+    // VMInstance should be used on thread which created it
+    m_ownerThread = pthread_self();
+    m_stackStartAddress = ThreadLocal::stackStartAddress();
+#if defined(ENABLE_THREADING)
+    m_pendingFinalizers = nullptr;
+    m_pendingGCEvents = 0;
 #endif
 
-    // test stack base property aligned
-    RELEASE_ASSERT(((size_t)m_stackStartAddress) % sizeof(size_t) == 0);
-
-    if (!String::emptyString) {
+    // values shared by every VMInstance. VMInstances can be created on several threads at once
+    static std::once_flag initializeSharedValuesOnce;
+    std::call_once(initializeSharedValuesOnce, []() {
         String::emptyString = new (NoGC) ASCIIString("");
-    }
+        g_doubleInSmallValueTag = DoubleInSmallValue(0).getTag();
+        g_objectRareDataTag = ObjectRareData(nullptr).getTag();
+        g_symbolTag = Symbol(nullptr).getTag();
+    });
+
     m_staticStrings.initStaticStrings(&m_atomicStringMap);
 
     m_bumpPointerAllocator = new (PointerFreeGC) WTF::BumpPointerAllocator();
     m_regexpCache = new (GC) RegExpCacheMap();
     m_regexpOptionStringCache = (ASCIIString**)GC_MALLOC(32 * sizeof(ASCIIString*));
     memset(m_regexpOptionStringCache, 0, 32 * sizeof(ASCIIString*));
+    m_objectKeysCache = new (GC) ObjectKeysCacheMap();
 
 #ifdef ENABLE_ICU
     m_timezone = nullptr;
@@ -325,12 +522,6 @@ VMInstance::VMInstance(Platform* platform, const char* locale, const char* timez
 
     GC_add_event_callback(gcEventCallback, this);
 
-    g_doubleInSmallValueTag = DoubleInSmallValue(0).getTag();
-
-    g_objectRareDataTag = ObjectRareData(nullptr).getTag();
-
-    g_symbolTag = Symbol(nullptr).getTag();
-
 #define DECLARE_GLOBAL_SYMBOLS(name) m_globalSymbols.name = new Symbol(String::fromASCII("Symbol." #name));
     DEFINE_GLOBAL_SYMBOLS(DECLARE_GLOBAL_SYMBOLS);
 #undef DECLARE_GLOBAL_SYMBOLS
@@ -429,12 +620,14 @@ void VMInstance::ensureTimezone()
 
     auto u16 = utf8StringToUTF16String(m_timezoneID.data(), m_timezoneID.size());
     m_timezone = vzone_openID(u16.data(), u16.size());
+    m_timezoneOffsetCache.clear();
 }
 #endif
 
 void VMInstance::clearCaches()
 {
     m_regexpCache->clear();
+    m_objectKeysCache->clear();
     m_cachedUTC = nullptr;
     globalSymbolRegistry().clear();
 }
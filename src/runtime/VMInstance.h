@@ -29,6 +29,9 @@
 #include "runtime/String.h"
 #include "runtime/Symbol.h"
 #include "runtime/ToStringRecursionPreventer.h"
+#include "runtime/SamplingProfiler.h"
+#include "runtime/AllocationProfiler.h"
+#include "runtime/TimezoneOffsetCache.h"
 
 namespace Escargot {
 
@@ -38,6 +41,7 @@ class JobQueue;
 class Job;
 class ASTAllocator;
 class CompressibleString;
+class InterpreterStack;
 
 #define DEFINE_GLOBAL_SYMBOLS(F) \
     F(hasInstance)               \
@@ -110,6 +114,17 @@ public:
     }
 
     void ensureTimezone();
+
+    // offsets of local timezone for DateObject. see TimezoneOffsetCache
+    bool timezoneOffset(int64_t t, int32_t& stdOffset, int32_t& dstOffset)
+    {
+        return m_timezoneOffsetCache.getOffset(timezone(), t, stdOffset, dstOffset);
+    }
+
+    int32_t timezoneRawOffset()
+    {
+        return m_timezoneOffsetCache.rawOffset(timezone());
+    }
 #endif
     DateObject* cachedUTC() const
     {
@@ -190,8 +205,45 @@ public:
     {
         return m_compressibleStringsUncomressedBufferSize;
     }
+
+    // if size of uncompressed buffers is over budget, we compress strings more aggressively
+    size_t& compressibleStringsMemoryBudget()
+    {
+        return m_compressibleStringsMemoryBudget;
+    }
+
+    bool isCompressibleStringsOverBudget()
+    {
+        return m_compressibleStringsUncomressedBufferSize > m_compressibleStringsMemoryBudget;
+    }
 #endif
 
+    InterpreterFrame*& topInterpreterFrame()
+    {
+        return m_topInterpreterFrame;
+    }
+
+    InterpreterStack* interpreterStack()
+    {
+        return m_interpreterStack;
+    }
+
+    SamplingProfiler* samplingProfiler()
+    {
+        if (!m_samplingProfiler) {
+            m_samplingProfiler = new SamplingProfiler(this);
+        }
+        return m_samplingProfiler;
+    }
+
+    AllocationProfiler* allocationProfiler()
+    {
+        if (!m_allocationProfiler) {
+            m_allocationProfiler = new AllocationProfiler(this);
+        }
+        return m_allocationProfiler;
+    }
+
     std::mt19937& randEngine()
     {
         return m_randEngine;
@@ -224,6 +276,19 @@ public:
         m_onVMInstanceDestroyData = data;
     }
 
+#if defined(ENABLE_THREADING)
+    // gc can invoke finalizers on any thread.
+    // finalizers which touch data of this VMInstance call this first.
+    // returns true if the finalizer is queued and runs later on the owner thread
+    bool deferFinalizerToOwnerThread(void* object, void (*finalizer)(void* object));
+    // called on the owner thread when it enters a SandBox
+    void runPendingFinalizers();
+    // gc event work recorded by gcEventCallback. called on the owner thread when it enters a SandBox
+    void runPendingGCEventWork();
+    // finalizers lock this to read flags which ~VMInstance sets
+    static std::mutex& pendingFinalizersMutex();
+#endif
+
 private:
     StaticStrings m_staticStrings;
     AtomicStringMap m_atomicStringMap;
@@ -253,9 +318,15 @@ private:
     std::vector<ByteCodeBlock*> m_compiledByteCodeBlocks;
     size_t m_compiledByteCodeSize;
 
+    InterpreterStack* m_interpreterStack;
+    InterpreterFrame* m_topInterpreterFrame;
+    SamplingProfiler* m_samplingProfiler;
+    AllocationProfiler* m_allocationProfiler;
+
 #if defined(ENABLE_COMPRESSIBLE_STRING)
     uint64_t m_lastCompressibleStringsTestTime;
     size_t m_compressibleStringsUncomressedBufferSize;
+    size_t m_compressibleStringsMemoryBudget;
     std::vector<CompressibleString*> m_compressibleStrings;
 
     NEVER_INLINE void compressStringsIfNeeds(uint64_t currentTickCount = fastTickCount());
@@ -267,18 +338,49 @@ private:
 
     ToStringRecursionPreventer m_toStringRecursionPreventer;
 
+    pthread_t m_ownerThread;
     void* m_stackStartAddress;
 
+#if defined(ENABLE_THREADING)
+    struct PendingFinalizer : public gc {
+        PendingFinalizer(void* object, void (*finalizer)(void*))
+            : m_object(object)
+            , m_finalizer(finalizer)
+            , m_next(nullptr)
+        {
+        }
+
+        // keeps the object alive until its finalizer runs
+        void* m_object;
+        void (*m_finalizer)(void*);
+        PendingFinalizer* m_next;
+    };
+    PendingFinalizer* m_pendingFinalizers;
+
+    enum PendingGCEvent {
+        PendingGCEventMarkStart = 1 << 0,
+        PendingGCEventReclaimEnd = 1 << 1,
+    };
+    // bits of PendingGCEvent. gc callbacks run on any thread while gc holds its lock, so they only set bits here
+    std::atomic<int> m_pendingGCEvents;
+
+    void purgeByteCodeBlocks();
+#endif
+
     // regexp object data
     WTF::BumpPointerAllocator* m_bumpPointerAllocator;
     RegExpCacheMap* m_regexpCache;
     ASCIIString** m_regexpOptionStringCache;
 
+    // Object.keys data
+    ObjectKeysCacheMap* m_objectKeysCache;
+
 // date object data
 #ifdef ENABLE_ICU
     std::string m_locale;
     VZone* m_timezone;
     std::string m_timezoneID;
+    TimezoneOffsetCache m_timezoneOffsetCache;
 #endif
     DateObject* m_cachedUTC;
 
@@ -0,0 +1,757 @@
+/*
+ * Copyright (c) 2020-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#include "Escargot.h"
+#include "ValueSerializer.h"
+#include "runtime/Context.h"
+#include "runtime/ArrayObject.h"
+#include "runtime/ArrayBufferObject.h"
+#include "runtime/TypedArrayObject.h"
+#include "runtime/DataViewObject.h"
+#include "runtime/DateObject.h"
+#include "runtime/RegExpObject.h"
+#include "runtime/BooleanObject.h"
+#include "runtime/NumberObject.h"
+#include "runtime/StringObject.h"
+#include "runtime/MapObject.h"
+#include "runtime/SetObject.h"
+#include "runtime/ErrorObject.h"
+
+namespace Escargot {
+
+static void checkStackOverflow(ExecutionState& state)
+{
+    volatile int sp;
+    size_t currentStackBase = (size_t)&sp;
+#ifdef STACK_GROWS_DOWN
+    if (UNLIKELY(state.stackLimit() > currentStackBase)) {
+#else
+    if (UNLIKELY(state.stackLimit() < currentStackBase)) {
+#endif
+        ErrorObject::throwBuiltinError(state, ErrorObject::RangeError, "Maximum call stack size exceeded");
+    }
+}
+
+// shape can be shared when every property is enumerable plain data property with string key
+static bool isSharableShape(ObjectStructure* structure)
+{
+    size_t count = structure->propertyCount();
+    for (size_t i = 0; i < count; i++) {
+        const ObjectStructureItem& item = structure->readProperty(i);
+        if (!item.m_propertyName.isPlainString() || !item.m_descriptor.isPlainDataProperty() || !item.m_descriptor.isEnumerable()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+ValueSerializer::ValueSerializer(ExecutionState& state, std::vector<uint8_t>& output, const ValueVector* transferList)
+    : m_state(state)
+    , m_output(output)
+    , m_transferList(transferList)
+    , m_shapeCount(0)
+{
+}
+
+void ValueSerializer::writeHeader()
+{
+    m_output.push_back(headerTag);
+    writeVarint(formatVersion);
+}
+
+void ValueSerializer::writeValue(const Value& value)
+{
+    checkStackOverflow(m_state);
+
+    if (value.isUndefined()) {
+        writeTag(SerializationTag::Undefined);
+    } else if (value.isNull()) {
+        writeTag(SerializationTag::Null);
+    } else if (value.isTrue()) {
+        writeTag(SerializationTag::True);
+    } else if (value.isFalse()) {
+        writeTag(SerializationTag::False);
+    } else if (value.isInt32()) {
+        int32_t i = value.asInt32();
+        writeTag(SerializationTag::Int32);
+        writeVarint(((uint32_t)i << 1) ^ (uint32_t)(i >> 31));
+    } else if (value.isNumber()) {
+        writeTag(SerializationTag::Double);
+        writeDouble(value.asNumber());
+    } else if (value.isString()) {
+        writeString(value.asString());
+    } else if (value.isObject()) {
+        writeObject(value.asObject());
+    } else {
+        throwDataCloneError();
+    }
+}
+
+void ValueSerializer::writeVarint(uint64_t value)
+{
+    while (value >= 0x80) {
+        m_output.push_back((uint8_t)(value | 0x80));
+        value >>= 7;
+    }
+    m_output.push_back((uint8_t)value);
+}
+
+void ValueSerializer::writeDouble(double value)
+{
+    writeBytes(&value, sizeof(double));
+}
+
+void ValueSerializer::writeBytes(const void* src, size_t length)
+{
+    const uint8_t* bytes = (const uint8_t*)src;
+    m_output.insert(m_output.end(), bytes, bytes + length);
+}
+
+void ValueSerializer::writeString(String* string)
+{
+    // contents are written in their own encoding without transcoding
+    auto accessData = string->bufferAccessData();
+    writeTag(accessData.has8BitContent ? SerializationTag::Latin1String : SerializationTag::UTF16String);
+    writeVarint(accessData.length);
+    writeBytes(accessData.buffer, accessData.length * (accessData.has8BitContent ? 1 : 2));
+}
+
+void ValueSerializer::writeObject(Object* object)
+{
+    auto iter = m_objectIndexes.find(object);
+    if (iter != m_objectIndexes.end()) {
+        writeTag(SerializationTag::ObjectReference);
+        writeVarint(iter->second);
+        return;
+    }
+
+    if (object->isCallable() || object->isProxyObject() || object->isSymbolObject() || object->isPromiseObject()
+        || object->isWeakMapObject() || object->isWeakSetObject()) {
+        throwDataCloneError();
+    }
+
+    // index is assigned before writing contents, so contents can refer object itself
+    m_objectIndexes.insert(std::make_pair(object, m_objects.size()));
+    m_objects.pushBack(object);
+
+    if (object->isArrayObject()) {
+        writeArray(object->asArrayObject());
+    } else if (object->isArrayBufferObject()) {
+        writeArrayBuffer(object->asArrayBufferObject());
+    } else if (object->isArrayBufferView()) {
+        writeArrayBufferView(object->asArrayBufferView());
+    } else if (object->isDateObject()) {
+        writeTag(SerializationTag::Date);
+        writeDouble(object->asDateObject()->primitiveValue());
+    } else if (object->isRegExpObject()) {
+        RegExpObject* regexp = object->asRegExpObject();
+        writeTag(SerializationTag::RegExp);
+        writeString(regexp->source());
+        writeVarint(regexp->option());
+    } else if (object->isBooleanObject()) {
+        writeTag(object->asBooleanObject()->primitiveValue() ? SerializationTag::TrueObject : SerializationTag::FalseObject);
+    } else if (object->isNumberObject()) {
+        writeTag(SerializationTag::NumberObject);
+        writeDouble(object->asNumberObject()->primitiveValue());
+    } else if (object->isStringObject()) {
+        writeTag(SerializationTag::StringObject);
+        writeString(object->asStringObject()->primitiveValue());
+    } else if (object->isMapObject()) {
+        // entries are copied first because getters called while writing values can modify map
+        const MapObject::MapObjectData& storage = object->asMapObject()->storage();
+        ValueVectorWithInlineStorage entries;
+        for (size_t i = 0; i < storage.size(); i++) {
+            if (!Value(storage[i].first).isEmpty()) {
+                entries.pushBack(storage[i].first);
+                entries.pushBack(storage[i].second);
+            }
+        }
+        writeTag(SerializationTag::Map);
+        writeVarint(entries.size() / 2);
+        for (size_t i = 0; i < entries.size(); i++) {
+            writeValue(entries[i]);
+        }
+    } else if (object->isSetObject()) {
+        const SetObject::SetObjectData& storage = object->asSetObject()->storage();
+        ValueVectorWithInlineStorage elements;
+        for (size_t i = 0; i < storage.size(); i++) {
+            if (!Value(storage[i]).isEmpty()) {
+                elements.pushBack(storage[i]);
+            }
+        }
+        writeTag(SerializationTag::Set);
+        writeVarint(elements.size());
+        for (size_t i = 0; i < elements.size(); i++) {
+            writeValue(elements[i]);
+        }
+    } else {
+        writePlainObject(object);
+    }
+}
+
+void ValueSerializer::writePlainObject(Object* object)
+{
+    ObjectStructure* structure = object->structure();
+    // structure without transition is owned by one object and changed in place
+    // so only structure in transition mode can identify shape
+    if (object->hasTag(g_objectTag) && structure->inTransitionMode()) {
+        auto iter = m_shapeIndexes.find(structure);
+        bool isNewShape = iter == m_shapeIndexes.end();
+        if (isNewShape && !isSharableShape(structure)) {
+            goto WriteWithKeys;
+        }
+
+        // values are copied first because getters called while writing values can modify object
+        size_t count = structure->propertyCount();
+        ValueVectorWithInlineStorage values;
+        for (size_t i = 0; i < count; i++) {
+            values.pushBack(object->uncheckedGetOwnDataProperty(m_state, i));
+        }
+
+        if (isNewShape) {
+            m_shapeIndexes.insert(std::make_pair(structure, m_shapeCount++));
+            m_shapeStructures.pushBack(structure);
+            writeTag(SerializationTag::Object);
+            writeVarint(count);
+            for (size_t i = 0; i < count; i++) {
+                writeString(structure->readProperty(i).m_propertyName.plainString());
+            }
+        } else {
+            writeTag(SerializationTag::ObjectWithShape);
+            writeVarint(iter->second);
+        }
+
+        for (size_t i = 0; i < count; i++) {
+            writeValue(values[i]);
+        }
+        return;
+    }
+
+WriteWithKeys:
+    // every Object tag defines a shape. this one is not referred by other objects
+    m_shapeCount++;
+    ValueVectorWithInlineStorage keys = Object::enumerableOwnProperties(m_state, object, EnumerableOwnPropertiesType::Key);
+    writeTag(SerializationTag::Object);
+    writeVarint(keys.size());
+    for (size_t i = 0; i < keys.size(); i++) {
+        writeString(keys[i].toString(m_state));
+    }
+    for (size_t i = 0; i < keys.size(); i++) {
+        writeValue(object->get(m_state, ObjectPropertyName(m_state, keys[i])).value(m_state, object));
+    }
+}
+
+void ValueSerializer::writeArray(ArrayObject* array)
+{
+    uint32_t length = array->getArrayLength(m_state);
+    if (!array->isFastModeArray() || array->structure()->propertyCount()) {
+        // array has named properties or too many holes
+        ValueVectorWithInlineStorage keys = Object::enumerableOwnProperties(m_state, array, EnumerableOwnPropertiesType::Key);
+        writeTag(SerializationTag::SparseArray);
+        writeVarint(length);
+        writeVarint(keys.size());
+        for (size_t i = 0; i < keys.size(); i++) {
+            writeString(keys[i].toString(m_state));
+            writeValue(array->get(m_state, ObjectPropertyName(m_state, keys[i])).value(m_state, array));
+        }
+        return;
+    }
+
+    writeTag(SerializationTag::DenseArray);
+    writeVarint(length);
+    for (uint32_t i = 0; i < length; i++) {
+        Value element;
+        if (LIKELY(array->isFastModeArray() && i < array->getArrayLength(m_state))) {
+            element = array->m_fastModeData[i];
+        } else {
+            // array is changed by getter
+            ObjectGetResult result = array->getOwnProperty(m_state, ObjectPropertyName(m_state, Value(i)));
+            element = result.hasValue() ? result.value(m_state, array) : Value(Value::EmptyValue);
+        }
+
+        if (element.isEmpty()) {
+            writeTag(SerializationTag::ArrayHole);
+        } else {
+            writeValue(element);
+        }
+    }
+}
+
+void ValueSerializer::writeArrayBuffer(ArrayBufferObject* buffer)
+{
+    if (m_transferList) {
+        for (size_t i = 0; i < m_transferList->size(); i++) {
+            if ((*m_transferList)[i] == Value(buffer)) {
+                writeTag(SerializationTag::TransferredArrayBuffer);
+                writeVarint(i);
+                return;
+            }
+        }
+    }
+
+    if (buffer->isDetachedBuffer()) {
+        throwDataCloneError();
+    }
+    writeTag(SerializationTag::ArrayBuffer);
+    writeVarint(buffer->byteLength());
+    writeBytes(buffer->data(), buffer->byteLength());
+}
+
+void ValueSerializer::writeArrayBufferView(ArrayBufferView* view)
+{
+    if (!view->buffer()) {
+        throwDataCloneError();
+    }
+
+    if (view->isDataViewObject()) {
+        writeTag(SerializationTag::DataView);
+        writeVarint(view->byteOffset());
+        writeVarint(view->byteLength());
+    } else {
+        writeTag(SerializationTag::TypedArray);
+        m_output.push_back((uint8_t)view->typedArrayType());
+        writeVarint(view->byteOffset());
+        writeVarint(view->arrayLength());
+    }
+    // buffer shared by views is written once
+    writeObject(view->buffer());
+}
+
+void ValueSerializer::throwDataCloneError()
+{
+    ErrorObject::throwBuiltinError(m_state, ErrorObject::TypeError, "value could not be cloned");
+}
+
+ValueDeserializer::ValueDeserializer(ExecutionState& state, const uint8_t* data, size_t length, const std::vector<ArrayBufferObjectBackingStore*>* transferredBuffers)
+    : m_state(state)
+    , m_data(data)
+    , m_length(length)
+    , m_position(0)
+    , m_transferredBuffers(transferredBuffers)
+{
+}
+
+void ValueDeserializer::readHeader()
+{
+    if (readByte() != ValueSerializer::headerTag) {
+        throwInvalidDataError();
+    }
+    if (readVarint() != ValueSerializer::formatVersion) {
+        ErrorObject::throwBuiltinError(m_state, ErrorObject::TypeError, "unsupported serialization format version");
+    }
+}
+
+Value ValueDeserializer::readValue()
+{
+    checkStackOverflow(m_state);
+
+    SerializationTag tag = (SerializationTag)readByte();
+    switch (tag) {
+    case SerializationTag::Undefined:
+        return Value();
+    case SerializationTag::Null:
+        return Value(Value::Null);
+    case SerializationTag::True:
+        return Value(true);
+    case SerializationTag::False:
+        return Value(false);
+    case SerializationTag::Int32: {
+        uint32_t zigzag = readUint32();
+        return Value((int32_t)((zigzag >> 1) ^ (0 - (zigzag & 1))));
+    }
+    case SerializationTag::Double:
+        return Value(readDouble());
+    case SerializationTag::Latin1String:
+    case SerializationTag::UTF16String:
+        return readString(tag);
+    case SerializationTag::ObjectReference: {
+        uint64_t index = readVarint();
+        // view under construction can't be referred
+        if (index >= m_objects.size() || m_objects[index].isEmpty()) {
+            throwInvalidDataError();
+        }
+        return m_objects[index];
+    }
+    case SerializationTag::Object:
+        return readObject();
+    case SerializationTag::ObjectWithShape: {
+        uint64_t shapeIndex = readVarint();
+        if (shapeIndex >= m_shapeKeyRanges.size()) {
+            throwInvalidDataError();
+        }
+        return readObjectWithShape(shapeIndex);
+    }
+    case SerializationTag::DenseArray:
+        return readDenseArray();
+    case SerializationTag::SparseArray:
+        return readSparseArray();
+    case SerializationTag::Date: {
+        DateObject* date = new DateObject(m_state);
+        addObject(date);
+        double time = readDouble();
+        if (std::isnan(time) || std::abs(time) > const_Date_MaximumDatePrimitiveValue) {
+            date->setTimeValueAsNaN();
+        } else {
+            date->setTimeValue((time64_t)time);
+        }
+        return date;
+    }
+    case SerializationTag::RegExp: {
+        String* source = readTaggedString();
+        uint64_t option = readVarint();
+        if (option > (RegExpObject::Global | RegExpObject::IgnoreCase | RegExpObject::MultiLine | RegExpObject::Sticky | RegExpObject::Unicode)) {
+            throwInvalidDataError();
+        }
+        RegExpObject* regexp = new RegExpObject(m_state, source, (unsigned int)option);
+        addObject(regexp);
+        return regexp;
+    }
+    case SerializationTag::TrueObject:
+    case SerializationTag::FalseObject: {
+        BooleanObject* object = new BooleanObject(m_state, tag == SerializationTag::TrueObject);
+        addObject(object);
+        return object;
+    }
+    case SerializationTag::NumberObject: {
+        NumberObject* object = new NumberObject(m_state, readDouble());
+        addObject(object);
+        return object;
+    }
+    case SerializationTag::StringObject: {
+        StringObject* object = new StringObject(m_state, readTaggedString());
+        addObject(object);
+        return object;
+    }
+    case SerializationTag::Map: {
+        MapObject* map = new MapObject(m_state);
+        addObject(map);
+        size_t count = readCount();
+        for (size_t i = 0; i < count; i++) {
+            Value key = readValue();
+            Value value = readValue();
+            map->set(m_state, key, value);
+        }
+        return map;
+    }
+    case SerializationTag::Set: {
+        SetObject* set = new SetObject(m_state);
+        addObject(set);
+        size_t count = readCount();
+        for (size_t i = 0; i < count; i++) {
+            set->add(m_state, readValue());
+        }
+        return set;
+    }
+    case SerializationTag::ArrayBuffer: {
+        ArrayBufferObject* buffer = new ArrayBufferObject(m_state);
+        addObject(buffer);
+        size_t byteLength = readCount();
+        buffer->allocateBuffer(m_state, byteLength);
+        buffer->fillData(readBytes(byteLength), byteLength);
+        return buffer;
+    }
+    case SerializationTag::TransferredArrayBuffer: {
+        uint64_t index = readVarint();
+        if (!m_transferredBuffers || index >= m_transferredBuffers->size()) {
+            throwInvalidDataError();
+        }
+        ArrayBufferObject* buffer = new ArrayBufferObject(m_state);
+        addObject(buffer);
+        // ArrayBuffer owns backing store from now
+        buffer->attachBuffer(m_state, (*m_transferredBuffers)[index]);
+        return buffer;
+    }
+    case SerializationTag::TypedArray:
+    case SerializationTag::DataView:
+        return readArrayBufferView(tag);
+    default:
+        throwInvalidDataError();
+        return Value();
+    }
+}
+
+uint8_t ValueDeserializer::readByte()
+{
+    if (UNLIKELY(m_position >= m_length)) {
+        throwInvalidDataError();
+    }
+    return m_data[m_position++];
+}
+
+uint64_t ValueDeserializer::readVarint()
+{
+    uint64_t result = 0;
+    for (unsigned shift = 0; shift < 64; shift += 7) {
+        uint8_t byte = readByte();
+        result |= (uint64_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            return result;
+        }
+    }
+    throwInvalidDataError();
+    return 0;
+}
+
+uint32_t ValueDeserializer::readUint32()
+{
+    uint64_t value = readVarint();
+    if (UNLIKELY(value > std::numeric_limits<uint32_t>::max())) {
+        throwInvalidDataError();
+    }
+    return (uint32_t)value;
+}
+
+size_t ValueDeserializer::readCount()
+{
+    uint64_t count = readVarint();
+    if (UNLIKELY(count > m_length - m_position)) {
+        throwInvalidDataError();
+    }
+    return (size_t)count;
+}
+
+double ValueDeserializer::readDouble()
+{
+    double value;
+    memcpy(&value, readBytes(sizeof(double)), sizeof(double));
+    return value;
+}
+
+const uint8_t* ValueDeserializer::readBytes(size_t length)
+{
+    if (UNLIKELY(length > m_length - m_position)) {
+        throwInvalidDataError();
+    }
+    const uint8_t* result = m_data + m_position;
+    m_position += length;
+    return result;
+}
+
+String* ValueDeserializer::readString(SerializationTag tag)
+{
+    size_t length = readCount();
+    if (length == 0) {
+        return String::emptyString;
+    }
+
+    if (tag == SerializationTag::Latin1String) {
+        const char* chars = (const char*)readBytes(length);
+        if (isAllASCII(chars, length)) {
+            return new ASCIIString(chars, length);
+        }
+        return new Latin1String((const LChar*)chars, length);
+    }
+
+    ASSERT(tag == SerializationTag::UTF16String);
+    // data is not aligned for char16_t
+    const uint8_t* bytes = readBytes(length * 2);
+    UTF16StringData chars;
+    chars.resizeWithUninitializedValues(length);
+    memcpy(chars.data(), bytes, length * 2);
+    return new UTF16String(std::move(chars));
+}
+
+String* ValueDeserializer::readTaggedString()
+{
+    SerializationTag tag = (SerializationTag)readByte();
+    if (tag != SerializationTag::Latin1String && tag != SerializationTag::UTF16String) {
+        throwInvalidDataError();
+    }
+    return readString(tag);
+}
+
+size_t ValueDeserializer::addObject(const Value& object)
+{
+    m_objects.pushBack(object);
+    return m_objects.size() - 1;
+}
+
+Value ValueDeserializer::readObject()
+{
+    size_t keyCount = readCount();
+    size_t keyStart = m_shapeKeys.size();
+    for (size_t i = 0; i < keyCount; i++) {
+        m_shapeKeys.pushBack(readTaggedString());
+    }
+
+    size_t shapeIndex = m_shapeKeyRanges.size();
+    m_shapeKeyRanges.push_back(std::make_pair(keyStart, keyCount));
+    m_shapeStructures.pushBack(nullptr);
+    return readObjectWithShape(shapeIndex);
+}
+
+ObjectStructure* ValueDeserializer::structureForShape(size_t shapeIndex)
+{
+    if (m_shapeStructures[shapeIndex]) {
+        return m_shapeStructures[shapeIndex];
+    }
+
+    ObjectStructure* structure = m_state.context()->defaultStructureForObject();
+    size_t keyEnd = m_shapeKeyRanges[shapeIndex].first + m_shapeKeyRanges[shapeIndex].second;
+    for (size_t i = m_shapeKeyRanges[shapeIndex].first; i < keyEnd; i++) {
+        ObjectStructurePropertyName name(m_state, m_shapeKeys[i]);
+        if (UNLIKELY(structure->findProperty(name).first != SIZE_MAX)) {
+            throwInvalidDataError();
+        }
+        structure = structure->addProperty(name, ObjectStructurePropertyDescriptor::createDataDescriptor());
+    }
+
+    // structure without transition is owned by one object
+    // so only structure in transition mode can be shared with every object of the shape
+    if (structure->inTransitionMode()) {
+        m_shapeStructures[shapeIndex] = structure;
+    }
+    return structure;
+}
+
+Value ValueDeserializer::readObjectWithShape(size_t shapeIndex)
+{
+    ObjectStructure* structure = structureForShape(shapeIndex);
+    size_t count = structure->propertyCount();
+
+    Object* object = new Object(m_state, count, true);
+    object->m_structure = structure;
+    for (size_t i = 0; i < count; i++) {
+        object->m_values[i] = Value();
+    }
+    addObject(object);
+
+    for (size_t i = 0; i < count; i++) {
+        object->uncheckedSetOwnDataProperty(m_state, i, readValue());
+    }
+    return object;
+}
+
+Value ValueDeserializer::readDenseArray()
+{
+    // every element takes at least one byte
+    size_t length = readCount();
+    ArrayObject* array = new ArrayObject(m_state, (uint64_t)length);
+    addObject(array);
+
+    for (size_t i = 0; i < length; i++) {
+        if (m_position < m_length && m_data[m_position] == (uint8_t)SerializationTag::ArrayHole) {
+            m_position++;
+            continue;
+        }
+
+        Value element = readValue();
+        if (LIKELY(array->isFastModeArray())) {
+            array->m_fastModeData[i] = element;
+        } else {
+            array->defineOwnPropertyThrowsException(m_state, ObjectPropertyName(m_state, Value(i)), ObjectPropertyDescriptor(element, ObjectPropertyDescriptor::AllPresent));
+        }
+    }
+    return array;
+}
+
+Value ValueDeserializer::readSparseArray()
+{
+    uint32_t length = readUint32();
+    size_t count = readCount();
+    ArrayObject* array = new ArrayObject(m_state, (uint64_t)length);
+    addObject(array);
+
+    for (size_t i = 0; i < count; i++) {
+        Value key = readTaggedString();
+        Value value = readValue();
+        array->defineOwnPropertyThrowsException(m_state, ObjectPropertyName(m_state, key), ObjectPropertyDescriptor(value, ObjectPropertyDescriptor::AllPresent));
+    }
+    return array;
+}
+
+Value ValueDeserializer::readArrayBufferView(SerializationTag tag)
+{
+    // view is registered before its buffer like serializer does
+    size_t index = addObject(Value(Value::EmptyValue));
+
+    TypedArrayType type = TypedArrayType::Uint8;
+    if (tag == SerializationTag::TypedArray) {
+        uint8_t typeValue = readByte();
+        if (typeValue > TypedArrayType::Float64) {
+            throwInvalidDataError();
+        }
+        type = (TypedArrayType)typeValue;
+    }
+    uint32_t byteOffset = readUint32();
+    uint32_t length = readUint32();
+    ArrayBufferObject* buffer = readArrayBufferValue();
+
+    size_t elementSize = ArrayBufferView::getElementSize(type);
+    uint64_t byteLength = (uint64_t)length * (tag == SerializationTag::TypedArray ? elementSize : 1);
+    if (byteOffset % elementSize || byteOffset + byteLength > buffer->byteLength()) {
+        throwInvalidDataError();
+    }
+
+    ArrayBufferView* view;
+    if (tag == SerializationTag::DataView) {
+        view = new DataViewObject(m_state);
+        view->setBuffer(buffer, byteOffset, byteLength);
+    } else {
+        switch (type) {
+        case TypedArrayType::Int8:
+            view = new Int8ArrayObject(m_state);
+            break;
+        case TypedArrayType::Int16:
+            view = new Int16ArrayObject(m_state);
+            break;
+        case TypedArrayType::Int32:
+            view = new Int32ArrayObject(m_state);
+            break;
+        case TypedArrayType::Uint8:
+            view = new Uint8ArrayObject(m_state);
+            break;
+        case TypedArrayType::Uint16:
+            view = new Uint16ArrayObject(m_state);
+            break;
+        case TypedArrayType::Uint32:
+            view = new Uint32ArrayObject(m_state);
+            break;
+        case TypedArrayType::Uint8Clamped:
+            view = new Uint8ClampedArrayObject(m_state);
+            break;
+        case TypedArrayType::Float32:
+            view = new Float32ArrayObject(m_state);
+            break;
+        default:
+            ASSERT(type == TypedArrayType::Float64);
+            view = new Float64ArrayObject(m_state);
+            break;
+        }
+        view->setBuffer(buffer, byteOffset, byteLength, length);
+    }
+
+    m_objects[index] = view;
+    return view;
+}
+
+ArrayBufferObject* ValueDeserializer::readArrayBufferValue()
+{
+    Value buffer = readValue();
+    if (!buffer.isObject() || !buffer.asObject()->isArrayBufferObject()) {
+        throwInvalidDataError();
+    }
+    return buffer.asObject()->asArrayBufferObject();
+}
+
+void ValueDeserializer::throwInvalidDataError()
+{
+    ErrorObject::throwBuiltinError(m_state, ErrorObject::TypeError, "invalid serialized data");
+}
+}
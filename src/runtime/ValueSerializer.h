@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2020-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#ifndef __EscargotValueSerializer__
+#define __EscargotValueSerializer__
+
+#include "runtime/Value.h"
+
+namespace Escargot {
+
+class ObjectStructure;
+class ArrayBufferObjectBackingStore;
+
+// Binary structured clone format
+// header is 0xFF and format version. every value starts with SerializationTag
+// lengths, counts and indexes are unsigned LEB128. Int32 is zigzag-encoded LEB128
+// Double and contents of strings and ArrayBuffers are raw bytes in host byte order
+// Objects are numbered in order of appearance. an object seen before is written as ObjectReference,
+// so shared and cyclic references are restored
+// Object defines a shape(list of keys). next objects with same ObjectStructure are written as
+// ObjectWithShape and deserializer creates them on one cached ObjectStructure
+enum class SerializationTag : uint8_t {
+    Undefined = 1,
+    Null,
+    True,
+    False,
+    Int32, // zigzag value
+    Double, // 8 bytes
+    Latin1String, // length, chars
+    UTF16String, // length, chars
+    ObjectReference, // object index
+    Object, // key count, keys as strings, values
+    ObjectWithShape, // shape index, values
+    DenseArray, // length, elements or ArrayHole
+    ArrayHole,
+    SparseArray, // length, property count, (key, value) pairs
+    Date, // time value as double
+    RegExp, // source as string, option flags
+    TrueObject,
+    FalseObject,
+    NumberObject, // double
+    StringObject, // string
+    Map, // entry count, (key, value) pairs
+    Set, // element count, elements
+    ArrayBuffer, // byte length, contents
+    TransferredArrayBuffer, // index in transfer list
+    TypedArray, // TypedArrayType, byte offset, array length, buffer
+    DataView, // byte offset, byte length, buffer
+};
+
+class ValueSerializer {
+public:
+    static const uint8_t headerTag = 0xFF;
+    static const uint32_t formatVersion = 1;
+
+    // ArrayBuffers in transferList are written as TransferredArrayBuffer
+    // moving their backing stores is up to caller
+    ValueSerializer(ExecutionState& state, std::vector<uint8_t>& output, const ValueVector* transferList = nullptr);
+
+    void writeHeader();
+    // throws TypeError if value contains function, symbol, proxy or other object which can't be cloned
+    void writeValue(const Value& value);
+
+private:
+    void writeTag(SerializationTag tag)
+    {
+        m_output.push_back((uint8_t)tag);
+    }
+
+    void writeVarint(uint64_t value);
+    void writeDouble(double value);
+    void writeBytes(const void* src, size_t length);
+    void writeString(String* string);
+
+    void writeObject(Object* object);
+    void writePlainObject(Object* object);
+    void writeArray(ArrayObject* array);
+    void writeArrayBuffer(ArrayBufferObject* buffer);
+    void writeArrayBufferView(ArrayBufferView* view);
+
+    void throwDataCloneError();
+
+    ExecutionState& m_state;
+    std::vector<uint8_t>& m_output;
+    const ValueVector* m_transferList;
+
+    // serialized objects and structures are kept alive until serialization ends
+    // so their addresses are not reused by new objects allocated on getter calls
+    Vector<Object*, GCUtil::gc_malloc_allocator<Object*>> m_objects;
+    std::unordered_map<Object*, size_t> m_objectIndexes;
+    Vector<ObjectStructure*, GCUtil::gc_malloc_allocator<ObjectStructure*>> m_shapeStructures;
+    std::unordered_map<ObjectStructure*, size_t> m_shapeIndexes;
+    size_t m_shapeCount;
+};
+
+class ValueDeserializer {
+public:
+    // transferredBuffers are backing stores for TransferredArrayBuffer
+    // each store is attached to ArrayBuffer. caller still releases the stores
+    ValueDeserializer(ExecutionState& state, const uint8_t* data, size_t length, const std::vector<ArrayBufferObjectBackingStore*>* transferredBuffers = nullptr);
+
+    // throws TypeError if data is malformed or written with another format version
+    void readHeader();
+    Value readValue();
+
+private:
+    uint8_t readByte();
+    uint64_t readVarint();
+    uint32_t readUint32();
+    // returns count which fits in remaining data when each item takes at least one byte
+    size_t readCount();
+    double readDouble();
+    const uint8_t* readBytes(size_t length);
+    String* readString(SerializationTag tag);
+    String* readTaggedString();
+
+    size_t addObject(const Value& object);
+    Value readObject();
+    Value readObjectWithShape(size_t shapeIndex);
+    ObjectStructure* structureForShape(size_t shapeIndex);
+    Value readDenseArray();
+    Value readSparseArray();
+    Value readArrayBufferView(SerializationTag tag);
+    ArrayBufferObject* readArrayBufferValue();
+
+    void throwInvalidDataError();
+
+    ExecutionState& m_state;
+    const uint8_t* m_data;
+    size_t m_length;
+    size_t m_position;
+    const std::vector<ArrayBufferObjectBackingStore*>* m_transferredBuffers;
+
+    ValueVector m_objects;
+    // keys of every shape are stored in one vector
+    ValueVector m_shapeKeys;
+    std::vector<std::pair<size_t, size_t>> m_shapeKeyRanges;
+    Vector<ObjectStructure*, GCUtil::gc_malloc_allocator<ObjectStructure*>> m_shapeStructures;
+};
+}
+
+#endif
@@ -32,8 +32,8 @@ WeakMapObject::WeakMapObject(ExecutionState& state)
 
 void* WeakMapObject::WeakMapObjectDataItem::operator new(size_t size)
 {
-    static bool typeInited = false;
-    static GC_descr descr;
+    static std::atomic<bool> typeInited(false);
+    static std::atomic<GC_descr> descr;
     if (!typeInited) {
         GC_word obj_bitmap[GC_BITMAP_SIZE(WeakMapObject::WeakMapObjectDataItem)] = { 0 };
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(WeakMapObject::WeakMapObjectDataItem, data));
@@ -45,8 +45,8 @@ void* WeakMapObject::WeakMapObjectDataItem::operator new(size_t size)
 
 void* WeakMapObject::operator new(size_t size)
 {
-    static bool typeInited = false;
-    static GC_descr descr;
+    static std::atomic<bool> typeInited(false);
+    static std::atomic<GC_descr> descr;
     if (!typeInited) {
         GC_word obj_bitmap[GC_BITMAP_SIZE(WeakMapObject)] = { 0 };
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(WeakMapObject, m_structure));
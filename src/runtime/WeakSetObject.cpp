@@ -32,8 +32,8 @@ WeakSetObject::WeakSetObject(ExecutionState& state)
 
 void* WeakSetObject::operator new(size_t size)
 {
-    static bool typeInited = false;
-    static GC_descr descr;
+    static std::atomic<bool> typeInited(false);
+    static std::atomic<GC_descr> descr;
     if (!typeInited) {
         GC_word obj_bitmap[GC_BITMAP_SIZE(WeakSetObject)] = { 0 };
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(WeakSetObject, m_structure));
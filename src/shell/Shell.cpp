@@ -18,9 +18,20 @@
  */
 
 #include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <vector>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include <algorithm>
 
 #include "api/EscargotPublic.h"
+#include "util/StringKernels.h"
 #include "malloc.h"
 
 #if defined(ESCARGOT_ENABLE_TEST)
@@ -62,6 +73,10 @@ void printEveryReachableGCObjects()
     printf("<-- end of print reachable pointers %fKB\n", totalRemainSize / 1024.f);
 }
 
+// defined in StringKernelsTest.cpp
+size_t verifyStringKernels();
+double benchmarkStringKernel(const char* name, size_t length, size_t iterations);
+
 // <---- these header & function above are used for Escargot internal development
 #endif
 
@@ -140,58 +155,174 @@ char32_t readUTF8Sequence(const char*& sequence, bool& valid, int& charlen)
     return ch - offsetsFromUTF8[length - 1];
 }
 
-static OptionalRef<StringRef> builtinHelperFileRead(OptionalRef<ExecutionStateRef> state, const char* fileName, const char* builtinName)
+struct ShellFileData {
+    std::string utf8Str;
+    std::basic_string<unsigned char, std::char_traits<unsigned char>> latin1Str;
+    bool hasNonLatin1Content;
+    // ASCII only file is mapped into memory and used as source string without copying
+    const char* mappedBuffer;
+    size_t mappedLength;
+
+    ShellFileData()
+        : hasNonLatin1Content(false)
+        , mappedBuffer(nullptr)
+        , mappedLength(0)
+    {
+    }
+
+    ShellFileData(ShellFileData&& src) noexcept
+        : utf8Str(std::move(src.utf8Str))
+        , latin1Str(std::move(src.latin1Str))
+        , hasNonLatin1Content(src.hasNonLatin1Content)
+        , mappedBuffer(src.mappedBuffer)
+        , mappedLength(src.mappedLength)
+    {
+        src.mappedBuffer = nullptr;
+        src.mappedLength = 0;
+    }
+
+    ShellFileData& operator=(ShellFileData&& src) noexcept
+    {
+        if (this != &src) {
+            unmap();
+            utf8Str = std::move(src.utf8Str);
+            latin1Str = std::move(src.latin1Str);
+            hasNonLatin1Content = src.hasNonLatin1Content;
+            mappedBuffer = src.mappedBuffer;
+            mappedLength = src.mappedLength;
+            src.mappedBuffer = nullptr;
+            src.mappedLength = 0;
+        }
+        return *this;
+    }
+
+    ShellFileData(const ShellFileData&) = delete;
+    ShellFileData& operator=(const ShellFileData&) = delete;
+
+    ~ShellFileData()
+    {
+        unmap();
+    }
+
+    void unmap()
+    {
+        if (mappedBuffer) {
+            munmap((void*)mappedBuffer, mappedLength);
+            mappedBuffer = nullptr;
+            mappedLength = 0;
+        }
+    }
+};
+
+static bool mapASCIIFile(const char* fileName, ShellFileData& data)
 {
+    if (getenv("SHELL_DISABLE_MMAP_SOURCE") && strlen(getenv("SHELL_DISABLE_MMAP_SOURCE"))) {
+        return false;
+    }
+
+    int fd = open(fileName, O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size == 0) {
+        close(fd);
+        return false;
+    }
+
+    size_t length = st.st_size;
+    void* buffer = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    // mapping is kept after closing file descriptor
+    close(fd);
+    if (buffer == MAP_FAILED) {
+        return false;
+    }
+
+    // UTF-8 file without non-ASCII character is valid ASCII string
+    if (!StringKernels::isAllASCII((const LChar*)buffer, length)) {
+        munmap(buffer, length);
+        return false;
+    }
+
+    data.mappedBuffer = (const char*)buffer;
+    data.mappedLength = length;
+    return true;
+}
+
+// this function doesn't touch vm. so it can run on other threads
+static bool readFileData(const char* fileName, ShellFileData& data)
+{
+    if (mapASCIIFile(fileName, data)) {
+        return true;
+    }
+
     FILE* fp = fopen(fileName, "r");
-    if (fp) {
-        StringRef* src = StringRef::emptyString();
-        std::string utf8Str;
-        std::basic_string<unsigned char, std::char_traits<unsigned char>> str;
-        char buf[512];
-        bool hasNonLatin1Content = false;
-        size_t readLen;
-        while ((readLen = fread(buf, 1, sizeof buf, fp))) {
-            if (!hasNonLatin1Content) {
-                const char* source = buf;
-                int charlen;
-                bool valid;
-                while (source < buf + readLen) {
-                    char32_t ch = readUTF8Sequence(source, valid, charlen);
-                    if (ch > 255) {
-                        hasNonLatin1Content = true;
-                        fseek(fp, 0, SEEK_SET);
-                        break;
-                    } else {
-                        str += (unsigned char)ch;
-                    }
+    if (!fp) {
+        return false;
+    }
+
+    char buf[512];
+    data.hasNonLatin1Content = false;
+    size_t readLen;
+    while ((readLen = fread(buf, 1, sizeof buf, fp))) {
+        if (!data.hasNonLatin1Content) {
+            const char* source = buf;
+            int charlen;
+            bool valid;
+            while (source < buf + readLen) {
+                char32_t ch = readUTF8Sequence(source, valid, charlen);
+                if (ch > 255) {
+                    data.hasNonLatin1Content = true;
+                    fseek(fp, 0, SEEK_SET);
+                    break;
+                } else {
+                    data.latin1Str += (unsigned char)ch;
                 }
-            } else {
-                utf8Str.append(buf, readLen);
-            }
-        }
-        fclose(fp);
-#if defined(ENABLE_COMPRESSIBLE_STRING)
-        if (state) {
-            if (hasNonLatin1Content) {
-                src = StringRef::createFromUTF8ToCompressibleString(state->context(), utf8Str.data(), utf8Str.length());
-            } else {
-                src = StringRef::createFromLatin1ToCompressibleString(state->context(), str.data(), str.length());
             }
         } else {
-            if (hasNonLatin1Content) {
-                src = StringRef::createFromUTF8(utf8Str.data(), utf8Str.length());
-            } else {
-                src = StringRef::createFromLatin1(str.data(), str.length());
-            }
+            data.utf8Str.append(buf, readLen);
         }
-#else
-        if (hasNonLatin1Content) {
-            src = StringRef::createFromUTF8(utf8Str.data(), utf8Str.length());
+    }
+    fclose(fp);
+    return true;
+}
+
+static StringRef* createStringFromFileData(OptionalRef<ExecutionStateRef> state, ShellFileData& data)
+{
+    if (data.mappedBuffer) {
+        // mapped source doesn't become CompressibleString even if ENABLE_COMPRESSIBLE_STRING is on.
+        // its pages are clean file-backed pages which kernel can drop and read again from file under memory pressure,
+        // so compressing them would only add a heap copy of the source
+        // mapping is released when source string is collected
+        StringRef* str = StringRef::createExternalFromASCII(data.mappedBuffer, data.mappedLength, [](const void* buffer, size_t length) {
+            munmap(const_cast<void*>(buffer), length);
+        });
+        data.mappedBuffer = nullptr;
+        data.mappedLength = 0;
+        return str;
+    }
+#if defined(ENABLE_COMPRESSIBLE_STRING)
+    if (state) {
+        if (data.hasNonLatin1Content) {
+            return StringRef::createFromUTF8ToCompressibleString(state->context(), data.utf8Str.data(), data.utf8Str.length());
         } else {
-            src = StringRef::createFromLatin1(str.data(), str.length());
+            return StringRef::createFromLatin1ToCompressibleString(state->context(), data.latin1Str.data(), data.latin1Str.length());
         }
+    }
 #endif
-        return src;
+    if (data.hasNonLatin1Content) {
+        return StringRef::createFromUTF8(data.utf8Str.data(), data.utf8Str.length());
+    } else {
+        return StringRef::createFromLatin1(data.latin1Str.data(), data.latin1Str.length());
+    }
+}
+
+static OptionalRef<StringRef> builtinHelperFileRead(OptionalRef<ExecutionStateRef> state, const char* fileName, const char* builtinName)
+{
+    ShellFileData data;
+    if (readFileData(fileName, data)) {
+        return createStringFromFileData(state, data);
     } else {
         char msg[1024];
         snprintf(msg, sizeof(msg), "GlobalObject.%s: cannot open file %s", builtinName, fileName);
@@ -278,6 +409,89 @@ static ValueRef* builtinDrainJobQueue(ExecutionStateRef* state, ValueRef* thisVa
     return ValueRef::create(true);
 }
 
+static ValueRef* builtinSerialize(ExecutionStateRef* state, ValueRef* thisValue, size_t argc, ValueRef** argv, bool isConstructCall)
+{
+    std::vector<uint8_t> data = ValueSerializerRef::serialize(state, argc ? argv[0] : ValueRef::createUndefined());
+    ArrayBufferObjectRef* buffer = ArrayBufferObjectRef::create(state);
+    buffer->allocateBuffer(state, data.size());
+    memcpy(buffer->rawBuffer(), data.data(), data.size());
+    return buffer;
+}
+
+static ValueRef* builtinDeserialize(ExecutionStateRef* state, ValueRef* thisValue, size_t argc, ValueRef** argv, bool isConstructCall)
+{
+    if (argc < 1 || !argv[0]->isArrayBufferObject()) {
+        state->throwException(TypeErrorObjectRef::create(state, StringRef::createFromASCII("deserialize needs an ArrayBuffer")));
+    }
+    ArrayBufferObjectRef* buffer = argv[0]->asArrayBufferObject();
+    return ValueDeserializerRef::deserialize(state, buffer->rawBuffer(), buffer->byteLength());
+}
+
+// calls function and returns stack trace of exception thrown from it as array of "functionName:line"
+static ValueRef* builtinStackTraceOf(ExecutionStateRef* state, ValueRef* thisValue, size_t argc, ValueRef** argv, bool isConstructCall)
+{
+    if (argc < 1 || !argv[0]->isFunctionObject()) {
+        state->throwException(TypeErrorObjectRef::create(state, StringRef::createFromASCII("stackTraceOf needs a function")));
+    }
+
+    auto result = Evaluator::execute(state->context(), [](ExecutionStateRef* state, ValueRef* fn) -> ValueRef* {
+        return fn->call(state, ValueRef::createUndefined(), 0, nullptr);
+    },
+                                     argv[0]);
+    if (result.isSuccessful()) {
+        return ValueRef::createUndefined();
+    }
+
+    ValueVectorRef* frames = ValueVectorRef::create();
+    for (size_t i = 0; i < result.stackTraceData.size(); i++) {
+        std::string frame = result.stackTraceData[i].functionName->toStdUTF8String() + ":" + std::to_string(result.stackTraceData[i].loc.line);
+        frames->pushBack(StringRef::createFromUTF8(frame.data(), frame.length()));
+    }
+    return ArrayObjectRef::create(state, frames);
+}
+
+static ValueRef* builtinVerifyStringKernels(ExecutionStateRef* state, ValueRef* thisValue, size_t argc, ValueRef** argv, bool isConstructCall)
+{
+    return ValueRef::create(verifyStringKernels());
+}
+
+static ValueRef* builtinBenchmarkStringKernel(ExecutionStateRef* state, ValueRef* thisValue, size_t argc, ValueRef** argv, bool isConstructCall)
+{
+    if (argc < 3) {
+        return ValueRef::create(-1);
+    }
+    std::string name = argv[0]->toString(state)->toStdUTF8String();
+    return ValueRef::create(benchmarkStringKernel(name.data(), argv[1]->toUint32(state), argv[2]->toUint32(state)));
+}
+
+static ValueRef* builtinStartCPUProfiler(ExecutionStateRef* state, ValueRef* thisValue, size_t argc, ValueRef** argv, bool isConstructCall)
+{
+    size_t interval = argc ? argv[0]->toUint32(state) : 1000;
+    return ValueRef::create(state->context()->vmInstance()->startCPUProfiler(interval));
+}
+
+static ValueRef* builtinStopCPUProfiler(ExecutionStateRef* state, ValueRef* thisValue, size_t argc, ValueRef** argv, bool isConstructCall)
+{
+    VMInstanceRef* instance = state->context()->vmInstance();
+    instance->stopCPUProfiler();
+    std::string profile = instance->dumpCPUProfile();
+    return StringRef::createFromUTF8(profile.data(), profile.length());
+}
+
+static ValueRef* builtinStartAllocationProfiler(ExecutionStateRef* state, ValueRef* thisValue, size_t argc, ValueRef** argv, bool isConstructCall)
+{
+    size_t interval = argc ? argv[0]->toUint32(state) : 32 * 1024;
+    return ValueRef::create(state->context()->vmInstance()->startAllocationProfiler(interval));
+}
+
+static ValueRef* builtinStopAllocationProfiler(ExecutionStateRef* state, ValueRef* thisValue, size_t argc, ValueRef** argv, bool isConstructCall)
+{
+    VMInstanceRef* instance = state->context()->vmInstance();
+    instance->stopAllocationProfiler();
+    std::string profile = instance->dumpAllocationProfile();
+    return StringRef::createFromUTF8(profile.data(), profile.length());
+}
+
 static ValueRef* builtinAddPromiseReactions(ExecutionStateRef* state, ValueRef* thisValue, size_t argc, ValueRef** argv, bool isConstructCall)
 {
     if (argc >= 3) {
@@ -295,6 +509,9 @@ static ValueRef* builtinDrainCreateNewGlobalObject(ExecutionStateRef* state, Val
 }
 #endif
 
+static ValueRef* builtinWorker(ExecutionStateRef* state, ValueRef* thisValue, size_t argc, ValueRef** argv, bool isConstructCall);
+static ValueRef* builtinWorkerGlobalPostMessage(ExecutionStateRef* state, ValueRef* thisValue, size_t argc, ValueRef** argv, bool isConstructCall);
+
 PersistentRefHolder<ContextRef> createEscargotContext(VMInstanceRef* instance)
 {
     PersistentRefHolder<ContextRef> context = ContextRef::create(instance);
@@ -331,6 +548,12 @@ PersistentRefHolder<ContextRef> createEscargotContext(VMInstanceRef* instance)
             context->globalObject()->defineDataProperty(state, StringRef::createFromASCII("gc"), buildFunctionObjectRef, true, true, true);
         }
 
+        {
+            FunctionObjectRef::NativeFunctionInfo nativeFunctionInfo(AtomicStringRef::create(context, "Worker"), builtinWorker, 1, true, true);
+            FunctionObjectRef* buildFunctionObjectRef = FunctionObjectRef::create(state, nativeFunctionInfo);
+            context->globalObject()->defineDataProperty(state, StringRef::createFromASCII("Worker"), buildFunctionObjectRef, true, false, true);
+        }
+
 #if defined(ESCARGOT_ENABLE_TEST)
         {
             FunctionObjectRef::NativeFunctionInfo nativeFunctionInfo(AtomicStringRef::create(context, "uneval"), builtinUneval, 1, true, false);
@@ -344,6 +567,60 @@ PersistentRefHolder<ContextRef> createEscargotContext(VMInstanceRef* instance)
             context->globalObject()->defineDataProperty(state, StringRef::createFromASCII("drainJobQueue"), buildFunctionObjectRef, true, true, true);
         }
 
+        {
+            FunctionObjectRef::NativeFunctionInfo nativeFunctionInfo(AtomicStringRef::create(context, "serialize"), builtinSerialize, 1, true, false);
+            FunctionObjectRef* buildFunctionObjectRef = FunctionObjectRef::create(state, nativeFunctionInfo);
+            context->globalObject()->defineDataProperty(state, StringRef::createFromASCII("serialize"), buildFunctionObjectRef, true, true, true);
+        }
+
+        {
+            FunctionObjectRef::NativeFunctionInfo nativeFunctionInfo(AtomicStringRef::create(context, "deserialize"), builtinDeserialize, 1, true, false);
+            FunctionObjectRef* buildFunctionObjectRef = FunctionObjectRef::create(state, nativeFunctionInfo);
+            context->globalObject()->defineDataProperty(state, StringRef::createFromASCII("deserialize"), buildFunctionObjectRef, true, true, true);
+        }
+
+        {
+            FunctionObjectRef::NativeFunctionInfo nativeFunctionInfo(AtomicStringRef::create(context, "stackTraceOf"), builtinStackTraceOf, 1, true, false);
+            FunctionObjectRef* buildFunctionObjectRef = FunctionObjectRef::create(state, nativeFunctionInfo);
+            context->globalObject()->defineDataProperty(state, StringRef::createFromASCII("stackTraceOf"), buildFunctionObjectRef, true, true, true);
+        }
+
+        {
+            FunctionObjectRef::NativeFunctionInfo nativeFunctionInfo(AtomicStringRef::create(context, "verifyStringKernels"), builtinVerifyStringKernels, 0, true, false);
+            FunctionObjectRef* buildFunctionObjectRef = FunctionObjectRef::create(state, nativeFunctionInfo);
+            context->globalObject()->defineDataProperty(state, StringRef::createFromASCII("verifyStringKernels"), buildFunctionObjectRef, true, true, true);
+        }
+
+        {
+            FunctionObjectRef::NativeFunctionInfo nativeFunctionInfo(AtomicStringRef::create(context, "benchmarkStringKernel"), builtinBenchmarkStringKernel, 3, true, false);
+            FunctionObjectRef* buildFunctionObjectRef = FunctionObjectRef::create(state, nativeFunctionInfo);
+            context->globalObject()->defineDataProperty(state, StringRef::createFromASCII("benchmarkStringKernel"), buildFunctionObjectRef, true, true, true);
+        }
+
+        {
+            FunctionObjectRef::NativeFunctionInfo nativeFunctionInfo(AtomicStringRef::create(context, "startCPUProfiler"), builtinStartCPUProfiler, 1, true, false);
+            FunctionObjectRef* buildFunctionObjectRef = FunctionObjectRef::create(state, nativeFunctionInfo);
+            context->globalObject()->defineDataProperty(state, StringRef::createFromASCII("startCPUProfiler"), buildFunctionObjectRef, true, true, true);
+        }
+
+        {
+            FunctionObjectRef::NativeFunctionInfo nativeFunctionInfo(AtomicStringRef::create(context, "stopCPUProfiler"), builtinStopCPUProfiler, 0, true, false);
+            FunctionObjectRef* buildFunctionObjectRef = FunctionObjectRef::create(state, nativeFunctionInfo);
+            context->globalObject()->defineDataProperty(state, StringRef::createFromASCII("stopCPUProfiler"), buildFunctionObjectRef, true, true, true);
+        }
+
+        {
+            FunctionObjectRef::NativeFunctionInfo nativeFunctionInfo(AtomicStringRef::create(context, "startAllocationProfiler"), builtinStartAllocationProfiler, 1, true, false);
+            FunctionObjectRef* buildFunctionObjectRef = FunctionObjectRef::create(state, nativeFunctionInfo);
+            context->globalObject()->defineDataProperty(state, StringRef::createFromASCII("startAllocationProfiler"), buildFunctionObjectRef, true, true, true);
+        }
+
+        {
+            FunctionObjectRef::NativeFunctionInfo nativeFunctionInfo(AtomicStringRef::create(context, "stopAllocationProfiler"), builtinStopAllocationProfiler, 0, true, false);
+            FunctionObjectRef* buildFunctionObjectRef = FunctionObjectRef::create(state, nativeFunctionInfo);
+            context->globalObject()->defineDataProperty(state, StringRef::createFromASCII("stopAllocationProfiler"), buildFunctionObjectRef, true, true, true);
+        }
+
         {
             FunctionObjectRef::NativeFunctionInfo nativeFunctionInfo(AtomicStringRef::create(context, "addPromiseReactions"), builtinAddPromiseReactions, 3, true, false);
             FunctionObjectRef* buildFunctionObjectRef = FunctionObjectRef::create(state, nativeFunctionInfo);
@@ -410,7 +687,8 @@ public:
     }
 
     std::vector<std::tuple<std::string /* abs path */, ContextRef*, PersistentRefHolder<ScriptRef>>> loadedModules;
-    virtual LoadModuleResult onLoadModule(ContextRef* relatedContext, ScriptRef* whereRequestFrom, StringRef* moduleSrc) override
+
+    std::string modulePath(ScriptRef* whereRequestFrom, StringRef* moduleSrc)
     {
         std::string referrerPath = whereRequestFrom->src()->toStdUTF8String();
 
@@ -421,25 +699,27 @@ public:
             }
         }
 
-        std::string absPath = absolutePath(referrerPath, moduleSrc->toStdUTF8String());
-        if (absPath.length() == 0) {
-            std::string s = "Error reading : " + moduleSrc->toStdUTF8String();
-            return LoadModuleResult(ErrorObjectRef::Code::None, StringRef::createFromUTF8(s.data(), s.length()));
-        }
+        return absolutePath(referrerPath, moduleSrc->toStdUTF8String());
+    }
 
+    OptionalRef<ScriptRef> findLoadedModule(ContextRef* relatedContext, const std::string& absPath)
+    {
         for (size_t i = 0; i < loadedModules.size(); i++) {
             if (std::get<0>(loadedModules[i]) == absPath && std::get<1>(loadedModules[i]) == relatedContext) {
-                return LoadModuleResult(std::get<2>(loadedModules[i]));
+                return std::get<2>(loadedModules[i]).get();
             }
         }
+        return nullptr;
+    }
 
-        OptionalRef<StringRef> source = builtinHelperFileRead(nullptr, absPath.data(), "");
-        if (!source) {
-            std::string s = "Error reading : " + absPath;
-            return LoadModuleResult(ErrorObjectRef::Code::None, StringRef::createFromUTF8(s.data(), s.length()));
-        }
+    static LoadModuleResult errorResult(const std::string& message)
+    {
+        return LoadModuleResult(ErrorObjectRef::Code::None, StringRef::createFromUTF8(message.data(), message.length()));
+    }
 
-        auto parseResult = relatedContext->scriptParser()->initializeScript(source.value(), moduleSrc, true);
+    LoadModuleResult parseModule(ContextRef* relatedContext, const std::string& absPath, StringRef* moduleSrc, StringRef* source)
+    {
+        auto parseResult = relatedContext->scriptParser()->initializeScript(source, moduleSrc, true);
         if (!parseResult.isSuccessful()) {
             return LoadModuleResult(parseResult.parseErrorCode, parseResult.parseErrorMessage);
         }
@@ -448,6 +728,115 @@ public:
         return LoadModuleResult(parseResult.script.get());
     }
 
+    virtual LoadModuleResult onLoadModule(ContextRef* relatedContext, ScriptRef* whereRequestFrom, StringRef* moduleSrc) override
+    {
+        std::string absPath = modulePath(whereRequestFrom, moduleSrc);
+        if (absPath.length() == 0) {
+            return errorResult("Error reading : " + moduleSrc->toStdUTF8String());
+        }
+
+        auto loaded = findLoadedModule(relatedContext, absPath);
+        if (loaded) {
+            return LoadModuleResult(loaded.get());
+        }
+
+        OptionalRef<StringRef> source = builtinHelperFileRead(nullptr, absPath.data(), "");
+        if (!source) {
+            return errorResult("Error reading : " + absPath);
+        }
+
+        return parseModule(relatedContext, absPath, moduleSrc, source.value());
+    }
+
+    struct ModuleFileReadTask {
+        std::string absPath;
+        ShellFileData data;
+        bool isSuccessful;
+        bool isDone;
+    };
+
+    // files are read by worker threads while vm thread parses sources already read
+    virtual GCManagedVector<LoadModuleResult> onLoadModules(ContextRef* relatedContext, const std::vector<ModuleRequest>& requests) override
+    {
+        std::vector<std::string> absPaths;
+        std::vector<size_t> taskIndexes;
+        std::vector<ModuleFileReadTask> tasks;
+        for (size_t i = 0; i < requests.size(); i++) {
+            std::string absPath = modulePath(requests[i].whereRequestFrom, requests[i].moduleSrc);
+            size_t taskIndex = SIZE_MAX;
+            if (absPath.length() && !findLoadedModule(relatedContext, absPath)) {
+                for (size_t j = 0; j < tasks.size(); j++) {
+                    if (tasks[j].absPath == absPath) {
+                        taskIndex = j;
+                        break;
+                    }
+                }
+                if (taskIndex == SIZE_MAX) {
+                    taskIndex = tasks.size();
+                    tasks.push_back(ModuleFileReadTask({ absPath, ShellFileData(), false, false }));
+                }
+            }
+            absPaths.push_back(absPath);
+            taskIndexes.push_back(taskIndex);
+        }
+
+        std::mutex mutex;
+        std::condition_variable condition;
+        std::atomic<size_t> nextTask(0);
+        std::vector<std::thread> workers;
+        size_t workerCount = std::min<size_t>(tasks.size(), std::max(std::thread::hardware_concurrency(), 2u));
+        for (size_t i = 0; i < workerCount; i++) {
+            workers.push_back(std::thread([&]() {
+                size_t index;
+                while ((index = nextTask++) < tasks.size()) {
+                    ShellFileData data;
+                    bool isSuccessful = readFileData(tasks[index].absPath.data(), data);
+                    std::lock_guard<std::mutex> guard(mutex);
+                    tasks[index].data = std::move(data);
+                    tasks[index].isSuccessful = isSuccessful;
+                    tasks[index].isDone = true;
+                    condition.notify_all();
+                }
+            }));
+        }
+
+        // parse sources in order of requests as soon as they are read
+        // results are kept in gc heap. modules parsed earlier can be collected while parsing later ones otherwise
+        GCManagedVector<LoadModuleResult> results(requests.size());
+        for (size_t i = 0; i < requests.size(); i++) {
+            if (absPaths[i].length() == 0) {
+                results[i] = errorResult("Error reading : " + requests[i].moduleSrc->toStdUTF8String());
+                continue;
+            }
+
+            auto loaded = findLoadedModule(relatedContext, absPaths[i]);
+            if (loaded) {
+                results[i] = LoadModuleResult(loaded.get());
+                continue;
+            }
+
+            ModuleFileReadTask& task = tasks[taskIndexes[i]];
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                condition.wait(lock, [&task]() {
+                    return task.isDone;
+                });
+            }
+            if (!task.isSuccessful) {
+                results[i] = errorResult("Error reading : " + absPaths[i]);
+                continue;
+            }
+
+            StringRef* source = createStringFromFileData(nullptr, task.data);
+            results[i] = parseModule(relatedContext, absPaths[i], requests[i].moduleSrc, source);
+        }
+
+        for (size_t i = 0; i < workers.size(); i++) {
+            workers[i].join();
+        }
+        return results;
+    }
+
     virtual void didLoadModule(ContextRef* relatedContext, OptionalRef<ScriptRef> referrer, ScriptRef* loadedModule) override
     {
         std::string path;
@@ -460,6 +849,24 @@ public:
     }
 };
 
+// parses source repeatedly without running it and prints throughput of parser
+static bool measureParseThroughput(ContextRef* context, StringRef* str, StringRef* fileName, bool isModule)
+{
+    const int iterations = 10;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        auto scriptInitializeResult = context->scriptParser()->initializeScript(str, fileName, isModule);
+        if (!scriptInitializeResult.script) {
+            printf("Script parsing error: %s\n", scriptInitializeResult.parseErrorMessage->toStdUTF8String().data());
+            return false;
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    double megabytes = (double)str->length() * iterations / (1024 * 1024);
+    printf("%s: %.2f MB/s (%d iterations, %.3f sec)\n", fileName->toStdUTF8String().data(), seconds > 0 ? megabytes / seconds : 0.0, iterations, seconds);
+    return true;
+}
+
 static bool evalScript(ContextRef* context, StringRef* str, StringRef* fileName, bool shouldPrintScriptResult, bool isModule)
 {
     if (stringEndsWith(fileName->toStdUTF8String(), "mjs")) {
@@ -525,6 +932,277 @@ static bool evalScript(ContextRef* context, StringRef* str, StringRef* fileName,
     return true;
 }
 
+// Worker runs a script file on its own thread and VMInstance
+// main script and worker exchange messages through entangled MessagePortRefs
+//  main   : var w = new Worker(file); w.postMessage(value, [transferred ArrayBuffers]);
+//           w.receiveMessage(timeoutInMilliseconds); w.terminate();
+//  worker : onmessage = function(value) { ... }; postMessage(value, [transferred ArrayBuffers]);
+struct ShellWorker {
+    MessagePortRef* port;
+    std::thread thread;
+};
+
+// workers created by VMInstance of current thread
+static thread_local std::vector<ShellWorker*> g_workers;
+// port connected to creator of worker. nullptr on main thread
+static thread_local MessagePortRef* g_workerPort;
+
+static void terminateWorker(ShellWorker* worker)
+{
+    // worker thread stops after handling messages already sent
+    worker->port->destroy();
+    worker->thread.join();
+    g_workers.erase(std::find(g_workers.begin(), g_workers.end(), worker));
+    delete worker;
+}
+
+static void terminateAllWorkers()
+{
+    while (g_workers.size()) {
+        terminateWorker(g_workers.back());
+    }
+}
+
+static void postMessageToPort(ExecutionStateRef* state, MessagePortRef* port, size_t argc, ValueRef** argv)
+{
+    ValueRef* message = argc >= 1 ? argv[0] : ValueRef::createUndefined();
+    ValueVectorRef* transferList = ValueVectorRef::create();
+    if (argc >= 2 && !argv[1]->isUndefined()) {
+        ObjectRef* list = argv[1]->toObject(state);
+        uint64_t length = list->get(state, StringRef::createFromASCII("length"))->toLength(state);
+        for (uint64_t i = 0; i < length; i++) {
+            transferList->pushBack(list->get(state, ValueRef::create(i)));
+        }
+    }
+    port->postMessage(state, message, transferList);
+}
+
+static void runWorker(std::string fileName, MessagePortRef* port)
+{
+    Globals::initializeThread();
+    g_workerPort = port;
+
+    ShellPlatform* platform = new ShellPlatform();
+    PersistentRefHolder<VMInstanceRef> instance = VMInstanceRef::create(platform);
+    instance->setOnVMInstanceDelete([](VMInstanceRef* instance) {
+        delete instance->platform();
+    });
+    PersistentRefHolder<ContextRef> context = createEscargotContext(instance.get());
+
+    Evaluator::execute(context, [](ExecutionStateRef* state) -> ValueRef* {
+        ContextRef* context = state->context();
+        FunctionObjectRef::NativeFunctionInfo nativeFunctionInfo(AtomicStringRef::create(context, "postMessage"), builtinWorkerGlobalPostMessage, 2, true, false);
+        FunctionObjectRef* buildFunctionObjectRef = FunctionObjectRef::create(state, nativeFunctionInfo);
+        context->globalObject()->defineDataProperty(state, StringRef::createFromASCII("postMessage"), buildFunctionObjectRef, true, true, true);
+        return ValueRef::createUndefined();
+    });
+
+    auto readResult = Evaluator::execute(context, [](ExecutionStateRef* state, const char* fileName) -> ValueRef* {
+        return builtinHelperFileRead(state, fileName, "Worker").get();
+    },
+                                         fileName.data());
+    if (!readResult.isSuccessful()) {
+        printf("Uncaught %s:\n", readResult.resultOrErrorToString(context)->toStdUTF8String().data());
+    } else if (evalScript(context, readResult.result->asString(), StringRef::createFromUTF8(fileName.data(), fileName.length()), false, false)) {
+        // waitForMessage returns false when creator terminated worker and there is no message left
+        while (port->waitForMessage()) {
+            auto result = Evaluator::execute(context, [](ExecutionStateRef* state, MessagePortRef* port) -> ValueRef* {
+                OptionalRef<ValueRef> message = port->receiveMessage(state);
+                ValueRef* handler = state->context()->globalObject()->get(state, StringRef::createFromASCII("onmessage"));
+                if (message && handler->isCallable()) {
+                    ValueRef* argv[1] = { message.value() };
+                    handler->call(state, ValueRef::createUndefined(), 1, argv);
+                }
+                return ValueRef::createUndefined();
+            },
+                                             port);
+            if (!result.isSuccessful()) {
+                printf("Uncaught %s:\n", result.resultOrErrorToString(context)->toStdUTF8String().data());
+            }
+
+            while (context->vmInstance()->hasPendingPromiseJob()) {
+                context->vmInstance()->executePendingPromiseJob();
+            }
+        }
+    }
+
+    terminateAllWorkers();
+    context.release();
+    instance.release();
+
+    port->destroy();
+    g_workerPort = nullptr;
+    Globals::finalizeThread();
+}
+
+static ShellWorker* thisWorker(ExecutionStateRef* state, ValueRef* thisValue)
+{
+    if (thisValue->isObject()) {
+        ShellWorker* worker = (ShellWorker*)thisValue->asObject()->extraData();
+        if (worker && std::find(g_workers.begin(), g_workers.end(), worker) != g_workers.end()) {
+            return worker;
+        }
+    }
+    state->throwException(TypeErrorObjectRef::create(state, StringRef::createFromASCII("this value is not a running Worker")));
+    return nullptr;
+}
+
+static ValueRef* builtinWorkerPostMessage(ExecutionStateRef* state, ValueRef* thisValue, size_t argc, ValueRef** argv, bool isConstructCall)
+{
+    postMessageToPort(state, thisWorker(state, thisValue)->port, argc, argv);
+    return ValueRef::createUndefined();
+}
+
+static ValueRef* builtinWorkerReceiveMessage(ExecutionStateRef* state, ValueRef* thisValue, size_t argc, ValueRef** argv, bool isConstructCall)
+{
+    MessagePortRef* port = thisWorker(state, thisValue)->port;
+    uint64_t timeout = std::numeric_limits<uint64_t>::max();
+    if (argc >= 1 && !argv[0]->isUndefined()) {
+        timeout = (uint64_t)std::max(argv[0]->toInteger(state), 0.0);
+    }
+    if (port->waitForMessage(timeout)) {
+        OptionalRef<ValueRef> message = port->receiveMessage(state);
+        if (message) {
+            return message.value();
+        }
+    }
+    return ValueRef::createUndefined();
+}
+
+static ValueRef* builtinWorkerTerminate(ExecutionStateRef* state, ValueRef* thisValue, size_t argc, ValueRef** argv, bool isConstructCall)
+{
+    terminateWorker(thisWorker(state, thisValue));
+    thisValue->asObject()->setExtraData(nullptr);
+    return ValueRef::createUndefined();
+}
+
+static ValueRef* builtinWorker(ExecutionStateRef* state, ValueRef* thisValue, size_t argc, ValueRef** argv, bool isConstructCall)
+{
+    if (!Globals::supportsThreading()) {
+        state->throwException(TypeErrorObjectRef::create(state, StringRef::createFromASCII("Escargot is built without threading support")));
+    }
+    if (!isConstructCall || argc < 1) {
+        state->throwException(TypeErrorObjectRef::create(state, StringRef::createFromASCII("Worker should be created with new Worker(fileName)")));
+    }
+
+    std::string fileName = argv[0]->toString(state)->toStdUTF8String();
+    ObjectRef* workerObject = ObjectRef::create(state);
+    ContextRef* context = state->context();
+    {
+        FunctionObjectRef::NativeFunctionInfo nativeFunctionInfo(AtomicStringRef::create(context, "postMessage"), builtinWorkerPostMessage, 2, true, false);
+        workerObject->defineDataProperty(state, StringRef::createFromASCII("postMessage"), FunctionObjectRef::create(state, nativeFunctionInfo), true, false, true);
+    }
+    {
+        FunctionObjectRef::NativeFunctionInfo nativeFunctionInfo(AtomicStringRef::create(context, "receiveMessage"), builtinWorkerReceiveMessage, 1, true, false);
+        workerObject->defineDataProperty(state, StringRef::createFromASCII("receiveMessage"), FunctionObjectRef::create(state, nativeFunctionInfo), true, false, true);
+    }
+    {
+        FunctionObjectRef::NativeFunctionInfo nativeFunctionInfo(AtomicStringRef::create(context, "terminate"), builtinWorkerTerminate, 0, true, false);
+        workerObject->defineDataProperty(state, StringRef::createFromASCII("terminate"), FunctionObjectRef::create(state, nativeFunctionInfo), true, false, true);
+    }
+
+    MessagePortRef* workerPort;
+    ShellWorker* worker = new ShellWorker();
+    MessagePortRef::createChannel(worker->port, workerPort);
+    worker->thread = std::thread(runWorker, fileName, workerPort);
+    g_workers.push_back(worker);
+    workerObject->setExtraData(worker);
+
+    return workerObject;
+}
+
+static ValueRef* builtinWorkerGlobalPostMessage(ExecutionStateRef* state, ValueRef* thisValue, size_t argc, ValueRef** argv, bool isConstructCall)
+{
+    postMessageToPort(state, g_workerPort, argc, argv);
+    return ValueRef::createUndefined();
+}
+
+// runs files on a VMInstance which is created and destroyed on current thread
+static bool runFilesOnNewVMInstance(const std::vector<const char*>& files)
+{
+    ShellPlatform* platform = new ShellPlatform();
+    PersistentRefHolder<VMInstanceRef> instance = VMInstanceRef::create(platform);
+    instance->setOnVMInstanceDelete([](VMInstanceRef* instance) {
+        delete instance->platform();
+    });
+    PersistentRefHolder<ContextRef> context = createEscargotContext(instance.get());
+
+    bool result = true;
+    for (size_t i = 0; i < files.size() && result; i++) {
+        OptionalRef<StringRef> src = Evaluator::execute(context, [](ExecutionStateRef* state, const char* fileName) -> ValueRef* {
+                                         return builtinHelperFileRead(state, fileName, "read").get();
+                                     },
+                                                        files[i])
+                                         .result->asString();
+        result = evalScript(context, src.get(), StringRef::createFromUTF8(files[i], strlen(files[i])), false, false);
+    }
+
+    terminateAllWorkers();
+    context.release();
+    instance.release();
+    return result;
+}
+
+// stress test for threading support
+// every thread runs same files on its own VMInstance at once
+static bool runFilesOnConcurrentVMInstances(size_t vmCount, const std::vector<const char*>& files)
+{
+    if (!Globals::supportsThreading()) {
+        fprintf(stderr, "Escargot is built without threading support\n");
+        return false;
+    }
+
+    std::atomic<size_t> failureCount(0);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < vmCount; i++) {
+        threads.push_back(std::thread([&]() {
+            Globals::initializeThread();
+            if (!runFilesOnNewVMInstance(files)) {
+                failureCount++;
+            }
+            Globals::finalizeThread();
+        }));
+    }
+    for (size_t i = 0; i < threads.size(); i++) {
+        threads[i].join();
+    }
+
+    printf("%zu VMInstances finished, %zu failed\n", vmCount, failureCount.load());
+    return failureCount == 0;
+}
+
+static void writeCPUProfile(VMInstanceRef* instance, const char* path)
+{
+    if (!path) {
+        return;
+    }
+    instance->stopCPUProfiler();
+    FILE* fp = fopen(path, "w");
+    if (!fp) {
+        fprintf(stderr, "Cannot open file %s\n", path);
+        return;
+    }
+    std::string profile = instance->dumpCPUProfile();
+    fwrite(profile.data(), 1, profile.length(), fp);
+    fclose(fp);
+}
+
+static void writeAllocationProfile(VMInstanceRef* instance, const char* path)
+{
+    if (!path) {
+        return;
+    }
+    instance->stopAllocationProfiler();
+    FILE* fp = fopen(path, "w");
+    if (!fp) {
+        fprintf(stderr, "Cannot open file %s\n", path);
+        return;
+    }
+    std::string profile = instance->dumpAllocationProfile();
+    fwrite(profile.data(), 1, profile.length(), fp);
+    fclose(fp);
+}
+
 int main(int argc, char* argv[])
 {
 #ifndef NDEBUG
@@ -557,6 +1235,11 @@ int main(int argc, char* argv[])
 
     bool runShell = true;
     bool seenModule = false;
+    bool parseOnly = false;
+    size_t concurrentVMCount = 0;
+    std::vector<const char*> concurrentVMFiles;
+    const char* cpuProfilePath = nullptr;
+    const char* allocationProfilePath = nullptr;
     for (int i = 1; i < argc; i++) {
         if (strlen(argv[i]) >= 2 && argv[i][0] == '-') { // parse command line option
             if (argv[i][1] == '-') { // `--option` case
@@ -564,17 +1247,49 @@ int main(int argc, char* argv[])
                     runShell = true;
                     continue;
                 }
+                if (strncmp(argv[i], "--cpu-profile=", strlen("--cpu-profile=")) == 0) {
+                    cpuProfilePath = argv[i] + strlen("--cpu-profile=");
+                    if (!instance->startCPUProfiler()) {
+                        fprintf(stderr, "Cannot start cpu profiler\n");
+                        cpuProfilePath = nullptr;
+                    }
+                    continue;
+                }
+                if (strncmp(argv[i], "--alloc-profile=", strlen("--alloc-profile=")) == 0) {
+                    allocationProfilePath = argv[i] + strlen("--alloc-profile=");
+                    if (!instance->startAllocationProfiler()) {
+                        fprintf(stderr, "Cannot start allocation profiler\n");
+                        allocationProfilePath = nullptr;
+                    }
+                    continue;
+                }
                 if (strcmp(argv[i], "--module") == 0) {
                     seenModule = true;
                     continue;
                 }
+                if (strncmp(argv[i], "--concurrent-vms=", strlen("--concurrent-vms=")) == 0) {
+                    // files after this option are run on each VMInstance of threads
+                    concurrentVMCount = atoi(argv[i] + strlen("--concurrent-vms="));
+                    if (concurrentVMCount == 0) {
+                        concurrentVMCount = std::max(std::thread::hardware_concurrency(), 1u);
+                    }
+                    continue;
+                }
+                if (strcmp(argv[i], "--parse-throughput") == 0) {
+                    // files after this option are only parsed for benchmarking lexer and parser
+                    parseOnly = true;
+                    continue;
+                }
             } else { // `-option` case
                 if (strcmp(argv[i], "-e") == 0) {
                     runShell = false;
                     i++;
                     StringRef* src = StringRef::createFromUTF8(argv[i], strlen(argv[i]));
-                    if (!evalScript(context, src, StringRef::createFromASCII("shell input"), false, false))
+                    if (!evalScript(context, src, StringRef::createFromASCII("shell input"), false, false)) {
+                        writeCPUProfile(instance.get(), cpuProfilePath);
+                        writeAllocationProfile(instance.get(), allocationProfilePath);
                         return 3;
+                    }
                     continue;
                 }
                 if (strcmp(argv[i], "-f") == 0) {
@@ -591,13 +1306,28 @@ int main(int argc, char* argv[])
             fclose(fp);
             runShell = false;
 
+            if (concurrentVMCount) {
+                concurrentVMFiles.push_back(argv[i]);
+                continue;
+            }
+
             StringRef* src = Evaluator::execute(context, [](ExecutionStateRef* state, char* c) -> ValueRef* {
                                  return builtinHelperFileRead(state, c, "read").get();
                              },
                                                 argv[i])
                                  .result->asString();
 
+            if (parseOnly) {
+                if (!measureParseThroughput(context, src, StringRef::createFromUTF8(argv[i], strlen(argv[i])), seenModule)) {
+                    return 3;
+                }
+                seenModule = false;
+                continue;
+            }
+
             if (!evalScript(context, src, StringRef::createFromUTF8(argv[i], strlen(argv[i])), false, seenModule)) {
+                writeCPUProfile(instance.get(), cpuProfilePath);
+                writeAllocationProfile(instance.get(), allocationProfilePath);
                 return 3;
             }
             seenModule = false;
@@ -608,6 +1338,12 @@ int main(int argc, char* argv[])
         }
     }
 
+    if (concurrentVMFiles.size()) {
+        if (!runFilesOnConcurrentVMInstances(concurrentVMCount, concurrentVMFiles)) {
+            return 3;
+        }
+    }
+
     while (runShell) {
         static char buf[2048];
         printf("escargot> ");
@@ -619,6 +1355,10 @@ int main(int argc, char* argv[])
         evalScript(context, str, StringRef::createFromASCII("from shell input"), true, false);
     }
 
+    writeCPUProfile(instance.get(), cpuProfilePath);
+    writeAllocationProfile(instance.get(), allocationProfilePath);
+
+    terminateAllWorkers();
     context.release();
     instance.release();
 
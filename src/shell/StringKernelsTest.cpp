@@ -0,0 +1,285 @@
+/*
+ * Copyright (c) 2020-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#if defined(ESCARGOT_ENABLE_TEST)
+// self tests and microbenchmarks of StringKernels for shell_test
+// these are kept out of the library so that release engine carries no test code
+
+#include "Escargot.h"
+#include "util/StringKernels.h"
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#if defined(CPU_X86) || defined(CPU_X86_64)
+#if defined(COMPILER_MSVC)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#endif
+
+using namespace Escargot;
+
+// reference predicates. each returns true if kernel should skip the character
+struct ReferencePredicates {
+    static bool isASCII(char16_t ch) { return ch < 0x80; }
+    static bool isLatin1(char16_t ch) { return ch < 0x100; }
+    static bool isJSONPlain(char16_t ch) { return ch >= 0x20 && ch != '"' && ch != '\\'; }
+    static bool isNonLineTerminator(char16_t ch) { return ch != '\n' && ch != '\r' && ch != 0x2028 && ch != 0x2029; }
+    static bool isMultiLineCommentPlain(char16_t ch) { return ch != '*' && isNonLineTerminator(ch); }
+    static bool isSingleQuoteStringPlain(char16_t ch) { return ch != '\'' && ch != '\\' && isNonLineTerminator(ch); }
+    static bool isDoubleQuoteStringPlain(char16_t ch) { return ch != '"' && ch != '\\' && isNonLineTerminator(ch); }
+    static bool isASCIIIdentifierPart(char16_t ch) { return (ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z') || (ch >= '0' && ch <= '9') || ch == '$' || ch == '_'; }
+    static bool isSpaceOrTab(char16_t ch) { return ch == ' ' || ch == '\t'; }
+};
+
+template <typename T, typename Kernel, typename Predicate>
+static size_t verifyKernel(Kernel kernel, Predicate predicate, char16_t plain, const char16_t* stoppers, size_t stopperCount)
+{
+    // lengths up to several vector widths cover every tail length of SSE2/AVX2/NEON loops
+    // and start offsets up to 32 cover every alignment of 32-byte vectors
+    const size_t maxLength = 100;
+    const size_t maxOffset = 32;
+    T buffer[maxOffset + maxLength + 1];
+    size_t mismatches = 0;
+
+    for (size_t s = 0; s < stopperCount; s++) {
+        T stopper = (T)stoppers[s];
+        if ((char16_t)stopper != stoppers[s]) {
+            // stopper doesn't fit into T
+            continue;
+        }
+        for (size_t offset = 0; offset < maxOffset; offset++) {
+            for (size_t length = 0; length <= maxLength; length++) {
+                // stopper at every position, plus no stopper at all (position == length)
+                for (size_t position = 0; position <= length; position++) {
+                    for (size_t i = 0; i < maxOffset + maxLength + 1; i++) {
+                        buffer[i] = (T)plain;
+                    }
+                    if (position < length) {
+                        buffer[offset + position] = stopper;
+                    }
+                    // a stopper right after the range must not be seen
+                    buffer[offset + length] = stopper;
+
+                    size_t expected = 0;
+                    while (expected < length && predicate(buffer[offset + expected])) {
+                        expected++;
+                    }
+                    if (kernel(buffer + offset, length) != expected) {
+                        mismatches++;
+                    }
+                }
+            }
+        }
+    }
+    return mismatches;
+}
+
+static size_t verifyConversions()
+{
+    const size_t maxLength = 100;
+    const size_t maxOffset = 32;
+    LChar latin1[maxOffset + maxLength];
+    char16_t utf16[maxOffset + maxLength];
+    LChar narrowed[maxOffset + maxLength + 1];
+    char16_t widened[maxOffset + maxLength + 1];
+    size_t mismatches = 0;
+
+    for (size_t i = 0; i < maxOffset + maxLength; i++) {
+        latin1[i] = (LChar)(i * 7 + 0x61);
+        utf16[i] = latin1[i];
+    }
+
+    for (size_t offset = 0; offset < maxOffset; offset++) {
+        for (size_t length = 0; length <= maxLength; length++) {
+            narrowed[offset + length] = 0xAA;
+            widened[offset + length] = 0xAAAA;
+            StringKernels::narrow(narrowed + offset, utf16 + offset, length);
+            StringKernels::widen(widened + offset, latin1 + offset, length);
+            for (size_t i = 0; i < length; i++) {
+                if (narrowed[offset + i] != latin1[offset + i] || widened[offset + i] != utf16[offset + i]) {
+                    mismatches++;
+                    break;
+                }
+            }
+            // kernels must not write past the end
+            if (narrowed[offset + length] != 0xAA || widened[offset + length] != 0xAAAA) {
+                mismatches++;
+            }
+        }
+    }
+    return mismatches;
+}
+
+#define STRING_KERNEL_LAMBDA(T, kernel, ...) [](const T* src, size_t length) { return StringKernels::kernel(src, length, ##__VA_ARGS__); }
+
+// compares every kernel with naive reference code over short lengths and unaligned start addresses
+// returns the number of mismatches
+size_t verifyStringKernels()
+{
+    size_t mismatches = 0;
+    const char16_t nonASCII[] = { 0x80, 0xFF, 0x100, 0x7FFF, 0x8000, 0xFFFF };
+    const char16_t nonLatin1[] = { 0x100, 0x7FFF, 0x8000, 0xFFFF };
+    const char16_t jsonSpecial[] = { 0, 0x1F, '"', '\\' };
+    const char16_t lineTerminators[] = { '\n', '\r', 0x2028, 0x2029, 0x202A, 0x0A0A, 0x0D00 };
+    const char16_t commentSpecial[] = { '*', '\n', '\r', 0x2028, 0x2029, 0x2A00 };
+    const char16_t stringSpecial[] = { '\'', '"', '\\', '\n', '\r', 0x2028, 0x2029, 0x2722 };
+    const char16_t nonIdentifierPart[] = { '@', '[', '`', '{', '/', ':', ' ', 0x80, 0x141, 0x161 };
+    const char16_t nonSpace[] = { 'a', '\n', '\v', 0x109, 0x120, 0xA0 };
+
+#define VERIFY(kernel, predicate, plain, stoppers, ...)                                                                                                                        \
+    mismatches += verifyKernel<LChar>(STRING_KERNEL_LAMBDA(LChar, kernel, ##__VA_ARGS__), ReferencePredicates::predicate, plain, stoppers, sizeof(stoppers) / sizeof(char16_t)); \
+    mismatches += verifyKernel<char16_t>(STRING_KERNEL_LAMBDA(char16_t, kernel, ##__VA_ARGS__), ReferencePredicates::predicate, plain, stoppers, sizeof(stoppers) / sizeof(char16_t));
+
+    VERIFY(countASCIIPrefix, isASCII, 'a', nonASCII);
+    VERIFY(countJSONPlainPrefix, isJSONPlain, 'a', jsonSpecial);
+    VERIFY(countNonLineTerminatorPrefix, isNonLineTerminator, 'a', lineTerminators);
+    VERIFY(countMultiLineCommentPlainPrefix, isMultiLineCommentPlain, 'a', commentSpecial);
+    VERIFY(countStringLiteralPlainPrefix, isSingleQuoteStringPlain, 'a', stringSpecial, '\'');
+    VERIFY(countStringLiteralPlainPrefix, isDoubleQuoteStringPlain, 'a', stringSpecial, '"');
+    VERIFY(countASCIIIdentifierPartPrefix, isASCIIIdentifierPart, 'z', nonIdentifierPart);
+    VERIFY(countSpaceOrTabPrefix, isSpaceOrTab, ' ', nonSpace);
+#undef VERIFY
+
+    mismatches += verifyKernel<char16_t>(STRING_KERNEL_LAMBDA(char16_t, countLatin1Prefix), ReferencePredicates::isLatin1, 0xFF, nonLatin1, sizeof(nonLatin1) / sizeof(char16_t));
+    mismatches += verifyConversions();
+    return mismatches;
+}
+
+// counts cpu cycles of current thread. uses hardware cycle counter of perf_event on linux,
+// and falls back to time stamp counter (which ticks at constant reference rate) on x86
+class CycleCounter {
+public:
+    CycleCounter()
+        : m_fd(-1)
+    {
+#if defined(__linux__)
+        struct perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_CPU_CYCLES;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        m_fd = syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+#endif
+    }
+
+    ~CycleCounter()
+    {
+#if defined(__linux__)
+        if (m_fd >= 0) {
+            close(m_fd);
+        }
+#endif
+    }
+
+    bool isAvailable() const
+    {
+#if defined(CPU_X86) || defined(CPU_X86_64)
+        return true;
+#else
+        return m_fd >= 0;
+#endif
+    }
+
+    uint64_t read() const
+    {
+#if defined(__linux__)
+        if (m_fd >= 0) {
+            uint64_t count = 0;
+            if (::read(m_fd, &count, sizeof(count)) == sizeof(count)) {
+                return count;
+            }
+        }
+#endif
+#if defined(CPU_X86) || defined(CPU_X86_64)
+        return __rdtsc();
+#else
+        return 0;
+#endif
+    }
+
+private:
+    int m_fd;
+};
+
+template <typename T, typename Kernel>
+static double benchmarkKernel(Kernel kernel, T plain, size_t length, size_t iterations)
+{
+    CycleCounter counter;
+    if (!counter.isAvailable()) {
+        return -1;
+    }
+    std::vector<T> buffer(length, plain);
+    volatile size_t sink = 0;
+    uint64_t start = counter.read();
+    for (size_t i = 0; i < iterations; i++) {
+        sink = sink + kernel(buffer.data(), length);
+    }
+    uint64_t cycles = counter.read() - start;
+    return ((double)length * sizeof(T) * iterations) / (double)(cycles ? cycles : 1);
+}
+
+// runs kernel named `name` over buffer of `length` characters `iterations` times
+// returns bytes of source buffer processed per cycle, or negative value if there is no such kernel or cycle counter
+double benchmarkStringKernel(const char* name, size_t length, size_t iterations)
+{
+    if (!length || !iterations) {
+        return -1;
+    }
+
+#define BENCHMARK(kernelName, plain, ...)                                                                  \
+    if (strcmp(name, #kernelName "8") == 0) {                                                              \
+        return benchmarkKernel<LChar>(STRING_KERNEL_LAMBDA(LChar, kernelName, ##__VA_ARGS__), plain, length, iterations);       \
+    }                                                                                                      \
+    if (strcmp(name, #kernelName "16") == 0) {                                                             \
+        return benchmarkKernel<char16_t>(STRING_KERNEL_LAMBDA(char16_t, kernelName, ##__VA_ARGS__), plain, length, iterations); \
+    }
+
+    BENCHMARK(countASCIIPrefix, 'a');
+    BENCHMARK(countJSONPlainPrefix, 'a');
+    BENCHMARK(countNonLineTerminatorPrefix, 'a');
+    BENCHMARK(countMultiLineCommentPlainPrefix, 'a');
+    BENCHMARK(countStringLiteralPlainPrefix, 'a', '"');
+    BENCHMARK(countASCIIIdentifierPartPrefix, 'a');
+    BENCHMARK(countSpaceOrTabPrefix, ' ');
+#undef BENCHMARK
+
+    if (strcmp(name, "countLatin1Prefix16") == 0) {
+        return benchmarkKernel<char16_t>(STRING_KERNEL_LAMBDA(char16_t, countLatin1Prefix), 0xFF, length, iterations);
+    }
+
+    std::vector<LChar> latin1(length, 'a');
+    std::vector<char16_t> utf16(length, 'a');
+    if (strcmp(name, "widen") == 0) {
+        return benchmarkKernel<LChar>([&utf16](const LChar* src, size_t length) { StringKernels::widen(utf16.data(), src, length); return (size_t)utf16[0]; }, 'a', length, iterations);
+    }
+    if (strcmp(name, "narrow") == 0) {
+        return benchmarkKernel<char16_t>([&latin1](const char16_t* src, size_t length) { StringKernels::narrow(latin1.data(), src, length); return (size_t)latin1[0]; }, 'a', length, iterations);
+    }
+    return -1;
+}
+#undef STRING_KERNEL_LAMBDA
+#endif
@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2020-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#ifndef __EscargotDtoa__
+#define __EscargotDtoa__
+
+namespace Escargot {
+
+// Conversion of double to decimal string based on shortest round-trip digits.
+// Digits are generated by the Ryu algorithm
+// (Ulf Adams. 2018. Ryu: fast float-to-string conversion. PLDI 2018)
+class Dtoa {
+public:
+    // the shortest round-trip representation of double never needs more than 17 digits
+    static const size_t MaximumDigitsLength = 17;
+    static const size_t BufferLength = 64;
+
+    // `value` should be finite and positive
+    // writes shortest digits which round-trip to `value` into `digits` and returns the number of digits
+    // `value` is nearest to 0.d0d1d2... * 10^decimalPoint
+    static size_t shortestDigits(double value, char* digits, int& decimalPoint);
+
+    // Number::toString(x) with radix 10
+    // see https://www.ecma-international.org/ecma-262/6.0/#sec-tostring-applied-to-the-number-type
+    // `value` should be finite and `buffer` should be at least BufferLength. returns length of result
+    static size_t toString(double value, char* buffer);
+
+    // fast paths of Number.prototype.toFixed and Number.prototype.toPrecision
+    // these produce result only if it can be made exactly from shortest digits
+    // returns 0 if caller should use the general(slow) path
+    // `buffer` should be at least BufferLength
+    static size_t toFixed(double value, int fractionDigits, char* buffer);
+    static size_t toPrecision(double value, int precision, char* buffer);
+};
+}
+
+#endif
@@ -0,0 +1,741 @@
+/*
+ * Copyright (c) 2020-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#include "Escargot.h"
+#include "StringKernels.h"
+
+#if defined(COMPILER_MSVC)
+#include <intrin.h>
+#endif
+
+#if defined(CPU_X86_64)
+#define STRING_KERNELS_SSE2
+#include <emmintrin.h>
+#if defined(COMPILER_GCC) || defined(COMPILER_CLANG)
+#define STRING_KERNELS_AVX2
+#include <immintrin.h>
+#endif
+#elif defined(CPU_ARM64)
+#define STRING_KERNELS_NEON
+#include <arm_neon.h>
+#endif
+
+namespace Escargot {
+
+#if defined(COMPILER_GCC) || defined(COMPILER_CLANG)
+#define COUNT_TRAILING_ZEROS(x) __builtin_ctz(x)
+#elif defined(COMPILER_MSVC)
+static inline unsigned countTrailingZeros(unsigned x)
+{
+    unsigned long ret;
+    _BitScanForward(&ret, x);
+    return ret;
+}
+#define COUNT_TRAILING_ZEROS(x) countTrailingZeros(x)
+#endif
+
+template <typename T, const unsigned highBitsMask>
+static ALWAYS_INLINE size_t countPrefixScalar(const T* src, size_t start, size_t length)
+{
+    for (size_t i = start; i < length; i++) {
+        if (src[i] & highBitsMask) {
+            return i;
+        }
+    }
+    return length;
+}
+
+template <typename T>
+static ALWAYS_INLINE bool isJSONPlainCharacter(T ch)
+{
+    return ch >= 0x20 && ch != '"' && ch != '\\';
+}
+
+template <typename T>
+static ALWAYS_INLINE size_t countJSONPlainPrefixScalar(const T* src, size_t start, size_t length)
+{
+    for (size_t i = start; i < length; i++) {
+        if (!isJSONPlainCharacter(src[i])) {
+            return i;
+        }
+    }
+    return length;
+}
+
+#if defined(STRING_KERNELS_SSE2)
+static size_t countASCIIPrefixSSE2(const LChar* src, size_t length)
+{
+    size_t i = 0;
+    for (; i + 16 <= length; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+        unsigned mask = _mm_movemask_epi8(v);
+        if (mask) {
+            return i + COUNT_TRAILING_ZEROS(mask);
+        }
+    }
+    return countPrefixScalar<LChar, 0x80>(src, i, length);
+}
+
+template <const unsigned highBitsMask>
+static size_t count16BitPrefixSSE2(const char16_t* src, size_t length)
+{
+    const __m128i highBits = _mm_set1_epi16(highBitsMask);
+    const __m128i zero = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 8 <= length; i += 8) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+        unsigned mask = _mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(v, highBits), zero)) ^ 0xFFFF;
+        if (mask) {
+            return i + COUNT_TRAILING_ZEROS(mask) / 2;
+        }
+    }
+    return countPrefixScalar<char16_t, highBitsMask>(src, i, length);
+}
+
+static size_t countJSONPlainPrefixSSE2(const LChar* src, size_t length)
+{
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i controlMax = _mm_set1_epi8(0x1F);
+    const __m128i zero = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 16 <= length; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+        // (v - 0x1F) saturates to zero for control characters
+        __m128i special = _mm_or_si128(_mm_cmpeq_epi8(_mm_subs_epu8(v, controlMax), zero),
+                                       _mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, backslash)));
+        unsigned mask = _mm_movemask_epi8(special);
+        if (mask) {
+            return i + COUNT_TRAILING_ZEROS(mask);
+        }
+    }
+    return countJSONPlainPrefixScalar(src, i, length);
+}
+
+static size_t countJSONPlainPrefixSSE2(const char16_t* src, size_t length)
+{
+    const __m128i quote = _mm_set1_epi16('"');
+    const __m128i backslash = _mm_set1_epi16('\\');
+    const __m128i controlMax = _mm_set1_epi16(0x1F);
+    const __m128i zero = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 8 <= length; i += 8) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+        __m128i special = _mm_or_si128(_mm_cmpeq_epi16(_mm_subs_epu16(v, controlMax), zero),
+                                       _mm_or_si128(_mm_cmpeq_epi16(v, quote), _mm_cmpeq_epi16(v, backslash)));
+        unsigned mask = _mm_movemask_epi8(special);
+        if (mask) {
+            return i + COUNT_TRAILING_ZEROS(mask) / 2;
+        }
+    }
+    return countJSONPlainPrefixScalar(src, i, length);
+}
+
+static void widenSSE2(char16_t* dst, const LChar* src, size_t length)
+{
+    const __m128i zero = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 16 <= length; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+        _mm_storeu_si128((__m128i*)(dst + i), _mm_unpacklo_epi8(v, zero));
+        _mm_storeu_si128((__m128i*)(dst + i + 8), _mm_unpackhi_epi8(v, zero));
+    }
+    for (; i < length; i++) {
+        dst[i] = src[i];
+    }
+}
+
+static void narrowSSE2(LChar* dst, const char16_t* src, size_t length)
+{
+    size_t i = 0;
+    for (; i + 16 <= length; i += 16) {
+        __m128i lo = _mm_loadu_si128((const __m128i*)(src + i));
+        __m128i hi = _mm_loadu_si128((const __m128i*)(src + i + 8));
+        // every character is in Latin-1 range so saturation never happens
+        _mm_storeu_si128((__m128i*)(dst + i), _mm_packus_epi16(lo, hi));
+    }
+    for (; i < length; i++) {
+        ASSERT(src[i] < 256);
+        dst[i] = src[i];
+    }
+}
+#endif
+
+#if defined(STRING_KERNELS_AVX2)
+static bool detectAVX2()
+{
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+}
+
+static const bool s_hasAVX2 = detectAVX2();
+
+__attribute__((target("avx2"))) static size_t countASCIIPrefixAVX2(const LChar* src, size_t length)
+{
+    size_t i = 0;
+    for (; i + 32 <= length; i += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(src + i));
+        unsigned mask = _mm256_movemask_epi8(v);
+        if (mask) {
+            return i + COUNT_TRAILING_ZEROS(mask);
+        }
+    }
+    return i + countASCIIPrefixSSE2(src + i, length - i);
+}
+
+template <const unsigned highBitsMask>
+__attribute__((target("avx2"))) static size_t count16BitPrefixAVX2(const char16_t* src, size_t length)
+{
+    const __m256i highBits = _mm256_set1_epi16(highBitsMask);
+    size_t i = 0;
+    for (; i + 16 <= length; i += 16) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(src + i));
+        if (!_mm256_testz_si256(v, highBits)) {
+            break;
+        }
+    }
+    return i + count16BitPrefixSSE2<highBitsMask>(src + i, length - i);
+}
+
+__attribute__((target("avx2"))) static void widenAVX2(char16_t* dst, const LChar* src, size_t length)
+{
+    size_t i = 0;
+    for (; i + 32 <= length; i += 32) {
+        __m128i lo = _mm_loadu_si128((const __m128i*)(src + i));
+        __m128i hi = _mm_loadu_si128((const __m128i*)(src + i + 16));
+        _mm256_storeu_si256((__m256i*)(dst + i), _mm256_cvtepu8_epi16(lo));
+        _mm256_storeu_si256((__m256i*)(dst + i + 16), _mm256_cvtepu8_epi16(hi));
+    }
+    widenSSE2(dst + i, src + i, length - i);
+}
+
+__attribute__((target("avx2"))) static void narrowAVX2(LChar* dst, const char16_t* src, size_t length)
+{
+    size_t i = 0;
+    for (; i + 32 <= length; i += 32) {
+        __m256i lo = _mm256_loadu_si256((const __m256i*)(src + i));
+        __m256i hi = _mm256_loadu_si256((const __m256i*)(src + i + 16));
+        // packus works on each 128-bit lane, so we should restore order of 64-bit blocks
+        __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(lo, hi), 0xD8);
+        _mm256_storeu_si256((__m256i*)(dst + i), packed);
+    }
+    narrowSSE2(dst + i, src + i, length - i);
+}
+#endif
+
+#if defined(STRING_KERNELS_NEON)
+static size_t countASCIIPrefixNEON(const LChar* src, size_t length)
+{
+    size_t i = 0;
+    for (; i + 16 <= length; i += 16) {
+        if (vmaxvq_u8(vld1q_u8(src + i)) >= 0x80) {
+            break;
+        }
+    }
+    return countPrefixScalar<LChar, 0x80>(src, i, length);
+}
+
+template <const unsigned highBitsMask>
+static size_t count16BitPrefixNEON(const char16_t* src, size_t length)
+{
+    const uint16x8_t highBits = vdupq_n_u16(highBitsMask);
+    size_t i = 0;
+    for (; i + 8 <= length; i += 8) {
+        if (vmaxvq_u16(vandq_u16(vld1q_u16((const uint16_t*)(src + i)), highBits))) {
+            break;
+        }
+    }
+    return countPrefixScalar<char16_t, highBitsMask>(src, i, length);
+}
+
+static size_t countJSONPlainPrefixNEON(const LChar* src, size_t length)
+{
+    const uint8x16_t quote = vdupq_n_u8('"');
+    const uint8x16_t backslash = vdupq_n_u8('\\');
+    const uint8x16_t controlMax = vdupq_n_u8(0x1F);
+    size_t i = 0;
+    for (; i + 16 <= length; i += 16) {
+        uint8x16_t v = vld1q_u8(src + i);
+        uint8x16_t special = vorrq_u8(vcleq_u8(v, controlMax), vorrq_u8(vceqq_u8(v, quote), vceqq_u8(v, backslash)));
+        if (vmaxvq_u8(special)) {
+            break;
+        }
+    }
+    return countJSONPlainPrefixScalar(src, i, length);
+}
+
+static size_t countJSONPlainPrefixNEON(const char16_t* src, size_t length)
+{
+    const uint16x8_t quote = vdupq_n_u16('"');
+    const uint16x8_t backslash = vdupq_n_u16('\\');
+    const uint16x8_t controlMax = vdupq_n_u16(0x1F);
+    size_t i = 0;
+    for (; i + 8 <= length; i += 8) {
+        uint16x8_t v = vld1q_u16((const uint16_t*)(src + i));
+        uint16x8_t special = vorrq_u16(vcleq_u16(v, controlMax), vorrq_u16(vceqq_u16(v, quote), vceqq_u16(v, backslash)));
+        if (vmaxvq_u16(special)) {
+            break;
+        }
+    }
+    return countJSONPlainPrefixScalar(src, i, length);
+}
+
+static void widenNEON(char16_t* dst, const LChar* src, size_t length)
+{
+    size_t i = 0;
+    for (; i + 16 <= length; i += 16) {
+        uint8x16_t v = vld1q_u8(src + i);
+        vst1q_u16((uint16_t*)(dst + i), vmovl_u8(vget_low_u8(v)));
+        vst1q_u16((uint16_t*)(dst + i + 8), vmovl_high_u8(v));
+    }
+    for (; i < length; i++) {
+        dst[i] = src[i];
+    }
+}
+
+static void narrowNEON(LChar* dst, const char16_t* src, size_t length)
+{
+    size_t i = 0;
+    for (; i + 16 <= length; i += 16) {
+        uint16x8_t lo = vld1q_u16((const uint16_t*)(src + i));
+        uint16x8_t hi = vld1q_u16((const uint16_t*)(src + i + 8));
+        vst1q_u8(dst + i, vcombine_u8(vmovn_u16(lo), vmovn_u16(hi)));
+    }
+    for (; i < length; i++) {
+        ASSERT(src[i] < 256);
+        dst[i] = src[i];
+    }
+}
+#endif
+
+// Kernels for lexer
+// Each kernel tells which characters stop skipping. Drivers below run kernel over vectors
+// and scalar code handles remaining characters.
+struct LineTerminatorKernel {
+    template <typename T>
+    ALWAYS_INLINE bool isSpecial(T ch) const
+    {
+        return ch == '\n' || ch == '\r' || (sizeof(T) == 2 && (ch == 0x2028 || ch == 0x2029));
+    }
+
+#if defined(STRING_KERNELS_SSE2)
+    ALWAYS_INLINE __m128i special8(__m128i v) const
+    {
+        return _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('\n')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\r')));
+    }
+
+    ALWAYS_INLINE __m128i special16(__m128i v) const
+    {
+        __m128i lineTerminator = _mm_or_si128(_mm_cmpeq_epi16(v, _mm_set1_epi16('\n')), _mm_cmpeq_epi16(v, _mm_set1_epi16('\r')));
+        // U+2028 and U+2029 differ only in the lowest bit
+        return _mm_or_si128(lineTerminator, _mm_cmpeq_epi16(_mm_or_si128(v, _mm_set1_epi16(1)), _mm_set1_epi16(0x2029)));
+    }
+#elif defined(STRING_KERNELS_NEON)
+    ALWAYS_INLINE uint8x16_t special8(uint8x16_t v) const
+    {
+        return vorrq_u8(vceqq_u8(v, vdupq_n_u8('\n')), vceqq_u8(v, vdupq_n_u8('\r')));
+    }
+
+    ALWAYS_INLINE uint16x8_t special16(uint16x8_t v) const
+    {
+        uint16x8_t lineTerminator = vorrq_u16(vceqq_u16(v, vdupq_n_u16('\n')), vceqq_u16(v, vdupq_n_u16('\r')));
+        return vorrq_u16(lineTerminator, vceqq_u16(vorrq_u16(v, vdupq_n_u16(1)), vdupq_n_u16(0x2029)));
+    }
+#endif
+};
+
+struct MultiLineCommentKernel {
+    LineTerminatorKernel lineTerminator;
+
+    template <typename T>
+    ALWAYS_INLINE bool isSpecial(T ch) const
+    {
+        return ch == '*' || lineTerminator.isSpecial(ch);
+    }
+
+#if defined(STRING_KERNELS_SSE2)
+    ALWAYS_INLINE __m128i special8(__m128i v) const
+    {
+        return _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('*')), lineTerminator.special8(v));
+    }
+
+    ALWAYS_INLINE __m128i special16(__m128i v) const
+    {
+        return _mm_or_si128(_mm_cmpeq_epi16(v, _mm_set1_epi16('*')), lineTerminator.special16(v));
+    }
+#elif defined(STRING_KERNELS_NEON)
+    ALWAYS_INLINE uint8x16_t special8(uint8x16_t v) const
+    {
+        return vorrq_u8(vceqq_u8(v, vdupq_n_u8('*')), lineTerminator.special8(v));
+    }
+
+    ALWAYS_INLINE uint16x8_t special16(uint16x8_t v) const
+    {
+        return vorrq_u16(vceqq_u16(v, vdupq_n_u16('*')), lineTerminator.special16(v));
+    }
+#endif
+};
+
+struct StringLiteralKernel {
+    LineTerminatorKernel lineTerminator;
+    char16_t quote;
+
+    explicit StringLiteralKernel(char16_t q)
+        : quote(q)
+    {
+    }
+
+    template <typename T>
+    ALWAYS_INLINE bool isSpecial(T ch) const
+    {
+        return ch == quote || ch == '\\' || lineTerminator.isSpecial(ch);
+    }
+
+#if defined(STRING_KERNELS_SSE2)
+    ALWAYS_INLINE __m128i special8(__m128i v) const
+    {
+        __m128i quoteOrBackslash = _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8((char)quote)), _mm_cmpeq_epi8(v, _mm_set1_epi8('\\')));
+        return _mm_or_si128(quoteOrBackslash, lineTerminator.special8(v));
+    }
+
+    ALWAYS_INLINE __m128i special16(__m128i v) const
+    {
+        __m128i quoteOrBackslash = _mm_or_si128(_mm_cmpeq_epi16(v, _mm_set1_epi16(quote)), _mm_cmpeq_epi16(v, _mm_set1_epi16('\\')));
+        return _mm_or_si128(quoteOrBackslash, lineTerminator.special16(v));
+    }
+#elif defined(STRING_KERNELS_NEON)
+    ALWAYS_INLINE uint8x16_t special8(uint8x16_t v) const
+    {
+        uint8x16_t quoteOrBackslash = vorrq_u8(vceqq_u8(v, vdupq_n_u8((uint8_t)quote)), vceqq_u8(v, vdupq_n_u8('\\')));
+        return vorrq_u8(quoteOrBackslash, lineTerminator.special8(v));
+    }
+
+    ALWAYS_INLINE uint16x8_t special16(uint16x8_t v) const
+    {
+        uint16x8_t quoteOrBackslash = vorrq_u16(vceqq_u16(v, vdupq_n_u16(quote)), vceqq_u16(v, vdupq_n_u16('\\')));
+        return vorrq_u16(quoteOrBackslash, lineTerminator.special16(v));
+    }
+#endif
+};
+
+struct ASCIIIdentifierPartKernel {
+    template <typename T>
+    ALWAYS_INLINE bool isSpecial(T ch) const
+    {
+        return !((ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z') || (ch >= '0' && ch <= '9') || ch == '$' || ch == '_');
+    }
+
+#if defined(STRING_KERNELS_SSE2)
+    // x is in range of [0, max] as unsigned value if (x - max) saturates to zero
+    ALWAYS_INLINE __m128i special8(__m128i v) const
+    {
+        const __m128i zero = _mm_setzero_si128();
+        __m128i alpha = _mm_cmpeq_epi8(_mm_subs_epu8(_mm_sub_epi8(_mm_or_si128(v, _mm_set1_epi8(0x20)), _mm_set1_epi8('a')), _mm_set1_epi8(25)), zero);
+        __m128i digit = _mm_cmpeq_epi8(_mm_subs_epu8(_mm_sub_epi8(v, _mm_set1_epi8('0')), _mm_set1_epi8(9)), zero);
+        __m128i etc = _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('$')), _mm_cmpeq_epi8(v, _mm_set1_epi8('_')));
+        return _mm_andnot_si128(_mm_or_si128(_mm_or_si128(alpha, digit), etc), _mm_cmpeq_epi8(zero, zero));
+    }
+
+    ALWAYS_INLINE __m128i special16(__m128i v) const
+    {
+        const __m128i zero = _mm_setzero_si128();
+        __m128i alpha = _mm_cmpeq_epi16(_mm_subs_epu16(_mm_sub_epi16(_mm_or_si128(v, _mm_set1_epi16(0x20)), _mm_set1_epi16('a')), _mm_set1_epi16(25)), zero);
+        __m128i digit = _mm_cmpeq_epi16(_mm_subs_epu16(_mm_sub_epi16(v, _mm_set1_epi16('0')), _mm_set1_epi16(9)), zero);
+        __m128i etc = _mm_or_si128(_mm_cmpeq_epi16(v, _mm_set1_epi16('$')), _mm_cmpeq_epi16(v, _mm_set1_epi16('_')));
+        return _mm_andnot_si128(_mm_or_si128(_mm_or_si128(alpha, digit), etc), _mm_cmpeq_epi16(zero, zero));
+    }
+#elif defined(STRING_KERNELS_NEON)
+    ALWAYS_INLINE uint8x16_t special8(uint8x16_t v) const
+    {
+        uint8x16_t alpha = vcleq_u8(vsubq_u8(vorrq_u8(v, vdupq_n_u8(0x20)), vdupq_n_u8('a')), vdupq_n_u8(25));
+        uint8x16_t digit = vcleq_u8(vsubq_u8(v, vdupq_n_u8('0')), vdupq_n_u8(9));
+        uint8x16_t etc = vorrq_u8(vceqq_u8(v, vdupq_n_u8('$')), vceqq_u8(v, vdupq_n_u8('_')));
+        return vmvnq_u8(vorrq_u8(vorrq_u8(alpha, digit), etc));
+    }
+
+    ALWAYS_INLINE uint16x8_t special16(uint16x8_t v) const
+    {
+        uint16x8_t alpha = vcleq_u16(vsubq_u16(vorrq_u16(v, vdupq_n_u16(0x20)), vdupq_n_u16('a')), vdupq_n_u16(25));
+        uint16x8_t digit = vcleq_u16(vsubq_u16(v, vdupq_n_u16('0')), vdupq_n_u16(9));
+        uint16x8_t etc = vorrq_u16(vceqq_u16(v, vdupq_n_u16('$')), vceqq_u16(v, vdupq_n_u16('_')));
+        return vmvnq_u16(vorrq_u16(vorrq_u16(alpha, digit), etc));
+    }
+#endif
+};
+
+struct SpaceOrTabKernel {
+    template <typename T>
+    ALWAYS_INLINE bool isSpecial(T ch) const
+    {
+        return ch != ' ' && ch != '\t';
+    }
+
+#if defined(STRING_KERNELS_SSE2)
+    ALWAYS_INLINE __m128i special8(__m128i v) const
+    {
+        __m128i space = _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\t')));
+        return _mm_andnot_si128(space, _mm_set1_epi8(-1));
+    }
+
+    ALWAYS_INLINE __m128i special16(__m128i v) const
+    {
+        __m128i space = _mm_or_si128(_mm_cmpeq_epi16(v, _mm_set1_epi16(' ')), _mm_cmpeq_epi16(v, _mm_set1_epi16('\t')));
+        return _mm_andnot_si128(space, _mm_set1_epi16(-1));
+    }
+#elif defined(STRING_KERNELS_NEON)
+    ALWAYS_INLINE uint8x16_t special8(uint8x16_t v) const
+    {
+        return vmvnq_u8(vorrq_u8(vceqq_u8(v, vdupq_n_u8(' ')), vceqq_u8(v, vdupq_n_u8('\t'))));
+    }
+
+    ALWAYS_INLINE uint16x8_t special16(uint16x8_t v) const
+    {
+        return vmvnq_u16(vorrq_u16(vceqq_u16(v, vdupq_n_u16(' ')), vceqq_u16(v, vdupq_n_u16('\t'))));
+    }
+#endif
+};
+
+template <typename Kernel, typename T>
+static ALWAYS_INLINE size_t countPlainPrefixScalar(const Kernel& kernel, const T* src, size_t start, size_t length)
+{
+    for (size_t i = start; i < length; i++) {
+        if (kernel.isSpecial(src[i])) {
+            return i;
+        }
+    }
+    return length;
+}
+
+#if defined(STRING_KERNELS_SSE2)
+template <typename Kernel>
+static ALWAYS_INLINE size_t countPlainPrefix(const Kernel& kernel, const LChar* src, size_t length)
+{
+    size_t i = 0;
+    for (; i + 16 <= length; i += 16) {
+        unsigned mask = _mm_movemask_epi8(kernel.special8(_mm_loadu_si128((const __m128i*)(src + i))));
+        if (mask) {
+            return i + COUNT_TRAILING_ZEROS(mask);
+        }
+    }
+    return countPlainPrefixScalar(kernel, src, i, length);
+}
+
+template <typename Kernel>
+static ALWAYS_INLINE size_t countPlainPrefix(const Kernel& kernel, const char16_t* src, size_t length)
+{
+    size_t i = 0;
+    for (; i + 8 <= length; i += 8) {
+        unsigned mask = _mm_movemask_epi8(kernel.special16(_mm_loadu_si128((const __m128i*)(src + i))));
+        if (mask) {
+            return i + COUNT_TRAILING_ZEROS(mask) / 2;
+        }
+    }
+    return countPlainPrefixScalar(kernel, src, i, length);
+}
+#elif defined(STRING_KERNELS_NEON)
+template <typename Kernel>
+static ALWAYS_INLINE size_t countPlainPrefix(const Kernel& kernel, const LChar* src, size_t length)
+{
+    size_t i = 0;
+    for (; i + 16 <= length; i += 16) {
+        if (vmaxvq_u8(kernel.special8(vld1q_u8(src + i)))) {
+            break;
+        }
+    }
+    return countPlainPrefixScalar(kernel, src, i, length);
+}
+
+template <typename Kernel>
+static ALWAYS_INLINE size_t countPlainPrefix(const Kernel& kernel, const char16_t* src, size_t length)
+{
+    size_t i = 0;
+    for (; i + 8 <= length; i += 8) {
+        if (vmaxvq_u16(kernel.special16(vld1q_u16((const uint16_t*)(src + i))))) {
+            break;
+        }
+    }
+    return countPlainPrefixScalar(kernel, src, i, length);
+}
+#else
+template <typename Kernel, typename T>
+static ALWAYS_INLINE size_t countPlainPrefix(const Kernel& kernel, const T* src, size_t length)
+{
+    return countPlainPrefixScalar(kernel, src, 0, length);
+}
+#endif
+
+size_t StringKernels::countASCIIPrefix(const LChar* src, size_t length)
+{
+#if defined(STRING_KERNELS_AVX2)
+    if (s_hasAVX2) {
+        return countASCIIPrefixAVX2(src, length);
+    }
+#endif
+#if defined(STRING_KERNELS_SSE2)
+    return countASCIIPrefixSSE2(src, length);
+#elif defined(STRING_KERNELS_NEON)
+    return countASCIIPrefixNEON(src, length);
+#else
+    return countPrefixScalar<LChar, 0x80>(src, 0, length);
+#endif
+}
+
+size_t StringKernels::countASCIIPrefix(const char16_t* src, size_t length)
+{
+#if defined(STRING_KERNELS_AVX2)
+    if (s_hasAVX2) {
+        return count16BitPrefixAVX2<0xFF80>(src, length);
+    }
+#endif
+#if defined(STRING_KERNELS_SSE2)
+    return count16BitPrefixSSE2<0xFF80>(src, length);
+#elif defined(STRING_KERNELS_NEON)
+    return count16BitPrefixNEON<0xFF80>(src, length);
+#else
+    return countPrefixScalar<char16_t, 0xFF80>(src, 0, length);
+#endif
+}
+
+size_t StringKernels::countLatin1Prefix(const char16_t* src, size_t length)
+{
+#if defined(STRING_KERNELS_AVX2)
+    if (s_hasAVX2) {
+        return count16BitPrefixAVX2<0xFF00>(src, length);
+    }
+#endif
+#if defined(STRING_KERNELS_SSE2)
+    return count16BitPrefixSSE2<0xFF00>(src, length);
+#elif defined(STRING_KERNELS_NEON)
+    return count16BitPrefixNEON<0xFF00>(src, length);
+#else
+    return countPrefixScalar<char16_t, 0xFF00>(src, 0, length);
+#endif
+}
+
+size_t StringKernels::countJSONPlainPrefix(const LChar* src, size_t length)
+{
+#if defined(STRING_KERNELS_SSE2)
+    return countJSONPlainPrefixSSE2(src, length);
+#elif defined(STRING_KERNELS_NEON)
+    return countJSONPlainPrefixNEON(src, length);
+#else
+    return countJSONPlainPrefixScalar(src, 0, length);
+#endif
+}
+
+size_t StringKernels::countJSONPlainPrefix(const char16_t* src, size_t length)
+{
+#if defined(STRING_KERNELS_SSE2)
+    return countJSONPlainPrefixSSE2(src, length);
+#elif defined(STRING_KERNELS_NEON)
+    return countJSONPlainPrefixNEON(src, length);
+#else
+    return countJSONPlainPrefixScalar(src, 0, length);
+#endif
+}
+
+void StringKernels::widen(char16_t* dst, const LChar* src, size_t length)
+{
+#if defined(STRING_KERNELS_AVX2)
+    if (s_hasAVX2) {
+        widenAVX2(dst, src, length);
+        return;
+    }
+#endif
+#if defined(STRING_KERNELS_SSE2)
+    widenSSE2(dst, src, length);
+#elif defined(STRING_KERNELS_NEON)
+    widenNEON(dst, src, length);
+#else
+    for (size_t i = 0; i < length; i++) {
+        dst[i] = src[i];
+    }
+#endif
+}
+
+void StringKernels::narrow(LChar* dst, const char16_t* src, size_t length)
+{
+#if defined(STRING_KERNELS_AVX2)
+    if (s_hasAVX2) {
+        narrowAVX2(dst, src, length);
+        return;
+    }
+#endif
+#if defined(STRING_KERNELS_SSE2)
+    narrowSSE2(dst, src, length);
+#elif defined(STRING_KERNELS_NEON)
+    narrowNEON(dst, src, length);
+#else
+    for (size_t i = 0; i < length; i++) {
+        ASSERT(src[i] < 256);
+        dst[i] = src[i];
+    }
+#endif
+}
+
+size_t StringKernels::countNonLineTerminatorPrefix(const LChar* src, size_t length)
+{
+    return countPlainPrefix(LineTerminatorKernel(), src, length);
+}
+
+size_t StringKernels::countNonLineTerminatorPrefix(const char16_t* src, size_t length)
+{
+    return countPlainPrefix(LineTerminatorKernel(), src, length);
+}
+
+size_t StringKernels::countMultiLineCommentPlainPrefix(const LChar* src, size_t length)
+{
+    return countPlainPrefix(MultiLineCommentKernel(), src, length);
+}
+
+size_t StringKernels::countMultiLineCommentPlainPrefix(const char16_t* src, size_t length)
+{
+    return countPlainPrefix(MultiLineCommentKernel(), src, length);
+}
+
+size_t StringKernels::countStringLiteralPlainPrefix(const LChar* src, size_t length, char16_t quote)
+{
+    return countPlainPrefix(StringLiteralKernel(quote), src, length);
+}
+
+size_t StringKernels::countStringLiteralPlainPrefix(const char16_t* src, size_t length, char16_t quote)
+{
+    return countPlainPrefix(StringLiteralKernel(quote), src, length);
+}
+
+size_t StringKernels::countASCIIIdentifierPartPrefix(const LChar* src, size_t length)
+{
+    return countPlainPrefix(ASCIIIdentifierPartKernel(), src, length);
+}
+
+size_t StringKernels::countASCIIIdentifierPartPrefix(const char16_t* src, size_t length)
+{
+    return countPlainPrefix(ASCIIIdentifierPartKernel(), src, length);
+}
+
+size_t StringKernels::countSpaceOrTabPrefix(const LChar* src, size_t length)
+{
+    return countPlainPrefix(SpaceOrTabKernel(), src, length);
+}
+
+size_t StringKernels::countSpaceOrTabPrefix(const char16_t* src, size_t length)
+{
+    return countPlainPrefix(SpaceOrTabKernel(), src, length);
+}
+}
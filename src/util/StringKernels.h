@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2020-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#ifndef __EscargotStringKernels__
+#define __EscargotStringKernels__
+
+namespace Escargot {
+
+// A type to hold a single Latin-1 character.
+typedef unsigned char LChar;
+
+// Kernels for checking and converting string contents.
+// x86-64 uses SSE2 (AVX2 is selected at runtime if cpu supports it),
+// aarch64 uses NEON, and other platforms use scalar code.
+class StringKernels {
+public:
+    // returns the number of leading characters in range of [0, 0x80)
+    static size_t countASCIIPrefix(const LChar* src, size_t length);
+    static size_t countASCIIPrefix(const char16_t* src, size_t length);
+    // returns the number of leading characters in range of [0, 0x100)
+    static size_t countLatin1Prefix(const char16_t* src, size_t length);
+
+    // returns the number of leading characters which can be written without escaping in JSON string
+    // see https://www.ecma-international.org/ecma-262/6.0/#sec-quotejsonstring
+    static size_t countJSONPlainPrefix(const LChar* src, size_t length);
+    static size_t countJSONPlainPrefix(const char16_t* src, size_t length);
+
+    // kernels for lexer
+    // each returns the number of leading characters which lexer can skip without special processing
+    // characters except line terminators (body of single-line comment)
+    static size_t countNonLineTerminatorPrefix(const LChar* src, size_t length);
+    static size_t countNonLineTerminatorPrefix(const char16_t* src, size_t length);
+    // characters except line terminators and '*' (body of multi-line comment)
+    static size_t countMultiLineCommentPlainPrefix(const LChar* src, size_t length);
+    static size_t countMultiLineCommentPlainPrefix(const char16_t* src, size_t length);
+    // characters except line terminators, '\\' and quote (body of string literal)
+    static size_t countStringLiteralPlainPrefix(const LChar* src, size_t length, char16_t quote);
+    static size_t countStringLiteralPlainPrefix(const char16_t* src, size_t length, char16_t quote);
+    // characters in [A-Za-z0-9$_]
+    static size_t countASCIIIdentifierPartPrefix(const LChar* src, size_t length);
+    static size_t countASCIIIdentifierPartPrefix(const char16_t* src, size_t length);
+    // ' ' and '\t'
+    static size_t countSpaceOrTabPrefix(const LChar* src, size_t length);
+    static size_t countSpaceOrTabPrefix(const char16_t* src, size_t length);
+
+    static bool isAllASCII(const LChar* src, size_t length)
+    {
+        return countASCIIPrefix(src, length) == length;
+    }
+
+    static bool isAllASCII(const char16_t* src, size_t length)
+    {
+        return countASCIIPrefix(src, length) == length;
+    }
+
+    static bool isAllLatin1(const char16_t* src, size_t length)
+    {
+        return countLatin1Prefix(src, length) == length;
+    }
+
+    // Latin-1 to UTF-16
+    static void widen(char16_t* dst, const LChar* src, size_t length);
+    // UTF-16 to Latin-1. every character of src should be in Latin-1 range
+    static void narrow(LChar* dst, const char16_t* src, size_t length);
+
+    template <typename DstType, typename SrcType>
+    static void copy(DstType* dst, const SrcType* src, size_t length);
+
+    // computes `hash = hash * 131 + ch` for each character
+    // 4 characters are folded at a time to shorten dependency chain of multiplication
+    template <typename T>
+    static size_t hash(const T* src, size_t length, size_t hash)
+    {
+        const size_t p2 = 131 * 131;
+        const size_t p3 = p2 * 131;
+        const size_t p4 = p3 * 131;
+        for (; length >= 4; length -= 4, src += 4) {
+            hash = hash * p4 + src[0] * p3 + src[1] * p2 + src[2] * 131 + src[3];
+        }
+        for (; length; --length) {
+            hash = (hash * 131) + *src++;
+        }
+        return hash;
+    }
+};
+
+template <>
+inline void StringKernels::copy(LChar* dst, const LChar* src, size_t length)
+{
+    memcpy(dst, src, length);
+}
+
+template <>
+inline void StringKernels::copy(char16_t* dst, const char16_t* src, size_t length)
+{
+    memcpy(dst, src, length * sizeof(char16_t));
+}
+
+template <>
+inline void StringKernels::copy(char16_t* dst, const LChar* src, size_t length)
+{
+    widen(dst, src, length);
+}
+
+template <>
+inline void StringKernels::copy(LChar* dst, const char16_t* src, size_t length)
+{
+    narrow(dst, src, length);
+}
+}
+
+#endif
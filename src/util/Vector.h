@@ -436,8 +436,8 @@ public:
 
     void* operator new(size_t size)
     {
-        static bool typeInited = false;
-        static GC_descr descr;
+        static std::atomic<bool> typeInited(false);
+        static std::atomic<GC_descr> descr;
         if (!typeInited) {
             GC_word desc[GC_BITMAP_SIZE(Vector)] = { 0 };
             GC_set_bit(desc, GC_WORD_OFFSET(Vector, m_buffer));
@@ -550,8 +550,8 @@ public:
 
     void* operator new(size_t size)
     {
-        static bool typeInited = false;
-        static GC_descr descr;
+        static std::atomic<bool> typeInited(false);
+        static std::atomic<GC_descr> descr;
         if (!typeInited) {
             GC_word desc[GC_BITMAP_SIZE(VectorWithNoSize)] = { 0 };
             GC_set_bit(desc, GC_WORD_OFFSET(VectorWithNoSize, m_buffer));
@@ -0,0 +1,291 @@
+/*
+ * Copyright (c) 2020-present Samsung Electronics Co., Ltd
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "api/EscargotPublic.h"
+#include <string.h>
+#include <vector>
+
+using namespace Escargot;
+
+static int g_failCount;
+
+#define CHECK(name, cond)                                  \
+    do {                                                   \
+        bool passed = (cond);                              \
+        if (!passed) {                                     \
+            g_failCount++;                                 \
+        }                                                  \
+        printf(name " | %s\n", passed ? "pass" : "fail"); \
+    } while (0)
+
+class TestPlatform : public PlatformRef {
+public:
+    virtual void didPromiseJobEnqueued(ContextRef* relatedContext, PromiseObjectRef* obj) override
+    {
+    }
+
+    virtual LoadModuleResult onLoadModule(ContextRef* relatedContext, ScriptRef* whereRequestFrom, StringRef* moduleSrc) override
+    {
+        return LoadModuleResult(ErrorObjectRef::Code::None, StringRef::createFromASCII("cctest doesn't load modules"));
+    }
+
+    virtual void didLoadModule(ContextRef* relatedContext, OptionalRef<ScriptRef> whereRequestFrom, ScriptRef* loadedModule) override
+    {
+    }
+};
+
+static ValueRef* evalScript(ExecutionStateRef* state, const char* source)
+{
+    ScriptParserRef::InitializeScriptResult result = state->context()->scriptParser()->initializeScript(StringRef::createFromUTF8(source, strlen(source)), StringRef::createFromASCII("FileName.js"));
+    return result.fetchScriptThrowsExceptionIfParseError(state)->execute(state);
+}
+
+static void testHandleScope(ContextRef* context)
+{
+    CHECK("HandleScope no handle outside of scope", HandleScope::handleCount() == 0);
+
+    Evaluator::EvaluatorResult result = Evaluator::execute(context, [](ExecutionStateRef* state) -> ValueRef* {
+        StringRef* key = StringRef::createFromASCII("value");
+
+        // handles of inner scope are popped and handles of outer scope are kept
+        {
+            HandleScope outer;
+            outer.add(ObjectRef::create(state));
+            outer.add(ObjectRef::create(state));
+            {
+                HandleScope inner;
+                inner.add(ObjectRef::create(state));
+                CHECK("HandleScope nested scopes push on one arena", HandleScope::handleCount() == 3);
+            }
+            CHECK("HandleScope inner scope pops its handles only", HandleScope::handleCount() == 2);
+        }
+        CHECK("HandleScope outer scope pops every handle", HandleScope::handleCount() == 0);
+
+        // escaped pointer is kept by slot of enclosing scope
+        {
+            HandleScope outer;
+            ObjectRef* escaped;
+            {
+                EscapableHandleScope inner;
+                CHECK("EscapableHandleScope reserves slot on enclosing scope", HandleScope::handleCount() == 1);
+                ObjectRef* object = inner.add(ObjectRef::create(state));
+                object->set(state, key, ValueRef::create(42));
+                inner.add(ObjectRef::create(state));
+                escaped = inner.escape(object);
+            }
+            CHECK("EscapableHandleScope leaves escaped handle only", HandleScope::handleCount() == 1);
+            Memory::gc();
+            CHECK("EscapableHandleScope escaped object is alive", escaped->get(state, key)->toNumber(state) == 42);
+        }
+        CHECK("EscapableHandleScope enclosing scope pops escaped handle", HandleScope::handleCount() == 0);
+
+        // arena grows over several blocks. objects are kept only by handles because vector is not scanned by gc
+        const int objectCount = 1000;
+        for (int round = 0; round < 2; round++) {
+            HandleScope scope;
+            std::vector<ObjectRef*> objects;
+            for (int i = 0; i < objectCount; i++) {
+                ObjectRef* object = scope.add(ObjectRef::create(state));
+                object->set(state, key, ValueRef::create(i));
+                objects.push_back(object);
+            }
+            CHECK("HandleScope arena grows across block boundary", HandleScope::handleCount() == (size_t)objectCount);
+            Memory::gc();
+            bool isAlive = true;
+            for (int i = 0; i < objectCount; i++) {
+                isAlive = isAlive && objects[i]->get(state, key)->toNumber(state) == i;
+            }
+            // second round reuses blocks of first round
+            CHECK("HandleScope objects on every block are alive after gc", isAlive);
+        }
+        CHECK("HandleScope blocks are popped", HandleScope::handleCount() == 0);
+        return ValueRef::createUndefined();
+    });
+    CHECK("HandleScope tests run without exception", result.isSuccessful());
+}
+
+static ValueRef* builtinTemplatePoint(ExecutionStateRef* state, ValueRef* thisValue, size_t argc, ValueRef** argv, bool isConstructCall)
+{
+    if (isConstructCall) {
+        thisValue->asObject()->set(state, StringRef::createFromASCII("constructed"), ValueRef::create(true));
+    }
+    return ValueRef::createUndefined();
+}
+
+static void testTemplates(ContextRef* context)
+{
+    PersistentRefHolder<ContextRef> otherContext = ContextRef::create(context->vmInstance());
+    PersistentRefHolder<ObjectTemplateRef> objectTemplate = ObjectTemplateRef::create(2);
+    PersistentRefHolder<FunctionTemplateRef> functionTemplate = FunctionTemplateRef::create(AtomicStringRef::create(context, "Point"), 0, true, true, builtinTemplatePoint);
+
+    objectTemplate->set(StringRef::createFromASCII("kind"), StringRef::createFromASCII("point"), true, true, true);
+    objectTemplate->setNativeDataAccessorProperty(StringRef::createFromASCII("x"), new ObjectRef::NativeDataAccessorPropertyData(false, true, false, [](ExecutionStateRef* state, ObjectRef* self, ObjectRef::NativeDataAccessorPropertyData* data) -> ValueRef* {
+        return ValueRef::create(7);
+    },
+                                                                                                                                nullptr));
+    functionTemplate->instanceTemplate()->set(StringRef::createFromASCII("y"), ValueRef::create(3), true, true, true);
+    functionTemplate->prototypeTemplate()->set(StringRef::createFromASCII("isPoint"), ValueRef::create(true), false, false, false);
+
+    Evaluator::EvaluatorResult result = Evaluator::execute(context, [](ExecutionStateRef* state, ObjectTemplateRef* objectTemplate, FunctionTemplateRef* functionTemplate) -> ValueRef* {
+        StringRef* kind = StringRef::createFromASCII("kind");
+        ObjectRef* first = objectTemplate->instantiate(state);
+        ObjectRef* second = objectTemplate->instantiate(state);
+        CHECK("ObjectTemplate instance has property value", first->get(state, kind)->toString(state)->equals(StringRef::createFromASCII("point")));
+        CHECK("ObjectTemplate instance has native accessor", second->get(state, StringRef::createFromASCII("x"))->toNumber(state) == 7);
+
+        CHECK("ObjectTemplate internal field count", first->internalFieldCount() == 2);
+        CHECK("ObjectTemplate internal field is null at first", first->internalField(1) == nullptr);
+        CHECK("ObjectTemplate set internal field", first->setInternalField(1, first));
+        CHECK("ObjectTemplate get internal field", first->internalField(1) == first);
+        CHECK("ObjectTemplate internal fields are not shared", second->internalField(1) == nullptr);
+        CHECK("ObjectTemplate internal field out of range is not set", !first->setInternalField(2, first));
+        CHECK("ObjectTemplate internal field out of range is null", first->internalField(2) == nullptr);
+
+        ObjectRef* plain = ObjectRef::create(state);
+        CHECK("plain object has no internal field", plain->internalFieldCount() == 0);
+        CHECK("plain object internal field is null", plain->internalField(0) == nullptr);
+        CHECK("plain object internal field is not set", !plain->setInternalField(0, plain));
+
+        // changing template after instantiation affects new instances only
+        objectTemplate->set(kind, StringRef::createFromASCII("line"), true, true, true);
+        ObjectRef* third = objectTemplate->instantiate(state);
+        CHECK("ObjectTemplate change affects new instance", third->get(state, kind)->toString(state)->equals(StringRef::createFromASCII("line")));
+        CHECK("ObjectTemplate change keeps old instance", first->get(state, kind)->toString(state)->equals(StringRef::createFromASCII("point")));
+        objectTemplate->set(kind, StringRef::createFromASCII("point"), true, true, true);
+
+        FunctionObjectRef* point = functionTemplate->instantiate(state);
+        CHECK("FunctionTemplate returns same function for same context", functionTemplate->instantiate(state) == point);
+        state->context()->globalObject()->set(state, StringRef::createFromASCII("Point"), point);
+        ValueRef* isInstance = evalScript(state, "var p = new Point(); p instanceof Point && p.isPoint && p.y === 3 && p.constructed");
+        CHECK("FunctionTemplate construct uses instance and prototype templates", isInstance->isTrue());
+        return point;
+    },
+                                                           objectTemplate.get(), functionTemplate.get());
+    CHECK("templates run without exception", result.isSuccessful());
+    FunctionObjectRef* pointOfContext = result.isSuccessful() ? result.result->asFunctionObject() : nullptr;
+
+    // templates are instantiated in another context with structures and functions of that context
+    Evaluator::EvaluatorResult otherResult = Evaluator::execute(otherContext.get(), [](ExecutionStateRef* state, ObjectTemplateRef* objectTemplate, FunctionTemplateRef* functionTemplate, FunctionObjectRef* pointOfContext) -> ValueRef* {
+        ObjectRef* object = objectTemplate->instantiate(state);
+        CHECK("ObjectTemplate instance of other context has property value", object->get(state, StringRef::createFromASCII("kind"))->toString(state)->equals(StringRef::createFromASCII("point")));
+        CHECK("ObjectTemplate instance of other context has own prototype", object->getPrototype(state) == state->context()->globalObject()->objectPrototype());
+        FunctionObjectRef* point = functionTemplate->instantiate(state);
+        CHECK("FunctionTemplate returns other function for other context", point != pointOfContext);
+        return ValueRef::createUndefined();
+    },
+                                                                objectTemplate.get(), functionTemplate.get(), pointOfContext);
+    CHECK("templates run in other context without exception", otherResult.isSuccessful());
+}
+
+// external buffers are released by releaser when strings are collected
+struct ExternalStringBuffer {
+    char data[16];
+    int releaseCount;
+    bool hasValidLength;
+};
+
+static const size_t ExternalStringCount = 64;
+static ExternalStringBuffer g_externalStringBuffers[ExternalStringCount];
+
+static void releaseExternalStringBuffer(const void* buffer, size_t length)
+{
+    for (size_t i = 0; i < ExternalStringCount; i++) {
+        if (buffer == g_externalStringBuffers[i].data) {
+            g_externalStringBuffers[i].releaseCount++;
+            g_externalStringBuffers[i].hasValidLength = length == strlen(g_externalStringBuffers[i].data);
+        }
+    }
+}
+
+// strings are created in separate frame, so references to them don't remain on stack of caller
+static __attribute__((noinline)) void createExternalStrings(size_t start, size_t end)
+{
+    for (size_t i = start; i < end; i++) {
+        snprintf(g_externalStringBuffers[i].data, sizeof(g_externalStringBuffers[i].data), "external%d", (int)i);
+        if (i % 2) {
+            StringRef::createExternalFromASCII(g_externalStringBuffers[i].data, strlen(g_externalStringBuffers[i].data), releaseExternalStringBuffer);
+        } else {
+            StringRef::createExternalFromLatin1((const unsigned char*)g_externalStringBuffers[i].data, strlen(g_externalStringBuffers[i].data), releaseExternalStringBuffer);
+        }
+    }
+}
+
+static __attribute__((noinline)) void clearStack()
+{
+    volatile char buffer[16 * 1024];
+    memset((void*)buffer, 0, sizeof(buffer));
+}
+
+static void testExternalStringReleaser()
+{
+    // last string is kept alive by holder
+    PersistentRefHolder<StringRef> aliveString;
+    strcpy(g_externalStringBuffers[ExternalStringCount - 1].data, "alive");
+    aliveString.reset(StringRef::createExternalFromASCII(g_externalStringBuffers[ExternalStringCount - 1].data, 5, releaseExternalStringBuffer));
+
+    createExternalStrings(0, ExternalStringCount - 1);
+    clearStack();
+    for (int i = 0; i < 3; i++) {
+        Memory::gc();
+    }
+
+    size_t releasedCount = 0;
+    bool isReleasedTwice = false;
+    bool hasValidLength = true;
+    for (size_t i = 0; i < ExternalStringCount - 1; i++) {
+        releasedCount += g_externalStringBuffers[i].releaseCount ? 1 : 0;
+        isReleasedTwice = isReleasedTwice || g_externalStringBuffers[i].releaseCount > 1;
+        hasValidLength = hasValidLength && (!g_externalStringBuffers[i].releaseCount || g_externalStringBuffers[i].hasValidLength);
+    }
+    CHECK("external string releaser runs for collected strings", releasedCount == ExternalStringCount - 1);
+    CHECK("external string releaser runs once per string", !isReleasedTwice);
+    CHECK("external string releaser gets buffer and length of string", hasValidLength);
+    CHECK("external string releaser doesn't run for alive string", g_externalStringBuffers[ExternalStringCount - 1].releaseCount == 0);
+
+    aliveString.reset(nullptr);
+    clearStack();
+    for (int i = 0; i < 3; i++) {
+        Memory::gc();
+    }
+    CHECK("external string releaser runs once after holder is released", g_externalStringBuffers[ExternalStringCount - 1].releaseCount == 1);
+}
+int main(int argc, char* argv[])
+{
+#ifndef NDEBUG
+    setbuf(stdout, NULL);
+    setbuf(stderr, NULL);
+#endif
+
+    printf("cctest begins\n");
+
+    Globals::initialize();
+    {
+        PersistentRefHolder<VMInstanceRef> vm = VMInstanceRef::create(new TestPlatform());
+        vm->setOnVMInstanceDelete([](VMInstanceRef* instance) {
+            delete instance->platform();
+        });
+        PersistentRefHolder<ContextRef> context = ContextRef::create(vm.get());
+
+        testHandleScope(context.get());
+        testTemplates(context.get());
+        testExternalStringReleaser();
+    }
+    Globals::finalize();
+
+    printf("cctest ended with %d failure(s)\n", g_failCount);
+
+    return g_failCount ? 1 : 0;
+}
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2020-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+
+// allocation profiler samples allocations of the thread which started it
+
+function parseProfile(profile) {
+    var sites = [];
+    var lines = profile.split("\n");
+    for (var i = 0; i < lines.length; i++) {
+        if (!lines[i].length || lines[i].indexOf("(dropped)") == 0) {
+            continue;
+        }
+        var fields = lines[i].split(" ");
+        var surviving = Number(fields.pop());
+        var count = Number(fields.pop());
+        var allocated = Number(fields.pop());
+        assert(allocated > 0 && count > 0, "bad site line: " + lines[i]);
+        var frames = fields.join(" ").split(";");
+        sites.push({ innermost: frames[frames.length - 1], allocated: allocated, count: count, surviving: surviving });
+    }
+    return sites;
+}
+
+function bytesOfSites(sites, functionName) {
+    var result = { allocated: 0, surviving: 0 };
+    for (var i = 0; i < sites.length; i++) {
+        if (sites[i].innermost.indexOf(functionName) == 0) {
+            result.allocated += sites[i].allocated;
+            result.surviving += sites[i].surviving;
+        }
+    }
+    return result;
+}
+
+function allocateObjects(count) {
+    var objects = [];
+    for (var i = 0; i < count; i++) {
+        objects.push({ index: i });
+    }
+    return objects;
+}
+
+function allocateGarbage(count) {
+    for (var i = 0; i < count; i++) {
+        var object = { index: i };
+    }
+}
+
+assert(startAllocationProfiler(1024), "profiler should start");
+assert(!startAllocationProfiler(1024), "profiler should not start twice on same thread");
+var kept = allocateObjects(20000);
+allocateGarbage(20000);
+gc();
+var sites = parseProfile(stopAllocationProfiler());
+
+var keptBytes = bytesOfSites(sites, "allocateObjects");
+var garbageBytes = bytesOfSites(sites, "allocateGarbage");
+assert(keptBytes.allocated > 0, "allocateObjects should be sampled");
+assert(garbageBytes.allocated > 0, "allocateGarbage should be sampled");
+assert(keptBytes.surviving > 0, "objects of allocateObjects are still alive");
+assert(garbageBytes.surviving < garbageBytes.allocated, "garbage should be collected");
+assertEquals(20000, kept.length);
+
+// profiler can be restarted after stop and previous sites are cleared
+assert(startAllocationProfiler(1000000000));
+assertEquals(0, bytesOfSites(parseProfile(stopAllocationProfiler()), "allocateObjects").allocated);
+
+// running profiler belongs to thread of vm. profiler of worker can run at the same time
+var worker;
+try {
+    worker = new Worker("resources/allocation-profiler-worker.js");
+} catch (e) {
+    // built without threading support
+}
+if (worker) {
+    assert(startAllocationProfiler(1024));
+    worker.postMessage("start");
+    var result = worker.receiveMessage();
+    allocateObjects(1000);
+    var mainSites = parseProfile(stopAllocationProfiler());
+    worker.terminate();
+
+    assert(result.started, "profiler of worker should start while main thread runs profiler");
+    assert(result.sampledWorkerAllocations, "profiler of worker should sample allocations of worker");
+    assertEquals(0, bytesOfSites(mainSites, "workerAllocateObjects").allocated);
+}
@@ -0,0 +1,293 @@
+/*
+ * Copyright (c) 2020-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+
+// arguments[key] converts key to property key exactly once
+// arguments object of strict functions and functions with non-simple parameter list is not mapped,
+// so arguments.length, arguments[key] and fn.apply(thisArg, arguments) there read argc/argv
+// without creating the object. sloppy functions with simple parameters keep mapped object
+
+var toStringCount = 0;
+var key = {
+    toString: function () {
+        toStringCount++;
+        return "1";
+    }
+};
+
+function getArgumentStrict(k) {
+    "use strict";
+    return arguments[k];
+}
+
+function getArgumentNonSimple(k = 0) {
+    return arguments[k];
+}
+
+function getArgumentMapped(k) {
+    return arguments[k];
+}
+
+var getters = [getArgumentStrict, getArgumentNonSimple, getArgumentMapped];
+for (var i = 0; i < getters.length; i++) {
+    var getArgument = getters[i];
+    toStringCount = 0;
+    assertEquals("x", getArgument(key, "x"), getArgument.name);
+    assertEquals(1, toStringCount, getArgument.name);
+}
+
+function getOther(k, a, b) {
+    "use strict";
+    return arguments[k];
+}
+
+toStringCount = 0;
+assertEquals("a", getOther(key, "a", "b"));
+assertEquals(1, toStringCount);
+
+// key which is out of range of arguments
+var outOfRange = {
+    toString: function () {
+        toStringCount++;
+        return "5";
+    }
+};
+toStringCount = 0;
+assertEquals(undefined, getOther(outOfRange, "a"));
+assertEquals(1, toStringCount);
+
+// valueOf is not used for property key
+var valueOfKey = {
+    valueOf: function () {
+        throw new Error("valueOf should not be called");
+    },
+    toString: function () {
+        toStringCount++;
+        return "2";
+    }
+};
+toStringCount = 0;
+assertEquals("b", getOther(valueOfKey, "a", "b"));
+assertEquals(1, toStringCount);
+
+// Symbol.toPrimitive runs once too
+var primitiveCount = 0;
+var primitiveKey = {};
+primitiveKey[Symbol.toPrimitive] = function (hint) {
+    primitiveCount++;
+    assertEquals("string", hint);
+    return 1;
+};
+assertEquals("a", getOther(primitiveKey, "a"));
+assertEquals(1, primitiveCount);
+
+// other keys still read arguments object
+function keys() {
+    "use strict";
+    return [arguments[0], arguments["1"], arguments[1.5], arguments[-1], arguments.length, arguments["length"], arguments[2]];
+}
+assertArrayEquals([10, 20, undefined, undefined, 2, 2, undefined], keys(10, 20));
+
+// properties of Object.prototype are visible through arguments[key]
+Object.prototype[7] = "proto";
+Object.prototype.inherited = "inherited";
+function inheritedKeys(...rest) {
+    return [arguments[7], arguments["inherited"], arguments.length];
+}
+assertArrayEquals(["proto", "inherited", 1], inheritedKeys(1));
+delete Object.prototype[7];
+delete Object.prototype.inherited;
+
+// loop over numbers takes fast path
+function sum() {
+    "use strict";
+    var s = 0;
+    for (var i = 0; i < arguments.length; i++) {
+        s += arguments[i];
+    }
+    return s;
+}
+assertEquals(15, sum(1, 2, 3, 4, 5));
+
+// reading arguments in nested block scope which has its own environment
+function inBlock(a, b = 1) {
+    var closures = [];
+    for (let i = 0; i < arguments.length; i++) {
+        closures.push(function () { return i; });
+        if (arguments[i] !== [a, b][i]) {
+            return false;
+        }
+    }
+    return closures.length === arguments.length;
+}
+assert(inBlock(3, 4));
+
+// writes create unmapped arguments object, which does not alias parameters
+function writeStrict(a) {
+    "use strict";
+    arguments[0] = 5;
+    return [a, arguments[0], arguments.length];
+}
+assertArrayEquals([1, 5, 1], writeStrict(1));
+
+function writeNonSimple(a, b = 2) {
+    a = 7;
+    return [a, arguments[0], arguments[1], arguments.length];
+}
+assertArrayEquals([7, 1, undefined, 1], writeNonSimple(1));
+
+// mapped arguments alias parameters in both directions
+function writeMapped(a) {
+    a = 7;
+    var first = arguments[0];
+    arguments[0] = 8;
+    return [first, a, arguments.length];
+}
+assertArrayEquals([7, 8, 1], writeMapped(1));
+
+// escaped arguments object is seen by later reads
+function escape() {
+    "use strict";
+    var saved = arguments;
+    saved[1] = "changed";
+    saved.length = 5;
+    return [arguments[1], arguments.length, saved === arguments];
+}
+assertArrayEquals(["changed", 5, true], escape("a", "b"));
+
+// arguments variable overwritten in sloppy function with non-simple parameters
+function overwritten(a = 0) {
+    arguments = ["replaced", "list"];
+    return [arguments[0], arguments.length];
+}
+assertArrayEquals(["replaced", 2], overwritten(1, 2, 3));
+
+// fn.apply(this, arguments) forwarding
+function collect() {
+    return [this === undefined ? "undefined" : this.name, Array.prototype.slice.call(arguments)];
+}
+function forwardStrict() {
+    "use strict";
+    return collect.apply(this, arguments);
+}
+function forwardNonSimple(...rest) {
+    return collect.apply(this, arguments);
+}
+function forwardMapped(a, b) {
+    return collect.apply(this, arguments);
+}
+var receiver = { name: "receiver" };
+var forwarders = [forwardStrict, forwardNonSimple, forwardMapped];
+for (var i = 0; i < forwarders.length; i++) {
+    var forward = forwarders[i];
+    var result = forward.call(receiver, 1, 2, 3);
+    assertEquals("receiver", result[0], forward.name);
+    assertArrayEquals([1, 2, 3], result[1], forward.name);
+    assertArrayEquals([], forward.call(receiver)[1], forward.name);
+}
+
+// forwarded arguments list is a copy of argv
+function mutateFirst() {
+    arguments[0] = "mutated";
+    return arguments[0];
+}
+function forwardThenRead() {
+    "use strict";
+    var r = mutateFirst.apply(null, arguments);
+    return [r, arguments[0]];
+}
+assertArrayEquals(["mutated", "original"], forwardThenRead("original"));
+
+// forwarding to constructor-only and non-callable values
+function forwardTo(target) {
+    "use strict";
+    return target.apply(null, arguments);
+}
+assertThrows(TypeError, function () { forwardTo({ apply: Function.prototype.apply }); });
+assertThrows(TypeError, function () { forwardTo(class {}); });
+assertEquals(3, forwardTo(function () { return arguments.length; }, 1, 2));
+
+// forwarding after arguments object escaped
+function forwardEscaped() {
+    "use strict";
+    var a = arguments;
+    a[0] = "escaped";
+    return collect.apply(this, arguments);
+}
+assertArrayEquals(["escaped", 2], forwardEscaped.call(receiver, 1, 2)[1]);
+
+// own apply property of receiver is used instead of Function.prototype.apply
+function ownApplyTarget() {}
+var ownApplyCalls = [];
+ownApplyTarget.apply = function (thisArg, args) {
+    ownApplyCalls.push([thisArg, Object.prototype.toString.call(args), args.length, args[0]]);
+    return "own";
+};
+function forwardOwnApply() {
+    "use strict";
+    return ownApplyTarget.apply(this, arguments);
+}
+assertEquals("own", forwardOwnApply.call(receiver, "x", "y"));
+assertEquals(receiver, ownApplyCalls[0][0]);
+assertEquals("[object Arguments]", ownApplyCalls[0][1]);
+assertEquals(2, ownApplyCalls[0][2]);
+assertEquals("x", ownApplyCalls[0][3]);
+
+// patched Function.prototype.apply receives real arguments object
+var originalApply = Function.prototype.apply;
+var patchedCalls = [];
+Function.prototype.apply = function (thisArg, args) {
+    patchedCalls.push({ callee: this, thisArg: thisArg, args: args });
+    return originalApply.call(this, thisArg, ["patched"]);
+};
+try {
+    for (var i = 0; i < forwarders.length; i++) {
+        patchedCalls = [];
+        var result = forwarders[i].call(receiver, 1, 2);
+        assertArrayEquals(["patched"], result[1], forwarders[i].name);
+        assertEquals(1, patchedCalls.length);
+        assertEquals(collect, patchedCalls[0].callee);
+        assertEquals(receiver, patchedCalls[0].thisArg);
+        assertEquals("[object Arguments]", Object.prototype.toString.call(patchedCalls[0].args));
+        assertEquals(2, patchedCalls[0].args.length);
+        assertEquals(2, patchedCalls[0].args[1]);
+    }
+    // patched apply keeping arguments object sees same object in every call
+    var kept = [];
+    Function.prototype.apply = function (thisArg, args) {
+        kept.push(args);
+        return originalApply.call(this, thisArg, args);
+    };
+    function forwardTwice() {
+        "use strict";
+        collect.apply(null, arguments);
+        collect.apply(null, arguments);
+        return arguments;
+    }
+    var returned = forwardTwice(1);
+    assertEquals(2, kept.length);
+    assertEquals(kept[0], kept[1]);
+    assertEquals(returned, kept[0]);
+} finally {
+    Function.prototype.apply = originalApply;
+}
+
+// restored apply takes fast path again
+assertArrayEquals([4, 5], forwardStrict.call(receiver, 4, 5)[1]);
+assertArrayEquals([4, 5], forwardMapped.call(receiver, 4, 5)[1]);
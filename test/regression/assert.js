@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2020-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+// helpers shared by test/regression tests. loaded before each test file
+
+function assert(condition, message) {
+    if (!condition) {
+        throw new Error("assertion failed" + (message ? ": " + message : ""));
+    }
+}
+
+function describe(value) {
+    if (typeof value === "string") {
+        return JSON.stringify(value);
+    }
+    return String(value);
+}
+
+function assertEquals(expected, actual, message) {
+    if (!Object.is(expected, actual)) {
+        throw new Error("expected " + describe(expected) + " but got " + describe(actual) + (message ? ": " + message : ""));
+    }
+}
+
+function assertArrayEquals(expected, actual, message) {
+    assertEquals(expected.length, actual.length, (message ? message + " " : "") + "length");
+    for (var i = 0; i < expected.length; i++) {
+        if (Array.isArray(expected[i])) {
+            assertArrayEquals(expected[i], actual[i], message);
+        } else {
+            assertEquals(expected[i], actual[i], (message ? message + " " : "") + "at " + i);
+        }
+    }
+}
+
+function assertThrows(errorType, fn, message) {
+    try {
+        fn();
+    } catch (e) {
+        if (!(e instanceof errorType)) {
+            throw new Error("expected " + errorType.name + " but got " + e + (message ? ": " + message : ""));
+        }
+        return;
+    }
+    throw new Error("expected " + errorType.name + " to be thrown" + (message ? ": " + message : ""));
+}
+
+// runs promise jobs until queue is empty. drainJobQueue is given by shell
+function runJobs() {
+    assert(drainJobQueue(), "promise job threw an error");
+}
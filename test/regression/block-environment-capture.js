@@ -0,0 +1,224 @@
+/*
+ * Copyright (c) 2020-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+
+// closures capturing block variables while function environment stays on stack
+
+// per-iteration binding of for-let
+function perIteration() {
+    var fns = [];
+    for (let i = 0; i < 5; i++) {
+        fns.push(() => i);
+        // modifying binding after capture is seen by closure of the same iteration only
+        if (i == 2) {
+            i += 0;
+        }
+    }
+    return fns.map(f => f());
+}
+assertArrayEquals([0, 1, 2, 3, 4], perIteration());
+assertArrayEquals([0, 1, 2, 3, 4], perIteration());
+assert(isFunctionAllocatedOnStack(perIteration), "only block variables are captured");
+
+function perIterationUpdate() {
+    var getters = [];
+    var setters = [];
+    for (let i = 0; i < 3; i++) {
+        getters.push(() => i);
+        setters.push(v => { i = v; });
+    }
+    setters[1](100);
+    return getters.map(f => f());
+}
+assertArrayEquals([0, 100, 2], perIterationUpdate());
+
+function forInOf() {
+    var fns = [];
+    for (let key in { a: 1, b: 2 }) {
+        fns.push(() => key);
+    }
+    for (const value of [3, 4]) {
+        fns.push(() => value);
+    }
+    return fns.map(f => f());
+}
+assertArrayEquals(["a", "b", 3, 4], forInOf());
+
+// closures nested through heap allocated blocks
+function nested(x) {
+    var result = [];
+    {
+        let a = x + 1;
+        {
+            let b = a + 1;
+            result.push(() => a + b);
+            {
+                const c = b + 1;
+                result.push(() => () => a + b + c + x);
+            }
+        }
+        a = 100;
+    }
+    return result;
+}
+var n = nested(1);
+assertEquals(103, n[0]());
+assertEquals(1 + 100 + 3 + 4, n[1]()());
+
+// function variable and block variable captured together
+function mixed(x) {
+    var fns = [];
+    for (let i = 0; i < 2; i++) {
+        let j = i * 10;
+        fns.push(() => x + i + j);
+    }
+    x = 1000;
+    return fns.map(f => f());
+}
+assertArrayEquals([1000, 1011], mixed(5));
+
+// function returning before closures run, then called again (stack reused)
+function makeCounter(start) {
+    {
+        let count = start;
+        return () => ++count;
+    }
+}
+var c1 = makeCounter(0);
+var c2 = makeCounter(10);
+assertEquals(1, c1());
+assertEquals(11, c2());
+assertEquals(2, c1());
+makeCounter(50)();
+assertEquals(3, c1());
+
+// recursive function capturing block variables in every frame
+function recurse(depth) {
+    if (depth == 0) {
+        return [];
+    }
+    let fns = recurse(depth - 1);
+    {
+        let d = depth;
+        fns.push(() => d);
+    }
+    return fns;
+}
+assertArrayEquals([1, 2, 3, 4, 5], recurse(5).map(f => f()));
+
+// arrow functions in blocks of derived class constructors touch this and super
+class Base {
+    constructor(v) {
+        this.v = v;
+    }
+    get base() {
+        return "base" + this.v;
+    }
+}
+
+class Derived extends Base {
+    constructor(v) {
+        var fns = [];
+        {
+            let before = () => this;
+            fns.push(before);
+        }
+        // this is not initialized yet
+        assertThrows(ReferenceError, fns[0]);
+        for (let i = 0; i < 2; i++) {
+            if (i == 0) {
+                let callSuper = () => super(v);
+                callSuper();
+            }
+            fns.push(() => this.v + i);
+            fns.push(() => super.base + i);
+        }
+        this.fns = fns;
+    }
+}
+var d = new Derived(7);
+assertEquals(d, d.fns[0]());
+assertEquals(7, d.fns[1]());
+assertEquals("base70", d.fns[2]());
+assertEquals(8, d.fns[3]());
+assertEquals("base71", d.fns[4]());
+
+// eval inside such blocks sees block variables
+function withEval(code) {
+    var fns = [];
+    for (let i = 0; i < 3; i++) {
+        let j = i * 2;
+        fns.push(() => eval(code));
+    }
+    {
+        let k = 42;
+        fns.push(() => eval("k"));
+        eval("var fromEval = k + 1");
+    }
+    fns.push(() => fromEval);
+    return fns.map(f => f());
+}
+assertArrayEquals([0, 3, 6, 42, 43], withEval("i + j"));
+
+function evalDeclaresInBlock() {
+    var fns = [];
+    for (let i = 0; i < 2; i++) {
+        eval("var captured" + i + " = i");
+        fns.push(() => i);
+    }
+    return [captured0, captured1].concat(fns.map(f => f()));
+}
+assertArrayEquals([0, 1, 0, 1], evalDeclaresInBlock());
+
+// with inside such blocks
+function withStatement(obj) {
+    var fns = [];
+    for (let i = 0; i < 2; i++) {
+        with (obj) {
+            let local = i;
+            fns.push(() => value + local);
+        }
+    }
+    obj.value = 100;
+    return fns.map(f => f());
+}
+assertArrayEquals([100, 101], withStatement({ value: 1 }));
+
+function withShadowing() {
+    var fns = [];
+    var x = "function";
+    {
+        let x = "block";
+        with ({ x: "with" }) {
+            fns.push(() => x);
+        }
+        fns.push(() => x);
+    }
+    fns.push(() => x);
+    return fns.map(f => f());
+}
+assertArrayEquals(["with", "block", "function"], withShadowing());
+
+// generators keep their block environment across yields
+function* generator() {
+    for (let i = 0; i < 3; i++) {
+        yield () => i;
+    }
+}
+assertArrayEquals([0, 1, 2], Array.from(generator()).map(f => f()));
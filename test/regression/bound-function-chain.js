@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2020-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+
+// calling bound function chains which are flattened at bind time
+
+function collect() {
+    return [this === undefined ? "undefined" : this.name].concat(Array.prototype.slice.call(arguments));
+}
+
+var objects = [{ name: "o0" }, { name: "o1" }, { name: "o2" }, { name: "o3" }];
+
+// f_n = f_(n-1).bind(objects[n], n * 10, n * 10 + 1)
+var chain = [collect];
+for (var n = 1; n <= 4; n++) {
+    chain.push(chain[n - 1].bind(objects[n - 1], n * 10, n * 10 + 1));
+}
+
+for (var n = 1; n <= 4; n++) {
+    var expected = ["o0"];
+    for (var i = 1; i <= n; i++) {
+        expected.push(i * 10, i * 10 + 1);
+    }
+    // call site in interpreter, native call path and apply with spread-like arguments
+    assertArrayEquals(expected.concat([1, 2]), chain[n](1, 2));
+    assertArrayEquals(expected.concat([3]), chain[n].call(objects[3], 3));
+    assertArrayEquals(expected.concat([4, 5, 6]), Reflect.apply(chain[n], null, [4, 5, 6]));
+    assertArrayEquals(expected, chain[n]());
+    assertEquals(Math.max(0, collect.length - 2 * n), chain[n].length);
+    assertEquals("bound ".repeat(n) + "collect", chain[n].name);
+}
+
+// bind without arguments in the middle of chain
+var noArgs = chain[2].bind(objects[3]).bind(null, "x");
+assertArrayEquals(["o0", 10, 11, 20, 21, "x", "y"], noArgs("y"));
+
+// inner chain is not affected by outer bind
+var branch = chain[1].bind(objects[2], "branch");
+assertArrayEquals(["o0", 10, 11, "branch"], branch());
+assertArrayEquals(["o0", 10, 11, 20, 21], chain[2]());
+
+// target which is not a plain function
+var proxyTarget = new Proxy(collect, {
+    apply: function (target, thisArg, args) {
+        return ["proxy"].concat(target.apply(thisArg, args));
+    }
+});
+var boundProxy = proxyTarget.bind(objects[0], 1).bind(objects[1], 2);
+assertArrayEquals(["proxy", "o0", 1, 2, 3], boundProxy(3));
+
+// native target
+var boundMax = Math.max.bind(null, 1).bind(null, 7);
+assertEquals(9, boundMax(9));
+assertEquals(7, boundMax(2));
+
+// construct through chain uses innermost target and ignores bound this
+function Point(x, y) {
+    this.x = x;
+    this.y = y;
+}
+var BoundPoint = Point.bind(objects[0], 1).bind(objects[1]);
+var p = new BoundPoint(2);
+assert(p instanceof Point);
+assertEquals(1, p.x);
+assertEquals(2, p.y);
+assert(new (BoundPoint.bind(null, 5))() instanceof Point);
+
+// many calls at the same call site hit cached call path
+var sum = 0;
+var add = function (a, b, c) { return a + b + c; }.bind(null, 1).bind(null, 2);
+for (var i = 0; i < 1000; i++) {
+    sum += add(i);
+}
+assertEquals(1000 * 3 + 999 * 1000 / 2, sum);
@@ -0,0 +1,252 @@
+/*
+ * Copyright (c) 2020-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+// Bytecode peephole pass fuses adjacent instruction pairs into superinstructions.
+// every case here runs code which is expected to be fused and checks it behaves like separate instructions,
+// including jumps into second instruction of a pair, exceptions from first instruction and side effects
+
+// Move then Move: swaps and assignment chains
+function swap(a, b) {
+    var t = a;
+    a = b;
+    b = t;
+    return [a, b];
+}
+assertArrayEquals([2, 1], swap(1, 2));
+function chain(v) {
+    var a, b, c;
+    a = b = c = v;
+    return [a, b, c];
+}
+assertArrayEquals(["x", "x", "x"], chain("x"));
+
+// Move then Jump: assignment at end of if branch jumps over else branch.
+// loops with continue jump to the Jump of a pair too
+function branches(n) {
+    var result = [];
+    for (var i = 0; i < n; i++) {
+        var v;
+        if (i % 3 === 0) {
+            v = i;
+        } else if (i % 3 === 1) {
+            v = -i;
+            if (i > 3) {
+                continue;
+            }
+        } else {
+            v = "s" + i;
+        }
+        result.push(v);
+    }
+    return result;
+}
+assertArrayEquals([0, -1, "s2", 3, "s5", 6, "s8"], branches(9));
+
+function ternaryMoves(c, a, b) {
+    var x = c ? a : b;
+    var y = !c ? a : b;
+    return [x, y];
+}
+assertArrayEquals([1, 2], ternaryMoves(true, 1, 2));
+assertArrayEquals([2, 1], ternaryMoves(false, 1, 2));
+
+// logical operators jump to instruction after moves of both sides
+function logical(a, b, c) {
+    var x = a && b;
+    var y = a || c;
+    var z = a == null ? c : a;
+    return [x, y, z];
+}
+assertArrayEquals([0, 3, 0], logical(0, 2, 3));
+assertArrayEquals([2, 1, 1], logical(1, 2, 3));
+assertArrayEquals([null, 3, 3], logical(null, 2, 3));
+
+// LoadLiteral then BinaryPlus: literal operand with every kind of other operand
+function plusLiteral(x) {
+    return [x + 1, 1 + x, x + "s", "s" + x, x + 0.5];
+}
+assertArrayEquals([2, 2, "1s", "s1", 1.5], plusLiteral(1));
+assertArrayEquals(["a1", "1a", "as", "sa", "a0.5"], plusLiteral("a"));
+assertArrayEquals([2147483648, 2147483648, "2147483647s", "s2147483647", 2147483647.5], plusLiteral(2147483647));
+var valueOfCount = 0;
+var withValueOf = {
+    valueOf: function () {
+        valueOfCount++;
+        return 10;
+    }
+};
+assertArrayEquals([11, 11, "10s", "s10", 10.5], plusLiteral(withValueOf));
+assertEquals(5, valueOfCount);
+assertThrows(TypeError, function () { plusLiteral(Symbol()); });
+
+// loop whose condition jumps into middle of fused pairs
+function sumLoop(n) {
+    var s = 0;
+    for (var i = 0; i < n; i++) {
+        s = s + 2;
+    }
+    return s;
+}
+assertEquals(200, sumLoop(100));
+
+// LoadLiteral then JumpIfEqual: comparison with literal, and switch cases
+function classify(x) {
+    if (x == 1) {
+        return "one";
+    }
+    if (x === "two") {
+        return "two";
+    }
+    if (x != 3) {
+        return "other";
+    }
+    return "three";
+}
+assertArrayEquals(["one", "one", "two", "three", "three", "other"], [1, "1", "two", 3, "3", null].map(classify));
+function switchCase(x) {
+    var r = "";
+    switch (x) {
+    case 0:
+        r += "a";
+    case 1:
+        r += "b";
+        break;
+    case "2":
+        r += "c";
+        break;
+    default:
+        r += "d";
+    case 4:
+        r += "e";
+    }
+    return r;
+}
+assertArrayEquals(["ab", "b", "c", "de", "e", "de"], [0, 1, "2", 3, 4, 2].map(switchCase));
+
+// Increment then Jump: loop updates with every kind of counter
+function countTo(start, end) {
+    var n = 0;
+    for (var i = start; i < end; i++) {
+        n++;
+    }
+    return [n, i];
+}
+assertArrayEquals([5, 5], countTo(0, 5));
+assertArrayEquals([3, 2.5], countTo(-0.5, 2.5));
+assertArrayEquals([2, 2], countTo("0", 2));
+assertArrayEquals([2, 2147483649], countTo(2147483647, 2147483649));
+// first half of pair throws, and catch block continues loop
+var throwCount = 0;
+var counter = { valueOf: function () { throw new RangeError("valueOf"); } };
+for (var k = 0; k < 3; k++) {
+    try {
+        var c = counter;
+        c++;
+    } catch (e) {
+        assert(e instanceof RangeError);
+        throwCount++;
+    }
+}
+assertEquals(3, throwCount);
+assertThrows(TypeError, function () { for (var s = Symbol(); ; s++) {} });
+
+// GetObjectPreComputedCase pairs: property chains and method calls
+var objectForChain = { a: { b: { c: 42 } } };
+function readChain(o) {
+    return o.a.b.c;
+}
+for (var i = 0; i < 10; i++) {
+    assertEquals(42, readChain(objectForChain));
+}
+assertThrows(TypeError, function () { readChain({ a: {} }); });
+assertThrows(TypeError, function () { readChain({}); });
+assertEquals(undefined, readChain({ a: { b: 1 } }));
+// primitive receivers of pairs
+assertEquals("3", (function (s) { return s.length.toString(); })("abc"));
+assertEquals(1, (function (s) { return s.length.toString.length; })("abc"));
+
+var calls = [];
+var receiverObject = {
+    tag: "receiver",
+    method: function (x) {
+        calls.push(this.tag + x);
+        return this;
+    }
+};
+function callMethods(o) {
+    return o.method(1).method(2).tag;
+}
+assertEquals("receiver", callMethods(receiverObject));
+assertArrayEquals(["receiver1", "receiver2"], calls);
+
+// getter of first half runs once and exception from it is caught
+var getterCount = 0;
+var withGetter = {
+    get method() {
+        getterCount++;
+        return function () { return this === withGetter; };
+    }
+};
+assert((function (o) { return o.method(); })(withGetter));
+assertEquals(1, getterCount);
+var throwingGetter = { get method() { throw new SyntaxError("getter"); } };
+assertThrows(SyntaxError, function () { throwingGetter.method(); });
+assertThrows(TypeError, function () { ({ method: 1 }).method(); });
+assertEquals("1", (function (n) { return n.toString(); })(1));
+
+// inline caches of fused instructions see structure changes
+function readX(o) {
+    return o.p.x;
+}
+var shapes = [{ p: { x: 1 } }, { p: { y: 0, x: 2 } }, { q: 0, p: { x: 3 } }, { p: Object.create({ x: 4 }) }];
+for (var round = 0; round < 3; round++) {
+    for (var i = 0; i < shapes.length; i++) {
+        assertEquals(i + 1, readX(shapes[i]));
+    }
+}
+shapes[0].p.x = 10;
+delete shapes[1].p.y;
+assertEquals(10, readX(shapes[0]));
+assertEquals(2, readX(shapes[1]));
+
+// fused instructions right before and after yield and await
+function* generatorPairs(a) {
+    var b = a;
+    var c = yield b + 1;
+    var d = c;
+    yield d + 1;
+    for (var i = 0; i < 2; i++) {
+        yield i;
+    }
+}
+assertArrayEquals([2, 11, 0, 1], (function () {
+    var g = generatorPairs(1);
+    var r = [g.next().value, g.next(10).value];
+    r.push(g.next().value, g.next().value);
+    return r;
+})());
+var awaited = [];
+(async function (a) {
+    var b = a;
+    var c = await b + 1;
+    var d = c;
+    awaited.push(d + 1, c.toString().length);
+})(1);
+runJobs();
+assertArrayEquals([3, 1], awaited);
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2020-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+
+// decompressing CompressibleString chunk by chunk
+// a chunk is 64KiB of string data. strings below span 7 chunks, more than per-string chunk cache keeps
+
+if (typeof createCompressibleString === "function") {
+
+var chunkSize = 64 * 1024;
+
+function makeSource(pattern, byteLength, charSize) {
+    return pattern.repeat(Math.ceil(byteLength / charSize / pattern.length)).substring(0, byteLength / charSize + 123);
+}
+
+function compress(str) {
+    for (var i = 0; i < 10 && !compressString(str); i++) {
+        gc();
+    }
+    assert(isStringCompressed(str), "string should be compressed");
+}
+
+function test(src, charSize) {
+    var str = createCompressibleString(src);
+    assertEquals(src.length, str.length);
+    compress(str);
+
+    var charsPerChunk = chunkSize / charSize;
+    var chunkCount = Math.ceil(str.length / charsPerChunk);
+
+    // charAt on both sides of every chunk boundary, forward and backward
+    // visiting more chunks than the cache keeps evicts chunks in between
+    for (var round = 0; round < 2; round++) {
+        for (var c = 1; c < chunkCount; c++) {
+            var chunk = round ? chunkCount - c : c;
+            var boundary = chunk * charsPerChunk;
+            assertEquals(src.charAt(boundary - 1), str.charAt(boundary - 1));
+            assertEquals(src.charAt(boundary), str.charAt(boundary));
+        }
+    }
+    assert(isStringCompressed(str), "charAt should not decompress whole string");
+
+    // keep views over ranges spanning chunk boundaries alive while other chunks are evicted
+    var views = [];
+    var ranges = [];
+    for (var c = 1; c < chunkCount; c++) {
+        var start = c * charsPerChunk - 100;
+        var end = Math.min(start + charsPerChunk, str.length);
+        ranges.push([start, end]);
+        views.push(str.substring(start, end));
+    }
+    for (var i = 0; i < views.length; i++) {
+        // comparison accesses view buffer while reading other ranges evicts chunks
+        assertEquals(src.substring(ranges[i][0], ranges[i][1]), views[i]);
+        assertEquals(src.charAt(ranges[(i + 3) % ranges.length][0]), str.charAt(ranges[(i + 3) % ranges.length][0]));
+        gc();
+    }
+    assert(isStringCompressed(str), "substring should not decompress whole string");
+
+    // accessing whole string decompresses it and clears chunk table
+    assertEquals(src.indexOf("\u{10000}"), str.indexOf("\u{10000}"));
+    assertEquals(src, str + "");
+    assert(!isStringCompressed(str), "string should be decompressed");
+
+    // compress again and read chunks again. stale chunks must not be returned
+    compress(str);
+    for (var c = chunkCount - 1; c >= 0; c--) {
+        var at = c * charsPerChunk + 7;
+        if (at < str.length) {
+            assertEquals(src.charAt(at), str.charAt(at));
+        }
+    }
+    assertEquals(src.substring(chunkSize / 2, chunkSize * 3 / charSize), str.substring(chunkSize / 2, chunkSize * 3 / charSize));
+    assertEquals(src, str + "");
+}
+
+test(makeSource("abcdefghijklmnopqrstuvwxyz0123456789!", chunkSize * 6, 1), 1);
+test(makeSource("abcdefghijklmnopqrstuvwxyzあいう", chunkSize * 6, 2), 2);
+
+}
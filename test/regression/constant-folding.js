@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2020-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+
+// constant folding of parser gives the same values as runtime operations
+// literal operands are folded while parsing, operands in variables are computed by interpreter
+
+var operandSources = ["0", "1", "-1", "-0", "1.5", "0x10", "1e308", "\"\"", "\"10\"", "\"a\"", "true", "false", "null"];
+var operators = ["+", "-", "*", "/", "%", "**", "<<", ">>", ">>>", "&", "|", "^", "<", ">", "<=", ">=", "==", "!=", "===", "!==", "&&", "||"];
+
+function describeValue(value) {
+    return typeof value + ":" + (Object.is(value, -0) ? "-0" : String(value));
+}
+
+for (var i = 0; i < operandSources.length; i++) {
+    for (var j = 0; j < operandSources.length; j++) {
+        for (var k = 0; k < operators.length; k++) {
+            // unary operand on left side of ** should be parenthesized
+            var left = operators[k] == "**" ? "(" + operandSources[i] + ")" : operandSources[i];
+            var source = left + " " + operators[k] + " " + operandSources[j];
+            var folded = Function("return " + source + ";")();
+            var computed = Function("a", "b", "return a " + operators[k] + " b;")(eval(operandSources[i]), eval(operandSources[j]));
+            assertEquals(describeValue(computed), describeValue(folded), source);
+        }
+    }
+}
+
+// nested operations are folded from inner ones
+assertEquals(7, 1 + 2 * 3);
+assertEquals("a12", "a" + 1 + 2);
+assertEquals("3a", 1 + 2 + "a");
+assertEquals(-1, ~0 + (1 - 1));
+assertEquals(Infinity, 1 / -0 * -1);
+
+// constant branches
+var sideEffects = [];
+function record(value) {
+    sideEffects.push(value);
+    return value;
+}
+assertEquals("then", true ? record("then") : record("else"));
+assertEquals("else", 0 ? record("then") : record("else"));
+if ("") {
+    record("if");
+} else {
+    record("else of if");
+}
+if (1 + 1 == 2) {
+    record("folded condition");
+}
+assertArrayEquals(["then", "else", "else of if", "folded condition"], sideEffects);
+
+// completion value of folded expression statement is kept
+assertEquals("ab", eval("\"a\" + \"b\";"));
+assertEquals(3, eval("1 + 2;"));
+
+// directive prologue is made of statements of single string literal token
+// folded string concatenation is not a directive
+function strictByDirective() {
+    "use strict";
+    return this;
+}
+function concatenatedUseStrict() {
+    "use" + " strict";
+    return this;
+}
+function useStrictFollowedByOperator() {
+    "use strict" + "";
+    return this;
+}
+function parenthesizedUseStrict() {
+    ("use strict");
+    return this;
+}
+function useStrictAfterFoldedStatement() {
+    "a" + "b";
+    "use strict";
+    return this;
+}
+function useStrictAfterOtherDirective() {
+    "a";
+    "use strict";
+    return this;
+}
+
+assertEquals(undefined, strictByDirective());
+assert(concatenatedUseStrict() !== undefined, "concatenated string is not a directive");
+assert(useStrictFollowedByOperator() !== undefined, "\"use strict\" with operator is not a directive");
+assert(parenthesizedUseStrict() !== undefined, "parenthesized string is not a directive");
+assert(useStrictAfterFoldedStatement() !== undefined, "prologue ends at folded statement");
+assertEquals(undefined, useStrictAfterOtherDirective());
+
+// sloppy mode code after non-directive "use strict" statement
+assertEquals(1, Function("\"use strict\" + \"\"; with ({ x: 1 }) { return x; }")());
+assertThrows(SyntaxError, function() {
+    Function("\"use strict\"; with ({ x: 1 }) { return x; }");
+});
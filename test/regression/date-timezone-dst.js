@@ -0,0 +1,104 @@
+// env: TZ=America/Los_Angeles
+/*
+ * Copyright (c) 2020-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+
+// timezone offset cache around daylight saving time transitions
+// America/Los_Angeles: PST is UTC-8, PDT is UTC-7
+
+var hour = 60 * 60 * 1000;
+
+// 2021-03-14 02:00 PST -> 03:00 PDT at 10:00 UTC
+var springForward = Date.UTC(2021, 2, 14, 10);
+// 2021-11-07 02:00 PDT -> 01:00 PST at 09:00 UTC
+var fallBack = Date.UTC(2021, 10, 7, 9);
+
+assertEquals(480, new Date(springForward - 1).getTimezoneOffset());
+assertEquals(420, new Date(springForward).getTimezoneOffset());
+assertEquals(420, new Date(fallBack - 1).getTimezoneOffset());
+assertEquals(480, new Date(fallBack).getTimezoneOffset());
+
+// local fields right across transitions
+var before = new Date(springForward - 1);
+assertArrayEquals([1, 59], [before.getHours(), before.getMinutes()]);
+var after = new Date(springForward);
+assertArrayEquals([3, 0], [after.getHours(), after.getMinutes()]);
+assertArrayEquals([1, 59], [new Date(fallBack - 1).getHours(), new Date(fallBack - 1).getMinutes()]);
+assertArrayEquals([1, 0], [new Date(fallBack).getHours(), new Date(fallBack).getMinutes()]);
+
+// local time to utc on both sides of transitions
+assertEquals(Date.UTC(2021, 2, 14, 9), new Date(2021, 2, 14, 1).getTime());
+assertEquals(Date.UTC(2021, 2, 14, 11), new Date(2021, 2, 14, 4).getTime());
+assertEquals(Date.UTC(2021, 10, 7, 7), new Date(2021, 10, 7, 0).getTime());
+assertEquals(Date.UTC(2021, 10, 7, 11), new Date(2021, 10, 7, 3).getTime());
+
+// cached intervals must give same result whatever order times are asked in
+function offsetsOf(times) {
+    var result = {};
+    for (var i = 0; i < times.length; i++) {
+        var d = new Date(times[i]);
+        result[times[i]] = d.getTimezoneOffset() + "/" + d.getHours();
+    }
+    return result;
+}
+
+var times = [];
+// every 30 minutes for 3 days around each transition, and every 7 hours over 3 years
+[springForward, fallBack].forEach(function (transition) {
+    for (var t = transition - 36 * hour; t <= transition + 36 * hour; t += hour / 2) {
+        times.push(t);
+    }
+});
+for (var t = Date.UTC(2020, 0, 1); t < Date.UTC(2023, 0, 1); t += 7 * hour) {
+    times.push(t);
+}
+
+var forward = offsetsOf(times);
+var backward = offsetsOf(times.slice().reverse());
+// jump between far times so that each lookup misses the last hit interval
+var shuffled = [];
+for (var i = 0; i < times.length; i++) {
+    shuffled.push(times[(i * 7919) % times.length]);
+}
+var jumping = offsetsOf(shuffled);
+
+var offsets = {};
+for (var i = 0; i < times.length; i++) {
+    var t = times[i];
+    assertEquals(forward[t], backward[t], "backward order at " + new Date(t).toISOString());
+    assertEquals(forward[t], jumping[t], "random order at " + new Date(t).toISOString());
+    offsets[forward[t].split("/")[0]] = true;
+}
+assertArrayEquals(["420", "480"], Object.keys(offsets).sort());
+
+// each offset change within a year happens only at the two transitions
+var changes = [];
+var last = new Date(Date.UTC(2021, 0, 1)).getTimezoneOffset();
+for (var t = Date.UTC(2021, 0, 1); t < Date.UTC(2022, 0, 1); t += hour) {
+    var offset = new Date(t).getTimezoneOffset();
+    if (offset != last) {
+        changes.push(t);
+        last = offset;
+    }
+}
+assertArrayEquals([springForward, fallBack], changes);
+
+// times far from transitions of 2021 use rules of their own year
+assertEquals(480, new Date(Date.UTC(1970, 0, 1)).getTimezoneOffset());
+assertEquals(420, new Date(Date.UTC(2100, 6, 1)).getTimezoneOffset());
@@ -0,0 +1,213 @@
+/*
+ * Copyright (c) 2020-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+// Calls between interpreted functions run on InterpreterStack without native recursion
+// checks exception unwinding through inline frames, fallback to native calls when
+// interpreter stack is full, stack traces and generators/async functions inside inline calls
+
+// exceptions unwind through inline frames and run finally blocks on the way
+var finallyLog = [];
+function thrower(depth) {
+    try {
+        if (depth === 0) {
+            throw new TypeError("bottom");
+        }
+        return thrower(depth - 1) + 1;
+    } finally {
+        finallyLog.push(depth);
+    }
+}
+assertThrows(TypeError, function () { thrower(5); });
+assertArrayEquals([0, 1, 2, 3, 4, 5], finallyLog);
+
+// catch in the middle of inline frames and continue with caller's registers intact
+function catchAt(depth, catchDepth) {
+    var local = depth * 10;
+    try {
+        if (depth === 0) {
+            throw depth;
+        }
+        return catchAt(depth - 1, catchDepth) + local;
+    } catch (e) {
+        if (depth !== catchDepth) {
+            throw e;
+        }
+        return 1000 + local;
+    }
+}
+assertEquals(1000 + 30 + 40 + 50, catchAt(5, 3));
+assertEquals(1000 + 10 + 20 + 30 + 40 + 50, catchAt(5, 0) - 0 + 0);
+
+// exceptions thrown from callbacks of native functions cross native and inline frames
+function viaNative(depth) {
+    if (depth === 0) {
+        throw new RangeError("from callback");
+    }
+    return [depth].map(function (d) { return viaNative(d - 1); })[0];
+}
+assertThrows(RangeError, function () { viaNative(20); });
+var caught = 0;
+for (var i = 0; i < 100; i++) {
+    try {
+        viaNative(i % 7);
+    } catch (e) {
+        caught++;
+    }
+}
+assertEquals(100, caught);
+
+// recursion deeper than the interpreter stack falls back to native calls
+function sum(n) {
+    return n === 0 ? 0 : n + sum(n - 1);
+}
+assertEquals(3000 * 3001 / 2, sum(3000));
+function sumWithLocals(n) {
+    var a = n, b = n * 2, c = n * 3;
+    if (n === 0) {
+        return 0;
+    }
+    return sumWithLocals(n - 1) + c - b - a + n;
+}
+assertEquals(2000 * 2001 / 2, sumWithLocals(2000));
+
+// infinite recursion throws RangeError and engine keeps working after that
+function infinite(n) {
+    return infinite(n + 1) + 1;
+}
+for (var i = 0; i < 3; i++) {
+    assertThrows(RangeError, function () { infinite(0); });
+    assertEquals(600 * 601 / 2, sum(600));
+}
+
+// function which needs bigger register file than a stack segment
+var source = "var s = 0;\n";
+for (var i = 0; i < 3000; i++) {
+    source += "var v" + i + " = n + " + i + ";\n";
+}
+for (var i = 0; i < 3000; i += 100) {
+    source += "s += v" + i + ";\n";
+}
+source += "return n === 0 ? s : s + self(n - 1, self);";
+var wide = new Function("n", "self", source);
+function wideExpected(n) {
+    var s = 0;
+    for (var i = 0; i < 3000; i += 100) {
+        s += n + i;
+    }
+    return n === 0 ? s : s + wideExpected(n - 1);
+}
+assertEquals(wideExpected(3), wide(3, wide));
+assertEquals(wideExpected(3) + wideExpected(3), sum(0) + wide(3, wide) + (function () { return wide(3, wide); })());
+
+// stack traces list inline frames in order
+function traceC() { throw new Error("trace"); }
+function traceB() { traceC(); }
+function traceA() { traceB(); }
+var trace = stackTraceOf(function traceTop() { traceA(); });
+assert(trace.length >= 4, "stack trace is too short " + trace);
+assertEquals("traceC", trace[0].split(":")[0]);
+assertEquals("traceB", trace[1].split(":")[0]);
+assertEquals("traceA", trace[2].split(":")[0]);
+assertEquals("traceTop", trace[3].split(":")[0]);
+assertEquals(stackTraceOf(function () {}), undefined);
+
+// stack trace of recursion deeper than one frame segment
+function deepThrow(n) {
+    if (n === 0) {
+        throw new Error("deep");
+    }
+    deepThrow(n - 1);
+}
+trace = stackTraceOf(function () { deepThrow(600); });
+assert(trace.length > 20, "deep stack trace is too short");
+for (var i = 0; i < 20; i++) {
+    assertEquals("deepThrow", trace[i].split(":")[0]);
+}
+
+// generators resumed from inline frames keep their own registers
+function* counter(limit) {
+    var local = 100;
+    for (var i = 0; i < limit; i++) {
+        var received = yield i + local;
+        if (received) {
+            local = received;
+        }
+    }
+    return "done";
+}
+function drive(gen, depth) {
+    if (depth > 0) {
+        return drive(gen, depth - 1);
+    }
+    return gen.next().value;
+}
+var gen = counter(4);
+assertEquals(100, drive(gen, 10));
+assertEquals(101, drive(gen, 3));
+assertEquals(202, gen.next(200).value);
+assertEquals(203, drive(gen, 50));
+assertEquals("done", drive(gen, 1));
+
+// generator throwing through inline frames
+function* throwingGenerator() {
+    yield 1;
+    throw new SyntaxError("generator");
+}
+function pull(g, depth) {
+    return depth === 0 ? g.next().value : pull(g, depth - 1);
+}
+var tg = throwingGenerator();
+assertEquals(1, pull(tg, 5));
+assertThrows(SyntaxError, function () { pull(tg, 5); });
+assert(tg.next().done);
+
+// yield* and inline calls inside generator body
+function helper(x) { return x * 2; }
+function* outer() {
+    yield helper(1);
+    yield* counter(2);
+    yield helper(sum(3));
+}
+assertArrayEquals([2, 100, 101, 12], Array.from(outer()));
+
+// async functions awaited inside inline calls resume with correct frames
+var asyncLog = [];
+async function asyncLeaf(v) {
+    var before = v;
+    await null;
+    asyncLog.push(before);
+    if (v === 3) {
+        throw new Error("async " + v);
+    }
+    return helper(v);
+}
+async function asyncMiddle(v) {
+    return (await asyncLeaf(v)) + sum(v);
+}
+function callAsync(v, depth) {
+    return depth === 0 ? asyncMiddle(v) : callAsync(v, depth - 1);
+}
+var asyncResults = [];
+callAsync(1, 5).then(function (r) { asyncResults.push(r); });
+callAsync(2, 300).then(function (r) { asyncResults.push(r); });
+callAsync(3, 20).catch(function (e) { asyncResults.push(e.message); });
+assertArrayEquals([], asyncLog);
+runJobs();
+assertArrayEquals([1, 2, 3], asyncLog);
+assertArrayEquals([2 + 1, 4 + 3, "async 3"], asyncResults);
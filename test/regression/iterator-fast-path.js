@@ -0,0 +1,471 @@
+/*
+ * Copyright (c) 2020-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+// Spread, destructuring, for-of, Array.from, TypedArray.from and Map/Set/WeakMap/WeakSet constructors
+// step built-in iterators directly when their next method is the original one.
+// each case runs once with built-in next methods and once with wrappers which force iterator protocol,
+// and results of both should be same
+
+var ArrayIteratorPrototype = Object.getPrototypeOf([][Symbol.iterator]());
+var StringIteratorPrototype = Object.getPrototypeOf(""[Symbol.iterator]());
+var MapIteratorPrototype = Object.getPrototypeOf(new Map()[Symbol.iterator]());
+var SetIteratorPrototype = Object.getPrototypeOf(new Set()[Symbol.iterator]());
+var iteratorPrototypes = [ArrayIteratorPrototype, StringIteratorPrototype, MapIteratorPrototype, SetIteratorPrototype];
+var originalNexts = iteratorPrototypes.map(function (proto) { return proto.next; });
+
+function restoreNexts() {
+    for (var i = 0; i < iteratorPrototypes.length; i++) {
+        iteratorPrototypes[i].next = originalNexts[i];
+    }
+}
+
+function wrapNexts() {
+    iteratorPrototypes.forEach(function (proto, i) {
+        proto.next = function () {
+            return originalNexts[i].call(this);
+        };
+    });
+}
+
+function serialize(v) {
+    if (Array.isArray(v) || ArrayBuffer.isView(v)) {
+        return "[" + Array.prototype.map.call(v, serialize).join(",") + "]";
+    }
+    if (v instanceof Map) {
+        return "Map" + serialize(Array.from(v));
+    }
+    if (v instanceof Set) {
+        return "Set" + serialize(Array.from(v));
+    }
+    if (v instanceof WeakMap || v instanceof WeakSet) {
+        return Object.prototype.toString.call(v);
+    }
+    if (typeof v === "string") {
+        // code units are written as they are, so surrogate pairs are not joined or escaped differently by engines
+        var escaped = "";
+        for (var i = 0; i < v.length; i++) {
+            var c = v.charCodeAt(i);
+            escaped += c >= 0x20 && c < 0x7f ? v.charAt(i) : "\\u" + c.toString(16);
+        }
+        return "\"" + escaped + "\"";
+    }
+    if (typeof v === "object" && v !== null && "id" in v) {
+        return "#" + v.id;
+    }
+    return String(v);
+}
+
+function capture(fn) {
+    try {
+        return serialize(fn());
+    } catch (e) {
+        return "throws " + e.constructor.name;
+    }
+}
+
+// returns result of fn, after checking it is same when iterator protocol is used
+function bothWays(fn, message) {
+    var fast = capture(fn);
+    wrapNexts();
+    var slow;
+    try {
+        slow = capture(fn);
+    } finally {
+        restoreNexts();
+    }
+    assertEquals(fast, slow, message);
+    return fast;
+}
+
+function spread(x) { return [...x]; }
+function destructure(x) { var [a, b, ...rest] = x; return [a, b, rest]; }
+function forOf(x) { var r = []; for (var v of x) { r.push(v); } return r; }
+function arrayFrom(x) { return Array.from(x); }
+function arrayFromMapped(x) { return Array.from(x, function (v, i) { return [i, v]; }); }
+function typedArrayFrom(x) { return Float64Array.from(x); }
+function mapConstructor(x) { return new Map(x); }
+function setConstructor(x) { return new Set(x); }
+function weakMapConstructor(x) { return new WeakMap(x); }
+function weakSetConstructor(x) { return new WeakSet(x); }
+var valueConsumers = [spread, destructure, forOf, arrayFrom, arrayFromMapped, typedArrayFrom, setConstructor];
+var allConsumers = valueConsumers.concat([mapConstructor, weakMapConstructor, weakSetConstructor]);
+
+// plain sources take fast path and give same results as protocol
+var keyA = { id: "a" }, keyB = { id: "b" };
+function plainSources() {
+    return [
+        [1, 2, 3],
+        [1, , 3],
+        [[keyA, 1], [keyB, 2]],
+        [keyA, keyB],
+        new Set([1, "s", keyA]),
+        new Map([[keyA, 1], [keyB, 2]]),
+        new Map([[1, 2]]).keys(),
+        [3, 4].entries(),
+        "abc",
+        new Float64Array([1.5, -0, NaN]),
+        new Uint8Array(0)
+    ];
+}
+for (var i = 0; i < allConsumers.length; i++) {
+    var sources = plainSources();
+    for (var j = 0; j < sources.length; j++) {
+        var index = j;
+        bothWays(function () { return allConsumers[i](plainSources()[index]); }, allConsumers[i].name + " of source " + j);
+    }
+}
+assertEquals("[1,2,3]", bothWays(function () { return spread([1, 2, 3]); }));
+assertEquals("Set[1,\"s\",#a]", bothWays(function () { return setConstructor(new Set([1, "s", keyA])); }));
+
+// ArrayIteratorPrototype.next patched before GetIterator is called by every consumer
+function patchedSequence() {
+    var count = 0;
+    ArrayIteratorPrototype.next = function () {
+        count++;
+        return { value: count <= 2 ? [{ id: count }, count] : undefined, done: count > 2 };
+    };
+}
+for (var i = 0; i < allConsumers.length; i++) {
+    patchedSequence();
+    var result;
+    try {
+        result = serialize(allConsumers[i]([]));
+    } finally {
+        restoreNexts();
+    }
+    var expected = {
+        spread: "[[#1,1],[#2,2]]",
+        destructure: "[[#1,1],[#2,2],[]]",
+        forOf: "[[#1,1],[#2,2]]",
+        arrayFrom: "[[#1,1],[#2,2]]",
+        arrayFromMapped: "[[0,[#1,1]],[1,[#2,2]]]",
+        typedArrayFrom: "[NaN,NaN]",
+        setConstructor: "Set[[#1,1],[#2,2]]",
+        mapConstructor: "Map[[#1,1],[#2,2]]",
+        weakMapConstructor: "[object WeakMap]",
+        weakSetConstructor: "[object WeakSet]"
+    };
+    assertEquals(expected[allConsumers[i].name], result, allConsumers[i].name);
+}
+
+// patched result object getters are observed too
+ArrayIteratorPrototype.next = function () {
+    var self = this;
+    return {
+        get done() { self.steps = (self.steps || 0) + 1; return self.steps > 2; },
+        get value() { return self.steps * 10; }
+    };
+};
+try {
+    assertEquals("[10,20]", serialize([...[7, 8, 9]]));
+} finally {
+    restoreNexts();
+}
+
+// next method is read once by GetIterator. patching it after that doesn't change running iteration
+function patchOnFirstRead(values) {
+    var source = values.slice();
+    Object.defineProperty(source, 0, {
+        get: function () {
+            ArrayIteratorPrototype.next = function () { throw new Error("patched next should not be called"); };
+            return values[0];
+        }
+    });
+    return source;
+}
+for (var i = 0; i < allConsumers.length; i++) {
+    var result;
+    try {
+        result = capture(function () { return allConsumers[i](patchOnFirstRead([[keyA, 1], [keyB, 2]])); });
+    } finally {
+        restoreNexts();
+    }
+    assert(result.indexOf("throws") !== 0, allConsumers[i].name + " called next patched after GetIterator");
+}
+
+// next iteration reads patched method
+var emptyResults = {
+    spread: "[]",
+    destructure: "[undefined,undefined,[]]",
+    forOf: "[]",
+    arrayFrom: "[]",
+    arrayFromMapped: "[]",
+    typedArrayFrom: "[]",
+    setConstructor: "Set[]",
+    mapConstructor: "Map[]",
+    weakMapConstructor: "[object WeakMap]",
+    weakSetConstructor: "[object WeakSet]"
+};
+for (var i = 0; i < allConsumers.length; i++) {
+    ArrayIteratorPrototype.next = function () { return { done: true }; };
+    try {
+        assertEquals(emptyResults[allConsumers[i].name], capture(function () { return allConsumers[i]([[keyA, 1]]); }), allConsumers[i].name);
+    } finally {
+        restoreNexts();
+    }
+}
+
+// own next property of iterator object is not used, and iterator with own next property set by user is not built-in
+var iteratorWithOwnNext = [1, 2][Symbol.iterator]();
+iteratorWithOwnNext.next = function () { return { done: true }; };
+var iterable = {};
+iterable[Symbol.iterator] = function () { return iteratorWithOwnNext; };
+assertEquals("[]", serialize([...iterable]));
+assertEquals("[]", serialize(Array.from(iterable)));
+var plainIterator = [5, 6][Symbol.iterator]();
+iterable[Symbol.iterator] = function () { return plainIterator; };
+assertEquals("[5,6]", serialize([...iterable]));
+assertEquals("[]", serialize([...iterable]));
+
+// ArrayIteratorPrototype itself is not an iterator of array
+iterable[Symbol.iterator] = function () { return ArrayIteratorPrototype; };
+assertThrows(TypeError, function () { return [...iterable]; });
+assertThrows(TypeError, function () { return Array.from(iterable); });
+
+// arrays which grow and shrink during iteration
+function growing() {
+    var source = [1, 2];
+    Object.defineProperty(source, 1, {
+        get: function () {
+            while (source.length < 5) {
+                source.push(source.length + 1);
+            }
+            return 2;
+        },
+        configurable: true
+    });
+    return source;
+}
+function shrinking() {
+    var source = [1, 2, 3, 4, 5];
+    Object.defineProperty(source, 1, {
+        get: function () {
+            source.length = 3;
+            return 2;
+        },
+        configurable: true
+    });
+    return source;
+}
+for (var i = 0; i < valueConsumers.length; i++) {
+    bothWays(function () { return valueConsumers[i](growing()); }, valueConsumers[i].name + " growing");
+    bothWays(function () { return valueConsumers[i](shrinking()); }, valueConsumers[i].name + " shrinking");
+}
+assertEquals("[1,2,3,4,5]", bothWays(function () { return spread(growing()); }));
+assertEquals("[1,2,3]", bothWays(function () { return spread(shrinking()); }));
+assertEquals("[[0,1],[1,2],[2,3],[3,4],[4,5]]", bothWays(function () { return arrayFromMapped(growing()); }));
+
+// callback of Array.from changes source array
+assertEquals("[1,2,3,4]", bothWays(function () {
+    var source = [1, 2];
+    return Array.from(source, function (v) {
+        if (source.length < 4) {
+            source.push(source.length + 1);
+        }
+        return v;
+    });
+}));
+assertEquals("[1,2]", bothWays(function () {
+    var source = [1, 2, 3, 4];
+    return Array.from(source, function (v) {
+        source.length = 2;
+        return v;
+    });
+}));
+// elements turned into holes and accessors during iteration
+assertEquals("[1,undefined,\"getter\"]", bothWays(function () {
+    var source = [1, 2, 3];
+    return Array.from(source, function (v, i) {
+        if (i === 0) {
+            delete source[1];
+            Object.defineProperty(source, 2, { get: function () { return "getter"; } });
+        }
+        return v;
+    });
+}));
+// array iterator over array-like object and proxy
+assertEquals("[\"a\",\"b\"]", bothWays(function () {
+    return spread(Array.prototype.values.call({ length: 2, 0: "a", 1: "b" }));
+}));
+assertEquals("[\"get length\",\"get 0\",\"get length\",\"get 1\",\"get length\"]", bothWays(function () {
+    var log = [];
+    var proxy = new Proxy([1, 2], {
+        get: function (target, key) {
+            if (typeof key === "string") {
+                log.push("get " + key);
+            }
+            return target[key];
+        }
+    });
+    spread(proxy);
+    return log;
+}));
+
+// Map and Set changed during iteration
+function setChangedByCallback(consumer) {
+    var set = new Set([1, 2, 3, 4]);
+    var first = true;
+    return consumer(set, function (v) {
+        if (first) {
+            first = false;
+            set.delete(2);
+            set.add(5);
+            set.delete(1);
+        }
+        return v;
+    });
+}
+assertEquals("[1,3,4,5]", bothWays(function () {
+    return setChangedByCallback(function (set, fn) { return Array.from(set, fn); });
+}));
+assertEquals("[1,3,4,5]", bothWays(function () {
+    return setChangedByCallback(function (set, fn) {
+        var r = [];
+        for (var v of set) {
+            r.push(fn(v));
+        }
+        return r;
+    });
+}));
+assertEquals("[[1,\"a\"],[3,\"c\"],[5,\"e\"]]", bothWays(function () {
+    var map = new Map([[1, "a"], [2, "b"], [3, "c"]]);
+    return Array.from(map, function (entry) {
+        if (entry[0] === 1) {
+            map.delete(2);
+            map.set(5, "e");
+        }
+        return entry;
+    });
+}));
+assertEquals("[]", bothWays(function () {
+    var map = new Map([[1, "a"], [2, "b"]]);
+    var iterator = map.keys();
+    map.clear();
+    return spread(iterator);
+}));
+
+// constructors of collections call patched adders, which change source collection
+var originalSetAdd = Set.prototype.add;
+var originalMapSet = Map.prototype.set;
+var originalWeakMapSet = WeakMap.prototype.set;
+var originalWeakSetAdd = WeakSet.prototype.add;
+function withAdders(source, fn) {
+    Set.prototype.add = function (v) {
+        source.delete(v === keyA ? keyB : 2);
+        return originalSetAdd.call(this, v);
+    };
+    Map.prototype.set = function (k, v) {
+        source.delete(k === keyA ? keyB : 2);
+        return originalMapSet.call(this, k, v);
+    };
+    WeakMap.prototype.set = function (k, v) {
+        source.delete(keyB);
+        return originalWeakMapSet.call(this, k, v);
+    };
+    WeakSet.prototype.add = function (v) {
+        source.delete(keyB);
+        return originalWeakSetAdd.call(this, v);
+    };
+    try {
+        return fn();
+    } finally {
+        Set.prototype.add = originalSetAdd;
+        Map.prototype.set = originalMapSet;
+        WeakMap.prototype.set = originalWeakMapSet;
+        WeakSet.prototype.add = originalWeakSetAdd;
+    }
+}
+assertEquals("Set[1,3]", bothWays(function () {
+    var source = new Set([1, 2, 3]);
+    return withAdders(source, function () { return new Set(source); });
+}));
+assertEquals("Map[[1,\"a\"],[3,\"c\"]]", bothWays(function () {
+    var source = new Map([[1, "a"], [2, "b"], [3, "c"]]);
+    return withAdders(source, function () { return new Map(source); });
+}));
+var weakResult = bothWays(function () {
+    var source = new Map([[keyA, 1], [keyB, 2]]);
+    var weakMap = withAdders(source, function () { return new WeakMap(source); });
+    return [weakMap.has(keyA), weakMap.has(keyB)];
+});
+assertEquals("[true,false]", weakResult);
+weakResult = bothWays(function () {
+    var source = new Set([keyA, keyB]);
+    var weakSet = withAdders(source, function () { return new WeakSet(source); });
+    return [weakSet.has(keyA), weakSet.has(keyB)];
+});
+assertEquals("[true,false]", weakResult);
+
+// invalid entries and throwing adders close source iterator in both ways
+assertEquals("throws TypeError", bothWays(function () { return new Map([1, 2]); }));
+assertEquals("throws TypeError", bothWays(function () { return new WeakSet([keyA, 1]); }));
+assertEquals("throws TypeError", bothWays(function () { return new WeakMap([[1, 2]]); }));
+
+// detached TypedArrays. buffers are detached by transferring them to worker
+var worker;
+try {
+    worker = new Worker("resources/message-port-transfer-worker.js");
+} catch (e) {
+    // built without threading support
+}
+if (worker) {
+    var detach = function (buffer) {
+        worker.postMessage({ type: "unknown", buffer: buffer }, [buffer]);
+    };
+    for (var i = 0; i < valueConsumers.length; i++) {
+        bothWays(function () {
+            var bytes = new Uint8Array([1, 2, 3]);
+            detach(bytes.buffer);
+            return valueConsumers[i](bytes);
+        }, valueConsumers[i].name + " of detached");
+    }
+    bothWays(function () {
+        var bytes = new Uint8Array([1, 2, 3]);
+        return Array.from(bytes, function (v) {
+            if (v === 1) {
+                detach(bytes.buffer);
+            }
+            return v;
+        });
+    }, "detached while iterating");
+    bothWays(function () {
+        var bytes = new Uint8Array([1, 2, 3]);
+        return Float64Array.from(bytes, function (v) {
+            if (v === 2) {
+                detach(bytes.buffer);
+            }
+            return v;
+        });
+    }, "detached while TypedArray.from");
+    worker.terminate();
+}
+
+// strings with surrogate pairs
+var surrogates = "a\uD83D\uDE00b\uD83D\uDE00\uD83Dc\uDE00";
+for (var i = 0; i < valueConsumers.length; i++) {
+    bothWays(function () { return valueConsumers[i](surrogates); }, valueConsumers[i].name + " of string");
+}
+assertEquals('["a","\\ud83d\\ude00","b","\\ud83d\\ude00","\\ud83d","c","\\ude00"]', bothWays(function () { return spread(surrogates); }));
+assertEquals('Set["\\ud83d\\ude00","x"]', bothWays(function () { return new Set("\uD83D\uDE00\uD83D\uDE00x"); }));
+assertEquals('["\\ud83d"]', bothWays(function () { return Array.from("\uD83D"); }));
+assertEquals('["\\ude00","\\ud83d"]', bothWays(function () { return spread("\uDE00\uD83D"); }));
+assertEquals("[]", bothWays(function () { return spread(""); }));
+var rope = "\uD83D";
+rope += "\uDE00";
+assertEquals(1, [...rope].length);
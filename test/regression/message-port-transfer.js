@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2020-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+
+
+// ArrayBuffers in transfer list move their backing stores to another VMInstance
+
+var worker;
+try {
+    worker = new Worker("resources/message-port-transfer-worker.js");
+} catch (e) {
+    // built without threading support
+}
+
+if (worker) {
+    // transfer to worker and back
+    var buffer = new ArrayBuffer(256);
+    var bytes = new Uint8Array(buffer);
+    var expectedSum = 0;
+    for (var i = 0; i < bytes.length; i++) {
+        bytes[i] = i;
+        expectedSum += i;
+    }
+    worker.postMessage({ type: "echo", buffer: buffer }, [buffer]);
+    assertEquals(0, buffer.byteLength, "transferred buffer should be detached");
+    assertEquals(0, bytes.length, "view of transferred buffer should be empty");
+
+    var reply = worker.receiveMessage();
+    assertEquals(expectedSum, reply.sum);
+    assertEquals(256, reply.buffer.byteLength);
+    var replyBytes = new Uint8Array(reply.buffer);
+    for (var i = 0; i < replyBytes.length; i++) {
+        assertEquals(255 - i, replyBytes[i], "byte written by worker at " + i);
+    }
+
+    // invalid transfer list throws before anything is detached
+    var kept = new ArrayBuffer(8);
+    assertThrows(TypeError, function() {
+        worker.postMessage({ buffer: kept }, [kept, kept]);
+    });
+    assertThrows(TypeError, function() {
+        worker.postMessage({ buffer: kept }, [kept, {}]);
+    });
+    assertThrows(TypeError, function() {
+        worker.postMessage({ f: function() {} }, [kept]);
+    });
+    assertEquals(8, kept.byteLength, "buffer should stay attached when postMessage throws");
+
+    // received buffer is owned by this VMInstance. dropping it frees the store through the platform of its allocator
+    reply = replyBytes = null;
+    gc();
+
+    // drop port while worker keeps posting messages with transferred buffers
+    worker.postMessage({ type: "flood", count: 16, byteLength: 65536 });
+    var first = worker.receiveMessage();
+    assertEquals(0, first.index);
+    assertEquals(65536, first.buffer.byteLength);
+    assertEquals(0, new Uint8Array(first.buffer)[0]);
+    worker.terminate();
+    gc();
+
+    assertThrows(TypeError, function() {
+        worker.postMessage("after terminate");
+    });
+
+    // terminate right after posting. worker still receives the store and drops it
+    var idleWorker = new Worker("resources/message-port-transfer-worker.js");
+    var unread = new ArrayBuffer(1024);
+    idleWorker.postMessage({ type: "unknown", buffer: unread }, [unread]);
+    idleWorker.terminate();
+    gc();
+}
@@ -0,0 +1,46 @@
+// flags: --module
+/*
+ * Copyright (c) 2020-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+// module graph with shared dependency (diamond) and cycle
+// every module is loaded and evaluated once, and dependencies are evaluated before dependents
+
+import { base as leftBase, left } from "./resources/module-graph-left.js";
+import { base as rightBase, right } from "./resources/module-graph-right.js";
+import { cycleA, valueOfB } from "./resources/module-graph-cycle-a.js";
+import { log } from "./resources/module-graph-base.js";
+
+// diamond: base is shared by left and right
+assertEquals(leftBase, rightBase);
+assertEquals("left", left);
+assertEquals("right", right);
+assertEquals(1, leftBase.evaluationCount);
+
+// cycle: cycle-a imports cycle-b and cycle-b imports cycle-a
+// cycle-b is evaluated first because cycle-a is still on the stack when cycle-b is visited
+assertEquals("a", cycleA());
+assertEquals("b", valueOfB());
+
+assertArrayEquals(["base", "left", "right", "cycle-b", "cycle-a"], log);
+
+var global = Function("return this")();
+// hoisted function of cycle-a is usable while cycle-b is evaluated
+assertEquals("a", global.moduleGraphFunctionCallInB);
+// let binding of cycle-a is not initialized while cycle-b is evaluated
+assertEquals("ReferenceError", global.moduleGraphBindingAccessInB);
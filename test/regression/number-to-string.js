@@ -0,0 +1,345 @@
+/*
+ * Copyright (c) 2020-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+
+// Number to string conversion (shortest digits), toFixed, toPrecision, toExponential and the dtoa cache
+// results of toFixed/toPrecision/toExponential are checked against exact decimal expansion of double
+
+function isNegativeZero(x) {
+    return x === 0 && 1 / x < 0;
+}
+
+// shortest round-trip representation of special values
+var shortest = [
+    [5e-324, "5e-324"], [-5e-324, "-5e-324"], [1e-323, "1e-323"], [1.5e-323, "1.5e-323"],
+    [2.225073858507201e-308, "2.225073858507201e-308"], [2.2250738585072014e-308, "2.2250738585072014e-308"],
+    [1.7976931348623157e308, "1.7976931348623157e+308"],
+    [1e-7, "1e-7"], [1.5e-7, "1.5e-7"], [5e-7, "5e-7"], [1e-6, "0.000001"], [1e-5, "0.00001"],
+    [1e20, "100000000000000000000"], [1e21, "1e+21"], [1.2345e21, "1.2345e+21"], [1e22, "1e+22"], [1e23, "1e+23"],
+    [123456789012345680000, "123456789012345680000"],
+    [0.1, "0.1"], [0.2, "0.2"], [0.30000000000000004, "0.30000000000000004"], [1 / 3, "0.3333333333333333"],
+    [2 / 3, "0.6666666666666666"], [1.0000000000000002, "1.0000000000000002"], [123.456, "123.456"], [4.35, "4.35"],
+    [9007199254740991, "9007199254740991"], [9007199254740992, "9007199254740992"], [9007199254740993, "9007199254740992"],
+    [9007199254740994, "9007199254740994"], [-9007199254740991, "-9007199254740991"],
+    [9223372036854775808, "9223372036854776000"], [18446744073709551616, "18446744073709552000"],
+    [-0, "0"], [0, "0"], [NaN, "NaN"], [Infinity, "Infinity"], [-Infinity, "-Infinity"]
+];
+for (var i = 0; i < shortest.length; i++) {
+    assertEquals(shortest[i][1], String(shortest[i][0]));
+    assertEquals(shortest[i][1], shortest[i][0].toString());
+}
+
+// every power of ten round-trips and switches to exponential form at 1e21 and 1e-7
+for (var e = -323; e <= 308; e++) {
+    var p = Number("1e" + e);
+    var s = String(p);
+    assertEquals(p, Number(s), "1e" + e);
+    if (e >= 21 || e <= -7) {
+        assertEquals("1e" + (e > 0 ? "+" : "") + e, s);
+    } else if (e >= 0) {
+        assertEquals("1" + "0".repeat(e), s);
+    } else {
+        assertEquals("0." + "0".repeat(-e - 1) + "1", s);
+    }
+}
+
+// exact decimal expansion of positive finite double
+// returns { digits, scale } where value is digits * 10^-scale
+var view = new DataView(new ArrayBuffer(8));
+var lastExactDecimal = { x: NaN };
+function exactDecimal(x) {
+    if (lastExactDecimal.x === x) {
+        return lastExactDecimal;
+    }
+    view.setFloat64(0, x);
+    var hi = view.getUint32(0);
+    var lo = view.getUint32(4);
+    var exponent = (hi >>> 20) & 0x7FF;
+    var mantissa = (hi & 0xFFFFF) * 4294967296 + lo;
+    if (exponent) {
+        mantissa += 4503599627370496;
+        exponent -= 1075;
+    } else {
+        exponent = -1074;
+    }
+
+    // little endian limbs of base 1e7
+    var limbs = [];
+    while (mantissa > 0) {
+        limbs.push(mantissa % 10000000);
+        mantissa = Math.floor(mantissa / 10000000);
+    }
+    function multiply(factor) {
+        var carry = 0;
+        for (var i = 0; i < limbs.length; i++) {
+            var v = limbs[i] * factor + carry;
+            limbs[i] = v % 10000000;
+            carry = Math.floor(v / 10000000);
+        }
+        while (carry > 0) {
+            limbs.push(carry % 10000000);
+            carry = Math.floor(carry / 10000000);
+        }
+    }
+
+    // m * 2^e for e >= 0, and m * 5^-e / 10^-e for e < 0
+    var scale = 0;
+    var power = exponent;
+    var step = exponent >= 0 ? 2 : 5;
+    var bigStep = exponent >= 0 ? 1048576 : 9765625;
+    var bigCount = exponent >= 0 ? 20 : 10;
+    if (exponent < 0) {
+        scale = -exponent;
+        power = -exponent;
+    }
+    for (; power >= bigCount; power -= bigCount) {
+        multiply(bigStep);
+    }
+    for (; power > 0; power--) {
+        multiply(step);
+    }
+
+    var digits = String(limbs[limbs.length - 1]);
+    for (var i = limbs.length - 2; i >= 0; i--) {
+        var limb = String(limbs[i]);
+        digits += "0000000".substring(limb.length) + limb;
+    }
+    lastExactDecimal = { x: x, digits: digits, scale: scale };
+    return lastExactDecimal;
+}
+
+// adds one to decimal digit string
+function increment(digits) {
+    var i = digits.length - 1;
+    while (i >= 0 && digits[i] === "9") {
+        i--;
+    }
+    if (i < 0) {
+        return "1" + "0".repeat(digits.length);
+    }
+    return digits.substring(0, i) + String.fromCharCode(digits.charCodeAt(i) + 1) + "0".repeat(digits.length - i - 1);
+}
+
+// first `count` digits of `digits` rounded half up
+function roundDigits(digits, count) {
+    if (digits.length <= count) {
+        return digits + "0".repeat(count - digits.length);
+    }
+    var head = digits.substring(0, count);
+    return digits[count] >= "5" ? increment(head) : head;
+}
+
+function referenceToFixed(x, fractionDigits) {
+    if (x < 0) {
+        // sign is kept even if digits round to zero, e.g. (-0.4).toFixed(0) is "-0"
+        return "-" + referenceToFixed(-x, fractionDigits);
+    }
+    var n;
+    if (x === 0) {
+        n = "0";
+    } else {
+        var d = exactDecimal(x);
+        // n = round(digits * 10^(fractionDigits - scale))
+        var keep = d.digits.length - d.scale + fractionDigits;
+        if (keep < 0) {
+            n = "0";
+        } else {
+            n = keep === 0 ? (d.digits[0] >= "5" ? "1" : "0") : roundDigits(d.digits, keep);
+        }
+        n = n.replace(/^0+(?=.)/, "");
+    }
+    if (fractionDigits === 0) {
+        return n;
+    }
+    if (n.length <= fractionDigits) {
+        n = "0".repeat(fractionDigits - n.length + 1) + n;
+    }
+    return n.substring(0, n.length - fractionDigits) + "." + n.substring(n.length - fractionDigits);
+}
+
+// returns significand digits of length `precision` and decimal exponent
+function roundToPrecision(x, precision) {
+    if (x === 0) {
+        return { n: "0".repeat(precision), e: 0 };
+    }
+    var d = exactDecimal(x);
+    var e = d.digits.length - 1 - d.scale;
+    var n = roundDigits(d.digits, precision);
+    if (n.length > precision) {
+        n = n.substring(0, precision);
+        e++;
+    }
+    return { n: n, e: e };
+}
+
+function exponentialForm(n, e) {
+    return n[0] + (n.length > 1 ? "." + n.substring(1) : "") + "e" + (e < 0 ? "-" : "+") + Math.abs(e);
+}
+
+function referenceToPrecision(x, precision) {
+    if (x < 0) {
+        return "-" + referenceToPrecision(-x, precision);
+    }
+    var r = roundToPrecision(x, precision);
+    var n = r.n, e = r.e;
+    if (e < -6 || e >= precision) {
+        return exponentialForm(n, e);
+    }
+    if (e === precision - 1) {
+        return n;
+    }
+    if (e >= 0) {
+        return n.substring(0, e + 1) + "." + n.substring(e + 1);
+    }
+    return "0." + "0".repeat(-(e + 1)) + n;
+}
+
+function referenceToExponential(x, fractionDigits) {
+    if (x < 0) {
+        return "-" + referenceToExponential(-x, fractionDigits);
+    }
+    var r = roundToPrecision(x, fractionDigits + 1);
+    return exponentialForm(r.n, r.e);
+}
+
+function checkFormats(x) {
+    if (Math.abs(x) < 1e21) {
+        for (var f = 0; f <= 20; f++) {
+            assertEquals(referenceToFixed(x, f), x.toFixed(f), x + ".toFixed(" + f + ")");
+        }
+    }
+    for (var p = 1; p <= 21; p++) {
+        assertEquals(referenceToPrecision(x, p), x.toPrecision(p), x + ".toPrecision(" + p + ")");
+    }
+    for (var f = 0; f <= 20; f++) {
+        assertEquals(referenceToExponential(x, f), x.toExponential(f), x + ".toExponential(" + f + ")");
+    }
+}
+
+// boundaries and ties. the exact value decides, not the shortest digits
+var fixed = [
+    [1.005, 2, "1.00"], [1.45, 1, "1.4"], [0.5, 0, "1"], [1.5, 0, "2"], [2.5, 0, "3"], [-2.5, 0, "-3"],
+    [-0, 2, "0.00"], [1e21, 2, "1e+21"], [999999999999999900000, 2, "999999999999999868928.00"],
+    [123.456, 10, "123.4560000000"], [0.000001, 7, "0.0000010"], [1.255, 2, "1.25"], [8.345, 2, "8.35"],
+    [0.1, 20, "0.10000000000000000555"], [1.23e-10, 20, "0.00000000012300000000"], [4.35, 1, "4.3"],
+    [1e-7, 5, "0.00000"], [-1.5e-7, 7, "-0.0000001"], [12345.6789, 0, "12346"]
+];
+for (var i = 0; i < fixed.length; i++) {
+    assertEquals(fixed[i][2], fixed[i][0].toFixed(fixed[i][1]), fixed[i][0] + ".toFixed(" + fixed[i][1] + ")");
+}
+
+var precision = [
+    [123.456, 1, "1e+2"], [123.456, 2, "1.2e+2"], [123.456, 3, "123"], [123.456, 4, "123.5"],
+    [123.456, 21, "123.456000000000003070"], [0.000123, 2, "0.00012"], [1e21, 1, "1e+21"],
+    [1e21, 21, "1.00000000000000000000e+21"], [1e-7, 1, "1e-7"], [9.5, 1, "1e+1"], [99.5, 2, "1.0e+2"], [-0, 3, "0.00"],
+    [1.25, 2, "1.3"], [1.35, 2, "1.4"], [5e-324, 3, "4.94e-324"], [1.7976931348623157e308, 5, "1.7977e+308"],
+    [9007199254740993, 17, "9007199254740992.0"], [0.00001, 1, "0.00001"], [0.000001, 2, "0.0000010"],
+    [1e-7, 3, "1.00e-7"], [123456, 5, "1.2346e+5"]
+];
+for (var i = 0; i < precision.length; i++) {
+    assertEquals(precision[i][2], precision[i][0].toPrecision(precision[i][1]), precision[i][0] + ".toPrecision(" + precision[i][1] + ")");
+}
+
+var exponential = [
+    [123.456, 0, "1e+2"], [123.456, 2, "1.23e+2"], [123.456, 20, "1.23456000000000003070e+2"], [0.00015, 1, "1.5e-4"],
+    [1.25, 1, "1.3e+0"], [1.35, 1, "1.4e+0"], [-0, 2, "0.00e+0"], [5e-324, 2, "4.94e-324"],
+    [1.7976931348623157e308, 20, "1.79769313486231570815e+308"], [9.5, 0, "1e+1"], [1e21, 3, "1.000e+21"]
+];
+for (var i = 0; i < exponential.length; i++) {
+    assertEquals(exponential[i][2], exponential[i][0].toExponential(exponential[i][1]), exponential[i][0] + ".toExponential(" + exponential[i][1] + ")");
+}
+assertEquals("1.2345e+4", (12345).toExponential());
+assertEquals("1e-1", (0.1).toExponential());
+
+// values from the table above against reference too
+for (var i = 0; i < shortest.length; i++) {
+    if (isFinite(shortest[i][0])) {
+        checkFormats(shortest[i][0]);
+    }
+}
+
+// decimal fractions are where shortest digits fast paths of toFixed/toPrecision apply
+for (var i = -2000; i <= 2000; i += 37) {
+    checkFormats(i / 100);
+    checkFormats(i / 1000 + 0.0005);
+}
+
+// pseudo random doubles over whole exponent range
+var seed = 0x2545F491;
+function nextRandom() {
+    seed ^= seed << 13;
+    seed ^= seed >>> 17;
+    seed ^= seed << 5;
+    return seed >>> 0;
+}
+
+for (var i = 0; i < 3000; i++) {
+    view.setUint32(0, nextRandom());
+    view.setUint32(4, nextRandom());
+    var x = view.getFloat64(0);
+    if (!isFinite(x)) {
+        continue;
+    }
+    var s = String(x);
+    assert(Object.is(Number(s), x) || (isNegativeZero(x) && s === "0"), "round trip of " + s);
+
+    // no shorter digits round-trip, except at power of two boundaries where lower gap is narrower
+    var significand = s.replace(/^-/, "").replace(/e.*$/, "").replace(".", "").replace(/^0+/, "").replace(/0+$/, "");
+    view.setFloat64(0, x);
+    var isPowerOfTwo = (view.getUint32(0) & 0xFFFFF) === 0 && view.getUint32(4) === 0;
+    if (significand.length > 1 && !isPowerOfTwo) {
+        assert(Number(x.toPrecision(significand.length - 1)) !== x, s + " is not shortest");
+    }
+
+    if (i % 30 === 0) {
+        checkFormats(x);
+    }
+}
+
+// subnormals near the smallest values and near normal boundary
+for (var i = 1; i < 64; i++) {
+    var sub = 5e-324 * i;
+    assertEquals(sub, Number(String(sub)));
+    var nearNormal = 2.2250738585072014e-308 - 5e-324 * i;
+    assertEquals(nearNormal, Number(String(nearNormal)));
+}
+
+// dtoa cache keeps per VM table of recently converted doubles.
+// more values than table entries, converted repeatedly in different orders, never give stale result
+var values = [];
+var expected = [];
+for (var i = 0; i < 2048; i++) {
+    values.push(i + 0.5);
+    expected.push(referenceToFixed(i + 0.5, 1));
+    values.push(-i / 8 - 0.125);
+    expected.push("-" + referenceToFixed(i / 8 + 0.125, 3).replace(/0+$/, "").replace(/\.$/, ""));
+}
+for (var round = 0; round < 3; round++) {
+    for (var i = 0; i < values.length; i++) {
+        var index = round === 1 ? values.length - 1 - i : (i * 97) % values.length;
+        assertEquals(expected[index], String(values[index]), "cached " + expected[index]);
+    }
+}
+// -0 and 0 share result, and NaN never matches a cached entry
+for (var i = 0; i < 4; i++) {
+    assertEquals("0", String(-0));
+    assertEquals("0", String(0));
+    assertEquals("NaN", String(NaN));
+    assertEquals("0.25", String(0.25));
+}
@@ -0,0 +1,281 @@
+/*
+ * Copyright (c) 2020-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+
+
+// Object.keys/values/entries/assign, object rest and spread into empty literal read ordinary objects from ObjectStructure directly
+// a Proxy without traps behaves like its target but always takes the generic path,
+// so every result is compared with the result for a Proxy of the same object
+
+function describeOwn(object) {
+    return Reflect.ownKeys(object).map(function(key) {
+        var desc = Object.getOwnPropertyDescriptor(object, key);
+        return [String(key), "value" in desc ? desc.value : "accessor", desc.writable, desc.enumerable, desc.configurable];
+    });
+}
+
+function assertSameOwn(expected, actual, message) {
+    assertArrayEquals(describeOwn(expected), describeOwn(actual), message);
+}
+
+var symbol = Symbol("s");
+var hiddenSymbol = Symbol("hidden");
+
+// each maker returns a fresh object, because getters of some objects modify them
+var makers = {
+    plain: function() {
+        return { b: 1, a: 2, c: 3 };
+    },
+    indexMixed: function() {
+        return { b: 1, 2: "two", a: 3, 0: "zero", "10": "ten" };
+    },
+    indexAddedLater: function() {
+        var o = { b: 1, a: 2 };
+        o[1] = "one";
+        o.c = 3;
+        return o;
+    },
+    nonEnumerable: function() {
+        var o = { a: 1, b: 2 };
+        Object.defineProperty(o, "hidden", { value: 3, enumerable: false, writable: true, configurable: true });
+        o.c = 4;
+        return o;
+    },
+    readOnly: function() {
+        var o = { a: 1 };
+        Object.defineProperty(o, "fixed", { value: 2, enumerable: true, writable: false, configurable: true });
+        return o;
+    },
+    symbols: function() {
+        var o = { a: 1 };
+        o[symbol] = "symbol";
+        Object.defineProperty(o, hiddenSymbol, { value: "hidden", enumerable: false });
+        o.b = 2;
+        return o;
+    },
+    deleted: function() {
+        var o = { a: 1, b: 2, c: 3 };
+        delete o.b;
+        o.d = 4;
+        return o;
+    },
+    getterDeletesLater: function() {
+        return {
+            a: 1,
+            get b() {
+                delete this.c;
+                return 2;
+            },
+            c: 3,
+            d: 4
+        };
+    },
+    getterAddsProperty: function() {
+        return {
+            a: 1,
+            get b() {
+                this.added = "added";
+                return 2;
+            },
+            c: 3
+        };
+    },
+    getterHidesLater: function() {
+        return {
+            get a() {
+                Object.defineProperty(this, "b", { enumerable: false });
+                return 1;
+            },
+            b: 2,
+            c: 3
+        };
+    },
+    ownProto: function() {
+        var o = { a: 1 };
+        Object.defineProperty(o, "__proto__", { value: "own", enumerable: true, writable: true, configurable: true });
+        o.b = 2;
+        return o;
+    },
+    empty: function() {
+        return {};
+    }
+};
+
+Object.keys(makers).forEach(function(name) {
+    // Object.keys, values and entries
+    assertArrayEquals(Object.keys(new Proxy(makers[name](), {})), Object.keys(makers[name]()), name + " keys");
+    assertArrayEquals(Object.values(new Proxy(makers[name](), {})), Object.values(makers[name]()), name + " values");
+    assertArrayEquals(Object.entries(new Proxy(makers[name](), {})), Object.entries(makers[name]()), name + " entries");
+
+    // Object.assign to an empty object
+    var sourceForFast = makers[name]();
+    var sourceForSlow = makers[name]();
+    var fast = Object.assign({}, sourceForFast);
+    var slow = Object.assign({}, new Proxy(sourceForSlow, {}));
+    assertSameOwn(slow, fast, name + " assign result");
+    assertSameOwn(sourceForSlow, sourceForFast, name + " assign source after getters");
+
+    // result of assign doesn't share properties with source
+    fast.a = "changed";
+    fast.newProperty = true;
+    assertEquals(undefined, sourceForFast.newProperty, name + " assign result is separated from source");
+    if (Object.getOwnPropertyDescriptor(sourceForFast, "a") && "value" in Object.getOwnPropertyDescriptor(sourceForFast, "a")) {
+        assert(sourceForFast.a !== "changed", name + " source value changed by result");
+    }
+
+    // object rest without and with destructured keys
+    var restSourceFast = makers[name]();
+    var restSourceSlow = makers[name]();
+    var restFast, restSlow;
+    ({ ...restFast } = restSourceFast);
+    ({ ...restSlow } = new Proxy(restSourceSlow, {}));
+    assertSameOwn(restSlow, restFast, name + " rest");
+
+    var aFast, aSlow;
+    restSourceFast = makers[name]();
+    restSourceSlow = makers[name]();
+    ({ a: aFast, 0: restFast.zero, ...restFast } = restSourceFast);
+    ({ a: aSlow, 0: restSlow.zero, ...restSlow } = new Proxy(restSourceSlow, {}));
+    assertEquals(aSlow, aFast, name + " destructured key");
+    assertSameOwn(restSlow, restFast, name + " rest after destructured keys");
+    assertSameOwn(restSourceSlow, restSourceFast, name + " rest source after getters");
+
+    // object spread into empty literal, with and without later properties
+    var spreadSourceFast = makers[name]();
+    var spreadSourceSlow = makers[name]();
+    var spreadFast = { ...spreadSourceFast };
+    var spreadSlow = { ...new Proxy(spreadSourceSlow, {}) };
+    assertSameOwn(spreadSlow, spreadFast, name + " spread");
+    assertSameOwn(spreadSourceSlow, spreadSourceFast, name + " spread source after getters");
+    assertEquals(Object.prototype, Object.getPrototypeOf(spreadFast), name + " spread prototype");
+
+    spreadFast.a = "changed";
+    spreadFast.newProperty = true;
+    assertEquals(undefined, spreadSourceFast.newProperty, name + " spread result is separated from source");
+
+    spreadFast = { ...makers[name](), a: "after", z: 26 };
+    spreadSlow = { ...new Proxy(makers[name](), {}), a: "after", z: 26 };
+    assertSameOwn(spreadSlow, spreadFast, name + " spread with later properties");
+
+    spreadFast = { first: 0, ...makers[name]() };
+    spreadSlow = { first: 0, ...new Proxy(makers[name](), {}) };
+    assertSameOwn(spreadSlow, spreadFast, name + " spread after property");
+});
+
+// spread of non-objects and spread defines properties instead of calling setters
+assertArrayEquals([], Reflect.ownKeys({ ...null }));
+assertArrayEquals([], Reflect.ownKeys({ ...undefined }));
+assertArrayEquals([], Reflect.ownKeys({ ...1 }));
+assertArrayEquals([["0", "a"], ["1", "b"]], Object.entries({ ..."ab" }));
+var spreadWithSetterProto = Object.create({ a: 1 });
+spreadWithSetterProto.b = 2;
+assertArrayEquals(["b"], Object.keys({ ...spreadWithSetterProto }));
+var setterCalled = false;
+Object.defineProperty(Object.prototype, "spreadSetter", {
+    set: function(v) {
+        setterCalled = true;
+    },
+    configurable: true
+});
+var spreadDefined = { ...{ spreadSetter: 1 } };
+delete Object.prototype.spreadSetter;
+assertEquals(false, setterCalled);
+assertEquals(1, spreadDefined.spreadSetter);
+
+// two literals spread from one source don't share later changes
+var spreadShape = { x: 1, y: 2 };
+var spread1 = { ...spreadShape };
+var spread2 = { ...spreadShape };
+spread1.z = 3;
+delete spread2.x;
+assertArrayEquals(["x", "y", "z"], Object.keys(spread1));
+assertArrayEquals(["y"], Object.keys(spread2));
+assertArrayEquals(["x", "y"], Object.keys(spreadShape));
+
+// several sources and getters which modify the target while assigning
+var target = {};
+var log = [];
+Object.assign(target, { a: 1, b: 2 }, {
+    get c() {
+        log.push("c");
+        target.a = "overwritten by getter";
+        delete target.b;
+        return 3;
+    },
+    d: 4
+}, null, undefined, { a: "last" });
+assertArrayEquals(["c"], log);
+assertArrayEquals([["a", "last"], ["c", 3], ["d", 4]], Object.entries(target));
+
+// setter and read-only property of prototype are reached through Set
+var setterLog = [];
+var protoWithSetter = {
+    set b(v) {
+        setterLog.push(v);
+    }
+};
+var assigned = Object.assign(Object.create(protoWithSetter), { a: 1, b: 2, c: 3 });
+assertArrayEquals([2], setterLog);
+assertArrayEquals(["a", "c"], Object.keys(assigned));
+
+var protoReadOnly = Object.defineProperty({}, "b", { value: "proto", writable: false });
+assertThrows(TypeError, function() {
+    Object.assign(Object.create(protoReadOnly), { a: 1, b: 2 });
+});
+
+// object used as prototype keeps working after assign
+var proto = Object.assign({}, { inherited: 1 });
+var child = Object.create(proto);
+Object.assign(proto, { late: 2 });
+assertEquals(1, child.inherited);
+assertEquals(2, child.late);
+
+// non-extensible or non-empty target takes generic path
+var frozen = Object.preventExtensions({});
+assertThrows(TypeError, function() {
+    Object.assign(frozen, { a: 1 });
+});
+var nonEmpty = Object.assign({ z: 0 }, { a: 1 });
+assertArrayEquals(["z", "a"], Object.keys(nonEmpty));
+
+// two objects assigned from one source don't share later changes
+var shapeSource = { x: 1, y: 2 };
+var copy1 = Object.assign({}, shapeSource);
+var copy2 = Object.assign({}, shapeSource);
+copy1.z = 3;
+delete copy2.x;
+assertArrayEquals(["x", "y", "z"], Object.keys(copy1));
+assertArrayEquals(["y"], Object.keys(copy2));
+assertArrayEquals(["x", "y"], Object.keys(shapeSource));
+
+// key list of a shape is cached. cached list should not be changed through results
+var sameShape1 = { p: 1, q: 2 };
+var keys1 = Object.keys(sameShape1);
+keys1.push("bogus");
+keys1[0] = "changed";
+var sameShape2 = { p: 3, q: 4 };
+assertArrayEquals(["p", "q"], Object.keys(sameShape2));
+sameShape2.r = 5;
+assertArrayEquals(["p", "q", "r"], Object.keys(sameShape2));
+assertArrayEquals(["p", "q"], Object.keys(sameShape1));
+Object.defineProperty(sameShape1, "q", { enumerable: false });
+assertArrayEquals(["p"], Object.keys(sameShape1));
+assertArrayEquals(["p", "q", "r"], Object.keys(sameShape2));
+gc();
+assertArrayEquals(["p", "q", "r"], Object.keys(sameShape2));
@@ -0,0 +1,239 @@
+/*
+ * Copyright (c) 2020-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+
+
+// await resumes async functions through promise reaction jobs
+// job order should follow the spec, compared with .then chains started at the same time
+
+function thenChain(log, name, length) {
+    var p = Promise.resolve();
+    for (var i = 1; i <= length; i++) {
+        p = p.then(function(step) {
+            log.push(name + step);
+        }.bind(null, i));
+    }
+    return p;
+}
+
+// await of a value or a native promise takes one job
+(function() {
+    var log = [];
+    async function f() {
+        log.push("f start");
+        await undefined;
+        log.push("f 1");
+        await Promise.resolve();
+        log.push("f 2");
+        await 42;
+        log.push("f 3");
+    }
+    f().then(function() {
+        log.push("f done");
+    });
+    thenChain(log, "then", 4);
+    log.push("sync");
+    runJobs();
+    assertArrayEquals(["f start", "sync", "f 1", "then1", "f 2", "then2", "f 3", "then3", "f done", "then4"], log);
+})();
+
+// await of a pending promise resumes right after the promise is resolved
+(function() {
+    var log = [];
+    var resolve;
+    var pending = new Promise(function(r) {
+        resolve = r;
+    });
+    async function waiter(name) {
+        var value = await pending;
+        log.push(name + " " + value);
+    }
+    waiter("a");
+    pending.then(function(value) {
+        log.push("then " + value);
+    });
+    waiter("b");
+    runJobs();
+    assertArrayEquals([], log);
+    resolve("value");
+    runJobs();
+    assertArrayEquals(["a value", "then value", "b value"], log);
+})();
+
+// rejected await throws into the async function
+(function() {
+    var log = [];
+    async function f() {
+        try {
+            await Promise.reject(new Error("rejected"));
+            log.push("not reached");
+        } catch (e) {
+            log.push("caught " + e.message);
+        }
+        try {
+            await {
+                then: function(resolve, reject) {
+                    reject("thenable rejected");
+                }
+            };
+        } catch (e) {
+            log.push("caught " + e);
+        }
+        throw "thrown";
+    }
+    f().catch(function(e) {
+        log.push("f rejected " + e);
+    });
+    thenChain(log, "then", 6);
+    runJobs();
+    assertArrayEquals(["caught rejected", "then1", "then2", "caught thenable rejected", "then3", "f rejected thrown", "then4", "then5", "then6"], log);
+})();
+
+// thenable takes a job to call then and another job to resume
+(function() {
+    var log = [];
+    var thenGetCount = 0;
+    var thenable = {
+        get then() {
+            thenGetCount++;
+            return function(resolve) {
+                log.push("thenable then");
+                resolve("from thenable");
+                resolve("ignored");
+            };
+        }
+    };
+    async function f() {
+        var value = await thenable;
+        log.push("f " + value);
+    }
+    f();
+    thenChain(log, "then", 3);
+    runJobs();
+    assertEquals(1, thenGetCount);
+    assertArrayEquals(["thenable then", "then1", "f from thenable", "then2", "then3"], log);
+})();
+
+// thenable whose then throws after resolve keeps resolved value
+(function() {
+    var log = [];
+    async function f() {
+        var value = await {
+            then: function(resolve) {
+                resolve("first");
+                throw new Error("ignored");
+            }
+        };
+        log.push(value);
+        try {
+            await {
+                then: function() {
+                    throw new Error("then threw");
+                }
+            };
+        } catch (e) {
+            log.push(e.message);
+        }
+    }
+    f();
+    runJobs();
+    assertArrayEquals(["first", "then threw"], log);
+})();
+
+// await uses native promise directly without looking up its then
+// promise with other constructor is resolved like a thenable
+(function() {
+    var log = [];
+    var patched = Promise.resolve("patched");
+    patched.then = function(onFulfilled, onRejected) {
+        log.push("patched then");
+        return Promise.prototype.then.call(this, onFulfilled, onRejected);
+    };
+    var foreign = Promise.resolve("foreign");
+    foreign.constructor = function() {};
+    foreign.then = patched.then;
+    async function f() {
+        log.push("f " + await patched);
+        log.push("f " + await foreign);
+    }
+    f();
+    thenChain(log, "then", 5);
+    runJobs();
+    assertArrayEquals(["f patched", "then1", "patched then", "then2", "then3", "f foreign", "then4", "then5"], log);
+})();
+
+// many chains at once make the job queue grow and wrap around
+(function() {
+    var log = [];
+    var chainCount = 20;
+    var depth = 30;
+    async function chain(id) {
+        for (var i = 0; i < depth; i++) {
+            log.push(id + ":" + i);
+            await null;
+        }
+    }
+    for (var id = 0; id < chainCount; id++) {
+        chain(id);
+    }
+    runJobs();
+    assertEquals(chainCount * depth, log.length);
+    for (var i = 0; i < depth; i++) {
+        for (var id = 0; id < chainCount; id++) {
+            assertEquals(id + ":" + i, log[i * chainCount + id]);
+        }
+    }
+})();
+
+// queue grows while its head is in the middle of the ring buffer
+(function() {
+    var log = [];
+    async function ticker(name, count) {
+        for (var i = 0; i < count; i++) {
+            await undefined;
+            log.push(name + i);
+        }
+    }
+    // 10 jobs per tick moves head of queue around the initial capacity
+    for (var i = 0; i < 10; i++) {
+        ticker("t" + i + "-", 8);
+    }
+    Promise.resolve().then(function() {}).then(function() {}).then(function() {
+        // 50 jobs are enqueued at once while other jobs are queued
+        for (var j = 0; j < 50; j++) {
+            Promise.resolve(j).then(function(value) {
+                log.push("burst" + value);
+            });
+        }
+    });
+    runJobs();
+    // burst jobs run after tickers queued before them and keep their order
+    var expected = [];
+    for (var step = 0; step < 8; step++) {
+        if (step == 4) {
+            for (var j = 0; j < 50; j++) {
+                expected.push("burst" + j);
+            }
+        }
+        for (var i = 0; i < 10; i++) {
+            expected.push("t" + i + "-" + step);
+        }
+    }
+    assertArrayEquals(expected, log);
+})();
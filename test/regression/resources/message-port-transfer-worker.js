@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2020-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+
+
+// worker of message-port-transfer.js
+
+onmessage = function(message) {
+    if (message.type === "echo") {
+        // check contents and send same backing store back
+        var bytes = new Uint8Array(message.buffer);
+        var sum = 0;
+        for (var i = 0; i < bytes.length; i++) {
+            sum += bytes[i];
+            bytes[i] = 255 - bytes[i];
+        }
+        postMessage({ buffer: message.buffer, sum: sum }, [message.buffer]);
+        if (message.buffer.byteLength !== 0) {
+            throw new Error("transferred buffer should be detached in worker");
+        }
+    } else if (message.type === "flood") {
+        // creator receives only first message and drops the others with its port
+        for (var i = 0; i < message.count; i++) {
+            var buffer = new ArrayBuffer(message.byteLength);
+            new Uint8Array(buffer)[0] = i;
+            postMessage({ index: i, buffer: buffer }, [buffer]);
+        }
+        gc();
+    }
+};
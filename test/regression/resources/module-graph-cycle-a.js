@@ -0,0 +1,36 @@
+/*
+ * Copyright (c) 2020-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+// module-graph.js: cycle of cycle-a and cycle-b
+
+import { log } from "./module-graph-base.js";
+import { valueOfB } from "./module-graph-cycle-b.js";
+
+export { valueOfB };
+export let valueOfA = "a";
+
+export function cycleA() {
+    return valueOfA;
+}
+
+export function nameOfA() {
+    return "a";
+}
+
+log.push("cycle-a");
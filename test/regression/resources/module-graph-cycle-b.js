@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2020-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+// module-graph.js: cycle of cycle-a and cycle-b
+
+import { log } from "./module-graph-base.js";
+import { nameOfA, valueOfA } from "./module-graph-cycle-a.js";
+
+var global = Function("return this")();
+global.moduleGraphFunctionCallInB = (function() {
+    try {
+        return nameOfA();
+    } catch (e) {
+        return e.name;
+    }
+})();
+global.moduleGraphBindingAccessInB = (function() {
+    try {
+        return valueOfA;
+    } catch (e) {
+        return e.name;
+    }
+})();
+
+export function valueOfB() {
+    return "b";
+}
+
+log.push("cycle-b");
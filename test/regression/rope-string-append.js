@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2020-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+// appending onto flat buffer of RopeString
+
+function build(parts) {
+    return parts.join("");
+}
+
+// s += s doubles string using its own buffer as right operand
+(function () {
+    var s = "abcdefghijklmnopqrstuvwxyz0123456789";
+    var expected = s;
+    for (var i = 0; i < 12; i++) {
+        s += s;
+        expected = build([expected, expected]);
+        assertEquals(expected.length, s.length);
+    }
+    assertEquals(expected, s);
+    assertEquals("abcdef", s.substring(0, 6));
+    assertEquals("0123456789", s.substring(s.length - 10));
+})();
+
+// 8-bit string becomes 16-bit in the middle of loop
+(function () {
+    var s = "prefix string which is longer than rope minimum length ";
+    var parts = [s];
+    for (var i = 0; i < 2000; i++) {
+        var chunk = (i == 1000) ? "あ😀" : ("item" + i + ",");
+        s += chunk;
+        parts.push(chunk);
+    }
+    assertEquals(build(parts), s);
+    assertEquals(0x3042, s.charCodeAt(s.indexOf("あ")));
+    assertEquals(0xDE00, s.charCodeAt(s.indexOf("あ") + 2));
+    assertEquals("item1999,", s.substring(s.length - 9));
+})();
+
+// several strings are made by appending onto same prefix
+// each result should keep its own suffix
+(function () {
+    var base = "";
+    for (var i = 0; i < 100; i++) {
+        base += "base" + i + ";";
+    }
+    var a = base + "AAAAAAAA";
+    var b = base + "BBBBBBBB";
+    var c = a + "CC";
+    var d = b + "ÿĀ";
+    var e = base + "EEEEEEEE";
+    assertEquals(base.length + 8, a.length);
+    assertEquals("AAAAAAAA", a.substring(base.length));
+    assertEquals("BBBBBBBB", b.substring(base.length));
+    assertEquals("AAAAAAAACC", c.substring(base.length));
+    assertEquals("BBBBBBBBÿĀ", d.substring(base.length));
+    assertEquals("EEEEEEEE", e.substring(base.length));
+    assertEquals(base, a.substring(0, base.length));
+    assertEquals(base, e.substring(0, base.length));
+
+    // appending more onto older branch must not change newer ones
+    for (var i = 0; i < 100; i++) {
+        a += "a";
+    }
+    assertEquals("EEEEEEEE", e.substring(base.length));
+    assertEquals("AAAAAAAACC", c.substring(base.length));
+    assertEquals(base.length + 108, a.length);
+})();
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2020-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+
+// sampling profiler takes samples of interpreter frames on vm thread
+
+function busyLoop(ms) {
+    var start = Date.now();
+    var x = 0;
+    while (Date.now() - start < ms) {
+        for (var i = 0; i < 1000; i++) {
+            x = (x + i * 7) % 1000003;
+        }
+    }
+    return x;
+}
+
+function parseProfile(profile) {
+    var result = { total: 0, dropped: 0, stacks: [] };
+    var lines = profile.split("\n");
+    for (var i = 0; i < lines.length; i++) {
+        if (!lines[i].length) {
+            continue;
+        }
+        var space = lines[i].lastIndexOf(" ");
+        var stack = lines[i].substring(0, space);
+        var count = Number(lines[i].substring(space + 1));
+        assert(count > 0, "bad sample count in line: " + lines[i]);
+        if (stack == "(dropped)") {
+            result.dropped += count;
+        } else {
+            result.total += count;
+            result.stacks.push(stack);
+        }
+    }
+    return result;
+}
+
+function profileOnce() {
+    assert(startCPUProfiler(1000), "profiler should start");
+    assert(!startCPUProfiler(1000), "profiler should not start twice");
+    busyLoop(300);
+    var profile = parseProfile(stopCPUProfiler());
+
+    // 300ms of cpu time with 1ms interval. allow heavy slack for loaded machines
+    assert(profile.total >= 10, "too few samples: " + profile.total);
+    // timer is bound to this thread. nothing is sampled from other threads
+    assertEquals(0, profile.dropped);
+
+    var sawBusyLoop = false;
+    for (var i = 0; i < profile.stacks.length; i++) {
+        var frames = profile.stacks[i].split(";");
+        if (frames[frames.length - 1].indexOf("busyLoop") == 0) {
+            sawBusyLoop = true;
+            assert(frames[frames.length - 2].indexOf("profileOnce") == 0, "caller of busyLoop should be profileOnce: " + profile.stacks[i]);
+        }
+    }
+    assert(sawBusyLoop, "busyLoop should be sampled");
+}
+
+// profiler can be restarted after stop
+profileOnce();
+profileOnce();
+
+// stopping without samples gives empty profile
+assert(startCPUProfiler(1000000));
+assertEquals("", stopCPUProfiler());
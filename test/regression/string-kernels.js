@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2020-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+
+// SIMD string kernels against naive reference code, and UTF-8 encoding built on top of them
+
+// every kernel over lengths 0..100 with every start alignment in 32 bytes
+assertEquals(0, verifyStringKernels(), "string kernel mismatches");
+
+function referenceUTF8(s) {
+    var out = "";
+    for (var i = 0; i < s.length; i++) {
+        var c = s.charCodeAt(i);
+        if (c >= 0xD800 && c <= 0xDBFF) {
+            if (i + 1 == s.length) {
+                // lone lead surrogate at the end is encoded as is
+            } else {
+                var c2 = s.charCodeAt(i + 1);
+                if (c2 >= 0xDC00 && c2 <= 0xDFFF) {
+                    out += unescape(encodeURIComponent(s.substr(i, 2)));
+                    i++;
+                    continue;
+                }
+                c = 0xFFFD;
+            }
+        }
+        if (c < 0x80) {
+            out += String.fromCharCode(c);
+        } else if (c < 0x800) {
+            out += String.fromCharCode(0xC0 | (c >> 6), 0x80 | (c & 0x3F));
+        } else {
+            out += String.fromCharCode(0xE0 | (c >> 12), 0x80 | ((c >> 6) & 0x3F), 0x80 | (c & 0x3F));
+        }
+    }
+    return out;
+}
+
+function check(s) {
+    assertEquals(referenceUTF8(s), toUTF8Bytes(s), "UTF-8 of " + escape(s));
+}
+
+var runs = ["", "a", "abcdefghijklmnopqrstuvwxyz0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ",
+            "\xe9", "\xe9\xe8\xff", "あい", "\u{1F600}\u{1F601}", "\uD800", "\uDC00", "\uD800x"];
+
+// ascii and non-ascii runs of every combination, both on 8-bit and 16-bit strings
+for (var i = 0; i < runs.length; i++) {
+    for (var j = 0; j < runs.length; j++) {
+        for (var k = 0; k < runs.length; k++) {
+            check(runs[i] + runs[j] + runs[k]);
+            check(runs[i] + runs[j] + runs[k] + "あ");
+        }
+    }
+}
+
+// long non-ascii run followed by ascii tail of every length
+var nonASCII = "\xe9あ\u{1F600}".repeat(40);
+var ascii = "x".repeat(70);
+for (var i = 0; i <= ascii.length; i++) {
+    check(nonASCII + ascii.substr(0, i));
+    check(ascii.substr(0, i) + nonASCII);
+}
+
+// lead surrogate at the very end after long run
+check("あ".repeat(100) + "\uD83D");
@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) 2020-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+
+
+// serialize(value) returns ArrayBuffer of structured clone and deserialize(buffer) reads it back
+
+function roundTrip(value) {
+    return deserialize(serialize(value));
+}
+
+function bytesOf(value) {
+    return Array.prototype.slice.call(new Uint8Array(serialize(value)));
+}
+
+function deserializeBytes(bytes) {
+    var buffer = new ArrayBuffer(bytes.length);
+    var view = new Uint8Array(buffer);
+    for (var i = 0; i < bytes.length; i++) {
+        view[i] = bytes[i];
+    }
+    return deserialize(buffer);
+}
+
+// primitives
+assertEquals(undefined, roundTrip(undefined));
+assertEquals(null, roundTrip(null));
+assertEquals(true, roundTrip(true));
+assertEquals(false, roundTrip(false));
+[0, -0, 1, -1, 0x7fffffff, -0x80000000, 0x80000000, 1.5, NaN, Infinity, -Infinity, Number.MIN_VALUE].forEach(function(n) {
+    assertEquals(n, roundTrip(n));
+});
+["", "ascii", "latin1 éÿ", "utf16 あ😀", "a".repeat(1000)].forEach(function(s) {
+    assertEquals(s, roundTrip(s));
+});
+
+// shared and cyclic references are restored
+var shared = { name: "shared" };
+var pair = roundTrip([shared, shared, { inner: shared }]);
+assert(pair[0] === pair[1], "shared object should be deserialized once");
+assert(pair[0] === pair[2].inner, "shared object referred from nested object");
+assertEquals("shared", pair[0].name);
+
+var cyclic = { name: "cyclic" };
+cyclic.self = cyclic;
+cyclic.list = [cyclic, 1];
+var cyclicCopy = roundTrip(cyclic);
+assert(cyclicCopy !== cyclic);
+assert(cyclicCopy.self === cyclicCopy, "object referring itself");
+assert(cyclicCopy.list[0] === cyclicCopy, "array referring its owner");
+
+var selfArray = [1, 2];
+selfArray.push(selfArray);
+var selfArrayCopy = roundTrip(selfArray);
+assert(selfArrayCopy[2] === selfArrayCopy, "array referring itself");
+
+var map = new Map();
+var set = new Set();
+map.set(map, set);
+map.set("key", map);
+set.add(set);
+set.add(map);
+var mapCopy = roundTrip(map);
+assertEquals(2, mapCopy.size);
+assert(mapCopy.get(mapCopy) instanceof Set, "map key referring map itself");
+assert(mapCopy.get("key") === mapCopy);
+var setCopy = mapCopy.get(mapCopy);
+assert(setCopy.has(setCopy) && setCopy.has(mapCopy), "set referring itself and map");
+
+// views keep sharing their buffer
+var buffer = new ArrayBuffer(16);
+var views = roundTrip({ bytes: new Uint8Array(buffer, 4, 8), data: new DataView(buffer), buffer: buffer });
+assert(views.bytes.buffer === views.buffer && views.data.buffer === views.buffer, "views should share deserialized buffer");
+assertEquals(4, views.bytes.byteOffset);
+assertEquals(8, views.bytes.length);
+views.data.setUint8(5, 42);
+assertEquals(42, views.bytes[1]);
+
+// other cloneable objects
+var date = roundTrip(new Date(1234567890123));
+assertEquals(1234567890123, date.getTime());
+var regexp = roundTrip(/a+b/gi);
+assertEquals("a+b", regexp.source);
+assert(regexp.global && regexp.ignoreCase && !regexp.multiline, "flags of regexp");
+assertEquals(false, roundTrip(new Boolean(false)).valueOf());
+assertEquals(-0, roundTrip(new Number(-0)).valueOf());
+assertEquals("boxed", roundTrip(new String("boxed")).valueOf());
+var sparse = [1, , 3];
+sparse[100] = 4;
+sparse.named = "named";
+var sparseCopy = roundTrip(sparse);
+assertEquals(101, sparseCopy.length);
+assert(!(1 in sparseCopy), "hole should stay hole");
+assertEquals(4, sparseCopy[100]);
+assertEquals("named", sparseCopy.named);
+
+// objects with same ObjectStructure are written with a cached shape
+var points = [];
+for (var i = 0; i < 50; i++) {
+    points.push({ x: i, y: "y" + i, z: i % 2 ? { nested: i } : null });
+}
+var pointsCopy = roundTrip(points);
+for (var i = 0; i < 50; i++) {
+    assertArrayEquals(["x", "y", "z"], Object.keys(pointsCopy[i]));
+    assertEquals(i, pointsCopy[i].x);
+    assertEquals("y" + i, pointsCopy[i].y);
+    assertEquals(i % 2 ? i : undefined, pointsCopy[i].z ? pointsCopy[i].z.nested : undefined);
+}
+pointsCopy[0].w = "added";
+assertEquals(undefined, pointsCopy[1].w, "objects sharing a shape should not share properties");
+
+// second object with the same shape is smaller than the first one
+var first = bytesOf([{ alpha: 1, beta: 2 }]).length;
+var two = bytesOf([{ alpha: 1, beta: 2 }, { alpha: 3, beta: 4 }]).length;
+assert(two - first < first - 4, "shape should be written once");
+
+// same keys in other order and objects grown from a shared shape
+var mixed = roundTrip([{ a: 1, b: 2 }, { b: 3, a: 4 }, { a: 5, b: 6, c: 7 }, { a: 8, b: 9 }]);
+assertArrayEquals(["a", "b"], Object.keys(mixed[0]));
+assertArrayEquals(["b", "a"], Object.keys(mixed[1]));
+assertArrayEquals(["a", "b", "c"], Object.keys(mixed[2]));
+assertArrayEquals([8, 9], [mixed[3].a, mixed[3].b]);
+
+// getter result is cloned, not the accessor
+var withGetter = roundTrip({ get value() { return 10; } });
+assertEquals(10, withGetter.value);
+assertEquals(undefined, Object.getOwnPropertyDescriptor(withGetter, "value").get);
+
+// values which can't be cloned
+assertThrows(TypeError, function() { serialize(function() {}); });
+assertThrows(TypeError, function() { serialize(Symbol("s")); });
+assertThrows(TypeError, function() { serialize({ nested: [new Proxy({}, {})] }); });
+assertThrows(TypeError, function() { serialize(new WeakMap()); });
+assertThrows(TypeError, function() { serialize(Promise.resolve(1)); });
+
+// every truncation of valid data throws
+var complex = { list: points.slice(0, 3), map: map, text: "あtext", buffer: buffer, number: 1.25, date: new Date(0) };
+var complexBytes = bytesOf(complex);
+for (var length = 0; length < complexBytes.length; length++) {
+    assertThrows(TypeError, function() {
+        deserializeBytes(complexBytes.slice(0, length));
+    }, "truncated at " + length);
+}
+// and full data is still valid
+assertEquals("あtext", deserializeBytes(complexBytes).text);
+
+// corrupted data throws
+var header = bytesOf(undefined).slice(0, 2);
+assertEquals(0xFF, header[0]);
+var corrupted = [
+    [0xFE, header[1], 1], // bad header
+    [0xFF, header[1] + 1, 1], // other format version
+    header.concat([0]), // unknown tag
+    header.concat([0xEE]), // unknown tag
+    header.concat([9, 0]), // reference to object not seen yet
+    header.concat([11, 0]), // shape not defined yet
+    header.concat([7, 0xFF, 0xFF, 0xFF, 0xFF, 0x0F]), // string longer than data
+    header.concat([12, 0xFF, 0xFF, 0xFF, 0xFF, 0x0F]), // array longer than data
+    header.concat([5, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x01]), // varint over 64 bits
+    header.concat([5, 0x80, 0x80, 0x80, 0x80, 0x10]), // int32 out of range
+    header.concat([10, 1, 1, 1]), // object key should be a string
+    header.concat([24, 0]), // transferred buffer without transfer list
+];
+corrupted.forEach(function(bytes, index) {
+    assertThrows(TypeError, function() {
+        deserializeBytes(bytes);
+    }, "corrupted data " + index);
+});
+assertThrows(TypeError, function() { deserialize(new ArrayBuffer(0)); });
+assertThrows(TypeError, function() { deserialize("not a buffer"); });
+
+// flipping any byte gives some value or throws. it never crashes
+for (var i = 2; i < complexBytes.length; i++) {
+    var flipped = complexBytes.slice();
+    flipped[i] ^= 0xFF;
+    try {
+        deserializeBytes(flipped);
+    } catch (e) {
+        assert(e instanceof Error, "byte " + i + " flipped: " + e);
+    }
+}
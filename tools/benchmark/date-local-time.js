@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2020-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+// Microbenchmark of local time Date getters and setters around DST transitions.
+// run with a timezone which has DST to exercise the timezone offset cache
+// usage: TZ=America/New_York escargot tools/benchmark/date-local-time.js
+// prints millions of operations per second for each case
+
+// times around spring forward and fall back transitions of every year, plus ordinary days
+var times = [];
+for (var year = 1970; year < 2038; year++) {
+    var months = [0, 2, 3, 6, 9, 10, 11];
+    for (var i = 0; i < months.length; i++) {
+        for (var day = 1; day <= 28; day += 3) {
+            var base = Date.UTC(year, months[i], day);
+            for (var hour = 0; hour < 24; hour += 5) {
+                times.push(base + hour * 3600 * 1000 + 17 * 60 * 1000);
+            }
+        }
+    }
+}
+var operationCount = 1 << 21;
+
+function run(name, count, fn) {
+    // warm up
+    fn(times.length);
+    var start = Date.now();
+    var result = fn(count);
+    var elapsed = Math.max(Date.now() - start, 1);
+    print(name + ": " + (count / elapsed / 1000).toFixed(2) + "M ops/s (" + elapsed + "ms, checksum " + result + ")");
+}
+
+// sequential access hits the cached offset interval, strided access moves across transitions
+run("getters sequential", operationCount, function (count) {
+    var d = new Date(0);
+    var sum = 0;
+    for (var i = 0; i < count; i++) {
+        d.setTime(times[i % times.length]);
+        sum += d.getHours() + d.getDate() + d.getMonth() + d.getDay() + d.getTimezoneOffset();
+    }
+    return sum;
+});
+
+run("getters strided", operationCount, function (count) {
+    var d = new Date(0);
+    var sum = 0;
+    var length = times.length;
+    for (var i = 0; i < count; i++) {
+        d.setTime(times[(i * 7919) % length]);
+        sum += d.getHours() + d.getDate() + d.getMonth() + d.getDay() + d.getTimezoneOffset();
+    }
+    return sum;
+});
+
+run("setters", operationCount, function (count) {
+    var d = new Date(0);
+    var sum = 0;
+    for (var i = 0; i < count; i++) {
+        d.setTime(times[i % times.length]);
+        d.setHours(i % 24, 30);
+        d.setDate(1 + i % 28);
+        d.setMonth(i % 12);
+        sum += d.getTime() % 1000003;
+    }
+    return sum;
+});
+
+run("constructor from local fields", operationCount, function (count) {
+    var sum = 0;
+    for (var i = 0; i < count; i++) {
+        // hours 1..3 of days around transitions include skipped and repeated local times
+        sum += new Date(1970 + i % 68, 2 + (i % 2) * 8, 1 + i % 14, 1 + i % 3, 30).getTime() % 1000003;
+    }
+    return sum;
+});
+
+run("toString", operationCount >> 4, function (count) {
+    var d = new Date(0);
+    var length = 0;
+    for (var i = 0; i < count; i++) {
+        d.setTime(times[(i * 31) % times.length]);
+        length += d.toString().length;
+    }
+    return length;
+});
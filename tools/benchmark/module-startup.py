@@ -0,0 +1,97 @@
+#!/usr/bin/env python
+
+# Copyright 2020-present Samsung Electronics Co., Ltd.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# Cold start benchmark of module-heavy application.
+# generates a module graph into temporary directory and measures wall time of
+# running its entry module with a fresh escargot process each time.
+# usage: tools/benchmark/module-startup.py [--engine ./escargot] [--modules 400] [--runs 10]
+
+from __future__ import print_function
+
+import os
+import shutil
+import subprocess
+import tempfile
+import time
+
+from argparse import ArgumentParser
+from os.path import abspath, dirname, join
+
+
+PROJECT_SOURCE_DIR = dirname(dirname(dirname(abspath(__file__))))
+DEFAULT_ESCARGOT = join(PROJECT_SOURCE_DIR, 'escargot')
+
+
+def module_source(index, module_count, fan_out, body_size):
+    lines = []
+    # every module imports some modules of next levels, so graph is wide and has shared dependencies
+    for k in range(1, fan_out + 1):
+        dependency = index * fan_out + k
+        if dependency < module_count:
+            lines.append('import { value%d } from "./module%d.mjs";' % (dependency, dependency))
+    lines.append('export function compute%d(n) {' % index)
+    lines.append('    var result = n;')
+    for j in range(body_size):
+        lines.append('    result = (result * %d + %d) %% 1000003;' % (j + 3, index))
+    lines.append('    return result;')
+    lines.append('}')
+    dependencies = ['value%d' % (index * fan_out + k) for k in range(1, fan_out + 1) if index * fan_out + k < module_count]
+    lines.append('export var value%d = compute%d(%s);' % (index, index, ' + '.join(dependencies) if dependencies else str(index)))
+    return '\n'.join(lines) + '\n'
+
+
+def generate_graph(directory, module_count, fan_out, body_size):
+    for index in range(module_count):
+        with open(join(directory, 'module%d.mjs' % index), 'w') as f:
+            f.write(module_source(index, module_count, fan_out, body_size))
+    entry = join(directory, 'entry.mjs')
+    with open(entry, 'w') as f:
+        f.write('import { value0 } from "./module0.mjs";\n')
+        f.write('if (typeof value0 !== "number") throw new Error("module graph is not evaluated");\n')
+    return entry
+
+
+def main():
+    parser = ArgumentParser(description='Module graph cold start benchmark')
+    parser.add_argument('--engine', metavar='PATH', default=DEFAULT_ESCARGOT, help='path to the engine to be tested (default: %(default)s)')
+    parser.add_argument('--modules', type=int, default=400, help='number of modules in graph (default: %(default)s)')
+    parser.add_argument('--fan-out', type=int, default=3, help='number of imports of each module (default: %(default)s)')
+    parser.add_argument('--body-size', type=int, default=50, help='number of statements in each module (default: %(default)s)')
+    parser.add_argument('--runs', type=int, default=10, help='number of measured runs (default: %(default)s)')
+    args = parser.parse_args()
+
+    directory = tempfile.mkdtemp(prefix='escargot-module-startup-')
+    try:
+        entry = generate_graph(directory, args.modules, args.fan_out, args.body_size)
+
+        # first run warms file system cache
+        subprocess.check_call([args.engine, entry])
+
+        elapsed = []
+        for _ in range(args.runs):
+            start = time.time()
+            subprocess.check_call([args.engine, entry])
+            elapsed.append((time.time() - start) * 1000)
+        elapsed.sort()
+
+        print('modules: %d, runs: %d' % (args.modules, args.runs))
+        print('min: %.2fms, median: %.2fms, max: %.2fms' % (elapsed[0], elapsed[len(elapsed) // 2], elapsed[-1]))
+    finally:
+        shutil.rmtree(directory)
+
+
+if __name__ == '__main__':
+    main()
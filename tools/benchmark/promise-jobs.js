@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2020-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+
+// Microbenchmark of promise reaction jobs and await.
+// cases run one after another from the job queue, so numbers are printed while the queue drains
+// usage: escargot tools/benchmark/promise-jobs.js
+// prints millions of operations per second for each case
+
+var operationCount = 1 << 20;
+
+var cases = [];
+
+function add(name, count, fn) {
+    cases.push({ name: name, count: count, fn: fn });
+}
+
+function runCase(index) {
+    if (index >= cases.length) {
+        return;
+    }
+    var c = cases[index];
+    // warm up
+    c.fn(c.count >> 6).then(function () {
+        var start = Date.now();
+        return c.fn(c.count).then(function (result) {
+            var elapsed = Math.max(Date.now() - start, 1);
+            print(c.name + ": " + (c.count / elapsed / 1000).toFixed(2) + "M ops/s (" + elapsed + "ms, checksum " + result + ")");
+        });
+    }).then(function () {
+        runCase(index + 1);
+    });
+}
+
+// each then enqueues one reaction job when previous promise is resolved
+add("then chain", operationCount, function (count) {
+    var p = Promise.resolve(0);
+    for (var i = 0; i < count; i++) {
+        p = p.then(function (v) {
+            return v + 1;
+        });
+    }
+    return p;
+});
+
+// chain is built while previous promise is pending, so reactions are queued on the promise first
+add("then chain on pending promise", operationCount, function (count) {
+    var resolve;
+    var first = new Promise(function (r) {
+        resolve = r;
+    });
+    var p = first;
+    for (var i = 0; i < count; i++) {
+        p = p.then(function (v) {
+            return v + 1;
+        });
+    }
+    resolve(0);
+    return p;
+});
+
+// await of non-promise values wraps them with the intrinsic %Promise%
+add("await value", operationCount, function (count) {
+    return (async function () {
+        var sum = 0;
+        for (var i = 0; i < count; i++) {
+            sum += await i;
+        }
+        return sum % 1000003;
+    })();
+});
+
+// await of a settled native promise resumes from the reaction record without helper functions
+add("await resolved promise", operationCount, function (count) {
+    return (async function () {
+        var sum = 0;
+        for (var i = 0; i < count; i++) {
+            sum += await Promise.resolve(i);
+        }
+        return sum % 1000003;
+    })();
+});
+
+// async function calling async function awaits the returned pending promise
+add("await async call", operationCount >> 1, function (count) {
+    async function inner(v) {
+        return v + 1;
+    }
+    return (async function () {
+        var sum = 0;
+        for (var i = 0; i < count; i++) {
+            sum += await inner(i);
+        }
+        return sum % 1000003;
+    })();
+});
+
+// many interleaved async functions keep a lot of jobs in the queue at once
+add("concurrent awaits", operationCount, function (count) {
+    var chains = 1000;
+    var steps = count / chains;
+    var all = [];
+    for (var j = 0; j < chains; j++) {
+        all.push((async function (seed) {
+            var sum = seed;
+            for (var i = 0; i < steps; i++) {
+                sum += await i;
+            }
+            return sum;
+        })(j));
+    }
+    return Promise.all(all).then(function (results) {
+        return results.length;
+    });
+});
+
+runCase(0);
@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2020-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+
+// Microbenchmark of string kernels.
+// needs a shell built with ESCARGOT_OUTPUT=shell_test
+// usage: escargot tools/benchmark/string-kernels.js
+// prints bytes of source buffer processed per cpu cycle for each buffer length
+
+var kernels = [
+    "countASCIIPrefix8", "countASCIIPrefix16", "countLatin1Prefix16",
+    "countJSONPlainPrefix8", "countJSONPlainPrefix16",
+    "countNonLineTerminatorPrefix8", "countNonLineTerminatorPrefix16",
+    "countMultiLineCommentPlainPrefix8", "countMultiLineCommentPlainPrefix16",
+    "countStringLiteralPlainPrefix8", "countStringLiteralPlainPrefix16",
+    "countASCIIIdentifierPartPrefix8", "countASCIIIdentifierPartPrefix16",
+    "countSpaceOrTabPrefix8", "countSpaceOrTabPrefix16",
+    "widen", "narrow"
+];
+
+// short buffers stress the tail handling, long ones the vector loop
+var lengths = [7, 31, 100, 4096];
+var totalCharacters = 1 << 26;
+
+for (var i = 0; i < kernels.length; i++) {
+    var line = kernels[i] + ":";
+    for (var j = 0; j < lengths.length; j++) {
+        var bytesPerCycle = benchmarkStringKernel(kernels[i], lengths[j], Math.ceil(totalCharacters / lengths[j]));
+        line += " " + lengths[j] + "=" + bytesPerCycle.toFixed(2) + "B/cycle";
+    }
+    print(line);
+}
@@ -112,6 +112,18 @@ def run_sunspider_js(engine, arch):
     run([engine] + sorted(glob(join(PROJECT_SOURCE_DIR, 'test', 'vendortest', 'SunSpider', 'tests', 'sunspider-1.0.2', '*.js'))))
 
 
+@runner('concurrent-vms')
+def run_concurrent_vms(engine, arch):
+    # needs an engine built with ESCARGOT_THREADING. every file runs on 4 VMInstances at once
+    run([engine, '--concurrent-vms=4'] + sorted(glob(join(PROJECT_SOURCE_DIR, 'test', 'vendortest', 'SunSpider', 'tests', 'sunspider-1.0.2', '*.js'))))
+
+
+@runner('cctest')
+def run_cctest(engine, arch):
+    # needs the executable of a build with -DESCARGOT_OUTPUT=cctest as engine. it exits with nonzero on any failed check
+    run([engine], cwd=join(PROJECT_SOURCE_DIR, 'test', 'cctest'))
+
+
 @runner('octane', default=True)
 def run_octane(engine, arch):
     max_retry_count = 3
@@ -293,10 +305,30 @@ def run_jsc_stress(engine, arch):
         env={'PYTHONPATH': '.'})
 
 
-def _run_regression_tests(engine, assert_js, files, is_fail):
+def _read_test_options(file):
+    # leading comment lines of test can give extra shell options and environment variables
+    # e.g. `// flags: --module` or `// env: TZ=America/Los_Angeles`
+    # flags are put right before the test file because some options like --module apply to the next file only
+    flags, env = [], dict(os.environ)
+    with open(file) as f:
+        for line in f:
+            line = line.strip()
+            if line.startswith('// flags:'):
+                flags += line[len('// flags:'):].split()
+            elif line.startswith('// env:'):
+                for assignment in line[len('// env:'):].split():
+                    name, value = assignment.split('=', 1)
+                    env[name] = value
+            else:
+                break
+    return flags, env
+
+
+def _run_regression_tests(engine, assert_js, files, is_fail, cwd=None):
     fails = 0
     for file in files:
-        proc = Popen([engine, assert_js, file], stdout=PIPE)
+        flags, env = _read_test_options(file)
+        proc = Popen([engine, assert_js] + flags + [file], stdout=PIPE, cwd=cwd, env=env)
         out, _ = proc.communicate()
 
         if is_fail and proc.returncode or not is_fail and not proc.returncode:
@@ -511,6 +543,35 @@ def run_intl(engine, arch):
     if fails > 0:
         raise Exception('Intl tests failed')
 
+def _is_test_shell(engine):
+    # tests under test/regression use builtins only a shell_test build provides (drainJobQueue, serialize, ...)
+    proc = Popen([engine, '-e', 'if (typeof drainJobQueue !== "function") throw new Error()'], stdout=PIPE, stderr=PIPE)
+    proc.communicate()
+    return proc.returncode == 0
+
+
+@runner('escargot-regression')
+def run_escargot_regression(engine, arch):
+    REGRESSION_DIR = join(PROJECT_SOURCE_DIR, 'test', 'regression')
+    REGRESSION_ASSERT_JS = join(REGRESSION_DIR, 'assert.js')
+
+    if not _is_test_shell(engine):
+        raise Exception('escargot regression tests need an engine built with -DESCARGOT_OUTPUT=shell_test')
+
+    print('Running escargot regression tests:')
+    files = sorted(glob(join(REGRESSION_DIR, '*.js')))
+    files.remove(REGRESSION_ASSERT_JS)
+    fail_total = _run_regression_tests(engine, REGRESSION_ASSERT_JS, files, False, cwd=REGRESSION_DIR)
+
+    tests_total = len(files)
+    print('TOTAL: %d' % (tests_total))
+    print('%sPASS : %d%s' % (COLOR_GREEN, tests_total - fail_total, COLOR_RESET))
+    print('%sFAIL : %d%s' % (COLOR_RED, fail_total, COLOR_RESET))
+
+    if fail_total > 0:
+        raise Exception('escargot regression tests failed')
+
+
 def main():
     parser = ArgumentParser(description='Escargot Test Suite Runner')
     parser.add_argument('--engine', metavar='PATH', default=DEFAULT_ESCARGOT,